@@ -127,22 +127,22 @@ public:
   /** iterator pointing to first change */
   const_iterator begin() const
   {
-    return objects_.begin();
+    return objects_->begin();
   }
   /** iterator pointing to end of changes */
   const_iterator end() const
   {
-    return objects_.end();
+    return objects_->end();
   }
   /** number of changes stored */
   std::size_t size() const
   {
-    return objects_.size();
+    return objects_->size();
   }
   /** find changes for a named object */
   const_iterator find(const std::string& object_id) const
   {
-    return objects_.find(object_id);
+    return objects_->find(object_id);
   }
 
   /** \brief Check if a particular object exists in the collision world*/
@@ -335,8 +335,14 @@ private:
   /** \brief Updates the global shape and subframe poses. */
   void updateGlobalPosesInternal(ObjectPtr& obj, bool update_shape_poses = true, bool update_subframe_poses = true);
 
-  /** The objects maintained in the world */
-  std::map<std::string, ObjectPtr> objects_;
+  using ObjectMap = std::map<std::string, ObjectPtr>;
+
+  /** \brief Make sure that the object map is known only to this instance of the World, copying it (but not the objects)
+   * if it is shared with a copy of this World. Must be called before the map or one of its objects is modified. */
+  void makeObjectsUnique();
+
+  /** The objects maintained in the world, shared with copies of this World until either is modified */
+  std::shared_ptr<ObjectMap> objects_;
 
   /** Wrapper for a callback function to call when something changes in the world */
   class Observer
@@ -50,13 +50,13 @@ rclcpp::Logger getLogger()
 }
 }  // namespace
 
-World::World()
+World::World() : objects_(std::make_shared<ObjectMap>())
 {
 }
 
-World::World(const World& other)
+World::World(const World& other) : objects_(other.objects_)
 {
-  objects_ = other.objects_;
+  // the object map is shared until either world changes, see makeObjectsUnique()
 }
 
 World::~World()
@@ -90,7 +90,8 @@ void World::addToObject(const std::string& object_id, const Eigen::Isometry3d& p
 
   int action = ADD_SHAPE;
 
-  ObjectPtr& obj = objects_[object_id];
+  makeObjectsUnique();
+  ObjectPtr& obj = (*objects_)[object_id];
   if (!obj)
   {
     obj = std::make_shared<Object>(object_id);
@@ -109,16 +110,16 @@ void World::addToObject(const std::string& object_id, const Eigen::Isometry3d& p
 std::vector<std::string> World::getObjectIds() const
 {
   std::vector<std::string> ids;
-  ids.reserve(objects_.size());
-  for (const auto& object : objects_)
+  ids.reserve(objects_->size());
+  for (const auto& object : *objects_)
     ids.push_back(object.first);
   return ids;
 }
 
 World::ObjectConstPtr World::getObject(const std::string& object_id) const
 {
-  const auto it = objects_.find(object_id);
-  if (it == objects_.end())
+  const auto it = objects_->find(object_id);
+  if (it == objects_->end())
   {
     return ObjectConstPtr();
   }
@@ -128,6 +129,13 @@ World::ObjectConstPtr World::getObject(const std::string& object_id) const
   }
 }
 
+void World::makeObjectsUnique()
+{
+  // after this, the objects are shared with the other world and ensureUnique() copies them before they are modified
+  if (objects_.use_count() > 1)
+    objects_ = std::make_shared<ObjectMap>(*objects_);
+}
+
 void World::ensureUnique(ObjectPtr& obj)
 {
   if (obj && !obj.unique())
@@ -136,20 +144,20 @@ void World::ensureUnique(ObjectPtr& obj)
 
 bool World::hasObject(const std::string& object_id) const
 {
-  return objects_.find(object_id) != objects_.end();
+  return objects_->find(object_id) != objects_->end();
 }
 
 bool World::knowsTransform(const std::string& name) const
 {
   // Check object names first
-  const std::map<std::string, ObjectPtr>::const_iterator it = objects_.find(name);
-  if (it != objects_.end())
+  const ObjectMap::const_iterator it = objects_->find(name);
+  if (it != objects_->end())
   {
     return true;
   }
   else  // Then objects' subframes
   {
-    for (const std::pair<const std::string, ObjectPtr>& object : objects_)
+    for (const std::pair<const std::string, ObjectPtr>& object : *objects_)
     {
       // if "object name/" matches start of object_id, we found the matching object
       // rfind searches name for object.first in the first index (returns 0 if found)
@@ -177,14 +185,14 @@ const Eigen::Isometry3d& World::getTransform(const std::string& name, bool& fram
   // assume found
   frame_found = true;
 
-  const std::map<std::string, ObjectPtr>::const_iterator it = objects_.find(name);
-  if (it != objects_.end())
+  const ObjectMap::const_iterator it = objects_->find(name);
+  if (it != objects_->end())
   {
     return it->second->pose_;
   }
   else  // Search within subframes
   {
-    for (const std::pair<const std::string, ObjectPtr>& object : objects_)
+    for (const std::pair<const std::string, ObjectPtr>& object : *objects_)
     {
       // if "object name/" matches start of object_id, we found the matching object
       // rfind searches name for object.first in the first index (returns 0 if found)
@@ -207,8 +215,8 @@ const Eigen::Isometry3d& World::getTransform(const std::string& name, bool& fram
 
 const Eigen::Isometry3d& World::getGlobalShapeTransform(const std::string& object_id, const int shape_index) const
 {
-  const auto it = objects_.find(object_id);
-  if (it != objects_.end())
+  const auto it = objects_->find(object_id);
+  if (it != objects_->end())
   {
     return it->second->global_shape_poses_[shape_index];
   }
@@ -222,8 +230,8 @@ const Eigen::Isometry3d& World::getGlobalShapeTransform(const std::string& objec
 
 const EigenSTL::vector_Isometry3d& World::getGlobalShapeTransforms(const std::string& object_id) const
 {
-  const auto it = objects_.find(object_id);
-  if (it != objects_.end())
+  const auto it = objects_->find(object_id);
+  if (it != objects_->end())
   {
     return it->second->global_shape_poses_;
   }
@@ -238,8 +246,9 @@ const EigenSTL::vector_Isometry3d& World::getGlobalShapeTransforms(const std::st
 bool World::moveShapeInObject(const std::string& object_id, const shapes::ShapeConstPtr& shape,
                               const Eigen::Isometry3d& shape_pose)
 {
-  const auto it = objects_.find(object_id);
-  if (it != objects_.end())
+  makeObjectsUnique();
+  const auto it = objects_->find(object_id);
+  if (it != objects_->end())
   {
     const unsigned int n = it->second->shapes_.size();
     for (unsigned int i = 0; i < n; ++i)
@@ -261,11 +270,13 @@ bool World::moveShapeInObject(const std::string& object_id, const shapes::ShapeC
 
 bool World::moveShapesInObject(const std::string& object_id, const EigenSTL::vector_Isometry3d& shape_poses)
 {
-  auto it = objects_.find(object_id);
-  if (it != objects_.end())
+  makeObjectsUnique();
+  auto it = objects_->find(object_id);
+  if (it != objects_->end())
   {
     if (shape_poses.size() == it->second->shapes_.size())
     {
+      ensureUnique(it->second);
       for (std::size_t i = 0; i < shape_poses.size(); ++i)
       {
         ASSERT_ISOMETRY(shape_poses[i])  // unsanitized input, could contain a non-isometry
@@ -281,8 +292,8 @@ bool World::moveShapesInObject(const std::string& object_id, const EigenSTL::vec
 
 bool World::moveObject(const std::string& object_id, const Eigen::Isometry3d& transform)
 {
-  const auto it = objects_.find(object_id);
-  if (it == objects_.end())
+  const auto it = objects_->find(object_id);
+  if (it == objects_->end())
     return false;
   if (transform.isApprox(Eigen::Isometry3d::Identity()))
     return true;  // object already at correct location
@@ -294,7 +305,8 @@ bool World::moveObject(const std::string& object_id, const Eigen::Isometry3d& tr
 bool World::setObjectPose(const std::string& object_id, const Eigen::Isometry3d& pose)
 {
   ASSERT_ISOMETRY(pose);  // unsanitized input, could contain a non-isometry
-  ObjectPtr& obj = objects_[object_id];
+  makeObjectsUnique();
+  ObjectPtr& obj = (*objects_)[object_id];
   int action;
   if (!obj)
   {
@@ -315,8 +327,9 @@ bool World::setObjectPose(const std::string& object_id, const Eigen::Isometry3d&
 
 bool World::removeShapeFromObject(const std::string& object_id, const shapes::ShapeConstPtr& shape)
 {
-  const auto it = objects_.find(object_id);
-  if (it != objects_.end())
+  makeObjectsUnique();
+  const auto it = objects_->find(object_id);
+  if (it != objects_->end())
   {
     const unsigned int n = it->second->shapes_.size();
     for (unsigned int i = 0; i < n; ++i)
@@ -331,7 +344,7 @@ bool World::removeShapeFromObject(const std::string& object_id, const shapes::Sh
         if (it->second->shapes_.empty())
         {
           notify(it->second, DESTROY);
-          objects_.erase(it);
+          objects_->erase(it);
         }
         else
         {
@@ -346,11 +359,12 @@ bool World::removeShapeFromObject(const std::string& object_id, const shapes::Sh
 
 bool World::removeObject(const std::string& object_id)
 {
-  const auto it = objects_.find(object_id);
-  if (it != objects_.end())
+  makeObjectsUnique();
+  const auto it = objects_->find(object_id);
+  if (it != objects_->end())
   {
     notify(it->second, DESTROY);
-    objects_.erase(it);
+    objects_->erase(it);
     return true;
   }
   return false;
@@ -359,13 +373,14 @@ bool World::removeObject(const std::string& object_id)
 void World::clearObjects()
 {
   notifyAll(DESTROY);
-  objects_.clear();
+  objects_ = std::make_shared<ObjectMap>();
 }
 
 bool World::setSubframesOfObject(const std::string& object_id, const moveit::core::FixedTransformsMap& subframe_poses)
 {
-  const auto obj_pair = objects_.find(object_id);
-  if (obj_pair == objects_.end())
+  makeObjectsUnique();
+  const auto obj_pair = objects_->find(object_id);
+  if (obj_pair == objects_->end())
   {
     return false;
   }
@@ -373,6 +388,7 @@ bool World::setSubframesOfObject(const std::string& object_id, const moveit::cor
   {
     ASSERT_ISOMETRY(t.second)  // unsanitized input, could contain a non-isometry
   }
+  ensureUnique(obj_pair->second);
   obj_pair->second->subframe_poses_ = subframe_poses;
   obj_pair->second->global_subframe_poses_ = subframe_poses;
   updateGlobalPosesInternal(obj_pair->second, false, true);
@@ -422,7 +438,7 @@ void World::removeObserver(ObserverHandle observer_handle)
 
 void World::notifyAll(Action action)
 {
-  for (std::map<std::string, ObjectPtr>::const_iterator it = objects_.begin(); it != objects_.end(); ++it)
+  for (ObjectMap::const_iterator it = objects_->begin(); it != objects_->end(); ++it)
     notify(it->second, action);
 }
 
@@ -439,7 +455,7 @@ void World::notifyObserverAllObjects(const ObserverHandle observer_handle, Actio
     if (observer == observer_handle.observer_)
     {
       // call the callback for each object
-      for (const auto& object : objects_)
+      for (const auto& object : *objects_)
         observer->callback_(object.second, action);
       break;
     }
@@ -458,6 +458,41 @@ TEST(World, ObjectPoseAndSubframes)
   EXPECT_EQ(1.0, pose(2, 3));  // z
 }
 
+TEST(World, CopyOnWrite)
+{
+  World world;
+  shapes::ShapePtr box = std::make_shared<shapes::Box>(1, 1, 1);
+  world.addToObject("box", box, Eigen::Isometry3d::Identity());
+  world.addToObject("other", box, Eigen::Isometry3d::Identity());
+
+  World copy(world);
+  EXPECT_EQ(world.getObject("box"), copy.getObject("box"));
+
+  // every mutator must leave the original untouched
+  copy.setObjectPose("box", Eigen::Isometry3d(Eigen::Translation3d(0, 0, 1)));
+  copy.moveShapesInObject("other", EigenSTL::vector_Isometry3d{ Eigen::Isometry3d(Eigen::Translation3d(1, 0, 0)) });
+  moveit::core::FixedTransformsMap subframes;
+  subframes["frame"] = Eigen::Isometry3d(Eigen::Translation3d(0, 1, 0));
+  copy.setSubframesOfObject("other", subframes);
+  copy.addToObject("new", box, Eigen::Isometry3d::Identity());
+
+  EXPECT_EQ(0.0, world.getObject("box")->pose_(2, 3));
+  EXPECT_EQ(1.0, copy.getObject("box")->pose_(2, 3));
+  EXPECT_EQ(0.0, world.getObject("other")->shape_poses_[0](0, 3));
+  EXPECT_EQ(1.0, copy.getObject("other")->shape_poses_[0](0, 3));
+  EXPECT_TRUE(world.getObject("other")->subframe_poses_.empty());
+  EXPECT_EQ(1u, copy.getObject("other")->subframe_poses_.size());
+  EXPECT_FALSE(world.hasObject("new"));
+  EXPECT_EQ(2u, world.size());
+  EXPECT_EQ(3u, copy.size());
+
+  // and the other way around
+  world.removeObject("box");
+  EXPECT_TRUE(copy.hasObject("box"));
+  world.clearObjects();
+  EXPECT_EQ(3u, copy.size());
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -264,6 +264,10 @@ struct FCLObject
 
   /** \brief Geometry data corresponding to \e collision_objects_. */
   std::vector<FCLGeometryConstPtr> collision_geometry_;
+
+  /** \brief For world objects, the object the geometry data points to. Collision objects can outlive it in the world
+   *  when they are shared with copies of the collision environment, so it is kept alive here. */
+  World::ObjectConstPtr world_object_;
 };
 
 /** \brief Bundles an \e FCLObject and a broadphase FCL collision manager. */
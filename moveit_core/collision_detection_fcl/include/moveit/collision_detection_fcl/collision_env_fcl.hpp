@@ -46,6 +46,8 @@
 #endif
 
 #include <memory>
+#include <set>
+#include <unordered_set>
 
 namespace collision_detection
 {
@@ -116,6 +118,12 @@ protected:
    *  If it does not exist in world, it is deleted. If it's not existing in \m fcl_objs_ yet, it's added there. */
   void updateFCLObject(const std::string& id);
 
+  /** \brief Collide \e obj with the world objects of this environment */
+  void collideWorld(fcl::CollisionObjectd* obj, CollisionData& cd) const;
+
+  /** \brief Compute the distance of \e obj to the world objects of this environment */
+  void distanceWorld(fcl::CollisionObjectd* obj, DistanceData& drd) const;
+
   /** \brief Out of the current robot state and its attached bodies construct an FCLObject which can then be used to
    *   check for collision.
    *
@@ -145,15 +153,45 @@ protected:
   /** \brief Vector of shared pointers to the FCL collision objects which make up the robot */
   std::vector<FCLCollisionObjectConstPtr> robot_fcl_objs_;
 
-  /// FCL collision manager which handles the collision checking process
+  /** \brief World objects registered in a broadphase manager.
+   *
+   *  Copies of an environment share these, so copying an environment does not rebuild the broadphase tree. An
+   *  environment only modifies them in place while it is their only owner; otherwise, changed objects are hidden here
+   *  and registered in \m manager_ instead. */
+  struct SharedWorldObjects
+  {
+    SharedWorldObjects();
+
+    std::unique_ptr<fcl::BroadPhaseCollisionManagerd> manager;
+    std::map<std::string, FCLObject> objects;
+  };
+  std::shared_ptr<SharedWorldObjects> shared_objs_;
+
+  /// FCL collision manager for the world objects that changed in this environment while \m shared_objs_ was shared
   std::unique_ptr<fcl::BroadPhaseCollisionManagerd> manager_;
 
+  /// The world objects registered in \m manager_
   std::map<std::string, FCLObject> fcl_objs_;
 
+  /// The objects in \m shared_objs_ that changed or were removed in this environment, and their collision objects
+  std::set<std::string> hidden_ids_;
+  std::unordered_set<const fcl::CollisionObjectd*> hidden_objs_;
+
 private:
   /** \brief Callback function executed for each change to the world environment */
   void notifyObjectChange(const ObjectConstPtr& obj, World::Action action);
 
+  /** \brief Get the broadphase manager and object map that a change to the world object \e id goes to */
+  std::pair<fcl::BroadPhaseCollisionManagerd*, std::map<std::string, FCLObject>*>
+  getWritableObjects(const std::string& id);
+
+  /** \brief Move the objects changed in this environment into \m shared_objs_, which this environment must own */
+  void mergeIntoSharedObjects();
+
+  /** \brief Replace \m shared_objs_ by a new set holding all world objects of this environment, once enough objects
+   *  changed that checking against both managers costs more than rebuilding */
+  void flattenIfNeeded();
+
   World::ObserverHandle observer_handle_;
 };
 }  // namespace collision_detection
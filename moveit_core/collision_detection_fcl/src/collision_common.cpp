@@ -791,6 +791,15 @@ FCLGeometryConstPtr createCollisionGeometry(const shapes::ShapeConstPtr& shape,
         //          object.", cache_it->second->collision_geometry_data_->getID().c_str());
         return cache_it->second;
       }
+      else if (shape->type == shapes::MESH)
+      {
+        // the mesh is shared with another object (e.g. interned by the planning scene); copying its BVH is much
+        // cheaper than building it again
+        const auto* model = static_cast<const fcl::BVHModel<BV>*>(cache_it->second->collision_geometry_.get());
+        auto cg_g = new fcl::BVHModel<BV>(*model);
+        cg_g->computeLocalAABB();
+        return std::make_shared<const FCLGeometry>(cg_g, data, shape_index);
+      }
     }
   }
 
@@ -1040,5 +1049,6 @@ void FCLObject::clear()
 {
   collision_objects_.clear();
   collision_geometry_.clear();
+  world_object_.reset();
 }
 }  // namespace collision_detection
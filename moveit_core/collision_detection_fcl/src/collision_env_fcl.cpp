@@ -47,6 +47,8 @@
 #include <fcl/broadphase/broadphase_dynamic_AABB_tree.h>
 #endif
 
+#include <algorithm>
+
 namespace collision_detection
 {
 const std::string CollisionDetectorAllocatorFCL::NAME("FCL");
@@ -79,8 +81,46 @@ void checkFCLCapabilities(const DistanceRequest& req)
   static_cast<void>(req);  // silent -Wunused-parameter
 #endif
 }
+
+// Passed to the callbacks below to skip the shared world objects that an environment replaced or removed
+template <typename Data>
+struct HiddenObjectsFilter
+{
+  Data* data;
+  const std::unordered_set<const fcl::CollisionObjectd*>* hidden;
+
+  bool isHidden(const fcl::CollisionObjectd* o1, const fcl::CollisionObjectd* o2) const
+  {
+    return hidden->find(o1) != hidden->end() || hidden->find(o2) != hidden->end();
+  }
+};
+
+bool filteredCollisionCallback(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, void* data)
+{
+  const auto* filter = static_cast<HiddenObjectsFilter<CollisionData>*>(data);
+  if (filter->isHidden(o1, o2))
+    return filter->data->done_;
+  return collisionCallback(o1, o2, filter->data);
+}
+
+bool filteredDistanceCallback(fcl::CollisionObjectd* o1, fcl::CollisionObjectd* o2, void* data, double& min_dist)
+{
+  const auto* filter = static_cast<HiddenObjectsFilter<DistanceData>*>(data);
+  if (filter->isHidden(o1, o2))
+    return filter->data->done;
+  return distanceCallback(o1, o2, filter->data, min_dist);
+}
+
+// Once this many objects changed relative to the shared world objects (at least a quarter of them), an environment
+// rebuilds its own set of shared objects rather than checking two managers and filtering
+constexpr std::size_t MIN_FLATTEN_CHANGES = 16;
 }  // namespace
 
+CollisionEnvFCL::SharedWorldObjects::SharedWorldObjects()
+  : manager(std::make_unique<fcl::DynamicAABBTreeCollisionManagerd>())
+{
+}
+
 CollisionEnvFCL::CollisionEnvFCL(const moveit::core::RobotModelConstPtr& model, double padding, double scale)
   : CollisionEnv(model, padding, scale)
 {
@@ -112,6 +152,7 @@ CollisionEnvFCL::CollisionEnvFCL(const moveit::core::RobotModelConstPtr& model,
     }
   }
 
+  shared_objs_ = std::make_shared<SharedWorldObjects>();
   manager_ = std::make_unique<fcl::DynamicAABBTreeCollisionManagerd>();
 
   // request notifications about changes to new world
@@ -150,6 +191,7 @@ CollisionEnvFCL::CollisionEnvFCL(const moveit::core::RobotModelConstPtr& model,
     }
   }
 
+  shared_objs_ = std::make_shared<SharedWorldObjects>();
   manager_ = std::make_unique<fcl::DynamicAABBTreeCollisionManagerd>();
 
   // request notifications about changes to new world
@@ -168,12 +210,16 @@ CollisionEnvFCL::CollisionEnvFCL(const CollisionEnvFCL& other, const WorldPtr& w
   robot_geoms_ = other.robot_geoms_;
   robot_fcl_objs_ = other.robot_fcl_objs_;
 
-  manager_ = std::make_unique<fcl::DynamicAABBTreeCollisionManagerd>();
+  // share the broadphase tree of the world objects and only register what changed in other on top of it, so copying
+  // costs O(changed objects) instead of rebuilding the tree
+  shared_objs_ = other.shared_objs_;
+  hidden_ids_ = other.hidden_ids_;
+  hidden_objs_ = other.hidden_objs_;
 
+  manager_ = std::make_unique<fcl::DynamicAABBTreeCollisionManagerd>();
   fcl_objs_ = other.fcl_objs_;
   for (auto& fcl_obj : fcl_objs_)
     fcl_obj.second.registerTo(manager_.get());
-  // manager_->update();
 
   // request notifications about changes to new world
   observer_handle_ = getWorld()->addObserver(
@@ -335,7 +381,7 @@ void CollisionEnvFCL::checkRobotCollisionHelper(const CollisionRequest& req, Col
   CollisionData cd(&req, &res, acm);
   cd.enableGroup(getRobotModel());
   for (std::size_t i = 0; !cd.done_ && i < fcl_obj.collision_objects_.size(); ++i)
-    manager_->collide(fcl_obj.collision_objects_[i].get(), &cd, &collisionCallback);
+    collideWorld(fcl_obj.collision_objects_[i].get(), cd);
 
   if (req.distance)
   {
@@ -376,16 +422,117 @@ void CollisionEnvFCL::distanceRobot(const DistanceRequest& req, DistanceResult&
 
   DistanceData drd(&req, &res);
   for (std::size_t i = 0; !drd.done && i < fcl_obj.collision_objects_.size(); ++i)
-    manager_->distance(fcl_obj.collision_objects_[i].get(), &drd, &distanceCallback);
+    distanceWorld(fcl_obj.collision_objects_[i].get(), drd);
+}
+
+void CollisionEnvFCL::collideWorld(fcl::CollisionObjectd* obj, CollisionData& cd) const
+{
+  if (hidden_objs_.empty())
+  {
+    shared_objs_->manager->collide(obj, &cd, &collisionCallback);
+  }
+  else
+  {
+    HiddenObjectsFilter<CollisionData> filter{ &cd, &hidden_objs_ };
+    shared_objs_->manager->collide(obj, &filter, &filteredCollisionCallback);
+  }
+  if (!cd.done_ && !fcl_objs_.empty())
+    manager_->collide(obj, &cd, &collisionCallback);
+}
+
+void CollisionEnvFCL::distanceWorld(fcl::CollisionObjectd* obj, DistanceData& drd) const
+{
+  if (hidden_objs_.empty())
+  {
+    shared_objs_->manager->distance(obj, &drd, &distanceCallback);
+  }
+  else
+  {
+    HiddenObjectsFilter<DistanceData> filter{ &drd, &hidden_objs_ };
+    shared_objs_->manager->distance(obj, &filter, &filteredDistanceCallback);
+  }
+  if (!drd.done && !fcl_objs_.empty())
+    manager_->distance(obj, &drd, &distanceCallback);
+}
+
+std::pair<fcl::BroadPhaseCollisionManagerd*, std::map<std::string, FCLObject>*>
+CollisionEnvFCL::getWritableObjects(const std::string& id)
+{
+  if (shared_objs_.use_count() == 1)
+  {
+    // no other environment sees the shared objects anymore
+    if (!fcl_objs_.empty() || !hidden_ids_.empty())
+      mergeIntoSharedObjects();
+    return { shared_objs_->manager.get(), &shared_objs_->objects };
+  }
+
+  const auto it = shared_objs_->objects.find(id);
+  if (it != shared_objs_->objects.end() && hidden_ids_.insert(id).second)
+  {
+    for (const FCLCollisionObjectPtr& collision_object : it->second.collision_objects_)
+      hidden_objs_.insert(collision_object.get());
+  }
+  return { manager_.get(), &fcl_objs_ };
+}
+
+void CollisionEnvFCL::mergeIntoSharedObjects()
+{
+  for (const std::string& id : hidden_ids_)
+  {
+    const auto it = shared_objs_->objects.find(id);
+    if (it != shared_objs_->objects.end())
+    {
+      it->second.unregisterFrom(shared_objs_->manager.get());
+      shared_objs_->objects.erase(it);
+    }
+  }
+  for (auto& [id, fcl_obj] : fcl_objs_)
+  {
+    fcl_obj.unregisterFrom(manager_.get());
+    fcl_obj.registerTo(shared_objs_->manager.get());
+    shared_objs_->objects[id] = std::move(fcl_obj);
+  }
+  fcl_objs_.clear();
+  hidden_ids_.clear();
+  hidden_objs_.clear();
+}
+
+void CollisionEnvFCL::flattenIfNeeded()
+{
+  const std::size_t changes = fcl_objs_.size() + hidden_ids_.size();
+  if (changes < std::max(MIN_FLATTEN_CHANGES, shared_objs_->objects.size() / 4))
+    return;
+
+  // the collision objects themselves are shared with the old set, as they are not modified once registered
+  auto flattened = std::make_shared<SharedWorldObjects>();
+  for (const auto& [id, fcl_obj] : shared_objs_->objects)
+  {
+    if (hidden_ids_.find(id) == hidden_ids_.end())
+      flattened->objects[id] = fcl_obj;
+  }
+  for (auto& [id, fcl_obj] : fcl_objs_)
+  {
+    fcl_obj.unregisterFrom(manager_.get());
+    flattened->objects[id] = std::move(fcl_obj);
+  }
+  for (auto& [id, fcl_obj] : flattened->objects)
+    fcl_obj.registerTo(flattened->manager.get());
+
+  shared_objs_ = std::move(flattened);
+  fcl_objs_.clear();
+  hidden_ids_.clear();
+  hidden_objs_.clear();
 }
 
 void CollisionEnvFCL::updateFCLObject(const std::string& id)
 {
+  auto [manager, fcl_objs] = getWritableObjects(id);
+
   // remove FCL objects that correspond to this object
-  auto jt = fcl_objs_.find(id);
-  if (jt != fcl_objs_.end())
+  auto jt = fcl_objs->find(id);
+  if (jt != fcl_objs->end())
   {
-    jt->second.unregisterFrom(manager_.get());
+    jt->second.unregisterFrom(manager);
     jt->second.clear();
   }
 
@@ -394,24 +541,27 @@ void CollisionEnvFCL::updateFCLObject(const std::string& id)
   if (it != getWorld()->end())
   {
     // construct FCL objects that correspond to this object
-    if (jt != fcl_objs_.end())
+    if (jt != fcl_objs->end())
     {
       constructFCLObjectWorld(it->second.get(), jt->second);
-      jt->second.registerTo(manager_.get());
+      jt->second.world_object_ = it->second;
+      jt->second.registerTo(manager);
     }
     else
     {
-      constructFCLObjectWorld(it->second.get(), fcl_objs_[id]);
-      fcl_objs_[id].registerTo(manager_.get());
+      FCLObject& fcl_obj = (*fcl_objs)[id];
+      constructFCLObjectWorld(it->second.get(), fcl_obj);
+      fcl_obj.world_object_ = it->second;
+      fcl_obj.registerTo(manager);
     }
   }
   else
   {
-    if (jt != fcl_objs_.end())
-      fcl_objs_.erase(jt);
+    if (jt != fcl_objs->end())
+      fcl_objs->erase(jt);
   }
 
-  // manager_->update();
+  flattenIfNeeded();
 }
 
 void CollisionEnvFCL::setWorld(const WorldPtr& world)
@@ -423,8 +573,11 @@ void CollisionEnvFCL::setWorld(const WorldPtr& world)
   getWorld()->removeObserver(observer_handle_);
 
   // clear out objects from old world
+  shared_objs_ = std::make_shared<SharedWorldObjects>();
   manager_->clear();
   fcl_objs_.clear();
+  hidden_ids_.clear();
+  hidden_objs_.clear();
   cleanCollisionGeometryCache();
 
   CollisionEnv::setWorld(world);
@@ -441,26 +594,42 @@ void CollisionEnvFCL::notifyObjectChange(const ObjectConstPtr& obj, World::Actio
 {
   if (action == World::DESTROY)
   {
-    auto it = fcl_objs_.find(obj->id_);
-    if (it != fcl_objs_.end())
+    auto [manager, fcl_objs] = getWritableObjects(obj->id_);
+    auto it = fcl_objs->find(obj->id_);
+    if (it != fcl_objs->end())
     {
-      it->second.unregisterFrom(manager_.get());
+      it->second.unregisterFrom(manager);
       it->second.clear();
-      fcl_objs_.erase(it);
+      fcl_objs->erase(it);
     }
+    flattenIfNeeded();
     cleanCollisionGeometryCache();
   }
   else if (action == World::MOVE_SHAPE)
   {
-    auto it = fcl_objs_.find(obj->id_);
-    if (it == fcl_objs_.end())
+    // look the object up before getWritableObjects() hides it
+    auto shared_it = shared_objs_->objects.find(obj->id_);
+    if (hidden_ids_.find(obj->id_) != hidden_ids_.end())
+      shared_it = shared_objs_->objects.end();
+    auto [manager, fcl_objs] = getWritableObjects(obj->id_);
+    auto it = fcl_objs->find(obj->id_);
+    bool registered = true;
+    if (it == fcl_objs->end())
     {
-      RCLCPP_ERROR(getLogger(), "Cannot move shapes of unknown FCL object: '%s'", obj->id_.c_str());
-      return;
+      if (shared_it == shared_objs_->objects.end())
+      {
+        RCLCPP_ERROR(getLogger(), "Cannot move shapes of unknown FCL object: '%s'", obj->id_.c_str());
+        return;
+      }
+      // the object is moved for the first time since the world objects were shared: move a copy of it over
+      it = fcl_objs->emplace(obj->id_, shared_it->second).first;
+      registered = false;
     }
 
     if (obj->global_shape_poses_.size() != it->second.collision_objects_.size())
     {
+      if (!registered)
+        it->second.registerTo(manager);
       RCLCPP_ERROR(getLogger(),
                    "Cannot move shapes, shape size mismatch between FCL object and world object: '%s'. Respectively "
                    "%zu and %zu.",
@@ -468,19 +637,28 @@ void CollisionEnvFCL::notifyObjectChange(const ObjectConstPtr& obj, World::Actio
       return;
     }
 
+    // update AABB in the FCL broadphase manager tree
+    // see https://github.com/moveit/moveit/pull/3601 for benchmarks
+    if (registered)
+      it->second.unregisterFrom(manager);
     for (std::size_t i = 0; i < it->second.collision_objects_.size(); ++i)
     {
-      it->second.collision_objects_[i]->setTransform(transform2fcl(obj->global_shape_poses_[i]));
+      FCLCollisionObjectPtr& collision_object = it->second.collision_objects_[i];
+      if (collision_object.use_count() > 1)
+      {
+        // registered in the managers of other environments as well: leave it alone and use a new collision object
+        collision_object = std::make_shared<fcl::CollisionObjectd>(
+            it->second.collision_geometry_[i]->collision_geometry_, transform2fcl(obj->global_shape_poses_[i]));
+        continue;
+      }
+      collision_object->setTransform(transform2fcl(obj->global_shape_poses_[i]));
 
       // compute AABB, order matters
       it->second.collision_geometry_[i]->collision_geometry_->computeLocalAABB();
-      it->second.collision_objects_[i]->computeAABB();
+      collision_object->computeAABB();
     }
-
-    // update AABB in the FCL broadphase manager tree
-    // see https://github.com/moveit/moveit/pull/3601 for benchmarks
-    it->second.unregisterFrom(manager_.get());
-    it->second.registerTo(manager_.get());
+    it->second.registerTo(manager);
+    flattenIfNeeded();
   }
   else
   {
@@ -195,6 +195,61 @@ TEST_F(CollisionDetectionEnvTest, RobotWorldCollision_2)
   res.clear();
 }
 
+/** \brief Copies of an environment share the broadphase tree of the world objects; changes must stay local. */
+TEST_F(CollisionDetectionEnvTest, CopiesAreIndependent)
+{
+  const auto in_collision = [this](const collision_detection::CollisionEnv& env) {
+    collision_detection::CollisionRequest req;
+    collision_detection::CollisionResult res;
+    env.checkRobotCollision(req, res, *robot_state_, *acm_);
+    return res.collision;
+  };
+
+  shapes::ShapeConstPtr box = std::make_shared<const shapes::Box>(.1, .1, .1);
+  Eigen::Isometry3d near = Eigen::Isometry3d::Identity();
+  near.translation().z() = 0.3;
+  Eigen::Isometry3d far = Eigen::Isometry3d::Identity();
+  far.translation().x() = 2.0;
+  c_env_->getWorld()->addToObject("near", box, near);
+  c_env_->getWorld()->addToObject("far", box, far);
+  ASSERT_TRUE(in_collision(*c_env_));
+
+  auto world_copy = std::make_shared<collision_detection::World>(*c_env_->getWorld());
+  collision_detection::CollisionEnvFCL copy(static_cast<const collision_detection::CollisionEnvFCL&>(*c_env_),
+                                            world_copy);
+  EXPECT_TRUE(in_collision(copy));
+
+  // moving an object in the copy leaves the original alone
+  world_copy->setObjectPose("near", far);
+  EXPECT_FALSE(in_collision(copy));
+  EXPECT_TRUE(in_collision(*c_env_));
+
+  // and changes to the original do not show up in the copy
+  c_env_->getWorld()->removeObject("near");
+  c_env_->getWorld()->moveShapesInObject("far", EigenSTL::vector_Isometry3d{ far.inverse() * near });
+  EXPECT_TRUE(in_collision(*c_env_));
+  EXPECT_FALSE(in_collision(copy));
+  EXPECT_EQ(world_copy->getObject("far")->global_shape_poses_[0].translation().x(), 2.0);
+
+  // a copy of the copy, with enough objects added to rebuild its own broadphase tree
+  auto world_copy2 = std::make_shared<collision_detection::World>(*world_copy);
+  collision_detection::CollisionEnvFCL copy2(copy, world_copy2);
+  for (int i = 0; i < 40; ++i)
+    world_copy2->addToObject("far" + std::to_string(i), box, far * Eigen::Translation3d(0.0, 0.2 * i, 0.0));
+  EXPECT_FALSE(in_collision(copy2));
+  world_copy2->setObjectPose("far", near);
+  EXPECT_TRUE(in_collision(copy2));
+  EXPECT_FALSE(in_collision(copy));
+  world_copy2->removeObject("far");
+  EXPECT_FALSE(in_collision(copy2));
+
+  collision_detection::DistanceRequest dreq;
+  dreq.acm = acm_.get();
+  collision_detection::DistanceResult dres;
+  copy.distanceRobot(dreq, dres, *robot_state_);
+  EXPECT_GT(dres.minimum_distance.distance, 0.5);
+}
+
 /** \brief Tests the padding through expanding the link geometry in such a way that a collision occurs. */
 TEST_F(CollisionDetectionEnvTest, PaddingTest)
 {
@@ -88,6 +88,19 @@ namespace online_signal_smoothing
 {
 MOVEIT_STRUCT_FORWARD(OSQPDataWrapper);
 
+/** \brief Statistics of the optimization problems solved by the AccelerationLimitedPlugin */
+struct SolverStatistics
+{
+  /** \brief Number of smoothing cycles that called the solver */
+  size_t solve_count = 0;
+  /** \brief Number of ADMM iterations of the last solve */
+  size_t last_iterations = 0;
+  /** \brief Wall time of the last solve, the slowest solve and all solves together in seconds */
+  double last_solve_time = 0.0;
+  double max_solve_time = 0.0;
+  double total_solve_time = 0.0;
+};
+
 // Plugin
 class AccelerationLimitedPlugin : public SmoothingBaseClass
 {
@@ -122,6 +135,15 @@ public:
   bool reset(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
              const Eigen::VectorXd& accelerations) override;
 
+  /**
+   * Get the statistics of the optimization problems solved since initialization.
+   * @return The solver statistics
+   */
+  const SolverStatistics& getSolverStatistics() const
+  {
+    return solver_statistics_;
+  }
+
   /**
    * memory allocated by osqp is freed in destructor
    */
@@ -150,13 +172,17 @@ private:
   /** \brief Extracted joint limits from robot model */
   Eigen::VectorXd max_acceleration_limits_;
   Eigen::VectorXd min_acceleration_limits_;
+  moveit::core::JointBoundsVector joint_bounds_;
   /** \brief Pointer to robot model */
   moveit::core::RobotModelConstPtr robot_model_;
-  /** \brief Constraint matrix for optimization problem */
-  Eigen::SparseMatrix<double> constraints_sparse_;
   /** \brief osqp types used for optimization problem */
   OSQPDataWrapperPtr osqp_data_;
   OSQPWorkspace* osqp_workspace_ = nullptr;
   OSQPSettings osqp_settings_;
+  /** \brief Zero primal and dual variables, used to drop the warm start after a failed solve */
+  Eigen::VectorXd zero_primal_;
+  Eigen::VectorXd zero_dual_;
+  /** \brief Statistics of the solved optimization problems */
+  SolverStatistics solver_statistics_;
 };
 }  // namespace online_signal_smoothing
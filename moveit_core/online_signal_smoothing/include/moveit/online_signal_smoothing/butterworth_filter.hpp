@@ -40,6 +40,8 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
+#include <vector>
 
 #include <moveit/robot_model/robot_model.hpp>
 #include <moveit/online_signal_smoothing/smoothing_base_class.hpp>
@@ -87,6 +89,74 @@ private:
   double feedback_term_;
 };
 
+/**
+ * Class ButterworthFilterBank - A Butterworth low-pass filter of any order for many channels at once, e.g. all joints
+ * of a robot. The filter state is stored per section as one vector over all channels, so that a whole measurement
+ * vector is filtered in one vectorized pass.
+ * An order N filter is the bilinear transform of the analog Butterworth filter of order N, implemented as N / 2
+ * second-order sections plus, for odd N, the first-order section of ButterworthFilter. All orders share the filter
+ * coefficient 1 / tan(pi * f_c / f_s), so the gain at the cutoff frequency f_c is -3 dB for every order, and the first
+ * order gives the same output as one ButterworthFilter per channel.
+ * Higher orders attenuate high frequencies more strongly, at the cost of more lag. Unlike the first order, they
+ * overshoot a step, by 4% for the second order and by 11% for the fourth.
+ */
+class ButterworthFilterBank
+{
+public:
+  /**
+   * Constructor.
+   * @param low_pass_filter_coeff The filter coefficient, see ButterworthFilter and coefficientFromCutoffFrequency().
+   * @param num_channels The number of signals filtered in parallel.
+   * @param order The order of the filter.
+   */
+  ButterworthFilterBank(double low_pass_filter_coeff, std::size_t num_channels, std::size_t order = 1);
+  ButterworthFilterBank() = delete;
+
+  /**
+   * Compute the filter coefficient for a cutoff frequency.
+   * @param normalized_cutoff_frequency The cutoff frequency divided by the sampling frequency, below 0.25.
+   * @return The filter coefficient, 1 / tan(pi * normalized_cutoff_frequency), for any order.
+   */
+  static double coefficientFromCutoffFrequency(double normalized_cutoff_frequency);
+
+  /**
+   * Filter the next measurement of all channels.
+   * @param measurements The new measurements, replaced by the filtered values. Must have num_channels elements.
+   */
+  void filter(Eigen::VectorXd& measurements);
+
+  /**
+   * Reset the filter to a steady state.
+   * @param data The value of each channel. Must have num_channels elements.
+   */
+  void reset(const Eigen::VectorXd& data);
+
+  std::size_t getNumChannels() const
+  {
+    return num_channels_;
+  }
+
+private:
+  // y[n] = scale_term * (x[n] + 2 x[n-1] + x[n-2]) - feedback_terms[0] * y[n-1] - feedback_terms[1] * y[n-2]
+  struct SecondOrderSection
+  {
+    double scale_term;
+    std::array<double, 2> feedback_terms;
+    // The last two inputs and outputs of all channels, index 0 is the most recent one
+    std::array<Eigen::VectorXd, 2> previous_measurements;
+    std::array<Eigen::VectorXd, 2> previous_filtered_measurements;
+  };
+
+  std::size_t num_channels_;
+  // The first-order section of odd orders, as in ButterworthFilter
+  bool has_first_order_section_;
+  Eigen::VectorXd previous_measurements_;
+  Eigen::VectorXd previous_filtered_measurements_;
+  double scale_term_;
+  double feedback_term_;
+  std::vector<SecondOrderSection> second_order_sections_;
+};
+
 // Plugin
 class ButterworthFilterPlugin : public SmoothingBaseClass
 {
@@ -122,7 +192,7 @@ public:
 
 private:
   rclcpp::Node::SharedPtr node_;
-  std::vector<ButterworthFilter> position_filters_;
+  std::optional<ButterworthFilterBank> position_filters_;
   size_t num_joints_;
 };
 }  // namespace online_signal_smoothing
@@ -39,6 +39,9 @@ Description: Applies jerk/acceleration/velocity limits to online motion commands
 #pragma once
 
 #include <cstddef>
+#include <string>
+#include <variant>
+#include <vector>
 
 #include <moveit/robot_model/robot_model.hpp>
 #include <moveit/online_signal_smoothing/smoothing_base_class.hpp>
@@ -49,6 +52,64 @@ Description: Applies jerk/acceleration/velocity limits to online motion commands
 namespace online_signal_smoothing
 {
 
+/**
+ * Class RuckigFilter - Ruckig's trajectory generator together with its input and output parameters, for a number of
+ * joints fixed at compile time or ruckig::DynamicDOFs. All Ruckig objects are created once and updated in place, so a
+ * smoothing cycle does not set up any Ruckig state. With a fixed number of joints, Ruckig's state is stored in
+ * std::arrays and its loops over the joints have constant bounds.
+ */
+template <size_t DOFs>
+class RuckigFilter
+{
+public:
+  /**
+   * Constructor.
+   * @param num_joints The number of joints. Must equal DOFs unless DOFs is ruckig::DynamicDOFs.
+   * @param update_period The time in seconds between calls to update().
+   * @param max_velocity The velocity limit of each joint.
+   * @param max_acceleration The acceleration limit of each joint.
+   * @param max_jerk The jerk limit of each joint.
+   */
+  RuckigFilter(size_t num_joints, double update_period, const std::vector<double>& max_velocity,
+               const std::vector<double>& max_acceleration, const std::vector<double>& max_jerk);
+
+  /**
+   * Compute the next jerk-limited state towards the commanded positions.
+   * The target is only rewritten when the commanded positions change. For an unchanged target, Ruckig continues along
+   * the trajectory it has already calculated instead of calculating a new one.
+   * @param positions The commanded joint positions, replaced by the smoothed positions.
+   * @param velocities Replaced by the smoothed joint velocities.
+   * @param accelerations Replaced by the smoothed joint accelerations.
+   * @return The Ruckig result. The state is only modified if Ruckig found a trajectory.
+   */
+  ruckig::Result update(Eigen::VectorXd& positions, Eigen::VectorXd& velocities, Eigen::VectorXd& accelerations);
+
+  /**
+   * Restart from a given joint state.
+   * @param positions The current joint positions.
+   * @param velocities The current joint velocities.
+   * @param accelerations The current joint accelerations.
+   */
+  void reset(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities, const Eigen::VectorXd& accelerations);
+
+  /**
+   * A utility to print Ruckig's internal state
+   */
+  std::string toString() const;
+
+private:
+  double update_period_;
+  ruckig::Ruckig<DOFs> ruckig_;
+  ruckig::InputParameter<DOFs> ruckig_input_;
+  ruckig::OutputParameter<DOFs> ruckig_output_;
+  bool have_initial_ruckig_output_ = false;
+};
+
+// Instantiated in ruckig_filter.cpp: the dynamic-size filter and fixed-size filters for common 6 and 7 joint arms
+extern template class RuckigFilter<ruckig::DynamicDOFs>;
+extern template class RuckigFilter<6>;
+extern template class RuckigFilter<7>;
+
 class RuckigFilterPlugin : public SmoothingBaseClass
 {
 public:
@@ -82,11 +143,6 @@ public:
              const Eigen::VectorXd& accelerations) override;
 
 private:
-  /**
-   * A utility to print Ruckig's internal state
-   */
-  void printRuckigState();
-
   /**
    * A utility to get velocity/acceleration/jerk bounds from the robot model
    * @return true if all bounds are defined
@@ -98,9 +154,7 @@ private:
   online_signal_smoothing::Params params_;
   /** \brief The robot model contains the vel/accel/jerk limits that Ruckig requires */
   moveit::core::RobotModelConstPtr robot_model_;
-  bool have_initial_ruckig_output_ = false;
-  std::optional<ruckig::Ruckig<ruckig::DynamicDOFs>> ruckig_;
-  std::optional<ruckig::InputParameter<ruckig::DynamicDOFs>> ruckig_input_;
-  std::optional<ruckig::OutputParameter<ruckig::DynamicDOFs>> ruckig_output_;
+  /** \brief Empty until initialized, then the filter for the number of joints */
+  std::variant<std::monostate, RuckigFilter<ruckig::DynamicDOFs>, RuckigFilter<6>, RuckigFilter<7>> filter_;
 };
 }  // namespace online_signal_smoothing
@@ -35,6 +35,9 @@
 #include <moveit/online_signal_smoothing/acceleration_filter.hpp>
 #include <rclcpp/logging.hpp>
 
+#include <chrono>
+#include <cmath>
+
 // Disable -Wold-style-cast because all _THROTTLE macros trigger this
 #pragma GCC diagnostic ignored "-Wold-style-cast"
 
@@ -51,6 +54,8 @@ constexpr double COMMAND_DIFFERENCE_THRESHOLD = 1E-4;
 constexpr double ALPHA_UPPER_BOUND = 1.0;
 // The scaling parameter alpha must also be greater than 0.0
 constexpr double ALPHA_LOWER_BOUND = 0.0;
+// Position offsets below this magnitude do not constrain alpha (rad)
+constexpr double POSITION_OFFSET_EPSILON = 1E-12;
 
 /** \brief Wrapper struct to make memory management easier for using osqp's C sparse_matrix types */
 struct CSCWrapper
@@ -121,14 +126,6 @@ struct OSQPDataWrapper
     data.u = u.data();
   }
 
-  /// Update the constraint matrix A without reallocating memory
-  void updateA(OSQPWorkspace* work, Eigen::SparseMatrix<double>& constraints_sparse)
-  {
-    constraints_sparse.makeCompressed();
-    A.update(constraints_sparse);
-    osqp_update_A(work, A.elements.data(), OSQP_NULL, A.elements.size());
-  }
-
   CSCWrapper P;
   CSCWrapper A;
   Eigen::VectorXd q;
@@ -145,6 +142,9 @@ bool AccelerationLimitedPlugin::initialize(rclcpp::Node::SharedPtr node, moveit:
   num_joints_ = num_joints;
   robot_model_ = robot_model;
   cur_acceleration_ = Eigen::VectorXd::Zero(num_joints);
+  positions_offset_ = Eigen::VectorXd::Zero(num_joints);
+  velocities_offset_ = Eigen::VectorXd::Zero(num_joints);
+  solver_statistics_ = SolverStatistics();
 
   // get node parameters and store in member variables
   auto param_listener = online_signal_smoothing::ParamListener(node_);
@@ -152,11 +152,11 @@ bool AccelerationLimitedPlugin::initialize(rclcpp::Node::SharedPtr node, moveit:
 
   // get robot acceleration limits and store in member variables
   auto joint_model_group = robot_model_->getJointModelGroup(params_.planning_group_name);
-  auto joint_bounds = joint_model_group->getActiveJointModelsBounds();
+  joint_bounds_ = joint_model_group->getActiveJointModelsBounds();
   min_acceleration_limits_ = Eigen::VectorXd::Zero(num_joints);
   max_acceleration_limits_ = Eigen::VectorXd::Zero(num_joints);
   size_t ind = 0;
-  for (const auto& joint_bound : joint_bounds)
+  for (const auto& joint_bound : joint_bounds_)
   {
     for (const auto& variable_bound : *joint_bound)
     {
@@ -176,20 +176,31 @@ bool AccelerationLimitedPlugin::initialize(rclcpp::Node::SharedPtr node, moveit:
   }
 
   // setup osqp optimization problem
+  // The constraint rows are normalized by the position offsets in doSmoothing, which keeps the constraint matrix and
+  // with it the factorization of the problem constant. Each cycle only updates the bounds and warm starts the solver
+  // from the previous solution.
   Eigen::SparseMatrix<double> objective_sparse(1, 1);
   objective_sparse.insert(0, 0) = 1.0;
   size_t num_constraints = num_joints + 1;
-  constraints_sparse_ = Eigen::SparseMatrix<double>(num_constraints, 1);
-  for (size_t i = 0; i < num_constraints - 1; ++i)
+  Eigen::SparseMatrix<double> constraints_sparse(num_constraints, 1);
+  for (size_t i = 0; i < num_constraints; ++i)
   {
-    constraints_sparse_.insert(i, 0) = 0;
+    constraints_sparse.insert(i, 0) = 1.0;
   }
-  constraints_sparse_.insert(num_constraints - 1, 0) = 0;
   osqp_set_default_settings(&osqp_settings_);
-  osqp_settings_.warm_start = 0;
+  osqp_settings_.warm_start = 1;
   osqp_settings_.verbose = 0;
-  osqp_data_ = std::make_shared<OSQPDataWrapper>(objective_sparse, constraints_sparse_);
+  osqp_data_ = std::make_shared<OSQPDataWrapper>(objective_sparse, constraints_sparse);
   osqp_data_->q[0] = 0;
+  zero_primal_ = Eigen::VectorXd::Zero(1);
+  zero_dual_ = Eigen::VectorXd::Zero(num_constraints);
+
+  // initialize may be called again, e.g. after the limits changed
+  if (osqp_workspace_ != nullptr)
+  {
+    osqp_cleanup(osqp_workspace_);
+    osqp_workspace_ = nullptr;
+  }
 
   if (osqp_setup(&osqp_workspace_, &osqp_data_->data, &osqp_settings_) != 0)
   {
@@ -230,19 +241,6 @@ double jointLimitAccelerationScalingFactor(const Eigen::VectorXd& accelerations,
   return min_scaling_factor;
 }
 
-inline bool updateData(const OSQPDataWrapperPtr& data, OSQPWorkspace* work,
-                       Eigen::SparseMatrix<double>& constraints_sparse, const Eigen::VectorXd& lower_bound,
-                       const Eigen::VectorXd& upper_bound)
-{
-  data->updateA(work, constraints_sparse);
-  size_t num_constraints = constraints_sparse.rows();
-  data->u.block(0, 0, num_constraints - 1, 1) = upper_bound;
-  data->l.block(0, 0, num_constraints - 1, 1) = lower_bound;
-  data->u[num_constraints - 1] = ALPHA_UPPER_BOUND;
-  data->l[num_constraints - 1] = ALPHA_LOWER_BOUND;
-  return 0 == osqp_update_bounds(work, data->l.data(), data->u.data());
-}
-
 bool AccelerationLimitedPlugin::doSmoothing(Eigen::VectorXd& positions, Eigen::VectorXd& velocities,
                                             Eigen::VectorXd& /* unused */)
 {
@@ -281,46 +279,89 @@ bool AccelerationLimitedPlugin::doSmoothing(Eigen::VectorXd& positions, Eigen::V
   // opt ||alpha||
   // s.t. constraints
   // p_n = p_t*alpha + p_c*(1-alpha)
+  // each joint constraint is divided by (p_c-p_t), so that the constraint matrix is constant
+  // joints with p_c = p_t do not constrain alpha, but make the problem infeasible if 0 is outside of their bounds
 
-  double& update_period = params_.update_period;
-  size_t num_constraints = num_joints_ + 1;
+  const double update_period = params_.update_period;
+  const double update_period_squared = update_period * update_period;
   positions_offset_ = last_positions_ - positions;
   velocities_offset_ = last_velocities_ - velocities;
-  for (size_t i = 0; i < num_constraints - 1; ++i)
+  bool feasible = true;
+  for (size_t i = 0; i < num_joints_; ++i)
   {
-    constraints_sparse_.coeffRef(i, 0) = positions_offset_[i];
-  }
-  constraints_sparse_.coeffRef(num_constraints - 1, 0) = 1;
-  Eigen::VectorXd vel_point = last_positions_ + last_velocities_ * update_period;
-  Eigen::VectorXd upper_bound = vel_point - positions + max_acceleration_limits_ * (update_period * update_period);
-  Eigen::VectorXd lower_bound = vel_point - positions + min_acceleration_limits_ * (update_period * update_period);
-  if (!updateData(osqp_data_, osqp_workspace_, constraints_sparse_, lower_bound, upper_bound))
-  {
-    RCLCPP_ERROR_THROTTLE(getLogger(), *node_->get_clock(), 1000,
-                          "failed to set osqp_update_bounds. Make sure the robot's acceleration limits are valid");
-    return false;
+    const double vel_point_offset = last_positions_[i] + last_velocities_[i] * update_period - positions[i];
+    const double upper_bound = vel_point_offset + max_acceleration_limits_[i] * update_period_squared;
+    const double lower_bound = vel_point_offset + min_acceleration_limits_[i] * update_period_squared;
+    if (!(lower_bound <= upper_bound))
+    {
+      RCLCPP_ERROR_THROTTLE(getLogger(), *node_->get_clock(), 1000,
+                            "Invalid acceleration bounds. Make sure the robot's acceleration limits are valid");
+      return false;
+    }
+
+    const double offset = positions_offset_[i];
+    if (std::abs(offset) < POSITION_OFFSET_EPSILON)
+    {
+      feasible = feasible && lower_bound <= osqp_settings_.eps_abs && upper_bound >= -osqp_settings_.eps_abs;
+      osqp_data_->l[i] = -OSQP_INFTY;
+      osqp_data_->u[i] = OSQP_INFTY;
+    }
+    else
+    {
+      osqp_data_->l[i] = (offset > 0.0 ? lower_bound : upper_bound) / offset;
+      osqp_data_->u[i] = (offset > 0.0 ? upper_bound : lower_bound) / offset;
+    }
   }
+  osqp_data_->l[num_joints_] = ALPHA_LOWER_BOUND;
+  osqp_data_->u[num_joints_] = ALPHA_UPPER_BOUND;
 
+  bool solved = false;
   if (positions_offset_.norm() < COMMAND_DIFFERENCE_THRESHOLD &&
       velocities_offset_.norm() < COMMAND_DIFFERENCE_THRESHOLD)
   {
     positions = last_positions_;
     velocities = last_velocities_;
+    solved = true;
   }
-  else if (osqp_solve(osqp_workspace_) == 0 &&
-           osqp_workspace_->solution->x[0] >= ALPHA_LOWER_BOUND - osqp_settings_.eps_abs &&
-           osqp_workspace_->solution->x[0] <= ALPHA_UPPER_BOUND + osqp_settings_.eps_abs)
+  else if (feasible)
   {
-    double alpha = osqp_workspace_->solution->x[0];
-    positions = alpha * last_positions_ + (1.0 - alpha) * positions.eval();
-    velocities = (positions - last_positions_) / update_period;
+    if (osqp_update_bounds(osqp_workspace_, osqp_data_->l.data(), osqp_data_->u.data()) != 0)
+    {
+      RCLCPP_ERROR_THROTTLE(getLogger(), *node_->get_clock(), 1000,
+                            "failed to set osqp_update_bounds. Make sure the robot's acceleration limits are valid");
+      return false;
+    }
+
+    const auto solve_start = std::chrono::steady_clock::now();
+    const bool solve_succeeded = osqp_solve(osqp_workspace_) == 0 &&
+                                 (osqp_workspace_->info->status_val == OSQP_SOLVED ||
+                                  osqp_workspace_->info->status_val == OSQP_SOLVED_INACCURATE);
+    const double solve_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - solve_start).count();
+    solver_statistics_.solve_count++;
+    solver_statistics_.last_iterations = osqp_workspace_->info->iter;
+    solver_statistics_.last_solve_time = solve_time;
+    solver_statistics_.max_solve_time = std::max(solver_statistics_.max_solve_time, solve_time);
+    solver_statistics_.total_solve_time += solve_time;
+
+    const double alpha = osqp_workspace_->solution->x[0];
+    if (solve_succeeded && alpha >= ALPHA_LOWER_BOUND - osqp_settings_.eps_abs &&
+        alpha <= ALPHA_UPPER_BOUND + osqp_settings_.eps_abs)
+    {
+      positions = alpha * last_positions_ + (1.0 - alpha) * positions;
+      velocities = (positions - last_positions_) / update_period;
+      solved = true;
+    }
+    else
+    {
+      // do not warm start the next cycle from an infeasibility certificate
+      osqp_warm_start(osqp_workspace_, zero_primal_.data(), zero_dual_.data());
+    }
   }
-  else
+
+  if (!solved)
   {
-    auto joint_model_group = robot_model_->getJointModelGroup(params_.planning_group_name);
-    auto joint_bounds = joint_model_group->getActiveJointModelsBounds();
     cur_acceleration_ = -(last_velocities_) / update_period;
-    cur_acceleration_ *= jointLimitAccelerationScalingFactor(cur_acceleration_, joint_bounds);
+    cur_acceleration_ *= jointLimitAccelerationScalingFactor(cur_acceleration_, joint_bounds_);
     velocities = last_velocities_ + cur_acceleration_ * update_period;
     positions = last_positions_ + velocities * update_period;
   }
@@ -40,6 +40,8 @@
 #include <rclcpp/clock.hpp>
 #include <rclcpp/logging.hpp>
 
+#include <cmath>
+
 // Disable -Wold-style-cast because all _THROTTLE macros trigger this
 #pragma GCC diagnostic ignored "-Wold-style-cast"
 
@@ -48,7 +50,27 @@ namespace online_signal_smoothing
 namespace
 {
 constexpr double EPSILON = 1e-9;
+
+void checkFilterTerms(const std::string& filter_name, double low_pass_filter_coeff, double scale_term,
+                      double feedback_term)
+{
+  if (std::isinf(feedback_term))
+    throw std::length_error(filter_name + ": infinite feedback_term_");
+
+  if (std::isinf(scale_term))
+    throw std::length_error(filter_name + ": infinite scale_term_");
+
+  if (low_pass_filter_coeff < 1)
+  {
+    throw std::length_error(filter_name + ": Filter coefficient < 1. makes the lowpass filter unstable");
+  }
+
+  if (std::abs(feedback_term) < EPSILON)
+  {
+    throw std::length_error(filter_name + ": Filter coefficient value resulted in feedback term of 0");
+  }
 }
+}  // namespace
 
 ButterworthFilter::ButterworthFilter(double low_pass_filter_coeff)
   : previous_measurements_{ 0., 0. }
@@ -60,23 +82,7 @@ ButterworthFilter::ButterworthFilter(double low_pass_filter_coeff)
   static_assert(ButterworthFilter::FILTER_LENGTH == 2,
                 "online_signal_smoothing::ButterworthFilter::FILTER_LENGTH should be 2");
 
-  if (std::isinf(feedback_term_))
-    throw std::length_error("online_signal_smoothing::ButterworthFilter: infinite feedback_term_");
-
-  if (std::isinf(scale_term_))
-    throw std::length_error("online_signal_smoothing::ButterworthFilter: infinite scale_term_");
-
-  if (low_pass_filter_coeff < 1)
-  {
-    throw std::length_error(
-        "online_signal_smoothing::ButterworthFilter: Filter coefficient < 1. makes the lowpass filter unstable");
-  }
-
-  if (std::abs(feedback_term_) < EPSILON)
-  {
-    throw std::length_error(
-        "online_signal_smoothing::ButterworthFilter: Filter coefficient value resulted in feedback term of 0");
-  }
+  checkFilterTerms("online_signal_smoothing::ButterworthFilter", low_pass_filter_coeff, scale_term_, feedback_term_);
 }
 
 double ButterworthFilter::filter(double new_measurement)
@@ -98,6 +104,82 @@ void ButterworthFilter::reset(const double data)
   previous_filtered_measurement_ = data;
 }
 
+ButterworthFilterBank::ButterworthFilterBank(double low_pass_filter_coeff, std::size_t num_channels,
+                                             std::size_t order)
+  : num_channels_(num_channels)
+  , has_first_order_section_(order % 2 == 1)
+  , previous_measurements_(Eigen::VectorXd::Zero(has_first_order_section_ ? num_channels : 0))
+  , previous_filtered_measurements_(Eigen::VectorXd::Zero(has_first_order_section_ ? num_channels : 0))
+  , scale_term_(1. / (1. + low_pass_filter_coeff))
+  , feedback_term_(1. - low_pass_filter_coeff)
+{
+  if (order < 1)
+    throw std::length_error("online_signal_smoothing::ButterworthFilterBank: Filter order must be at least 1");
+
+  checkFilterTerms("online_signal_smoothing::ButterworthFilterBank", low_pass_filter_coeff, scale_term_,
+                   feedback_term_);
+
+  // The analog Butterworth filter of order N has the second-order factors s^2 + 2 sin((2k - 1) pi / 2N) s + 1 for
+  // k = 1 .. N / 2. The bilinear transform s = coeff * (1 - z^-1) / (1 + z^-1) maps each to a section with the
+  // numerator (1 + z^-1)^2 and the denominator a0 + a1 z^-1 + a2 z^-2 below.
+  const double coeff = low_pass_filter_coeff;
+  for (std::size_t k = 1; k <= order / 2; ++k)
+  {
+    const double damping_term = 2. * std::sin((2. * k - 1.) * M_PI / (2. * order)) * coeff;
+    const double a0 = coeff * coeff + damping_term + 1.;
+    SecondOrderSection& section = second_order_sections_.emplace_back();
+    section.scale_term = 1. / a0;
+    section.feedback_terms = { 2. * (1. - coeff * coeff) / a0, (coeff * coeff - damping_term + 1.) / a0 };
+    section.previous_measurements.fill(Eigen::VectorXd::Zero(num_channels));
+    section.previous_filtered_measurements.fill(Eigen::VectorXd::Zero(num_channels));
+  }
+}
+
+double ButterworthFilterBank::coefficientFromCutoffFrequency(double normalized_cutoff_frequency)
+{
+  // The bilinear transform maps the analog cutoff frequency to this coefficient
+  return 1. / std::tan(M_PI * normalized_cutoff_frequency);
+}
+
+void ButterworthFilterBank::filter(Eigen::VectorXd& measurements)
+{
+  // Each section filters the output of the previous one. The first-order section has the same arithmetic as
+  // ButterworthFilter::filter
+  if (has_first_order_section_)
+  {
+    previous_filtered_measurements_ =
+        scale_term_ * (previous_measurements_ + measurements - feedback_term_ * previous_filtered_measurements_);
+    previous_measurements_ = measurements;
+    measurements = previous_filtered_measurements_;
+  }
+  for (SecondOrderSection& section : second_order_sections_)
+  {
+    auto& x = section.previous_measurements;
+    auto& y = section.previous_filtered_measurements;
+    // Overwrite the oldest output with the new one, then rotate the history without copying
+    y[1] = section.scale_term * (measurements + 2. * x[0] + x[1]) - section.feedback_terms[0] * y[0] -
+           section.feedback_terms[1] * y[1];
+    y[0].swap(y[1]);
+    x[0].swap(x[1]);
+    x[0] = measurements;
+    measurements = y[0];
+  }
+}
+
+void ButterworthFilterBank::reset(const Eigen::VectorXd& data)
+{
+  if (has_first_order_section_)
+  {
+    previous_measurements_ = data;
+    previous_filtered_measurements_ = data;
+  }
+  for (SecondOrderSection& section : second_order_sections_)
+  {
+    section.previous_measurements.fill(data);
+    section.previous_filtered_measurements.fill(data);
+  }
+}
+
 bool ButterworthFilterPlugin::initialize(rclcpp::Node::SharedPtr node, moveit::core::RobotModelConstPtr /* unused */,
                                          size_t num_joints)
 {
@@ -105,12 +187,13 @@ bool ButterworthFilterPlugin::initialize(rclcpp::Node::SharedPtr node, moveit::c
   num_joints_ = num_joints;
 
   online_signal_smoothing::ParamListener param_listener(node_);
-  double filter_coeff = param_listener.get_params().butterworth_filter_coeff;
+  const auto params = param_listener.get_params();
+  const double filter_coeff =
+      params.butterworth_normalized_cutoff_frequency > 0.0 ?
+          ButterworthFilterBank::coefficientFromCutoffFrequency(params.butterworth_normalized_cutoff_frequency) :
+          params.butterworth_filter_coeff;
 
-  for (std::size_t i = 0; i < num_joints_; ++i)
-  {
-    position_filters_.emplace_back(filter_coeff);
-  }
+  position_filters_.emplace(filter_coeff, num_joints_, params.butterworth_filter_order);
   return true;
 };
 
@@ -118,17 +201,14 @@ bool ButterworthFilterPlugin::doSmoothing(Eigen::VectorXd& positions, Eigen::Vec
                                           Eigen::VectorXd& /* unused */)
 {
   const size_t num_positions = positions.size();
-  if (num_positions != position_filters_.size())
+  if (!position_filters_ || num_positions != position_filters_->getNumChannels())
   {
     RCLCPP_ERROR_THROTTLE(node_->get_logger(), *node_->get_clock(), 1000,
                           "Position vector to be smoothed does not have the right length.");
     return false;
   }
-  for (size_t i = 0; i < num_positions; ++i)
-  {
-    // Lowpass filter the position command
-    positions[i] = position_filters_.at(i).filter(positions[i]);
-  }
+  // Lowpass filter the position commands
+  position_filters_->filter(positions);
   return true;
 };
 
@@ -136,16 +216,13 @@ bool ButterworthFilterPlugin::reset(const Eigen::VectorXd& positions, const Eige
                                     const Eigen::VectorXd& /* unused */)
 {
   const size_t num_positions = positions.size();
-  if (num_positions != position_filters_.size())
+  if (!position_filters_ || num_positions != position_filters_->getNumChannels())
   {
     RCLCPP_ERROR_THROTTLE(node_->get_logger(), *node_->get_clock(), 1000,
                           "Position vector to be reset does not have the right length.");
     return false;
   }
-  for (size_t joint_idx = 0; joint_idx < num_positions; ++joint_idx)
-  {
-    position_filters_.at(joint_idx).reset(positions[joint_idx]);
-  }
+  position_filters_->reset(positions);
   return true;
 };
 
@@ -32,6 +32,9 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  *********************************************************************/
 
+#include <algorithm>
+#include <sstream>
+
 #include <moveit/online_signal_smoothing/ruckig_filter.hpp>
 #include <rclcpp/clock.hpp>
 #include <rclcpp/logging.hpp>
@@ -47,106 +50,223 @@ rclcpp::Logger getLogger()
 {
   return moveit::getLogger("moveit.core.ruckig_filter_plugin");
 }
-}  // namespace
 
-bool RuckigFilterPlugin::initialize(rclcpp::Node::SharedPtr node, moveit::core::RobotModelConstPtr robot_model,
-                                    size_t num_joints)
+template <size_t DOFs>
+ruckig::Ruckig<DOFs> makeRuckig(size_t num_joints, double update_period)
 {
-  robot_model_ = robot_model;
-
-  // get node parameters and store in member variables
-  auto param_listener = online_signal_smoothing::ParamListener(node);
-  params_ = param_listener.get_params();
+  if constexpr (DOFs == ruckig::DynamicDOFs)
+  {
+    return ruckig::Ruckig<DOFs>(num_joints, update_period);
+  }
+  else
+  {
+    return ruckig::Ruckig<DOFs>(update_period);
+  }
+}
 
-  // Ruckig needs the joint vel/accel bounds
-  // TODO: Ruckig says the jerk bounds can be optional. We require them, for now.
-  ruckig::InputParameter<ruckig::DynamicDOFs> ruckig_input(num_joints);
-  if (!getVelAccelJerkBounds(ruckig_input.max_velocity, ruckig_input.max_acceleration, ruckig_input.max_jerk))
+template <typename Parameter, size_t DOFs>
+Parameter makeRuckigParameter(size_t num_joints)
+{
+  if constexpr (DOFs == ruckig::DynamicDOFs)
   {
-    return false;
+    return Parameter(num_joints);
   }
-  ruckig_input.current_position = std::vector<double>(num_joints, 0.0);
-  ruckig_input.current_velocity = std::vector<double>(num_joints, 0.0);
-  ruckig_input.current_acceleration = std::vector<double>(num_joints, 0.0);
-  ruckig_input.synchronization = ruckig::Synchronization::Phase;
+  else
+  {
+    return Parameter();
+  }
+}
 
-  ruckig_input_ = ruckig_input;
+// Ruckig's vectors are either std::vector or std::array, both are assigned element-wise
+template <typename RuckigVector>
+void assign(const Eigen::VectorXd& values, RuckigVector& ruckig_vector)
+{
+  std::copy_n(values.data(), ruckig_vector.size(), ruckig_vector.begin());
+}
 
-  ruckig_output_.emplace(ruckig::OutputParameter<ruckig::DynamicDOFs>(num_joints));
+bool smooth(std::monostate& /* filter */, Eigen::VectorXd& /* positions */, Eigen::VectorXd& /* velocities */,
+            Eigen::VectorXd& /* accelerations */)
+{
+  RCLCPP_ERROR_STREAM(getLogger(), "The Ruckig smoother was not initialized");
+  return false;
+}
 
-  ruckig_.emplace(ruckig::Ruckig<ruckig::DynamicDOFs>(num_joints, params_.update_period));
+template <size_t DOFs>
+bool smooth(RuckigFilter<DOFs>& filter, Eigen::VectorXd& positions, Eigen::VectorXd& velocities,
+            Eigen::VectorXd& accelerations)
+{
+  const ruckig::Result ruckig_result = filter.update(positions, velocities, accelerations);
 
+  // Finished means the target state can be reached in this timestep.
+  // Working means the target state can be reached but not in this timestep.
+  // ErrorSynchronizationCalculation means smoothing was successful but the robot will deviate a bit from the desired
+  // path.
+  // See https://github.com/pantor/ruckig/blob/master/include/ruckig/input_parameter.hpp
+  if (ruckig_result != ruckig::Result::Finished && ruckig_result != ruckig::Result::Working &&
+      ruckig_result != ruckig::Result::ErrorSynchronizationCalculation)
+  {
+    RCLCPP_ERROR_STREAM(getLogger(), "Ruckig jerk-limited smoothing failed with code: " << ruckig_result);
+    RCLCPP_INFO_STREAM(getLogger(), filter.toString());
+  }
+  // Ruckig errors leave the position/vel/accel unmodified, which is not a failure of the smoothing
   return true;
 }
 
-bool RuckigFilterPlugin::doSmoothing(Eigen::VectorXd& positions, Eigen::VectorXd& velocities,
-                                     Eigen::VectorXd& accelerations)
+bool resetFilter(std::monostate& /* filter */, const Eigen::VectorXd& /* positions */,
+                 const Eigen::VectorXd& /* velocities */, const Eigen::VectorXd& /* accelerations */)
 {
-  if (!ruckig_input_ || !ruckig_output_ || !ruckig_)
-  {
-    RCLCPP_ERROR_STREAM(getLogger(), "The Ruckig smoother was not initialized");
-    return false;
-  }
+  RCLCPP_ERROR_STREAM(getLogger(), "The Ruckig smoother was not initialized");
+  return false;
+}
+
+template <size_t DOFs>
+bool resetFilter(RuckigFilter<DOFs>& filter, const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
+                 const Eigen::VectorXd& accelerations)
+{
+  filter.reset(positions, velocities, accelerations);
+  return true;
+}
+}  // namespace
 
+template <size_t DOFs>
+RuckigFilter<DOFs>::RuckigFilter(size_t num_joints, double update_period, const std::vector<double>& max_velocity,
+                                 const std::vector<double>& max_acceleration, const std::vector<double>& max_jerk)
+  : update_period_(update_period)
+  , ruckig_(makeRuckig<DOFs>(num_joints, update_period))
+  , ruckig_input_(makeRuckigParameter<ruckig::InputParameter<DOFs>, DOFs>(num_joints))
+  , ruckig_output_(makeRuckigParameter<ruckig::OutputParameter<DOFs>, DOFs>(num_joints))
+{
+  std::copy_n(max_velocity.begin(), num_joints, ruckig_input_.max_velocity.begin());
+  std::copy_n(max_acceleration.begin(), num_joints, ruckig_input_.max_acceleration.begin());
+  std::copy_n(max_jerk.begin(), num_joints, ruckig_input_.max_jerk.begin());
+  std::fill(ruckig_input_.current_position.begin(), ruckig_input_.current_position.end(), 0.0);
+  std::fill(ruckig_input_.current_velocity.begin(), ruckig_input_.current_velocity.end(), 0.0);
+  std::fill(ruckig_input_.current_acceleration.begin(), ruckig_input_.current_acceleration.end(), 0.0);
+  std::fill(ruckig_input_.target_position.begin(), ruckig_input_.target_position.end(), 0.0);
+  std::fill(ruckig_input_.target_velocity.begin(), ruckig_input_.target_velocity.end(), 0.0);
+  // target_acceleration remains a vector of zeroes
+  std::fill(ruckig_input_.target_acceleration.begin(), ruckig_input_.target_acceleration.end(), 0.0);
+  ruckig_input_.synchronization = ruckig::Synchronization::Phase;
+}
+
+template <size_t DOFs>
+ruckig::Result RuckigFilter<DOFs>::update(Eigen::VectorXd& positions, Eigen::VectorXd& velocities,
+                                          Eigen::VectorXd& accelerations)
+{
   if (have_initial_ruckig_output_)
   {
-    ruckig_output_->pass_to_input(*ruckig_input_);
+    ruckig_output_.pass_to_input(ruckig_input_);
   }
 
-  // Update Ruckig target state
-  ruckig_input_->target_position = std::vector<double>(positions.data(), positions.data() + positions.size());
-  // We don't know what the next command will be. Assume velocity continues forward based on current state,
-  // target_acceleration is zero.
-  const size_t num_joints = ruckig_input_->current_acceleration.size();
-  for (size_t i = 0; i < num_joints; ++i)
+  // Only a new command updates the Ruckig target state. Otherwise the input stays equal to the one Ruckig last
+  // calculated a trajectory for, and Ruckig samples that trajectory instead of calculating it again.
+  const size_t num_joints = ruckig_input_.current_position.size();
+  const bool target_changed =
+      !have_initial_ruckig_output_ ||
+      !std::equal(ruckig_input_.target_position.begin(), ruckig_input_.target_position.end(), positions.data());
+  if (target_changed)
   {
-    ruckig_input_->target_velocity.at(i) =
-        ruckig_input_->current_velocity.at(i) + ruckig_input_->current_acceleration.at(i) * params_.update_period;
+    assign(positions, ruckig_input_.target_position);
+    // We don't know what the next command will be. Assume velocity continues forward based on current state,
+    // target_acceleration is zero.
+    for (size_t i = 0; i < num_joints; ++i)
+    {
+      ruckig_input_.target_velocity[i] =
+          ruckig_input_.current_velocity[i] + ruckig_input_.current_acceleration[i] * update_period_;
+    }
   }
-  // target_acceleration remains a vector of zeroes
 
   // Call the Ruckig algorithm
-  ruckig::Result ruckig_result = ruckig_->update(*ruckig_input_, *ruckig_output_);
-
-  // Finished means the target state can be reached in this timestep.
-  // Working means the target state can be reached but not in this timestep.
-  // ErrorSynchronizationCalculation means smoothing was successful but the robot will deviate a bit from the desired
-  // path.
-  // See https://github.com/pantor/ruckig/blob/master/include/ruckig/input_parameter.hpp
+  const ruckig::Result ruckig_result = ruckig_.update(ruckig_input_, ruckig_output_);
   if (ruckig_result != ruckig::Result::Finished && ruckig_result != ruckig::Result::Working &&
       ruckig_result != ruckig::Result::ErrorSynchronizationCalculation)
-
   {
-    RCLCPP_ERROR_STREAM(getLogger(), "Ruckig jerk-limited smoothing failed with code: " << ruckig_result);
-    printRuckigState();
-    // Return without modifying the position/vel/accel
     have_initial_ruckig_output_ = false;
-    return true;
+    return ruckig_result;
   }
 
   // Update the target state with Ruckig output
-  positions = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(ruckig_output_->new_position.data(),
-                                                            ruckig_output_->new_position.size());
-  velocities = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(ruckig_output_->new_velocity.data(),
-                                                             ruckig_output_->new_velocity.size());
-  accelerations = Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(ruckig_output_->new_acceleration.data(),
-                                                                ruckig_output_->new_acceleration.size());
+  positions = Eigen::Map<const Eigen::VectorXd>(ruckig_output_.new_position.data(), num_joints);
+  velocities = Eigen::Map<const Eigen::VectorXd>(ruckig_output_.new_velocity.data(), num_joints);
+  accelerations = Eigen::Map<const Eigen::VectorXd>(ruckig_output_.new_acceleration.data(), num_joints);
   have_initial_ruckig_output_ = true;
+  return ruckig_result;
+}
+
+template <size_t DOFs>
+void RuckigFilter<DOFs>::reset(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
+                               const Eigen::VectorXd& accelerations)
+{
+  assign(positions, ruckig_input_.current_position);
+  assign(velocities, ruckig_input_.current_velocity);
+  assign(accelerations, ruckig_input_.current_acceleration);
+  have_initial_ruckig_output_ = false;
+}
+
+template <size_t DOFs>
+std::string RuckigFilter<DOFs>::toString() const
+{
+  std::stringstream stream;
+  stream << update_period_ << "\nRuckig input:\n"
+         << ruckig_input_.to_string() << "\nRuckig output:\n"
+         << ruckig_output_.to_string();
+  return stream.str();
+}
+
+template class RuckigFilter<ruckig::DynamicDOFs>;
+template class RuckigFilter<6>;
+template class RuckigFilter<7>;
+
+bool RuckigFilterPlugin::initialize(rclcpp::Node::SharedPtr node, moveit::core::RobotModelConstPtr robot_model,
+                                    size_t num_joints)
+{
+  robot_model_ = robot_model;
+
+  // get node parameters and store in member variables
+  auto param_listener = online_signal_smoothing::ParamListener(node);
+  params_ = param_listener.get_params();
+
+  // Ruckig needs the joint vel/accel bounds
+  // TODO: Ruckig says the jerk bounds can be optional. We require them, for now.
+  std::vector<double> max_velocity, max_acceleration, max_jerk;
+  if (!getVelAccelJerkBounds(max_velocity, max_acceleration, max_jerk))
+  {
+    return false;
+  }
+  if (max_velocity.size() != num_joints)
+  {
+    RCLCPP_ERROR_STREAM(getLogger(), "The planning group has " << max_velocity.size() << " active joints, but "
+                                                                << num_joints << " joints are smoothed.");
+    return false;
+  }
+
+  // Common arm sizes get a filter specialized for their number of joints
+  switch (num_joints)
+  {
+    case 6:
+      filter_.emplace<RuckigFilter<6>>(num_joints, params_.update_period, max_velocity, max_acceleration, max_jerk);
+      break;
+    case 7:
+      filter_.emplace<RuckigFilter<7>>(num_joints, params_.update_period, max_velocity, max_acceleration, max_jerk);
+      break;
+    default:
+      filter_.emplace<RuckigFilter<ruckig::DynamicDOFs>>(num_joints, params_.update_period, max_velocity,
+                                                         max_acceleration, max_jerk);
+  }
 
   return true;
 }
 
+bool RuckigFilterPlugin::doSmoothing(Eigen::VectorXd& positions, Eigen::VectorXd& velocities,
+                                     Eigen::VectorXd& accelerations)
+{
+  return std::visit([&](auto& filter) { return smooth(filter, positions, velocities, accelerations); }, filter_);
+}
+
 bool RuckigFilterPlugin::reset(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
                                const Eigen::VectorXd& accelerations)
 {
-  // Initialize Ruckig
-  ruckig_input_->current_position = std::vector<double>(positions.data(), positions.data() + positions.size());
-  ruckig_input_->current_velocity = std::vector<double>(velocities.data(), velocities.data() + velocities.size());
-  ruckig_input_->current_acceleration =
-      std::vector<double>(accelerations.data(), accelerations.data() + accelerations.size());
-
-  have_initial_ruckig_output_ = false;
-  return true;
+  return std::visit([&](auto& filter) { return resetFilter(filter, positions, velocities, accelerations); }, filter_);
 }
 
 bool RuckigFilterPlugin::getVelAccelJerkBounds(std::vector<double>& joint_velocity_bounds,
@@ -206,13 +326,6 @@ bool RuckigFilterPlugin::getVelAccelJerkBounds(std::vector<double>& joint_veloci
 
   return true;
 }
-
-void RuckigFilterPlugin::printRuckigState()
-{
-  RCLCPP_INFO_STREAM(getLogger(), ruckig_->delta_time << "\nRuckig input:\n"
-                                                      << ruckig_input_->to_string() << "\nRuckig output:\n"
-                                                      << ruckig_output_->to_string());
-}
 }  // namespace online_signal_smoothing
 
 #include <pluginlib/class_list_macros.hpp>
@@ -0,0 +1,119 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Measures the time per cycle of the AccelerationLimitedPlugin at 1 kHz over a servo command stream.
+// To run this benchmark, 'cd' to the build/moveit_core/online_signal_smoothing directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/online_signal_smoothing/acceleration_filter.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+
+#include "command_stream.hpp"
+
+namespace
+{
+constexpr size_t PANDA_NUM_JOINTS = 7u;
+constexpr double UPDATE_PERIOD = 0.001;
+constexpr size_t STREAM_LENGTH = 5000;
+
+moveit::core::RobotModelPtr makeRobotModel()
+{
+  moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel("panda");
+  const auto joint_model_group = robot_model->getJointModelGroup("panda_arm");
+  for (const auto& joint_model : robot_model->getJointModels())
+  {
+    if (!joint_model_group->hasJointModel(joint_model->getName()))
+    {
+      continue;
+    }
+    std::vector<moveit_msgs::msg::JointLimits> joint_bounds_msg(joint_model->getVariableBoundsMsg());
+    for (auto& joint_bound : joint_bounds_msg)
+    {
+      joint_bound.has_acceleration_limits = true;
+      joint_bound.max_acceleration = 5.0;
+    }
+    joint_model->setVariableBounds(joint_bounds_msg);
+  }
+  return robot_model;
+}
+}  // namespace
+
+// Smooth the whole command stream, reporting the solver statistics of the filter as counters.
+static void accelerationFilterCommandStream(benchmark::State& st)
+{
+  rclcpp::Node::SharedPtr node = std::make_shared<rclcpp::Node>("acceleration_filter_benchmark");
+  node->declare_parameter<std::string>("planning_group_name", "panda_arm");
+  node->declare_parameter<double>("update_period", UPDATE_PERIOD);
+  online_signal_smoothing::AccelerationLimitedPlugin filter;
+  if (!filter.initialize(node, makeRobotModel(), PANDA_NUM_JOINTS))
+  {
+    st.SkipWithError("Failed to initialize the acceleration filter");
+    return;
+  }
+
+  const std::vector<Eigen::VectorXd> stream =
+      online_signal_smoothing_test::makeCommandStream(PANDA_NUM_JOINTS, UPDATE_PERIOD, STREAM_LENGTH);
+  Eigen::VectorXd positions = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  Eigen::VectorXd velocities = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  Eigen::VectorXd accelerations = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  for (auto _ : st)
+  {
+    filter.reset(stream.front(), velocities.setZero(), accelerations);
+    for (const auto& command : stream)
+    {
+      positions = command;
+      filter.doSmoothing(positions, velocities, accelerations);
+    }
+    benchmark::DoNotOptimize(positions.data());
+  }
+
+  const auto& statistics = filter.getSolverStatistics();
+  st.SetItemsProcessed(st.iterations() * stream.size());
+  st.counters["solves"] = statistics.solve_count;
+  st.counters["mean_solve_us"] =
+      statistics.solve_count > 0 ? 1E6 * statistics.total_solve_time / statistics.solve_count : 0.0;
+  st.counters["max_solve_us"] = 1E6 * statistics.max_solve_time;
+}
+
+BENCHMARK(accelerationFilterCommandStream);
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  rclcpp::shutdown();
+  return 0;
+}
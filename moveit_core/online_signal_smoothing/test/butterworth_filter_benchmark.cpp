@@ -0,0 +1,80 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Compares filtering a joint vector with one ButterworthFilter per joint against the vectorized ButterworthFilterBank.
+// To run this benchmark, 'cd' to the build/moveit_core/online_signal_smoothing directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/online_signal_smoothing/butterworth_filter.hpp>
+
+namespace
+{
+constexpr double FILTER_COEFF = 1.5;
+}  // namespace
+
+// Filter a joint vector of the size given by the range argument with a scalar filter per joint.
+static void butterworthFilterPerJoint(benchmark::State& st)
+{
+  const size_t num_joints = st.range(0);
+  const online_signal_smoothing::ButterworthFilter filter(FILTER_COEFF);
+  std::vector<online_signal_smoothing::ButterworthFilter> filters(num_joints, filter);
+  Eigen::VectorXd positions = Eigen::VectorXd::Random(num_joints);
+  for (auto _ : st)
+  {
+    for (size_t i = 0; i < num_joints; ++i)
+    {
+      positions[i] = filters[i].filter(positions[i]);
+    }
+    benchmark::DoNotOptimize(positions.data());
+  }
+}
+
+// Filter a joint vector of the size given by the range argument with a filter bank of the given order.
+static void butterworthFilterBank(benchmark::State& st)
+{
+  const size_t num_joints = st.range(0);
+  online_signal_smoothing::ButterworthFilterBank filters(FILTER_COEFF, num_joints, st.range(1));
+  Eigen::VectorXd positions = Eigen::VectorXd::Random(num_joints);
+  for (auto _ : st)
+  {
+    filters.filter(positions);
+    benchmark::DoNotOptimize(positions.data());
+  }
+}
+
+BENCHMARK(butterworthFilterPerJoint)->RangeMultiplier(4)->Range(8, 512);
+BENCHMARK(butterworthFilterBank)->ArgsProduct({ benchmark::CreateRange(8, 512, 4), { 1, 2 } });
+
+BENCHMARK_MAIN();
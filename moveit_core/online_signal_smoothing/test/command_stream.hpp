@@ -0,0 +1,70 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include <cstddef>
+#include <vector>
+
+namespace online_signal_smoothing_test
+{
+/** \brief A command stream as servo produces it for a jogging operator, shared by the smoothing filter benchmarks.
+
+    Segments of constant joint velocity commands with abrupt changes between them, including stops and reversals that
+    the filters have to limit. Each command is repeated for \e cycles_per_command cycles, as when commands arrive at a
+    lower rate than the filter runs. */
+inline std::vector<Eigen::VectorXd> makeCommandStream(std::size_t num_joints, double update_period,
+                                                      std::size_t stream_length, std::size_t cycles_per_command = 1)
+{
+  const std::vector<double> segment_velocities = { 0.0, 0.5, 1.0, -1.0, 0.0, 0.3, -0.6, 0.0 };
+  const std::size_t segment_length = stream_length / segment_velocities.size();
+  std::vector<Eigen::VectorXd> stream;
+  stream.reserve(stream_length);
+  Eigen::VectorXd position = Eigen::VectorXd::Zero(num_joints);
+  for (std::size_t i = 0; i < stream_length; ++i)
+  {
+    const double velocity = segment_velocities[(i / segment_length) % segment_velocities.size()];
+    for (std::size_t joint = 0; joint < num_joints; ++joint)
+    {
+      // every joint follows the stream with a different gain
+      position[joint] += velocity * (1.0 + 0.1 * joint) * update_period;
+    }
+    stream.push_back(i % cycles_per_command == 0 ? position : stream.back());
+  }
+  return stream;
+}
+}  // namespace online_signal_smoothing_test
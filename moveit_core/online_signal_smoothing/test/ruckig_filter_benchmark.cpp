@@ -0,0 +1,81 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Compares the time per cycle of the RuckigFilter with a fixed number of joints against the dynamic-size filter.
+// To run this benchmark, 'cd' to the build/moveit_core/online_signal_smoothing directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/online_signal_smoothing/ruckig_filter.hpp>
+
+#include "command_stream.hpp"
+
+namespace
+{
+constexpr size_t PANDA_NUM_JOINTS = 7u;
+constexpr double UPDATE_PERIOD = 0.001;
+constexpr size_t STREAM_LENGTH = 5000;
+}  // namespace
+
+// Smooth the whole command stream with a filter for DOFs joints, holding each command for the number of cycles given
+// by the range argument.
+template <size_t DOFs>
+static void ruckigFilterCommandStream(benchmark::State& st)
+{
+  online_signal_smoothing::RuckigFilter<DOFs> filter(PANDA_NUM_JOINTS, UPDATE_PERIOD,
+                                                     std::vector<double>(PANDA_NUM_JOINTS, 2.0),
+                                                     std::vector<double>(PANDA_NUM_JOINTS, 5.0),
+                                                     std::vector<double>(PANDA_NUM_JOINTS, 200.0));
+
+  const std::vector<Eigen::VectorXd> stream =
+      online_signal_smoothing_test::makeCommandStream(PANDA_NUM_JOINTS, UPDATE_PERIOD, STREAM_LENGTH, st.range(0));
+  Eigen::VectorXd positions = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  Eigen::VectorXd velocities = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  Eigen::VectorXd accelerations = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  for (auto _ : st)
+  {
+    filter.reset(stream.front(), velocities.setZero(), accelerations.setZero());
+    for (const auto& command : stream)
+    {
+      positions = command;
+      filter.update(positions, velocities, accelerations);
+    }
+    benchmark::DoNotOptimize(positions.data());
+  }
+  st.SetItemsProcessed(st.iterations() * stream.size());
+}
+
+BENCHMARK_TEMPLATE(ruckigFilterCommandStream, ruckig::DynamicDOFs)->Arg(1)->Arg(10);
+BENCHMARK_TEMPLATE(ruckigFilterCommandStream, PANDA_NUM_JOINTS)->Arg(1)->Arg(10);
+
+BENCHMARK_MAIN();
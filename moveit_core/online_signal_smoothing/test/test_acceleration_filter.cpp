@@ -156,6 +156,40 @@ TEST_F(AccelerationFilterTest, FilterDoSmooth)
   EXPECT_TRUE((velocity * update_period - expected_offset).norm() < 1E-3);
 }
 
+TEST_F(AccelerationFilterTest, FilterSolverStatistics)
+{
+  online_signal_smoothing::AccelerationLimitedPlugin filter;
+  rclcpp::Node::SharedPtr node = std::make_shared<rclcpp::Node>("AccelerationFilterTest");
+  node->declare_parameter<std::string>("planning_group_name", PLANNING_GROUP_NAME.data());
+  const double update_period = 0.001;
+  node->declare_parameter<double>("update_period", update_period);
+  Eigen::VectorXd acceleration_limits = 1.2 * Eigen::VectorXd::Ones(PANDA_NUM_JOINTS);
+  setLimits(acceleration_limits);
+  EXPECT_TRUE(filter.initialize(node, robot_model_, PANDA_NUM_JOINTS));
+  EXPECT_EQ(filter.getSolverStatistics().solve_count, 0u);
+
+  // accelerate towards a distant target, every cycle solves the warm started problem
+  Eigen::VectorXd position = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  Eigen::VectorXd velocity = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  Eigen::VectorXd acceleration = Eigen::VectorXd::Zero(PANDA_NUM_JOINTS);
+  filter.reset(position, velocity, acceleration);
+  constexpr size_t num_cycles = 100;
+  for (size_t cycle = 0; cycle < num_cycles; ++cycle)
+  {
+    position.array() = 1.0;
+    EXPECT_TRUE(filter.doSmoothing(position, velocity, acceleration));
+  }
+  EXPECT_GT(position[0], 0.0);
+  EXPECT_LT(position[0], 1.0);
+
+  const auto& statistics = filter.getSolverStatistics();
+  EXPECT_EQ(statistics.solve_count, num_cycles);
+  EXPECT_GT(statistics.last_iterations, 0u);
+  EXPECT_GT(statistics.total_solve_time, 0.0);
+  EXPECT_GE(statistics.max_solve_time, statistics.last_solve_time);
+  EXPECT_LE(statistics.max_solve_time, statistics.total_solve_time);
+}
+
 TEST_F(AccelerationFilterTest, FilterBadAccelerationConfig)
 {
   online_signal_smoothing::AccelerationLimitedPlugin filter;
@@ -40,6 +40,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <moveit/online_signal_smoothing/butterworth_filter.hpp>
 
 TEST(SMOOTHING_PLUGINS, FilterConverge)
@@ -71,3 +72,89 @@ TEST(SMOOTHING_PLUGINS, FilterReset)
   // Then check that a different measurement changes the value
   EXPECT_NE(5.0, lpf.filter(100.0));
 }
+
+TEST(SMOOTHING_PLUGINS, FilterBankMatchesFilter)
+{
+  constexpr size_t num_channels = 7;
+  online_signal_smoothing::ButterworthFilterBank bank(2.0, num_channels);
+  const online_signal_smoothing::ButterworthFilter filter(2.0);
+  std::vector<online_signal_smoothing::ButterworthFilter> filters(num_channels, filter);
+
+  Eigen::VectorXd measurements(num_channels);
+  for (size_t step = 0; step < 100; ++step)
+  {
+    for (size_t i = 0; i < num_channels; ++i)
+    {
+      measurements[i] = std::sin(0.1 * step * (i + 1)) + (step % 10 == 0 ? 1.0 : 0.0);
+    }
+    Eigen::VectorXd filtered = measurements;
+    bank.filter(filtered);
+
+    // The first order gives the same output as the scalar filter
+    for (size_t i = 0; i < num_channels; ++i)
+    {
+      EXPECT_EQ(filtered[i], filters[i].filter(measurements[i]));
+    }
+  }
+}
+
+TEST(SMOOTHING_PLUGINS, FilterBankFrequencyResponse)
+{
+  constexpr double cutoff_frequency = 0.05;
+  const double coeff = online_signal_smoothing::ButterworthFilterBank::coefficientFromCutoffFrequency(cutoff_frequency);
+  // Sinusoids at the cutoff frequency and above it, both with a whole number of periods in the measured samples
+  const std::vector<double> frequencies{ cutoff_frequency, 2 * cutoff_frequency };
+  constexpr size_t settling_steps = 1000;
+  constexpr size_t measured_steps = 1000;
+
+  for (size_t order = 1; order <= 4; ++order)
+  {
+    online_signal_smoothing::ButterworthFilterBank bank(coeff, frequencies.size(), order);
+    Eigen::VectorXd in_phase = Eigen::VectorXd::Zero(frequencies.size());
+    Eigen::VectorXd quadrature = Eigen::VectorXd::Zero(frequencies.size());
+    for (size_t step = 0; step < settling_steps + measured_steps; ++step)
+    {
+      Eigen::VectorXd phases(frequencies.size());
+      for (size_t i = 0; i < frequencies.size(); ++i)
+      {
+        phases[i] = 2 * M_PI * frequencies[i] * step;
+      }
+      Eigen::VectorXd filtered = phases.array().sin();
+      bank.filter(filtered);
+      if (step >= settling_steps)
+      {
+        in_phase += (filtered.array() * phases.array().sin()).matrix();
+        quadrature += (filtered.array() * phases.array().cos()).matrix();
+      }
+    }
+
+    for (size_t i = 0; i < frequencies.size(); ++i)
+    {
+      const double gain = 2.0 / measured_steps * std::hypot(in_phase[i], quadrature[i]);
+      // The gain of the bilinear transformed Butterworth filter, -3 dB at the cutoff frequency for every order
+      const double ratio = std::tan(M_PI * frequencies[i]) / std::tan(M_PI * cutoff_frequency);
+      const double expected_gain = 1.0 / std::sqrt(1.0 + std::pow(ratio, 2.0 * order));
+      EXPECT_NEAR(gain, expected_gain, 1e-6) << "order " << order << ", frequency " << frequencies[i];
+    }
+  }
+}
+
+TEST(SMOOTHING_PLUGINS, FilterBankReset)
+{
+  online_signal_smoothing::ButterworthFilterBank bank(
+      online_signal_smoothing::ButterworthFilterBank::coefficientFromCutoffFrequency(0.1), 3, 3);
+  bank.reset(Eigen::Vector3d(1.0, 2.0, 3.0));
+  Eigen::VectorXd value = Eigen::Vector3d(1.0, 2.0, 3.0);
+  bank.filter(value);
+
+  // Check that both sections of the third order were properly set to the desired value
+  EXPECT_NEAR(1.0, value[0], 1e-12);
+  EXPECT_NEAR(2.0, value[1], 1e-12);
+  EXPECT_NEAR(3.0, value[2], 1e-12);
+
+  // Cutoff frequencies at or above a quarter of the sampling frequency make the filter unstable
+  EXPECT_THROW(online_signal_smoothing::ButterworthFilterBank(
+                   online_signal_smoothing::ButterworthFilterBank::coefficientFromCutoffFrequency(0.3), 3),
+               std::length_error);
+  EXPECT_THROW(online_signal_smoothing::ButterworthFilterBank(2.0, 3, 0), std::length_error);
+}
@@ -0,0 +1,99 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/online_signal_smoothing/ruckig_filter.hpp>
+
+namespace
+{
+constexpr size_t NUM_JOINTS = 7u;
+constexpr double UPDATE_PERIOD = 0.001;
+constexpr double MAX_VELOCITY = 2.0;
+
+template <size_t DOFs>
+online_signal_smoothing::RuckigFilter<DOFs> makeFilter()
+{
+  return online_signal_smoothing::RuckigFilter<DOFs>(NUM_JOINTS, UPDATE_PERIOD,
+                                                     std::vector<double>(NUM_JOINTS, MAX_VELOCITY),
+                                                     std::vector<double>(NUM_JOINTS, 5.0),
+                                                     std::vector<double>(NUM_JOINTS, 200.0));
+}
+}  // namespace
+
+TEST(RuckigFilter, FixedSizeMatchesDynamicSize)
+{
+  auto dynamic_filter = makeFilter<ruckig::DynamicDOFs>();
+  auto fixed_filter = makeFilter<NUM_JOINTS>();
+  Eigen::VectorXd dynamic_positions(NUM_JOINTS), dynamic_velocities(NUM_JOINTS), dynamic_accelerations(NUM_JOINTS);
+  Eigen::VectorXd fixed_positions(NUM_JOINTS), fixed_velocities(NUM_JOINTS), fixed_accelerations(NUM_JOINTS);
+  const Eigen::VectorXd zeros = Eigen::VectorXd::Zero(NUM_JOINTS);
+  dynamic_filter.reset(zeros, zeros, zeros);
+  fixed_filter.reset(zeros, zeros, zeros);
+
+  Eigen::VectorXd command = Eigen::VectorXd::Zero(NUM_JOINTS);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    // A new command every 10 cycles
+    if (i % 10 == 0)
+    {
+      command.array() += 0.001 * Eigen::ArrayXd::LinSpaced(NUM_JOINTS, 1.0, 2.0);
+    }
+    dynamic_positions = command;
+    fixed_positions = command;
+    ASSERT_EQ(dynamic_filter.update(dynamic_positions, dynamic_velocities, dynamic_accelerations),
+              fixed_filter.update(fixed_positions, fixed_velocities, fixed_accelerations));
+    EXPECT_NEAR((dynamic_positions - fixed_positions).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((dynamic_velocities - fixed_velocities).norm(), 0.0, 1e-12);
+  }
+}
+
+TEST(RuckigFilter, HeldCommandIsReached)
+{
+  auto filter = makeFilter<NUM_JOINTS>();
+  const Eigen::VectorXd zeros = Eigen::VectorXd::Zero(NUM_JOINTS);
+  filter.reset(zeros, zeros, zeros);
+
+  // The same command for 2 seconds, which keeps the target Ruckig calculated its trajectory for
+  const Eigen::VectorXd command = Eigen::VectorXd::Constant(NUM_JOINTS, 0.5);
+  Eigen::VectorXd positions(NUM_JOINTS), velocities(NUM_JOINTS), accelerations(NUM_JOINTS);
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    positions = command;
+    const ruckig::Result result = filter.update(positions, velocities, accelerations);
+    ASSERT_TRUE(result == ruckig::Result::Working || result == ruckig::Result::Finished);
+    EXPECT_LE(velocities.cwiseAbs().maxCoeff(), MAX_VELOCITY + 1e-9);
+  }
+  EXPECT_TRUE(positions.isApprox(command, 1e-6));
+  EXPECT_NEAR(velocities.norm(), 0.0, 1e-6);
+}
@@ -0,0 +1,78 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+#include <geometric_shapes/shapes.h>
+#include <shape_msgs/msg/mesh.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <moveit_planning_scene_export.h>
+
+namespace planning_scene
+{
+/** \brief Interns meshes received as messages by their content.
+
+    Identical mesh messages map to the same shapes::Mesh instance for as long as that instance is used somewhere. The
+    collision checkers cache their geometry (e.g. the BVH of a mesh) per shape instance, so objects that are re-sent
+    with unchanged meshes, or that share a mesh with other objects, reuse the geometry that was already built. */
+class MOVEIT_PLANNING_SCENE_EXPORT MeshCache
+{
+public:
+  MeshCache();
+
+  /** \brief The cache shared by all planning scenes of this process */
+  static MeshCache& global();
+
+  /** \brief Get the mesh described by \e msg, constructing it only if no identical mesh is in use.
+      Returns nullptr if the message does not describe a valid mesh. */
+  shapes::ShapeConstPtr getMesh(const shape_msgs::msg::Mesh& msg);
+
+  /** \brief The number of distinct meshes currently in use */
+  std::size_t size() const;
+
+private:
+  std::size_t removeExpired();
+
+  mutable std::mutex lock_;
+  std::unordered_multimap<std::size_t, std::weak_ptr<const shapes::Mesh>> meshes_;
+
+  // expired entries are removed when the cache grew to twice its size after the last cleanup
+  std::size_t cleanup_size_;
+};
+}  // namespace planning_scene
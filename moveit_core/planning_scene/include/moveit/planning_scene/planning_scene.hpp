@@ -685,6 +685,10 @@ public:
   void processOctomapMsg(const octomap_msgs::msg::Octomap& map);
   void processOctomapPtr(const std::shared_ptr<const octomap::OcTree>& octree, const Eigen::Isometry3d& t);
 
+  /** \brief Get the number of calls to processOctomapPtr(), which also signal updates of the octree in place.
+      For a diff scene, the updates of the parent are included. */
+  std::size_t getOctomapUpdateCount() const;
+
   /**
    * \brief Clear all collision objects in planning scene
    */
@@ -983,6 +987,7 @@ private:
   collision_detection::WorldPtr world_;             // never nullptr, never shared with parent/child
   collision_detection::WorldConstPtr world_const_;  // copy of world_
   collision_detection::WorldDiffPtr world_diff_;    // nullptr unless this is a diff scene
+  std::size_t octomap_update_count_ = 0;            // if this is a diff scene, the count is added to the parent's
   collision_detection::World::ObserverCallbackFn current_world_object_update_callback_;
   collision_detection::World::ObserverHandle current_world_object_update_observer_handle_;
 
@@ -0,0 +1,141 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+#include <moveit/planning_scene/planning_scene.hpp>
+#include <shape_msgs/msg/mesh.hpp>
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <moveit_planning_scene_export.h>
+
+namespace planning_scene
+{
+/** \brief Encodes the planning scene messages sent to one client as diffs against the messages sent before.
+
+    The first message (and the first after reset()) describes the complete scene. Every later message is a diff
+    (is_diff is set) that turns the scene the client built from the previous messages into the current one. Only
+    world objects that were added or changed are sent with their geometry. Objects whose shapes are unchanged and that
+    only moved are sent as MOVE operations. Shapes are compared by content hashes, which are cached per shape
+    instance. The octomap and the attached objects are only sent when their content changed. The octomap is only
+    serialized when it was replaced, moved or updated (see PlanningScene::getOctomapUpdateCount()). With a mesh table,
+    a mesh shared by several objects is sent once per client instead of once per object. The client must apply every
+    message in order, using PlanningScene::usePlanningSceneMsg(). If a message may have been lost, call reset() so the
+    next message describes the complete scene. */
+class MOVEIT_PLANNING_SCENE_EXPORT PlanningSceneDeltaEncoder
+{
+public:
+  /** \brief The meshes of the world collision objects of a message, sent separately and addressed by content hash */
+  struct MeshTable
+  {
+    /** \brief The meshes that were not sent to the client since the last complete scene, by content hash */
+    std::map<std::size_t, shape_msgs::msg::Mesh> meshes;
+
+    /** \brief The content hashes of the meshes of each collision object sent without mesh data, by object id */
+    std::map<std::string, std::vector<std::size_t>> object_meshes;
+  };
+
+  PlanningSceneDeltaEncoder();
+
+  /** \brief Fill \e scene_msg with the components \e comp of \e scene that changed since the previous message */
+  void getPlanningSceneMsg(const PlanningScene& scene, const moveit_msgs::msg::PlanningSceneComponents& comp,
+                           moveit_msgs::msg::PlanningScene& scene_msg);
+
+  /** \brief Like getPlanningSceneMsg(), but the meshes of the world collision objects are sent in \e mesh_table.
+
+      The meshes in \e scene_msg are left empty. A mesh is only put in \e mesh_table once until the next complete
+      scene, however many objects use it. Attached objects keep their meshes. The client restores the meshes with
+      restoreMeshes(). */
+  void getPlanningSceneMsg(const PlanningScene& scene, const moveit_msgs::msg::PlanningSceneComponents& comp,
+                           moveit_msgs::msg::PlanningScene& scene_msg, MeshTable& mesh_table);
+
+  /** \brief Put the meshes of \e mesh_table back into the collision objects of \e scene_msg, on the client side.
+      \e client_meshes holds the meshes the client received so far. It is cleared by a complete scene.
+      \return false if an object refers to a mesh the client did not receive */
+  static bool restoreMeshes(const MeshTable& mesh_table, std::map<std::size_t, shape_msgs::msg::Mesh>& client_meshes,
+                            moveit_msgs::msg::PlanningScene& scene_msg);
+
+  /** \brief Forget what was sent, so the next message describes the complete scene again */
+  void reset();
+
+  /** \brief Get the number of messages encoded since construction or the last reset() */
+  std::size_t getVersion() const
+  {
+    return version_;
+  }
+
+private:
+  struct WorldObjectRecord
+  {
+    std::size_t geometry_hash;
+    Eigen::Isometry3d pose;
+  };
+
+  struct OctomapRecord
+  {
+    bool present;
+    std::weak_ptr<const shapes::Shape> shape;
+    Eigen::Isometry3d pose;
+    std::size_t update_count;
+    std::size_t hash;
+  };
+
+  void encode(const PlanningScene& scene, const moveit_msgs::msg::PlanningSceneComponents& comp,
+              moveit_msgs::msg::PlanningScene& scene_msg, MeshTable* mesh_table);
+  void encodeWorldObjects(const PlanningScene& scene, bool full, bool attached_objects_encoded,
+                          moveit_msgs::msg::PlanningScene& scene_msg, MeshTable* mesh_table);
+  void moveMeshesToTable(const collision_detection::World::Object& object,
+                         moveit_msgs::msg::CollisionObject& object_msg, MeshTable& mesh_table);
+  void encodeAttachedObjects(const PlanningScene& scene, bool full, moveit_msgs::msg::PlanningScene& scene_msg);
+  void encodeOctomap(const PlanningScene& scene, bool full, moveit_msgs::msg::PlanningScene& scene_msg);
+
+  std::size_t getShapeHash(const shapes::ShapeConstPtr& shape);
+  std::size_t getObjectTypeHash(const PlanningScene& scene, const std::string& id) const;
+
+  std::size_t version_;
+  std::map<std::string, WorldObjectRecord> world_objects_;
+  std::optional<std::map<std::string, std::size_t>> attached_objects_;
+  std::optional<OctomapRecord> octomap_;
+  // content hashes of the meshes put in a mesh table since the last complete scene
+  std::set<std::size_t> sent_meshes_;
+
+  // content hashes of the shapes seen so far; the weak pointer detects shapes that were freed and their address reused
+  std::unordered_map<const shapes::Shape*, std::pair<std::weak_ptr<const shapes::Shape>, std::size_t>> shape_hashes_;
+};
+}  // namespace planning_scene
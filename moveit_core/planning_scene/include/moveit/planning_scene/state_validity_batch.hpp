@@ -0,0 +1,101 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+#include <moveit/planning_scene/planning_scene.hpp>
+#include <optional>
+
+#include <moveit_planning_scene_export.h>
+
+namespace planning_scene
+{
+/** \brief Options for checkStateValidity() and its batch variants */
+struct StateValidityOptions
+{
+  /** \brief The group to check; all links and joints of the robot if empty */
+  std::string group;
+
+  /** \brief Report the contacts and cost sources of colliding states */
+  bool compute_contacts = false;
+
+  /** \brief Compute the clearance of states that are not colliding */
+  bool compute_clearance = false;
+
+  /** \brief Number of threads the batch variants use; 0 for one per core, never more than the number of cores */
+  std::size_t threads = 1;
+};
+
+/** \brief The outcome of checking one state */
+struct StateValidityResult
+{
+  /** \brief Within bounds, not colliding, feasible and satisfying the constraints */
+  bool valid = false;
+  bool satisfies_bounds = false;
+  bool feasible = false;
+  collision_detection::CollisionResult collision;
+  kinematic_constraints::ConstraintEvaluationResult constraints;
+  std::vector<kinematic_constraints::ConstraintEvaluationResult> constraint_results;
+  /** \brief The distance between the robot and the nearest world object, if requested and the state is not colliding.
+      Infinity when there is no world object the robot could collide with. */
+  std::optional<double> clearance;
+  /** \brief The closest pair of bodies, when the clearance is finite */
+  std::optional<collision_detection::DistanceResultsData> nearest_bodies;
+};
+
+/** \brief Check \e state against the bounds, collisions, feasibility predicate and \e constraints (may be nullptr) of
+    \e scene. The state is updated as needed. */
+MOVEIT_PLANNING_SCENE_EXPORT StateValidityResult
+checkStateValidity(const PlanningScene& scene, moveit::core::RobotState& state,
+                   const kinematic_constraints::KinematicConstraintSet* constraints,
+                   const StateValidityOptions& options = StateValidityOptions());
+
+/** \brief Check many states in parallel, one result per state.
+
+    The scene is only read, so it must not be modified while this runs; a snapshot of a monitored scene is
+    consistent for the whole batch. The feasibility predicate of the scene and the constraints must be thread-safe
+    when more than one thread is used. */
+MOVEIT_PLANNING_SCENE_EXPORT std::vector<StateValidityResult>
+checkStatesValidity(const PlanningScene& scene, const std::vector<moveit::core::RobotState>& states,
+                    const kinematic_constraints::KinematicConstraintSet* constraints,
+                    const StateValidityOptions& options = StateValidityOptions());
+
+/** \brief Check every waypoint of \e trajectory in parallel, one result per waypoint, with the same requirements as
+    checkStatesValidity(). The group of the trajectory is checked unless \e options names another one. */
+MOVEIT_PLANNING_SCENE_EXPORT std::vector<StateValidityResult>
+checkTrajectoryValidity(const PlanningScene& scene, const robot_trajectory::RobotTrajectory& trajectory,
+                        const kinematic_constraints::KinematicConstraintSet* constraints,
+                        const StateValidityOptions& options = StateValidityOptions());
+}  // namespace planning_scene
@@ -0,0 +1,154 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <moveit/planning_scene/mesh_cache.hpp>
+#include <geometric_shapes/shape_operations.h>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace planning_scene
+{
+namespace
+{
+constexpr std::size_t MIN_CLEANUP_SIZE = 64;
+
+// the messages are hashed as plain memory, which requires them to be packed arrays of their numbers
+static_assert(sizeof(geometry_msgs::msg::Point) == 3 * sizeof(double), "unexpected layout of geometry_msgs::Point");
+static_assert(sizeof(shape_msgs::msg::MeshTriangle) == 3 * sizeof(uint32_t),
+              "unexpected layout of shape_msgs::MeshTriangle");
+
+std::size_t hashMesh(const shape_msgs::msg::Mesh& msg)
+{
+  std::size_t hash = std::hash<std::string_view>()(std::string_view(
+      reinterpret_cast<const char*>(msg.vertices.data()), msg.vertices.size() * sizeof(geometry_msgs::msg::Point)));
+  const std::size_t triangles_hash = std::hash<std::string_view>()(
+      std::string_view(reinterpret_cast<const char*>(msg.triangles.data()),
+                       msg.triangles.size() * sizeof(shape_msgs::msg::MeshTriangle)));
+  hash ^= triangles_hash + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+bool meshEquals(const shapes::Mesh& mesh, const shape_msgs::msg::Mesh& msg)
+{
+  if (mesh.vertex_count != msg.vertices.size() || mesh.triangle_count != msg.triangles.size())
+    return false;
+  for (std::size_t i = 0; i < msg.vertices.size(); ++i)
+  {
+    const geometry_msgs::msg::Point& p = msg.vertices[i];
+    if (mesh.vertices[3 * i] != p.x || mesh.vertices[3 * i + 1] != p.y || mesh.vertices[3 * i + 2] != p.z)
+      return false;
+  }
+  for (std::size_t i = 0; i < msg.triangles.size(); ++i)
+  {
+    const auto& t = msg.triangles[i].vertex_indices;
+    if (mesh.triangles[3 * i] != t[0] || mesh.triangles[3 * i + 1] != t[1] || mesh.triangles[3 * i + 2] != t[2])
+      return false;
+  }
+  return true;
+}
+}  // namespace
+
+MeshCache::MeshCache() : cleanup_size_(MIN_CLEANUP_SIZE)
+{
+}
+
+MeshCache& MeshCache::global()
+{
+  static MeshCache cache;
+  return cache;
+}
+
+shapes::ShapeConstPtr MeshCache::getMesh(const shape_msgs::msg::Mesh& msg)
+{
+  const std::size_t hash = hashMesh(msg);
+  {
+    std::scoped_lock slock(lock_);
+    const auto range = meshes_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      std::shared_ptr<const shapes::Mesh> mesh = it->second.lock();
+      if (mesh && meshEquals(*mesh, msg))
+        return mesh;
+    }
+  }
+
+  // construct outside the lock; if another thread interned the same mesh meanwhile, use the one it made
+  std::shared_ptr<const shapes::Mesh> mesh(static_cast<shapes::Mesh*>(shapes::constructShapeFromMsg(msg)));
+  if (!mesh)
+    return mesh;
+
+  std::scoped_lock slock(lock_);
+  const auto range = meshes_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    std::shared_ptr<const shapes::Mesh> known = it->second.lock();
+    if (known && meshEquals(*known, msg))
+      return known;
+  }
+  meshes_.emplace(hash, mesh);
+  if (meshes_.size() >= cleanup_size_)
+    cleanup_size_ = std::max(MIN_CLEANUP_SIZE, 2 * removeExpired());
+  return mesh;
+}
+
+std::size_t MeshCache::size() const
+{
+  std::scoped_lock slock(lock_);
+  std::size_t count = 0;
+  for (const auto& [hash, mesh] : meshes_)
+  {
+    if (!mesh.expired())
+      ++count;
+  }
+  return count;
+}
+
+std::size_t MeshCache::removeExpired()
+{
+  for (auto it = meshes_.begin(); it != meshes_.end();)
+  {
+    if (it->second.expired())
+    {
+      it = meshes_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  return meshes_.size();
+}
+}  // namespace planning_scene
@@ -36,6 +36,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <moveit/planning_scene/planning_scene.hpp>
+#include <moveit/planning_scene/mesh_cache.hpp>
 #include <moveit/collision_detection/occupancy_map.hpp>
 #include <moveit/collision_detection_fcl/collision_detector_allocator_fcl.hpp>
 #include <geometric_shapes/shape_operations.h>
@@ -61,6 +62,70 @@ rclcpp::Logger getLogger()
 {
   return moveit::getLogger("moveit.core.planning_scene");
 }
+
+shapes::ShapeConstPtr shapeFromMsg(const shape_msgs::msg::SolidPrimitive& msg)
+{
+  return shapes::ShapeConstPtr(shapes::constructShapeFromMsg(msg));
+}
+
+shapes::ShapeConstPtr shapeFromMsg(const shape_msgs::msg::Plane& msg)
+{
+  return shapes::ShapeConstPtr(shapes::constructShapeFromMsg(msg));
+}
+
+// meshes are interned, so that unchanged meshes keep the collision geometry that was built for them
+shapes::ShapeConstPtr shapeFromMsg(const shape_msgs::msg::Mesh& msg)
+{
+  return MeshCache::global().getMesh(msg);
+}
+
+bool sameShapeContent(const shapes::Shape& a, const shapes::Shape& b)
+{
+  if (a.type != b.type)
+    return false;
+  switch (a.type)
+  {
+    case shapes::SPHERE:
+      return static_cast<const shapes::Sphere&>(a).radius == static_cast<const shapes::Sphere&>(b).radius;
+    case shapes::CYLINDER:
+      return static_cast<const shapes::Cylinder&>(a).radius == static_cast<const shapes::Cylinder&>(b).radius &&
+             static_cast<const shapes::Cylinder&>(a).length == static_cast<const shapes::Cylinder&>(b).length;
+    case shapes::CONE:
+      return static_cast<const shapes::Cone&>(a).radius == static_cast<const shapes::Cone&>(b).radius &&
+             static_cast<const shapes::Cone&>(a).length == static_cast<const shapes::Cone&>(b).length;
+    case shapes::BOX:
+    {
+      const double* size_a = static_cast<const shapes::Box&>(a).size;
+      const double* size_b = static_cast<const shapes::Box&>(b).size;
+      return size_a[0] == size_b[0] && size_a[1] == size_b[1] && size_a[2] == size_b[2];
+    }
+    case shapes::PLANE:
+    {
+      const auto& plane_a = static_cast<const shapes::Plane&>(a);
+      const auto& plane_b = static_cast<const shapes::Plane&>(b);
+      return plane_a.a == plane_b.a && plane_a.b == plane_b.b && plane_a.c == plane_b.c && plane_a.d == plane_b.d;
+    }
+    default:
+      // meshes are interned, so equal meshes are the same instance
+      return false;
+  }
+}
+
+/** \brief Check whether \e object consists of the given shapes, at the given poses relative to the object */
+bool hasSameGeometry(const collision_detection::World::Object& object, const std::vector<shapes::ShapeConstPtr>& shapes,
+                     const EigenSTL::vector_Isometry3d& shape_poses)
+{
+  if (object.shapes_.size() != shapes.size())
+    return false;
+  for (std::size_t i = 0; i < shapes.size(); ++i)
+  {
+    if (object.shapes_[i] != shapes[i] && !sameShapeContent(*object.shapes_[i], *shapes[i]))
+      return false;
+    if (object.shape_poses_[i].matrix() != shape_poses[i].matrix())
+      return false;
+  }
+  return true;
+}
 }  // namespace
 
 const std::string PlanningScene::OCTOMAP_NS = "<octomap>";
@@ -382,6 +447,9 @@ void PlanningScene::pushDiffs(const PlanningScenePtr& scene)
       }
       else
       {
+        // the octree may have been updated in place through this scene
+        if (it.first == OCTOMAP_NS)
+          ++scene->octomap_update_count_;
         const collision_detection::World::Object& obj = *world_->getObject(it.first);
         scene->world_->removeObject(obj.id_);
         scene->world_->addToObject(obj.id_, obj.pose_, obj.shapes_, obj.shape_poses_);
@@ -1308,6 +1376,7 @@ void PlanningScene::decoupleParent()
         (object_types_.value())[it->first] = it->second;
     }
   }
+  octomap_update_count_ = getOctomapUpdateCount();
   parent_.reset();
 }
 
@@ -1500,6 +1569,7 @@ void PlanningScene::processOctomapMsg(const octomap_msgs::msg::OctomapWithPose&
 
 void PlanningScene::processOctomapPtr(const std::shared_ptr<const octomap::OcTree>& octree, const Eigen::Isometry3d& t)
 {
+  ++octomap_update_count_;
   collision_detection::CollisionEnv::ObjectConstPtr map = world_->getObject(OCTOMAP_NS);
   if (map)
   {
@@ -1533,6 +1603,11 @@ void PlanningScene::processOctomapPtr(const std::shared_ptr<const octomap::OcTre
   world_->addToObject(OCTOMAP_NS, std::make_shared<const shapes::OcTree>(octree), t);
 }
 
+std::size_t PlanningScene::getOctomapUpdateCount() const
+{
+  return parent_ ? parent_->getOctomapUpdateCount() + octomap_update_count_ : octomap_update_count_;
+}
+
 bool PlanningScene::processAttachedCollisionObjectMsg(const moveit_msgs::msg::AttachedCollisionObject& object)
 {
   if (object.object.operation == moveit_msgs::msg::CollisionObject::ADD &&
@@ -1834,8 +1909,8 @@ bool PlanningScene::shapesAndPosesFromCollisionObjectMessage(const moveit_msgs::
     utilities::poseMsgToEigen(object.pose, object_pose);
   }
 
-  auto append = [&object_pose, &shapes, &shape_poses,
-                 &switch_object_pose_and_shape_pose](shapes::Shape* s, const geometry_msgs::msg::Pose& pose_msg) {
+  auto append = [&object_pose, &shapes, &shape_poses, &switch_object_pose_and_shape_pose](
+                    shapes::ShapeConstPtr s, const geometry_msgs::msg::Pose& pose_msg) {
     if (!s)
       return;
     Eigen::Isometry3d pose;
@@ -1849,7 +1924,7 @@ bool PlanningScene::shapesAndPosesFromCollisionObjectMessage(const moveit_msgs::
       shape_poses.emplace_back(std::move(object_pose));
       object_pose = pose;
     }
-    shapes.emplace_back(shapes::ShapeConstPtr(s));
+    shapes.emplace_back(std::move(s));
   };
 
   auto treat_shape_vectors = [&append](const auto& shape_vector,        // the shape_msgs of each type
@@ -1864,17 +1939,17 @@ bool PlanningScene::shapesAndPosesFromCollisionObjectMessage(const moveit_msgs::
       {
         if (i >= shape_poses_vector.size())
         {
-          append(shapes::constructShapeFromMsg(shape_vector[i]),
+          append(shapeFromMsg(shape_vector[i]),
                  geometry_msgs::msg::Pose());  // Empty shape pose => Identity
         }
         else
-          append(shapes::constructShapeFromMsg(shape_vector[i]), shape_poses_vector[i]);
+          append(shapeFromMsg(shape_vector[i]), shape_poses_vector[i]);
       }
     }
     else
     {
       for (std::size_t i = 0; i < shape_vector.size(); ++i)
-        append(shapes::constructShapeFromMsg(shape_vector[i]), shape_poses_vector[i]);
+        append(shapeFromMsg(shape_vector[i]), shape_poses_vector[i]);
     }
   };
 
@@ -1898,10 +1973,6 @@ bool PlanningScene::processCollisionObjectAdd(const moveit_msgs::msg::CollisionO
     return false;
   }
 
-  // replace the object if ADD is specified instead of APPEND
-  if (object.operation == moveit_msgs::msg::CollisionObject::ADD && world_->hasObject(object.id))
-    world_->removeObject(object.id);
-
   const Eigen::Isometry3d& world_to_object_header_transform = getFrameTransform(object.header.frame_id);
   Eigen::Isometry3d header_to_pose_transform;
   std::vector<shapes::ShapeConstPtr> shapes;
@@ -1910,7 +1981,19 @@ bool PlanningScene::processCollisionObjectAdd(const moveit_msgs::msg::CollisionO
     return false;
   const Eigen::Isometry3d object_frame_transform = world_to_object_header_transform * header_to_pose_transform;
 
-  world_->addToObject(object.id, object_frame_transform, shapes, shape_poses);
+  // replace the object if ADD is specified instead of APPEND; if its geometry did not change, only move it
+  const collision_detection::World::ObjectConstPtr existing =
+      object.operation == moveit_msgs::msg::CollisionObject::ADD ? world_->getObject(object.id) : nullptr;
+  if (existing && hasSameGeometry(*existing, shapes, shape_poses))
+  {
+    world_->setObjectPose(object.id, object_frame_transform);
+  }
+  else
+  {
+    if (existing)
+      world_->removeObject(object.id);
+    world_->addToObject(object.id, object_frame_transform, shapes, shape_poses);
+  }
 
   if (!object.type.key.empty() || !object.type.db.empty())
     setObjectType(object.id, object.type);
@@ -0,0 +1,384 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <moveit/planning_scene/planning_scene_delta_encoder.hpp>
+#include <moveit/robot_state/attached_body.hpp>
+#include <moveit/robot_state/conversions.hpp>
+#include <geometric_shapes/shapes.h>
+#include <tf2_eigen/tf2_eigen.hpp>
+#include <string_view>
+
+namespace planning_scene
+{
+namespace
+{
+void hashCombine(std::size_t& hash, std::size_t value)
+{
+  hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+}
+
+std::size_t hashBytes(const void* data, std::size_t size)
+{
+  return std::hash<std::string_view>()(std::string_view(static_cast<const char*>(data), size));
+}
+
+std::size_t hashTransform(const Eigen::Isometry3d& transform)
+{
+  return hashBytes(transform.matrix().data(), sizeof(double) * 16);
+}
+
+std::size_t hashShapeContent(const shapes::Shape& shape)
+{
+  std::size_t hash = std::hash<int>()(shape.type);
+  switch (shape.type)
+  {
+    case shapes::MESH:
+    {
+      const auto& mesh = static_cast<const shapes::Mesh&>(shape);
+      hashCombine(hash, hashBytes(mesh.vertices, sizeof(double) * 3 * mesh.vertex_count));
+      hashCombine(hash, hashBytes(mesh.triangles, sizeof(unsigned int) * 3 * mesh.triangle_count));
+      break;
+    }
+    case shapes::SPHERE:
+      hashCombine(hash, std::hash<double>()(static_cast<const shapes::Sphere&>(shape).radius));
+      break;
+    case shapes::CYLINDER:
+      hashCombine(hash, std::hash<double>()(static_cast<const shapes::Cylinder&>(shape).radius));
+      hashCombine(hash, std::hash<double>()(static_cast<const shapes::Cylinder&>(shape).length));
+      break;
+    case shapes::CONE:
+      hashCombine(hash, std::hash<double>()(static_cast<const shapes::Cone&>(shape).radius));
+      hashCombine(hash, std::hash<double>()(static_cast<const shapes::Cone&>(shape).length));
+      break;
+    case shapes::BOX:
+      hashCombine(hash, hashBytes(static_cast<const shapes::Box&>(shape).size, sizeof(double) * 3));
+      break;
+    case shapes::PLANE:
+    {
+      const auto& plane = static_cast<const shapes::Plane&>(shape);
+      for (double coefficient : { plane.a, plane.b, plane.c, plane.d })
+        hashCombine(hash, std::hash<double>()(coefficient));
+      break;
+    }
+    default:
+      // shapes that cannot be compared by content (e.g. octrees, which are updated in place) are never equal
+      hashCombine(hash, std::hash<const void*>()(&shape));
+      break;
+  }
+  return hash;
+}
+}  // namespace
+
+PlanningSceneDeltaEncoder::PlanningSceneDeltaEncoder() : version_(0)
+{
+}
+
+void PlanningSceneDeltaEncoder::reset()
+{
+  version_ = 0;
+  world_objects_.clear();
+  attached_objects_.reset();
+  octomap_.reset();
+  sent_meshes_.clear();
+  shape_hashes_.clear();
+}
+
+void PlanningSceneDeltaEncoder::getPlanningSceneMsg(const PlanningScene& scene,
+                                                    const moveit_msgs::msg::PlanningSceneComponents& comp,
+                                                    moveit_msgs::msg::PlanningScene& scene_msg)
+{
+  encode(scene, comp, scene_msg, nullptr);
+}
+
+void PlanningSceneDeltaEncoder::getPlanningSceneMsg(const PlanningScene& scene,
+                                                    const moveit_msgs::msg::PlanningSceneComponents& comp,
+                                                    moveit_msgs::msg::PlanningScene& scene_msg, MeshTable& mesh_table)
+{
+  mesh_table = MeshTable();
+  encode(scene, comp, scene_msg, &mesh_table);
+}
+
+bool PlanningSceneDeltaEncoder::restoreMeshes(const MeshTable& mesh_table,
+                                              std::map<std::size_t, shape_msgs::msg::Mesh>& client_meshes,
+                                              moveit_msgs::msg::PlanningScene& scene_msg)
+{
+  if (!scene_msg.is_diff)
+    client_meshes.clear();
+  client_meshes.insert(mesh_table.meshes.begin(), mesh_table.meshes.end());
+
+  for (moveit_msgs::msg::CollisionObject& object : scene_msg.world.collision_objects)
+  {
+    const auto object_meshes = mesh_table.object_meshes.find(object.id);
+    if (object_meshes == mesh_table.object_meshes.end())
+      continue;
+    if (object_meshes->second.size() != object.meshes.size())
+      return false;
+    for (std::size_t i = 0; i < object.meshes.size(); ++i)
+    {
+      const auto mesh = client_meshes.find(object_meshes->second[i]);
+      if (mesh == client_meshes.end())
+        return false;
+      object.meshes[i] = mesh->second;
+    }
+  }
+  return true;
+}
+
+void PlanningSceneDeltaEncoder::encode(const PlanningScene& scene,
+                                       const moveit_msgs::msg::PlanningSceneComponents& comp,
+                                       moveit_msgs::msg::PlanningScene& scene_msg, MeshTable* mesh_table)
+{
+  using moveit_msgs::msg::PlanningSceneComponents;
+  const bool full = version_ == 0;
+  // a complete scene starts a new mesh table on the client
+  if (full)
+    sent_meshes_.clear();
+
+  // the small components are always sent in full; the robot state is sent without its attached objects here
+  PlanningSceneComponents other_comp;
+  other_comp.components = comp.components & ~(PlanningSceneComponents::WORLD_OBJECT_GEOMETRY |
+                                               PlanningSceneComponents::OCTOMAP |
+                                               PlanningSceneComponents::ROBOT_STATE_ATTACHED_OBJECTS);
+  if (comp.components & PlanningSceneComponents::ROBOT_STATE_ATTACHED_OBJECTS)
+    other_comp.components |= PlanningSceneComponents::ROBOT_STATE;
+  if (comp.components & PlanningSceneComponents::WORLD_OBJECT_GEOMETRY)
+    other_comp.components &= ~PlanningSceneComponents::WORLD_OBJECT_NAMES;
+
+  scene_msg = moveit_msgs::msg::PlanningScene();
+  scene.getPlanningSceneMsg(scene_msg, other_comp);
+  scene_msg.is_diff = !full;
+  // in a diff, a robot state that is not a diff would drop the attached objects the client already has
+  scene_msg.robot_state.is_diff = !full;
+
+  const bool attached_objects_encoded =
+      (comp.components & PlanningSceneComponents::ROBOT_STATE_ATTACHED_OBJECTS) != 0;
+  if (attached_objects_encoded)
+    encodeAttachedObjects(scene, full, scene_msg);
+  if (comp.components & PlanningSceneComponents::WORLD_OBJECT_GEOMETRY)
+    encodeWorldObjects(scene, full, attached_objects_encoded, scene_msg, mesh_table);
+  if (comp.components & PlanningSceneComponents::OCTOMAP)
+    encodeOctomap(scene, full, scene_msg);
+
+  ++version_;
+}
+
+void PlanningSceneDeltaEncoder::encodeWorldObjects(const PlanningScene& scene, bool full, bool attached_objects_encoded,
+                                                   moveit_msgs::msg::PlanningScene& scene_msg, MeshTable* mesh_table)
+{
+  const collision_detection::WorldConstPtr& world = scene.getWorld();
+  std::map<std::string, WorldObjectRecord> objects;
+  for (const std::string& id : world->getObjectIds())
+  {
+    if (id == PlanningScene::OCTOMAP_NS)
+      continue;
+    const collision_detection::World::ObjectConstPtr object = world->getObject(id);
+
+    std::size_t geometry_hash = getObjectTypeHash(scene, id);
+    for (std::size_t i = 0; i < object->shapes_.size(); ++i)
+    {
+      hashCombine(geometry_hash, getShapeHash(object->shapes_[i]));
+      hashCombine(geometry_hash, hashTransform(object->shape_poses_[i]));
+    }
+    for (const auto& [name, pose] : object->subframe_poses_)
+    {
+      hashCombine(geometry_hash, std::hash<std::string>()(name));
+      hashCombine(geometry_hash, hashTransform(pose));
+    }
+
+    const auto known = world_objects_.find(id);
+    if (full || known == world_objects_.end() || known->second.geometry_hash != geometry_hash)
+    {
+      moveit_msgs::msg::CollisionObject& object_msg = scene_msg.world.collision_objects.emplace_back();
+      scene.getCollisionObjectMsg(object_msg, id);
+      if (mesh_table)
+        moveMeshesToTable(*object, object_msg, *mesh_table);
+    }
+    else if (known->second.pose.matrix() != object->pose_.matrix())
+    {
+      moveit_msgs::msg::CollisionObject& move = scene_msg.world.collision_objects.emplace_back();
+      move.header.frame_id = scene.getPlanningFrame();
+      move.id = id;
+      move.pose = tf2::toMsg(object->pose_);
+      move.operation = moveit_msgs::msg::CollisionObject::MOVE;
+    }
+    objects.emplace(id, WorldObjectRecord{ geometry_hash, object->pose_ });
+  }
+
+  if (!full)
+  {
+    for (const auto& [id, record] : world_objects_)
+    {
+      // objects that were attached leave the world of the client when the attached objects are applied
+      if (objects.count(id) || (attached_objects_encoded && scene.getCurrentState().hasAttachedBody(id)))
+        continue;
+      moveit_msgs::msg::CollisionObject& remove = scene_msg.world.collision_objects.emplace_back();
+      remove.header.frame_id = scene.getPlanningFrame();
+      remove.id = id;
+      remove.operation = moveit_msgs::msg::CollisionObject::REMOVE;
+    }
+  }
+  world_objects_ = std::move(objects);
+}
+
+void PlanningSceneDeltaEncoder::moveMeshesToTable(const collision_detection::World::Object& object,
+                                                  moveit_msgs::msg::CollisionObject& object_msg, MeshTable& mesh_table)
+{
+  // the message lists the meshes in the order of the shapes of the object
+  std::vector<std::size_t> mesh_hashes;
+  for (const shapes::ShapeConstPtr& shape : object.shapes_)
+  {
+    if (shape->type == shapes::MESH)
+      mesh_hashes.push_back(getShapeHash(shape));
+  }
+  if (mesh_hashes.empty() || mesh_hashes.size() != object_msg.meshes.size())
+    return;
+
+  for (std::size_t i = 0; i < mesh_hashes.size(); ++i)
+  {
+    if (sent_meshes_.insert(mesh_hashes[i]).second)
+      mesh_table.meshes.emplace(mesh_hashes[i], std::move(object_msg.meshes[i]));
+    object_msg.meshes[i] = shape_msgs::msg::Mesh();
+  }
+  mesh_table.object_meshes.emplace(object_msg.id, std::move(mesh_hashes));
+}
+
+void PlanningSceneDeltaEncoder::encodeAttachedObjects(const PlanningScene& scene, bool full,
+                                                      moveit_msgs::msg::PlanningScene& scene_msg)
+{
+  std::vector<const moveit::core::AttachedBody*> bodies;
+  scene.getCurrentState().getAttachedBodies(bodies);
+  std::map<std::string, std::size_t> attached_objects;
+  for (const moveit::core::AttachedBody* body : bodies)
+  {
+    std::size_t hash = getObjectTypeHash(scene, body->getName());
+    hashCombine(hash, std::hash<std::string>()(body->getAttachedLinkName()));
+    hashCombine(hash, hashTransform(body->getPose()));
+    for (std::size_t i = 0; i < body->getShapes().size(); ++i)
+    {
+      hashCombine(hash, getShapeHash(body->getShapes()[i]));
+      hashCombine(hash, hashTransform(body->getShapePoses()[i]));
+    }
+    for (const std::string& touch_link : body->getTouchLinks())
+      hashCombine(hash, std::hash<std::string>()(touch_link));
+    for (const auto& [name, pose] : body->getSubframes())
+    {
+      hashCombine(hash, std::hash<std::string>()(name));
+      hashCombine(hash, hashTransform(pose));
+    }
+    attached_objects.emplace(body->getName(), hash);
+  }
+
+  // attached objects cannot be updated individually, so any change resends all of them with the full robot state
+  if (full || !attached_objects_ || *attached_objects_ != attached_objects)
+  {
+    moveit::core::robotStateToRobotStateMsg(scene.getCurrentState(), scene_msg.robot_state, true);
+    for (moveit_msgs::msg::AttachedCollisionObject& attached_collision_object :
+         scene_msg.robot_state.attached_collision_objects)
+    {
+      if (scene.hasObjectType(attached_collision_object.object.id))
+        attached_collision_object.object.type = scene.getObjectType(attached_collision_object.object.id);
+    }
+  }
+  attached_objects_ = std::move(attached_objects);
+}
+
+void PlanningSceneDeltaEncoder::encodeOctomap(const PlanningScene& scene, bool full,
+                                              moveit_msgs::msg::PlanningScene& scene_msg)
+{
+  const collision_detection::World::ObjectConstPtr map = scene.getWorld()->getObject(PlanningScene::OCTOMAP_NS);
+  const shapes::ShapeConstPtr shape = map && map->shapes_.size() == 1 ? map->shapes_[0] : nullptr;
+  const Eigen::Isometry3d pose = shape ? map->shape_poses_[0] : Eigen::Isometry3d::Identity();
+  const std::size_t update_count = scene.getOctomapUpdateCount();
+
+  // the octree is only serialized if it was replaced, moved or updated in place since the previous message
+  if (!full && octomap_ && octomap_->present == (shape != nullptr) && octomap_->shape.lock() == shape &&
+      octomap_->pose.matrix() == pose.matrix() && octomap_->update_count == update_count)
+    return;
+
+  octomap_msgs::msg::OctomapWithPose octomap;
+  scene.getOctomapMsg(octomap);
+
+  std::size_t hash = std::hash<std::string>()(octomap.octomap.id);
+  hashCombine(hash, std::hash<double>()(octomap.octomap.resolution));
+  hashCombine(hash, hashBytes(octomap.octomap.data.data(), octomap.octomap.data.size()));
+  for (double value : { octomap.origin.position.x, octomap.origin.position.y, octomap.origin.position.z,
+                        octomap.origin.orientation.x, octomap.origin.orientation.y, octomap.origin.orientation.z,
+                        octomap.origin.orientation.w })
+    hashCombine(hash, std::hash<double>()(value));
+
+  if (full || !octomap_ || octomap_->hash != hash)
+  {
+    scene_msg.world.octomap = std::move(octomap);
+    // an octomap message without data removes the octomap of the client, but only if its id is set
+    if (!full && scene_msg.world.octomap.octomap.id.empty())
+      scene_msg.world.octomap.octomap.id = "OcTree";
+  }
+  octomap_ = OctomapRecord{ shape != nullptr, shape, pose, update_count, hash };
+}
+
+std::size_t PlanningSceneDeltaEncoder::getShapeHash(const shapes::ShapeConstPtr& shape)
+{
+  auto it = shape_hashes_.find(shape.get());
+  if (it != shape_hashes_.end() && it->second.first.lock() == shape)
+    return it->second.second;
+
+  // drop the hashes of freed shapes once they make up the larger part of the cache
+  if (shape_hashes_.size() > 64 && it == shape_hashes_.end())
+  {
+    std::size_t expired = 0;
+    for (const auto& entry : shape_hashes_)
+      expired += entry.second.first.expired();
+    if (2 * expired > shape_hashes_.size())
+    {
+      for (auto entry = shape_hashes_.begin(); entry != shape_hashes_.end();)
+        entry = entry->second.first.expired() ? shape_hashes_.erase(entry) : std::next(entry);
+    }
+  }
+
+  const std::size_t hash = hashShapeContent(*shape);
+  shape_hashes_[shape.get()] = { shape, hash };
+  return hash;
+}
+
+std::size_t PlanningSceneDeltaEncoder::getObjectTypeHash(const PlanningScene& scene, const std::string& id) const
+{
+  if (!scene.hasObjectType(id))
+    return 0;
+  const object_recognition_msgs::msg::ObjectType& type = scene.getObjectType(id);
+  std::size_t hash = std::hash<std::string>()(type.key);
+  hashCombine(hash, std::hash<std::string>()(type.db));
+  return hash;
+}
+}  // namespace planning_scene
@@ -0,0 +1,146 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <moveit/planning_scene/state_validity_batch.hpp>
+#include <moveit/utils/parallel_for.hpp>
+#include <limits>
+
+namespace planning_scene
+{
+namespace
+{
+// check the states returned by get_state(i) for i < count; every thread copies the states it checks into its own
+// RobotState, so the inputs are never updated concurrently
+template <typename GetState>
+std::vector<StateValidityResult> checkInParallel(const PlanningScene& scene, std::size_t count,
+                                                 const GetState& get_state,
+                                                 const kinematic_constraints::KinematicConstraintSet* constraints,
+                                                 const StateValidityOptions& options)
+{
+  std::vector<StateValidityResult> results(count);
+  std::vector<std::optional<moveit::core::RobotState>> states(moveit::parallelThreadCount(count, options.threads));
+  moveit::parallelFor(count, options.threads, [&](std::size_t i, std::size_t worker) {
+    std::optional<moveit::core::RobotState>& state = states[worker];
+    if (state)
+      *state = get_state(i);
+    else
+      state.emplace(get_state(i));
+    results[i] = checkStateValidity(scene, *state, constraints, options);
+  });
+  return results;
+}
+}  // namespace
+
+StateValidityResult checkStateValidity(const PlanningScene& scene, moveit::core::RobotState& state,
+                                       const kinematic_constraints::KinematicConstraintSet* constraints,
+                                       const StateValidityOptions& options)
+{
+  StateValidityResult result;
+  state.update();
+
+  const moveit::core::JointModelGroup* jmg =
+      options.group.empty() ? nullptr : scene.getRobotModel()->getJointModelGroup(options.group);
+  result.satisfies_bounds = jmg ? state.satisfiesBounds(jmg) : state.satisfiesBounds();
+
+  collision_detection::CollisionRequest creq;
+  creq.group_name = options.group;
+  if (options.compute_contacts)
+  {
+    // same limits as the state validation service of move_group
+    creq.cost = true;
+    creq.contacts = true;
+    creq.max_contacts =
+        scene.getWorld()->size() + scene.getRobotModel()->getLinkModelsWithCollisionGeometry().size();
+    creq.max_cost_sources = creq.max_contacts;
+    creq.max_contacts *= creq.max_contacts;
+  }
+  scene.checkCollision(creq, result.collision, state);
+
+  result.feasible = scene.isStateFeasible(state);
+  if (constraints)
+    result.constraints = constraints->decide(state, result.constraint_results);
+  else
+    result.constraints.satisfied = true;
+
+  if (options.compute_clearance && !result.collision.collision)
+  {
+    collision_detection::DistanceRequest dreq;
+    dreq.group_name = options.group;
+    dreq.enableGroup(scene.getRobotModel());
+    dreq.acm = &scene.getAllowedCollisionMatrix();
+    dreq.enable_nearest_points = true;
+    collision_detection::DistanceResult dres;
+    scene.getCollisionEnv()->distanceRobot(dreq, dres, state);
+    // the minimum distance keeps its initial value of DBL_MAX when no pair of bodies was checked
+    if (dres.minimum_distance.distance < std::numeric_limits<double>::max())
+    {
+      result.clearance = dres.minimum_distance.distance;
+      result.nearest_bodies = dres.minimum_distance;
+    }
+    else
+    {
+      result.clearance = std::numeric_limits<double>::infinity();
+    }
+  }
+
+  result.valid =
+      result.satisfies_bounds && !result.collision.collision && result.feasible && result.constraints.satisfied;
+  return result;
+}
+
+std::vector<StateValidityResult> checkStatesValidity(const PlanningScene& scene,
+                                                     const std::vector<moveit::core::RobotState>& states,
+                                                     const kinematic_constraints::KinematicConstraintSet* constraints,
+                                                     const StateValidityOptions& options)
+{
+  return checkInParallel(
+      scene, states.size(), [&states](std::size_t i) -> const moveit::core::RobotState& { return states[i]; },
+      constraints, options);
+}
+
+std::vector<StateValidityResult>
+checkTrajectoryValidity(const PlanningScene& scene, const robot_trajectory::RobotTrajectory& trajectory,
+                        const kinematic_constraints::KinematicConstraintSet* constraints,
+                        const StateValidityOptions& options)
+{
+  StateValidityOptions trajectory_options = options;
+  if (trajectory_options.group.empty())
+    trajectory_options.group = trajectory.getGroupName();
+  return checkInParallel(
+      scene, trajectory.getWayPointCount(),
+      [&trajectory](std::size_t i) -> const moveit::core::RobotState& { return trajectory.getWayPoint(i); },
+      constraints, trajectory_options);
+}
+}  // namespace planning_scene
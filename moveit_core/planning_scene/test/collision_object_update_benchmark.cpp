@@ -0,0 +1,124 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Measures how fast collision object updates are applied to a planning scene when perception republishes the same
+// meshes at new poses, compared to updates that change the meshes.
+// To run this benchmark, 'cd' to the build/moveit_core/planning_scene directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/planning_scene/planning_scene.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <cmath>
+
+namespace
+{
+constexpr int OBJECT_COUNT = 10;
+
+// an open tube around the z axis with the given number of segments, two triangles each
+shape_msgs::msg::Mesh makeTube(int segments, double radius)
+{
+  shape_msgs::msg::Mesh mesh;
+  for (int i = 0; i < segments; ++i)
+  {
+    const double angle = 2.0 * M_PI * i / segments;
+    for (double z : { 0.0, 0.2 })
+    {
+      geometry_msgs::msg::Point& p = mesh.vertices.emplace_back();
+      p.x = radius * std::cos(angle);
+      p.y = radius * std::sin(angle);
+      p.z = z;
+    }
+  }
+  for (int i = 0; i < segments; ++i)
+  {
+    const uint32_t a = 2 * i, b = 2 * i + 1, c = 2 * ((i + 1) % segments), d = c + 1;
+    mesh.triangles.emplace_back().vertex_indices = { a, c, b };
+    mesh.triangles.emplace_back().vertex_indices = { b, c, d };
+  }
+  return mesh;
+}
+
+moveit_msgs::msg::PlanningScene makeUpdate(const shape_msgs::msg::Mesh& mesh, double offset)
+{
+  moveit_msgs::msg::PlanningScene msg;
+  msg.is_diff = true;
+  for (int i = 0; i < OBJECT_COUNT; ++i)
+  {
+    moveit_msgs::msg::CollisionObject& co = msg.world.collision_objects.emplace_back();
+    co.header.frame_id = "base_footprint";
+    co.id = "object" + std::to_string(i);
+    co.operation = moveit_msgs::msg::CollisionObject::ADD;
+    co.meshes.push_back(mesh);
+    co.mesh_poses.emplace_back().orientation.w = 1.0;
+    co.pose.position.x = 2.0 + offset;
+    co.pose.position.y = 0.5 * i;
+    co.pose.orientation.w = 1.0;
+  }
+  return msg;
+}
+
+void applyUpdates(benchmark::State& st, bool change_meshes)
+{
+  auto scene = std::make_shared<planning_scene::PlanningScene>(moveit::core::loadTestingRobotModel("pr2"));
+  shape_msgs::msg::Mesh mesh = makeTube(st.range(0), 0.1);
+  collision_detection::CollisionRequest req;
+  int cycle = 0;
+  for (auto _ : st)
+  {
+    if (change_meshes)
+      mesh.vertices[0].z = 1e-6 * cycle;
+    scene->usePlanningSceneMsg(makeUpdate(mesh, 0.01 * (cycle++ % 100)));
+    collision_detection::CollisionResult res;
+    scene->checkCollision(req, res);
+    benchmark::DoNotOptimize(res.collision);
+  }
+  st.SetItemsProcessed(st.iterations() * OBJECT_COUNT);
+}
+}  // namespace
+
+// Benchmark updates that re-send unchanged meshes at new poses, for meshes with the number of segments given by the
+// range argument.
+static void updateObjectPoses(benchmark::State& st)
+{
+  applyUpdates(st, false);
+}
+
+// Benchmark updates where the meshes change every time.
+static void updateObjectMeshes(benchmark::State& st)
+{
+  applyUpdates(st, true);
+}
+
+BENCHMARK(updateObjectPoses)->RangeMultiplier(8)->Range(16, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(updateObjectMeshes)->RangeMultiplier(8)->Range(16, 4096)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,87 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Measures the cost of a PlanningScene::diff() cycle: diff the scene, move one world object and check collisions.
+// To run this benchmark, 'cd' to the build/moveit_core/planning_scene directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/planning_scene/planning_scene.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <geometric_shapes/shapes.h>
+
+namespace
+{
+planning_scene::PlanningScenePtr makeScene(int object_count)
+{
+  auto scene = std::make_shared<planning_scene::PlanningScene>(moveit::core::loadTestingRobotModel("pr2"));
+  for (int i = 0; i < object_count; ++i)
+  {
+    // a grid of small boxes well clear of the robot
+    const Eigen::Isometry3d pose(Eigen::Translation3d(2.0 + 0.2 * (i % 32), -3.0 + 0.2 * (i / 32), 0.5));
+    scene->getWorldNonConst()->addToObject("box" + std::to_string(i), pose,
+                                           std::make_shared<const shapes::Box>(0.1, 0.1, 0.1),
+                                           Eigen::Isometry3d::Identity());
+  }
+  return scene;
+}
+}  // namespace
+
+// Benchmark diff() alone for the number of world objects given by the range argument.
+static void planningSceneDiff(benchmark::State& st)
+{
+  const planning_scene::PlanningScenePtr scene = makeScene(st.range(0));
+  for (auto _ : st)
+    benchmark::DoNotOptimize(scene->diff());
+}
+
+// Benchmark diff() followed by moving a single object and a collision check of the current state.
+static void planningSceneDiffModifyCheck(benchmark::State& st)
+{
+  const planning_scene::PlanningScenePtr scene = makeScene(st.range(0));
+  const moveit::core::RobotState& state = scene->getCurrentState();
+  collision_detection::CollisionRequest req;
+  int i = 0;
+  for (auto _ : st)
+  {
+    const planning_scene::PlanningScenePtr diff = scene->diff();
+    const std::string id = "box" + std::to_string(i++ % st.range(0));
+    diff->getWorldNonConst()->setObjectPose(id, Eigen::Isometry3d(Eigen::Translation3d(0.6, 0.0, 0.8)));
+    collision_detection::CollisionResult res;
+    diff->checkCollision(req, res, state);
+    benchmark::DoNotOptimize(res.collision);
+  }
+}
+
+BENCHMARK(planningSceneDiff)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK(planningSceneDiffModifyCheck)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,101 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Measures the throughput of checkStatesValidity() for random PR2 right arm states, with and without clearance.
+// To run this benchmark, 'cd' to the build/moveit_core/planning_scene directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/planning_scene/state_validity_batch.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <geometric_shapes/shapes.h>
+#include <random_numbers/random_numbers.h>
+
+namespace
+{
+constexpr std::size_t STATE_COUNT = 1000;
+
+struct Pr2Scene
+{
+  Pr2Scene()
+  {
+    scene = std::make_shared<planning_scene::PlanningScene>(moveit::core::loadTestingRobotModel("pr2"));
+    for (int i = 0; i < 4; ++i)
+    {
+      scene->getWorldNonConst()->addToObject(
+          "box" + std::to_string(i), Eigen::Isometry3d(Eigen::Translation3d(0.5 + 0.2 * i, -0.4 + 0.2 * i, 0.8)),
+          std::make_shared<const shapes::Box>(0.1, 0.1, 0.1), Eigen::Isometry3d::Identity());
+    }
+
+    const moveit::core::JointModelGroup* jmg = scene->getRobotModel()->getJointModelGroup("right_arm");
+    random_numbers::RandomNumberGenerator rng(42);
+    states.assign(STATE_COUNT, scene->getCurrentState());
+    for (moveit::core::RobotState& state : states)
+    {
+      state.setToRandomPositions(jmg, rng);
+      state.update();
+    }
+  }
+
+  planning_scene::PlanningScenePtr scene;
+  std::vector<moveit::core::RobotState> states;
+};
+
+void checkStates(benchmark::State& st, bool compute_clearance)
+{
+  Pr2Scene pr2;
+  planning_scene::StateValidityOptions options;
+  options.group = "right_arm";
+  options.compute_clearance = compute_clearance;
+  options.threads = st.range(0);
+  for (auto _ : st)
+    benchmark::DoNotOptimize(planning_scene::checkStatesValidity(*pr2.scene, pr2.states, nullptr, options));
+  st.SetItemsProcessed(st.iterations() * STATE_COUNT);
+}
+}  // namespace
+
+// Benchmark collision, bounds and feasibility checks with the number of threads given by the range argument.
+static void checkStatesValidity(benchmark::State& st)
+{
+  checkStates(st, false);
+}
+
+// Benchmark the same checks with the clearance of every collision-free state.
+static void checkStatesValidityWithClearance(benchmark::State& st)
+{
+  checkStates(st, true);
+}
+
+BENCHMARK(checkStatesValidity)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond);
+BENCHMARK(checkStatesValidityWithClearance)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond);
@@ -40,6 +40,7 @@
 #include <moveit/utils/message_checks.hpp>
 #include <moveit/utils/robot_model_test_utils.hpp>
 #include <urdf_parser/urdf_parser.h>
+#include <array>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -664,6 +665,61 @@ TEST(PlanningScene, UpdateACMAfterObjectRemoval)
   EXPECT_FALSE(ps->getAllowedCollisionMatrix().hasEntry(object_name));
 }
 
+TEST(PlanningScene, ResendIdenticalMesh)
+{
+  auto robot_model = moveit::core::loadTestingRobotModel("panda");
+  auto ps = std::make_shared<planning_scene::PlanningScene>(robot_model);
+
+  shape_msgs::msg::Mesh mesh;
+  const std::vector<std::array<double, 3>> vertices = { { 0, 0, 0 }, { 0.1, 0, 0 }, { 0, 0.1, 0 }, { 0, 0, 0.1 } };
+  for (const auto& [x, y, z] : vertices)
+  {
+    geometry_msgs::msg::Point& p = mesh.vertices.emplace_back();
+    p.x = x;
+    p.y = y;
+    p.z = z;
+  }
+  for (const auto& indices : std::vector<std::array<uint32_t, 3>>{ { 0, 1, 2 }, { 0, 1, 3 }, { 0, 2, 3 }, { 1, 2, 3 } })
+    mesh.triangles.emplace_back().vertex_indices = indices;
+
+  auto make_object = [&mesh](const std::string& id, double x) {
+    moveit_msgs::msg::CollisionObject co;
+    co.header.frame_id = "panda_link0";
+    co.id = id;
+    co.operation = moveit_msgs::msg::CollisionObject::ADD;
+    co.meshes.push_back(mesh);
+    co.mesh_poses.emplace_back().orientation.w = 1.0;
+    co.pose.position.x = x;
+    co.pose.orientation.w = 1.0;
+    return co;
+  };
+
+  // objects with identical meshes share the shape instance
+  EXPECT_TRUE(ps->processCollisionObjectMsg(make_object("a", 2.0)));
+  EXPECT_TRUE(ps->processCollisionObjectMsg(make_object("b", 3.0)));
+  const shapes::ShapeConstPtr shape = ps->getWorld()->getObject("a")->shapes_[0];
+  EXPECT_EQ(shape, ps->getWorld()->getObject("b")->shapes_[0]);
+
+  // re-adding the object with the same mesh only moves it
+  const collision_detection::World::ObjectConstPtr before = ps->getWorld()->getObject("a");
+  EXPECT_TRUE(ps->processCollisionObjectMsg(make_object("a", 4.0)));
+  const collision_detection::World::ObjectConstPtr after = ps->getWorld()->getObject("a");
+  EXPECT_EQ(shape, after->shapes_[0]);
+  EXPECT_EQ(4.0, after->pose_.translation().x());
+  EXPECT_EQ(2.0, before->pose_.translation().x());
+
+  collision_detection::CollisionResult res;
+  ps->checkCollision(collision_detection::CollisionRequest(), res);
+  EXPECT_FALSE(res.collision);
+
+  // a changed mesh replaces the shape
+  mesh.vertices[3].z = 0.2;
+  EXPECT_TRUE(ps->processCollisionObjectMsg(make_object("a", 4.0)));
+  EXPECT_NE(shape, ps->getWorld()->getObject("a")->shapes_[0]);
+  const auto changed = std::static_pointer_cast<const shapes::Mesh>(ps->getWorld()->getObject("a")->shapes_[0]);
+  EXPECT_EQ(0.2, changed->vertices[11]);
+}
+
 #ifndef INSTANTIATE_TEST_SUITE_P  // prior to gtest 1.10
 #define INSTANTIATE_TEST_SUITE_P(...) INSTANTIATE_TEST_CASE_P(__VA_ARGS__)
 #endif
@@ -0,0 +1,347 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <moveit/planning_scene/planning_scene_delta_encoder.hpp>
+#include <moveit/robot_state/attached_body.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <geometric_shapes/shapes.h>
+#include <octomap/OcTree.h>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+namespace
+{
+constexpr std::size_t OBJECT_COUNT = 10;
+
+shapes::ShapeConstPtr makeMesh(double scale)
+{
+  // a triangle strip with enough vertices that resending it shows up in the message size
+  const unsigned int vertex_count = 2000;
+  auto mesh = std::make_shared<shapes::Mesh>(vertex_count, vertex_count - 2);
+  for (unsigned int i = 0; i < vertex_count; ++i)
+  {
+    mesh->vertices[3 * i] = scale * 1e-3 * i;
+    mesh->vertices[3 * i + 1] = scale * (i % 2);
+    mesh->vertices[3 * i + 2] = 0.0;
+  }
+  for (unsigned int i = 0; i + 2 < vertex_count; ++i)
+  {
+    mesh->triangles[3 * i] = i;
+    mesh->triangles[3 * i + 1] = i + 1;
+    mesh->triangles[3 * i + 2] = i + 2;
+  }
+  return mesh;
+}
+
+template <typename MessageT>
+std::size_t serializedSize(const MessageT& msg)
+{
+  rclcpp::Serialization<MessageT> serialization;
+  rclcpp::SerializedMessage serialized;
+  serialization.serialize_message(&msg, &serialized);
+  return serialized.size();
+}
+
+std::size_t serializedSize(const planning_scene::PlanningSceneDeltaEncoder::MeshTable& mesh_table)
+{
+  // as sent by the get_planning_scene_delta service: a 64 bit hash per mesh and per mesh reference
+  std::size_t size = 0;
+  for (const auto& [hash, mesh] : mesh_table.meshes)
+    size += sizeof(uint64_t) + serializedSize(mesh);
+  for (const auto& [id, mesh_hashes] : mesh_table.object_meshes)
+    size += id.size() + sizeof(uint64_t) * mesh_hashes.size();
+  return size;
+}
+
+void expectSameWorld(const planning_scene::PlanningScene& expected, const planning_scene::PlanningScene& actual)
+{
+  EXPECT_EQ(expected.getWorld()->getObjectIds().size(), actual.getWorld()->getObjectIds().size());
+  for (const std::string& id : expected.getWorld()->getObjectIds())
+  {
+    ASSERT_TRUE(actual.getWorld()->hasObject(id)) << id;
+    const auto expected_object = expected.getWorld()->getObject(id);
+    const auto actual_object = actual.getWorld()->getObject(id);
+    EXPECT_TRUE(expected_object->pose_.isApprox(actual_object->pose_, 1e-9)) << id;
+    ASSERT_EQ(expected_object->shapes_.size(), actual_object->shapes_.size()) << id;
+    for (std::size_t i = 0; i < expected_object->shapes_.size(); ++i)
+    {
+      ASSERT_EQ(expected_object->shapes_[i]->type, shapes::MESH);
+      const auto& expected_mesh = static_cast<const shapes::Mesh&>(*expected_object->shapes_[i]);
+      const auto& actual_mesh = static_cast<const shapes::Mesh&>(*actual_object->shapes_[i]);
+      EXPECT_EQ(expected_mesh.vertex_count, actual_mesh.vertex_count) << id;
+      EXPECT_EQ(expected_mesh.triangle_count, actual_mesh.triangle_count) << id;
+    }
+  }
+  std::vector<const moveit::core::AttachedBody*> expected_bodies;
+  expected.getCurrentState().getAttachedBodies(expected_bodies);
+  std::vector<const moveit::core::AttachedBody*> actual_bodies;
+  actual.getCurrentState().getAttachedBodies(actual_bodies);
+  EXPECT_EQ(expected_bodies.size(), actual_bodies.size());
+  for (const moveit::core::AttachedBody* body : expected_bodies)
+    EXPECT_TRUE(actual.getCurrentState().hasAttachedBody(body->getName())) << body->getName();
+}
+}  // namespace
+
+class PlanningSceneDeltaEncoderTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    const moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel("pr2");
+    server_ = std::make_shared<planning_scene::PlanningScene>(robot_model);
+    client_ = std::make_shared<planning_scene::PlanningScene>(robot_model);
+
+    for (std::size_t i = 0; i < OBJECT_COUNT; ++i)
+    {
+      Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+      pose.translation() = Eigen::Vector3d(1.0 + 0.1 * i, 0.0, 0.5);
+      server_->getWorldNonConst()->addToObject("object" + std::to_string(i), makeMesh(1.0 + i),
+                                               Eigen::Isometry3d::Identity());
+      server_->getWorldNonConst()->setObjectPose("object" + std::to_string(i), pose);
+    }
+
+    comp_.components = moveit_msgs::msg::PlanningSceneComponents::SCENE_SETTINGS |
+                       moveit_msgs::msg::PlanningSceneComponents::ROBOT_STATE_ATTACHED_OBJECTS |
+                       moveit_msgs::msg::PlanningSceneComponents::WORLD_OBJECT_GEOMETRY |
+                       moveit_msgs::msg::PlanningSceneComponents::OCTOMAP |
+                       moveit_msgs::msg::PlanningSceneComponents::OBJECT_COLORS;
+  }
+
+  // encode the server scene, apply it to the client and return the serialized size of the message
+  std::size_t poll()
+  {
+    moveit_msgs::msg::PlanningScene msg;
+    encoder_.getPlanningSceneMsg(*server_, comp_, msg);
+    EXPECT_TRUE(client_->usePlanningSceneMsg(msg));
+    last_msg_ = msg;
+    return serializedSize(msg);
+  }
+
+  // like poll(), but the meshes are sent in a mesh table; the size includes the table
+  std::size_t pollWithMeshTable()
+  {
+    moveit_msgs::msg::PlanningScene msg;
+    encoder_.getPlanningSceneMsg(*server_, comp_, msg, last_mesh_table_);
+    const std::size_t size = serializedSize(msg) + serializedSize(last_mesh_table_);
+    EXPECT_TRUE(planning_scene::PlanningSceneDeltaEncoder::restoreMeshes(last_mesh_table_, client_meshes_, msg));
+    EXPECT_TRUE(client_->usePlanningSceneMsg(msg));
+    last_msg_ = msg;
+    return size;
+  }
+
+  planning_scene::PlanningScenePtr server_;
+  planning_scene::PlanningScenePtr client_;
+  planning_scene::PlanningSceneDeltaEncoder encoder_;
+  moveit_msgs::msg::PlanningSceneComponents comp_;
+  moveit_msgs::msg::PlanningScene last_msg_;
+  planning_scene::PlanningSceneDeltaEncoder::MeshTable last_mesh_table_;
+  std::map<std::size_t, shape_msgs::msg::Mesh> client_meshes_;
+};
+
+TEST_F(PlanningSceneDeltaEncoderTest, FirstMessageIsComplete)
+{
+  poll();
+  EXPECT_FALSE(last_msg_.is_diff);
+  EXPECT_EQ(last_msg_.world.collision_objects.size(), OBJECT_COUNT);
+  EXPECT_EQ(encoder_.getVersion(), 1u);
+  expectSameWorld(*server_, *client_);
+}
+
+TEST_F(PlanningSceneDeltaEncoderTest, UnchangedSceneSendsNoGeometry)
+{
+  const std::size_t full_bytes = poll();
+  const std::size_t unchanged_bytes = poll();
+  RecordProperty("full_bytes", std::to_string(full_bytes));
+  RecordProperty("unchanged_bytes", std::to_string(unchanged_bytes));
+
+  EXPECT_TRUE(last_msg_.is_diff);
+  EXPECT_TRUE(last_msg_.world.collision_objects.empty());
+  EXPECT_TRUE(last_msg_.robot_state.attached_collision_objects.empty());
+  EXPECT_LT(20 * unchanged_bytes, full_bytes);
+  expectSameWorld(*server_, *client_);
+}
+
+TEST_F(PlanningSceneDeltaEncoderTest, MovedObjectIsSentWithoutGeometry)
+{
+  const std::size_t full_bytes = poll();
+
+  Eigen::Isometry3d pose = server_->getWorld()->getObject("object3")->pose_;
+  pose.translation().z() += 0.25;
+  server_->getWorldNonConst()->setObjectPose("object3", pose);
+  const std::size_t move_bytes = poll();
+  RecordProperty("move_bytes", std::to_string(move_bytes));
+
+  ASSERT_EQ(last_msg_.world.collision_objects.size(), 1u);
+  EXPECT_EQ(last_msg_.world.collision_objects[0].id, "object3");
+  EXPECT_EQ(last_msg_.world.collision_objects[0].operation, moveit_msgs::msg::CollisionObject::MOVE);
+  EXPECT_TRUE(last_msg_.world.collision_objects[0].meshes.empty());
+  EXPECT_LT(20 * move_bytes, full_bytes);
+  expectSameWorld(*server_, *client_);
+}
+
+TEST_F(PlanningSceneDeltaEncoderTest, ChangedObjectsAreAddedAndRemoved)
+{
+  poll();
+
+  server_->getWorldNonConst()->removeObject("object1");
+  server_->getWorldNonConst()->addToObject("object_new", makeMesh(0.5), Eigen::Isometry3d::Identity());
+  // same shape instance, but a different shape pose: the geometry changed
+  server_->getWorldNonConst()->moveShapeInObject("object2", server_->getWorld()->getObject("object2")->shapes_[0],
+                                                 Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.1, 0.0)));
+  poll();
+
+  std::map<std::string, int> operations;
+  for (const moveit_msgs::msg::CollisionObject& object : last_msg_.world.collision_objects)
+    operations[object.id] = object.operation;
+  EXPECT_EQ(operations.size(), 3u);
+  EXPECT_EQ(operations["object1"], moveit_msgs::msg::CollisionObject::REMOVE);
+  EXPECT_EQ(operations["object_new"], moveit_msgs::msg::CollisionObject::ADD);
+  EXPECT_EQ(operations["object2"], moveit_msgs::msg::CollisionObject::ADD);
+  expectSameWorld(*server_, *client_);
+}
+
+TEST_F(PlanningSceneDeltaEncoderTest, AttachedObjectsAreResentOnChange)
+{
+  poll();
+
+  moveit_msgs::msg::AttachedCollisionObject attached_object;
+  attached_object.link_name = "r_wrist_roll_link";
+  attached_object.object.operation = moveit_msgs::msg::CollisionObject::ADD;
+  attached_object.object.id = "object4";
+  ASSERT_TRUE(server_->processAttachedCollisionObjectMsg(attached_object));
+  poll();
+
+  EXPECT_FALSE(last_msg_.robot_state.is_diff);
+  ASSERT_EQ(last_msg_.robot_state.attached_collision_objects.size(), 1u);
+  // the object leaves the world of the client through the attach, not through a separate removal
+  EXPECT_TRUE(last_msg_.world.collision_objects.empty());
+  expectSameWorld(*server_, *client_);
+
+  poll();
+  EXPECT_TRUE(last_msg_.robot_state.is_diff);
+  EXPECT_TRUE(last_msg_.robot_state.attached_collision_objects.empty());
+}
+
+TEST_F(PlanningSceneDeltaEncoderTest, OctomapIsSentOnlyWhenUpdated)
+{
+  auto octree = std::make_shared<octomap::OcTree>(0.1);
+  octree->updateNode(octomap::point3d(1.0, 0.0, 0.5), true);
+  server_->processOctomapPtr(octree, Eigen::Isometry3d::Identity());
+  poll();
+  EXPECT_FALSE(last_msg_.world.octomap.octomap.data.empty());
+  EXPECT_TRUE(client_->getWorld()->hasObject(planning_scene::PlanningScene::OCTOMAP_NS));
+
+  poll();
+  EXPECT_TRUE(last_msg_.world.octomap.octomap.id.empty());
+  EXPECT_TRUE(last_msg_.world.octomap.octomap.data.empty());
+
+  // the monitor updates the octree in place and then passes the same pointer again
+  octree->updateNode(octomap::point3d(1.5, 0.0, 0.5), true);
+  server_->processOctomapPtr(octree, Eigen::Isometry3d::Identity());
+  poll();
+  EXPECT_FALSE(last_msg_.world.octomap.octomap.data.empty());
+
+  server_->processOctomapMsg(octomap_msgs::msg::Octomap());
+  poll();
+  EXPECT_EQ(last_msg_.world.octomap.octomap.id, "OcTree");
+  EXPECT_TRUE(last_msg_.world.octomap.octomap.data.empty());
+  EXPECT_FALSE(client_->getWorld()->hasObject(planning_scene::PlanningScene::OCTOMAP_NS));
+
+  poll();
+  EXPECT_TRUE(last_msg_.world.octomap.octomap.id.empty());
+}
+
+TEST_F(PlanningSceneDeltaEncoderTest, SharedMeshIsSentOnce)
+{
+  // an encoder that sends the meshes inside the objects, for comparison
+  planning_scene::PlanningSceneDeltaEncoder inline_encoder;
+  moveit_msgs::msg::PlanningScene inline_msg;
+  inline_encoder.getPlanningSceneMsg(*server_, comp_, inline_msg);
+  pollWithMeshTable();
+  EXPECT_EQ(last_mesh_table_.meshes.size(), OBJECT_COUNT);
+  expectSameWorld(*server_, *client_);
+
+  // two objects with separate mesh instances of the same content
+  server_->getWorldNonConst()->addToObject("shared_a", makeMesh(0.5), Eigen::Isometry3d::Identity());
+  server_->getWorldNonConst()->addToObject("shared_b", makeMesh(0.5), Eigen::Isometry3d::Identity());
+  inline_encoder.getPlanningSceneMsg(*server_, comp_, inline_msg);
+  const std::size_t inline_bytes = serializedSize(inline_msg);
+  const std::size_t table_bytes = pollWithMeshTable();
+  RecordProperty("shared_mesh_inline_bytes", std::to_string(inline_bytes));
+  RecordProperty("shared_mesh_table_bytes", std::to_string(table_bytes));
+
+  EXPECT_EQ(last_msg_.world.collision_objects.size(), 2u);
+  EXPECT_EQ(last_mesh_table_.meshes.size(), 1u);
+  ASSERT_EQ(last_mesh_table_.object_meshes.size(), 2u);
+  EXPECT_EQ(last_mesh_table_.object_meshes["shared_a"], last_mesh_table_.object_meshes["shared_b"]);
+  EXPECT_LT(10 * table_bytes, 6 * inline_bytes);
+  expectSameWorld(*server_, *client_);
+
+  // a later object with the same mesh only refers to the mesh the client already has
+  server_->getWorldNonConst()->addToObject("shared_c", makeMesh(0.5), Eigen::Isometry3d::Identity());
+  const std::size_t reference_bytes = pollWithMeshTable();
+  RecordProperty("shared_mesh_reference_bytes", std::to_string(reference_bytes));
+  EXPECT_TRUE(last_mesh_table_.meshes.empty());
+  EXPECT_EQ(last_mesh_table_.object_meshes.size(), 1u);
+  EXPECT_LT(20 * reference_bytes, table_bytes);
+  expectSameWorld(*server_, *client_);
+
+  // a client that lost the table cannot restore the meshes
+  moveit_msgs::msg::PlanningScene msg;
+  server_->getWorldNonConst()->addToObject("shared_d", makeMesh(0.5), Eigen::Isometry3d::Identity());
+  encoder_.getPlanningSceneMsg(*server_, comp_, msg, last_mesh_table_);
+  std::map<std::size_t, shape_msgs::msg::Mesh> empty_client_meshes;
+  EXPECT_FALSE(planning_scene::PlanningSceneDeltaEncoder::restoreMeshes(last_mesh_table_, empty_client_meshes, msg));
+}
+
+TEST_F(PlanningSceneDeltaEncoderTest, ResetSendsCompleteScene)
+{
+  poll();
+  poll();
+  encoder_.reset();
+  EXPECT_EQ(encoder_.getVersion(), 0u);
+
+  moveit_msgs::msg::PlanningScene msg;
+  encoder_.getPlanningSceneMsg(*server_, comp_, msg);
+  EXPECT_FALSE(msg.is_diff);
+  EXPECT_EQ(msg.world.collision_objects.size(), OBJECT_COUNT);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <moveit/planning_scene/state_validity_batch.hpp>
+#include <moveit/robot_trajectory/robot_trajectory.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <geometric_shapes/shapes.h>
+#include <random_numbers/random_numbers.h>
+#include <limits>
+
+class StateValidityBatchTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = moveit::core::loadTestingRobotModel("pr2");
+    scene_ = std::make_shared<planning_scene::PlanningScene>(robot_model_);
+    jmg_ = robot_model_->getJointModelGroup("right_arm");
+    // a wall in front of the robot that random right arm configurations frequently hit
+    scene_->getWorldNonConst()->addToObject("wall", Eigen::Isometry3d(Eigen::Translation3d(0.6, -0.4, 0.8)),
+                                            std::make_shared<const shapes::Box>(0.05, 1.0, 1.0),
+                                            Eigen::Isometry3d::Identity());
+  }
+
+  std::vector<moveit::core::RobotState> randomStates(std::size_t count) const
+  {
+    random_numbers::RandomNumberGenerator rng(42);
+    std::vector<moveit::core::RobotState> states(count, scene_->getCurrentState());
+    for (moveit::core::RobotState& state : states)
+    {
+      state.setToRandomPositions(jmg_, rng);
+      state.update();
+    }
+    return states;
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  planning_scene::PlanningScenePtr scene_;
+  const moveit::core::JointModelGroup* jmg_;
+};
+
+TEST_F(StateValidityBatchTest, SingleState)
+{
+  moveit::core::RobotState state = scene_->getCurrentState();
+  planning_scene::StateValidityOptions options;
+  options.compute_clearance = true;
+  planning_scene::StateValidityResult result = planning_scene::checkStateValidity(*scene_, state, nullptr, options);
+  EXPECT_TRUE(result.valid);
+  EXPECT_TRUE(result.satisfies_bounds);
+  EXPECT_TRUE(result.feasible);
+  EXPECT_TRUE(result.constraints.satisfied);
+  ASSERT_TRUE(result.clearance.has_value());
+  EXPECT_GT(*result.clearance, 0.0);
+  EXPECT_LT(*result.clearance, 10.0);
+  ASSERT_TRUE(result.nearest_bodies.has_value());
+  EXPECT_DOUBLE_EQ(result.nearest_bodies->distance, *result.clearance);
+
+  // out of bounds
+  state.setVariablePosition("r_shoulder_pan_joint", 10.0);
+  result = planning_scene::checkStateValidity(*scene_, state, nullptr);
+  EXPECT_FALSE(result.valid);
+  EXPECT_FALSE(result.satisfies_bounds);
+
+  // colliding, with contacts and without clearance
+  scene_->getWorldNonConst()->addToObject("base_box", std::make_shared<const shapes::Box>(1.0, 1.0, 1.0),
+                                          Eigen::Isometry3d::Identity());
+  state = scene_->getCurrentState();
+  options.compute_contacts = true;
+  result = planning_scene::checkStateValidity(*scene_, state, nullptr, options);
+  EXPECT_FALSE(result.valid);
+  EXPECT_TRUE(result.collision.collision);
+  EXPECT_FALSE(result.collision.contacts.empty());
+  EXPECT_FALSE(result.clearance.has_value());
+}
+
+TEST_F(StateValidityBatchTest, ClearanceOfEmptyWorld)
+{
+  scene_->getWorldNonConst()->clearObjects();
+  moveit::core::RobotState state = scene_->getCurrentState();
+  planning_scene::StateValidityOptions options;
+  options.compute_clearance = true;
+  const planning_scene::StateValidityResult result =
+      planning_scene::checkStateValidity(*scene_, state, nullptr, options);
+  EXPECT_TRUE(result.valid);
+  ASSERT_TRUE(result.clearance.has_value());
+  EXPECT_EQ(*result.clearance, std::numeric_limits<double>::infinity());
+  EXPECT_FALSE(result.nearest_bodies.has_value());
+}
+
+TEST_F(StateValidityBatchTest, Feasibility)
+{
+  scene_->setStateFeasibilityPredicate([](const moveit::core::RobotState&, bool) { return false; });
+  moveit::core::RobotState state = scene_->getCurrentState();
+  const planning_scene::StateValidityResult result = planning_scene::checkStateValidity(*scene_, state, nullptr);
+  EXPECT_FALSE(result.valid);
+  EXPECT_FALSE(result.feasible);
+  EXPECT_FALSE(result.collision.collision);
+}
+
+TEST_F(StateValidityBatchTest, ParallelMatchesSequential)
+{
+  const std::vector<moveit::core::RobotState> states = randomStates(200);
+  planning_scene::StateValidityOptions options;
+  options.group = "right_arm";
+  options.compute_clearance = true;
+
+  const std::vector<planning_scene::StateValidityResult> sequential =
+      planning_scene::checkStatesValidity(*scene_, states, nullptr, options);
+  options.threads = 4;
+  const std::vector<planning_scene::StateValidityResult> parallel =
+      planning_scene::checkStatesValidity(*scene_, states, nullptr, options);
+
+  ASSERT_EQ(sequential.size(), states.size());
+  ASSERT_EQ(parallel.size(), states.size());
+  std::size_t colliding = 0;
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    EXPECT_EQ(sequential[i].valid, parallel[i].valid) << i;
+    EXPECT_EQ(sequential[i].collision.collision, parallel[i].collision.collision) << i;
+    EXPECT_EQ(sequential[i].clearance.has_value(), parallel[i].clearance.has_value()) << i;
+    if (sequential[i].clearance && parallel[i].clearance)
+      EXPECT_NEAR(*sequential[i].clearance, *parallel[i].clearance, 1e-9) << i;
+
+    moveit::core::RobotState state = states[i];
+    EXPECT_EQ(sequential[i].collision.collision, scene_->isStateColliding(state, "right_arm")) << i;
+    colliding += sequential[i].collision.collision ? 1 : 0;
+  }
+  // the wall must make the comparison meaningful
+  EXPECT_GT(colliding, 0u);
+  EXPECT_LT(colliding, states.size());
+}
+
+TEST_F(StateValidityBatchTest, Trajectory)
+{
+  const std::vector<moveit::core::RobotState> states = randomStates(50);
+  robot_trajectory::RobotTrajectory trajectory(robot_model_, jmg_);
+  for (const moveit::core::RobotState& state : states)
+    trajectory.addSuffixWayPoint(state, 0.1);
+
+  planning_scene::StateValidityOptions options;
+  options.threads = 0;
+  const std::vector<planning_scene::StateValidityResult> results =
+      planning_scene::checkTrajectoryValidity(*scene_, trajectory, nullptr, options);
+  ASSERT_EQ(results.size(), states.size());
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    moveit::core::RobotState state = states[i];
+    EXPECT_EQ(results[i].valid, scene_->isStateValid(state, "right_arm")) << i;
+  }
+
+  EXPECT_TRUE(planning_scene::checkTrajectoryValidity(*scene_, robot_trajectory::RobotTrajectory(robot_model_),
+                                                      nullptr, options)
+                  .empty());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
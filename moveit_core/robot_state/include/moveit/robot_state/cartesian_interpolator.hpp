@@ -52,6 +52,17 @@ struct CartesianPrecision
   double max_resolution = 1e-5;  //< max resolution for waypoints (fraction of total path)
 };
 
+/** \brief Struct configuring the adaptive variant of computeCartesianPath.
+
+    Only every coarse_stride-th waypoint is solved sequentially. The waypoints in between are taken from the
+    joint-space interpolation of their enclosing coarse waypoints if that stays within CartesianPrecision, and solved
+    by IK otherwise. With threads > 1, the IK solver and the state validity callback are called concurrently and must be thread-safe. */
+struct CartesianRefinement
+{
+  std::size_t coarse_stride = 8;  //< number of max_step increments between sequentially solved waypoints
+  std::size_t threads = 1;        //< threads refining intervals and validating states, 0 uses all hardware threads
+};
+
 /** \brief Struct with options for defining joint-space jump thresholds. */
 struct JumpThreshold
 {
@@ -221,6 +232,36 @@ public:
       const kinematics::KinematicsBase::IKCostFn& cost_function = kinematics::KinematicsBase::IKCostFn(),
       const Eigen::Isometry3d& link_offset = Eigen::Isometry3d::Identity());
 
+  /** \brief Compute the sequence of joint values that correspond to a straight Cartesian path, for a particular frame.
+
+     Produces a path with the same max_step resolution and CartesianPrecision guarantees as the corresponding
+     computeCartesianPath() overload, but requires fewer IK queries and spreads them over \e refinement.threads threads:
+     waypoints are first solved every \e refinement.coarse_stride steps, then the intervals between them are refined
+     independently. Waypoints that skipped IK are checked with \e validCallback in one batch afterwards.
+     If an interval cannot be refined or contains an invalid state, the path is continued sequentially from the start
+     of that interval, so the achieved fraction matches that of the sequential computation. */
+  static Percentage computeCartesianPathAdaptive(
+      const RobotState* start_state, const JointModelGroup* group, std::vector<RobotStatePtr>& traj,
+      const LinkModel* link, const Eigen::Isometry3d& target, bool global_reference_frame, const MaxEEFStep& max_step,
+      const CartesianPrecision& precision, const CartesianRefinement& refinement,
+      const GroupStateValidityCallbackFn& validCallback = GroupStateValidityCallbackFn(),
+      const kinematics::KinematicsQueryOptions& options = kinematics::KinematicsQueryOptions(),
+      const kinematics::KinematicsBase::IKCostFn& cost_function = kinematics::KinematicsBase::IKCostFn(),
+      const Eigen::Isometry3d& link_offset = Eigen::Isometry3d::Identity());
+
+  /** \brief Compute the sequence of joint values that perform a general Cartesian path, adaptively and in parallel.
+
+     The waypoint variant of computeCartesianPathAdaptive(). Each segment between consecutive waypoints is computed
+     as described there. */
+  static Percentage computeCartesianPathAdaptive(
+      const RobotState* start_state, const JointModelGroup* group, std::vector<RobotStatePtr>& traj,
+      const LinkModel* link, const EigenSTL::vector_Isometry3d& waypoints, bool global_reference_frame,
+      const MaxEEFStep& max_step, const CartesianPrecision& precision, const CartesianRefinement& refinement,
+      const GroupStateValidityCallbackFn& validCallback = GroupStateValidityCallbackFn(),
+      const kinematics::KinematicsQueryOptions& options = kinematics::KinematicsQueryOptions(),
+      const kinematics::KinematicsBase::IKCostFn& cost_function = kinematics::KinematicsBase::IKCostFn(),
+      const Eigen::Isometry3d& link_offset = Eigen::Isometry3d::Identity());
+
   /** \brief Compute the sequence of joint values that correspond to a straight Cartesian path for a particular link.
 
      The Cartesian path to be followed is specified as a \e translation vector to be followed by the robot \e link.
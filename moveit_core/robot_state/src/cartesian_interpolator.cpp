@@ -36,6 +36,8 @@
 
 /* Author: Ioan Sucan, Sachin Chitta, Acorn Pooley, Mario Prats, Dave Coleman, Robert Haschke */
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <moveit/robot_state/cartesian_interpolator.hpp>
 #include <geometric_shapes/check_isometry.h>
@@ -43,6 +45,7 @@
 #include <rclcpp/logging.hpp>
 #include <rcpputils/asserts.hpp>
 #include <moveit/utils/logger.hpp>
+#include <moveit/utils/parallel_for.hpp>
 
 namespace moveit::core
 {
@@ -60,6 +63,54 @@ rclcpp::Logger getLogger()
   return moveit::getLogger("moveit.core.cartesian_interpolator");
 }
 
+// Straight Cartesian line between two poses: linear interpolation of the translation and slerp of the rotation
+struct CartesianLine
+{
+  CartesianLine(const Eigen::Isometry3d& start_pose, const Eigen::Isometry3d& target_pose)
+    : start_quaternion(start_pose.linear())
+    , target_quaternion(target_pose.linear())
+    , start_translation(start_pose.translation())
+    , target_translation(target_pose.translation())
+  {
+  }
+
+  Eigen::Isometry3d poseAt(double percentage) const
+  {
+    Eigen::Isometry3d pose(start_quaternion.slerp(percentage, target_quaternion));
+    pose.translation() = percentage * target_translation + (1 - percentage) * start_translation;
+    return pose;
+  }
+
+  // number of max_step increments needed to follow the line
+  std::size_t countSteps(const MaxEEFStep& max_step) const
+  {
+    double rotation_distance = start_quaternion.angularDistance(target_quaternion);
+    double translation_distance = (target_translation - start_translation).norm();
+
+    std::size_t translation_steps = 0;
+    if (max_step.translation > 0.0)
+      translation_steps = floor(translation_distance / max_step.translation);
+
+    std::size_t rotation_steps = 0;
+    if (max_step.rotation > 0.0)
+      rotation_steps = floor(rotation_distance / max_step.rotation);
+    return std::max(translation_steps, rotation_steps) + 1;
+  }
+
+  Eigen::Quaterniond start_quaternion;
+  Eigen::Quaterniond target_quaternion;
+  Eigen::Vector3d start_translation;
+  Eigen::Vector3d target_translation;
+};
+
+bool isWithinPrecision(const Eigen::Isometry3d& pose, const Eigen::Isometry3d& reference,
+                       const CartesianPrecision& precision)
+{
+  double linear_distance = (reference.translation() - pose.translation()).norm();
+  double angular_distance = Eigen::Quaterniond(reference.linear()).angularDistance(Eigen::Quaterniond(pose.linear()));
+  return linear_distance <= precision.translational && angular_distance <= precision.rotational;
+}
+
 bool validateAndImproveInterval(const RobotState& start_state, const RobotState& end_state,
                                 const Eigen::Isometry3d& start_pose, const Eigen::Isometry3d& end_pose,
                                 std::vector<RobotStatePtr>& traj, double& percentage, const double width,
@@ -79,9 +130,7 @@ bool validateAndImproveInterval(const RobotState& start_state, const RobotState&
   mid_pose.translation() = 0.5 * (start_pose.translation() + end_pose.translation());
 
   // if deviation between both poses, fk_pose and mid_pose is within precision, we are satisfied
-  double linear_distance = (mid_pose.translation() - fk_pose.translation()).norm();
-  double angular_distance = Eigen::Quaterniond(mid_pose.linear()).angularDistance(Eigen::Quaterniond(fk_pose.linear()));
-  if (linear_distance <= precision.translational && angular_distance <= precision.rotational)
+  if (isWithinPrecision(fk_pose, mid_pose, precision))
   {
     traj.push_back(std::make_shared<moveit::core::RobotState>(end_state));
     return true;
@@ -108,6 +157,96 @@ bool validateAndImproveInterval(const RobotState& start_state, const RobotState&
                                     precision, validCallback, options, cost_function, link_offset);
 }
 
+// Follow the line sequentially from the waypoint at first_step, seeding each IK query with the previous solution.
+// Returns the percentage of the line up to the last waypoint that was reached.
+double followCartesianLine(RobotState& state, const Eigen::Isometry3d& first_pose, std::size_t first_step,
+                           std::size_t steps, const CartesianLine& line, std::vector<RobotStatePtr>& traj,
+                           const JointModelGroup* group, const LinkModel* link, const CartesianPrecision& precision,
+                           const GroupStateValidityCallbackFn& validCallback,
+                           const kinematics::KinematicsQueryOptions& options,
+                           const kinematics::KinematicsBase::IKCostFn& cost_function,
+                           const Eigen::Isometry3d& link_offset)
+{
+  const Eigen::Isometry3d inv_offset = link_offset.inverse();
+  double last_valid_percentage = static_cast<double>(first_step) / static_cast<double>(steps);
+  Eigen::Isometry3d prev_pose = first_pose;
+  RobotState prev_state(state);
+  for (std::size_t i = first_step + 1; i <= steps; ++i)
+  {
+    double percentage = static_cast<double>(i) / static_cast<double>(steps);
+    Eigen::Isometry3d pose = line.poseAt(percentage);
+
+    if (!state.setFromIK(group, pose * inv_offset, link->getName(), 0.0, validCallback, options, cost_function) ||
+        !validateAndImproveInterval(prev_state, state, prev_pose, pose, traj, percentage,
+                                    1.0 / static_cast<double>(steps), group, link, precision, validCallback, options,
+                                    cost_function, link_offset))
+      break;
+
+    prev_pose = pose;
+    prev_state = state;
+    last_valid_percentage = percentage;
+  }
+  return last_valid_percentage;
+}
+
+// Path section between two consecutive coarse waypoints of computeCartesianPathAdaptive()
+struct CartesianInterval
+{
+  std::vector<RobotStatePtr> traj;        // waypoints after the interval start, up to and including its end
+  std::vector<std::size_t> interpolated;  // indices into traj of waypoints that were not validated by IK
+  bool refined = false;
+};
+
+// Fill interval.traj with the waypoints between start_state (at first_step) and end_state (at last_step).
+// Waypoints are taken from the joint-space interpolation of both ends where that is precise enough, and
+// validateAndImproveInterval() bisects every resulting max_step increment as in the sequential computation.
+bool refineCartesianInterval(const RobotState& start_state, const RobotState& end_state, std::size_t first_step,
+                             std::size_t last_step, std::size_t steps, const CartesianLine& line,
+                             CartesianInterval& interval, const JointModelGroup* group, const LinkModel* link,
+                             const CartesianPrecision& precision, const GroupStateValidityCallbackFn& validCallback,
+                             const kinematics::KinematicsQueryOptions& options,
+                             const kinematics::KinematicsBase::IKCostFn& cost_function,
+                             const Eigen::Isometry3d& link_offset)
+{
+  const Eigen::Isometry3d inv_offset = link_offset.inverse();
+  const double span = static_cast<double>(last_step - first_step);
+  RobotState prev_state(start_state);
+  RobotState state(start_state);
+  Eigen::Isometry3d prev_pose = line.poseAt(static_cast<double>(first_step) / static_cast<double>(steps));
+  for (std::size_t i = first_step + 1; i <= last_step; ++i)
+  {
+    double percentage = static_cast<double>(i) / static_cast<double>(steps);
+    Eigen::Isometry3d pose = line.poseAt(percentage);
+
+    bool interpolated = false;
+    if (i == last_step)
+    {
+      state = end_state;
+    }
+    else
+    {
+      start_state.interpolate(end_state, static_cast<double>(i - first_step) / span, state);
+      state.update();
+      interpolated = isWithinPrecision(state.getGlobalLinkTransform(link) * link_offset, pose, precision);
+      // otherwise solve IK, seeded with the interpolated state
+      if (!interpolated &&
+          !state.setFromIK(group, pose * inv_offset, link->getName(), 0.0, validCallback, options, cost_function))
+        return false;
+    }
+
+    if (!validateAndImproveInterval(prev_state, state, prev_pose, pose, interval.traj, percentage,
+                                    1.0 / static_cast<double>(steps), group, link, precision, validCallback, options,
+                                    cost_function, link_offset))
+      return false;
+    if (interpolated)
+      interval.interpolated.push_back(interval.traj.size() - 1);
+
+    prev_pose = pose;
+    prev_state = state;
+  }
+  return true;
+}
+
 std::optional<int> hasRelativeJointSpaceJump(const std::vector<moveit::core::RobotStatePtr>& waypoints,
                                              const moveit::core::JointModelGroup& group, double jump_threshold_factor)
 {
@@ -223,52 +362,159 @@ CartesianInterpolator::Percentage CartesianInterpolator::computeCartesianPath(
 
   // Cartesian pose we start from
   Eigen::Isometry3d start_pose = state.getGlobalLinkTransform(link) * link_offset;
-  Eigen::Isometry3d inv_offset = link_offset.inverse();
 
   // the target can be in the local reference frame (in which case we rotate it)
   Eigen::Isometry3d rotated_target = global_reference_frame ? target : start_pose * target;
 
-  Eigen::Quaterniond start_quaternion(start_pose.linear());
-  Eigen::Quaterniond target_quaternion(rotated_target.linear());
-
-  double rotation_distance = start_quaternion.angularDistance(target_quaternion);
-  double translation_distance = (rotated_target.translation() - start_pose.translation()).norm();
+  const CartesianLine line(start_pose, rotated_target);
 
   // decide how many steps we will need for this trajectory
-  std::size_t translation_steps = 0;
-  if (max_step.translation > 0.0)
-    translation_steps = floor(translation_distance / max_step.translation);
-
-  std::size_t rotation_steps = 0;
-  if (max_step.rotation > 0.0)
-    rotation_steps = floor(rotation_distance / max_step.rotation);
-  std::size_t steps = std::max(translation_steps, rotation_steps) + 1;
+  std::size_t steps = line.countSteps(max_step);
 
   traj.clear();
   traj.push_back(std::make_shared<moveit::core::RobotState>(*start_state));
 
-  double last_valid_percentage = 0.0;
-  Eigen::Isometry3d prev_pose = start_pose;
-  RobotState prev_state(state);
-  for (std::size_t i = 1; i <= steps; ++i)
+  return followCartesianLine(state, start_pose, 0, steps, line, traj, group, link, precision, validCallback, options,
+                             cost_function, link_offset);
+}
+
+CartesianInterpolator::Percentage CartesianInterpolator::computeCartesianPathAdaptive(
+    const RobotState* start_state, const JointModelGroup* group, std::vector<RobotStatePtr>& traj,
+    const LinkModel* link, const Eigen::Isometry3d& target, bool global_reference_frame, const MaxEEFStep& max_step,
+    const CartesianPrecision& precision, const CartesianRefinement& refinement,
+    const GroupStateValidityCallbackFn& validCallback, const kinematics::KinematicsQueryOptions& options,
+    const kinematics::KinematicsBase::IKCostFn& cost_function, const Eigen::Isometry3d& link_offset)
+{
+  // check unsanitized inputs for non-isometry
+  ASSERT_ISOMETRY(target)
+  ASSERT_ISOMETRY(link_offset)
+
+  RobotState state(*start_state);
+
+  // make sure that continuous joints wrap
+  for (const JointModel* joint : group->getContinuousJointModels())
+    state.enforceBounds(joint);
+  state.update();
+
+  Eigen::Isometry3d start_pose = state.getGlobalLinkTransform(link) * link_offset;
+  Eigen::Isometry3d inv_offset = link_offset.inverse();
+  Eigen::Isometry3d rotated_target = global_reference_frame ? target : start_pose * target;
+  const CartesianLine line(start_pose, rotated_target);
+  const std::size_t steps = line.countSteps(max_step);
+  const std::size_t stride = std::max<std::size_t>(refinement.coarse_stride, 1);
+
+  // solve the coarse waypoints sequentially, each seeded with its predecessor
+  std::vector<std::size_t> coarse_steps = { 0 };
+  std::vector<RobotStatePtr> coarse_states = { std::make_shared<RobotState>(state) };
+  for (std::size_t i = std::min(stride, steps);; i = std::min(i + stride, steps))
   {
-    double percentage = static_cast<double>(i) / static_cast<double>(steps);
+    auto coarse_state = std::make_shared<RobotState>(*coarse_states.back());
+    Eigen::Isometry3d pose = line.poseAt(static_cast<double>(i) / static_cast<double>(steps));
+    if (!coarse_state->setFromIK(group, pose * inv_offset, link->getName(), 0.0, validCallback, options,
+                                 cost_function))
+      break;
+    coarse_state->update();
+    coarse_steps.push_back(i);
+    coarse_states.push_back(coarse_state);
+    if (i == steps)
+      break;
+  }
 
-    Eigen::Isometry3d pose(start_quaternion.slerp(percentage, target_quaternion));
-    pose.translation() = percentage * rotated_target.translation() + (1 - percentage) * start_pose.translation();
+  // refine the intervals between coarse waypoints independently, skipping those behind the first failure
+  std::vector<CartesianInterval> intervals(coarse_states.size() - 1);
+  std::atomic<std::size_t> first_failure{ intervals.size() };
+  moveit::parallelFor(intervals.size(), refinement.threads, [&](std::size_t k, std::size_t /* worker */) {
+    if (k > first_failure)
+      return;
+    intervals[k].refined = refineCartesianInterval(*coarse_states[k], *coarse_states[k + 1], coarse_steps[k],
+                                                   coarse_steps[k + 1], steps, line, intervals[k], group, link,
+                                                   precision, validCallback, options, cost_function, link_offset);
+    if (!intervals[k].refined)
+    {
+      std::size_t failure = first_failure;
+      while (k < failure && !first_failure.compare_exchange_weak(failure, k))
+      {
+      }
+    }
+  });
 
-    if (!state.setFromIK(group, pose * inv_offset, link->getName(), 0.0, validCallback, options, cost_function) ||
-        !validateAndImproveInterval(prev_state, state, prev_pose, pose, traj, percentage,
-                                    1.0 / static_cast<double>(steps), group, link, precision, validCallback, options,
-                                    cost_function, link_offset))
+  // validate all interpolated waypoints of the refined intervals in one batch
+  std::vector<std::pair<std::size_t, std::size_t>> pending;
+  for (std::size_t k = 0; k < first_failure; ++k)
+  {
+    for (std::size_t index : intervals[k].interpolated)
+      pending.emplace_back(k, index);
+  }
+  std::vector<char> valid(pending.size(), true);
+  if (validCallback)
+  {
+    moveit::parallelFor(pending.size(), refinement.threads, [&](std::size_t i, std::size_t /* worker */) {
+      RobotState& waypoint = *intervals[pending[i].first].traj[pending[i].second];
+      std::vector<double> values;
+      waypoint.copyJointGroupPositions(group, values);
+      valid[i] = validCallback(&waypoint, group, values.data());
+    });
+  }
+  std::size_t first_invalid = first_failure;
+  for (std::size_t i = 0; i < pending.size(); ++i)
+  {
+    if (!valid[i])
+    {
+      first_invalid = std::min(first_invalid, pending[i].first);
       break;
+    }
+  }
 
-    prev_pose = pose;
-    prev_state = state;
-    last_valid_percentage = percentage;
+  traj.clear();
+  traj.push_back(std::make_shared<moveit::core::RobotState>(*start_state));
+  for (std::size_t k = 0; k < first_invalid; ++k)
+    traj.insert(traj.end(), intervals[k].traj.begin(), intervals[k].traj.end());
+  if (coarse_steps[first_invalid] == steps)
+    return 1.0;
+
+  // continue sequentially from the last waypoint that is known to be good
+  RobotState& resume_state = *coarse_states[first_invalid];
+  const std::size_t resume_step = coarse_steps[first_invalid];
+  Eigen::Isometry3d resume_pose =
+      resume_step == 0 ? start_pose : line.poseAt(static_cast<double>(resume_step) / static_cast<double>(steps));
+  return followCartesianLine(resume_state, resume_pose, resume_step, steps, line, traj, group, link, precision,
+                             validCallback, options, cost_function, link_offset);
+}
+
+CartesianInterpolator::Percentage CartesianInterpolator::computeCartesianPathAdaptive(
+    const RobotState* start_state, const JointModelGroup* group, std::vector<RobotStatePtr>& traj,
+    const LinkModel* link, const EigenSTL::vector_Isometry3d& waypoints, bool global_reference_frame,
+    const MaxEEFStep& max_step, const CartesianPrecision& precision, const CartesianRefinement& refinement,
+    const GroupStateValidityCallbackFn& validCallback, const kinematics::KinematicsQueryOptions& options,
+    const kinematics::KinematicsBase::IKCostFn& cost_function, const Eigen::Isometry3d& link_offset)
+{
+  double percentage_solved = 0.0;
+  for (std::size_t i = 0; i < waypoints.size(); ++i)
+  {
+    std::vector<RobotStatePtr> waypoint_traj;
+    double wp_percentage_solved =
+        computeCartesianPathAdaptive(start_state, group, waypoint_traj, link, waypoints[i], global_reference_frame,
+                                     max_step, precision, refinement, validCallback, options, cost_function,
+                                     link_offset);
+
+    std::vector<RobotStatePtr>::iterator start = waypoint_traj.begin();
+    if (i > 0 && !waypoint_traj.empty())
+      std::advance(start, 1);
+    traj.insert(traj.end(), start, waypoint_traj.end());
+
+    if (fabs(wp_percentage_solved - 1.0) < std::numeric_limits<double>::epsilon())
+    {
+      percentage_solved = static_cast<double>(i + 1) / static_cast<double>(waypoints.size());
+    }
+    else
+    {
+      percentage_solved += wp_percentage_solved / static_cast<double>(waypoints.size());
+      break;
+    }
+    start_state = traj.back().get();
   }
 
-  return last_valid_percentage;
+  return percentage_solved;
 }
 
 CartesianInterpolator::Percentage CartesianInterpolator::computeCartesianPath(
@@ -0,0 +1,101 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Compares sequential and adaptive Cartesian path computation with an IK solver that takes 20us per query.
+// To run this benchmark, 'cd' to the build/moveit_core/robot_state directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+#include <moveit/robot_state/cartesian_interpolator.hpp>
+
+#include "planar_arm_kinematics.hpp"
+
+namespace
+{
+struct PlanarArmPath
+{
+  PlanarArmPath()
+  {
+    robot_model = planar_arm_kinematics::createPlanarArmModel();
+    jmg = robot_model->getJointModelGroup("arm");
+    link = robot_model->getLinkModel("d");
+    planar_arm_kinematics::PlanarArmKinematics::attach(jmg, std::chrono::microseconds(20));
+
+    start_state = std::make_shared<moveit::core::RobotState>(robot_model);
+    start_state->setToDefaultValues();
+    start_state->setJointGroupPositions(jmg, std::vector<double>{ 0.3, 1.2, -0.5 });
+    start_state->update();
+    target = Eigen::Translation3d(-0.6, 0.4, 0.0) * start_state->getGlobalLinkTransform(link) *
+             Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitZ());
+  }
+
+  moveit::core::RobotModelPtr robot_model;
+  moveit::core::JointModelGroup* jmg;
+  const moveit::core::LinkModel* link;
+  moveit::core::RobotStatePtr start_state;
+  Eigen::Isometry3d target;
+};
+}  // namespace
+
+// Benchmark time to compute a path of about 700 waypoints one IK query at a time.
+static void computeCartesianPathSequential(benchmark::State& st)
+{
+  PlanarArmPath path;
+  std::vector<moveit::core::RobotStatePtr> traj;
+  for (auto _ : st)
+  {
+    benchmark::DoNotOptimize(moveit::core::CartesianInterpolator::computeCartesianPath(
+        path.start_state.get(), path.jmg, traj, path.link, path.target, true, moveit::core::MaxEEFStep(0.001, 0.005),
+        moveit::core::CartesianPrecision{}, moveit::core::GroupStateValidityCallbackFn(),
+        kinematics::KinematicsQueryOptions()));
+  }
+}
+
+// Benchmark time to compute the same path adaptively, with the number of threads given by the range argument.
+static void computeCartesianPathAdaptive(benchmark::State& st)
+{
+  PlanarArmPath path;
+  moveit::core::CartesianRefinement refinement;
+  refinement.threads = st.range(0);
+  std::vector<moveit::core::RobotStatePtr> traj;
+  for (auto _ : st)
+  {
+    benchmark::DoNotOptimize(moveit::core::CartesianInterpolator::computeCartesianPathAdaptive(
+        path.start_state.get(), path.jmg, traj, path.link, path.target, true, moveit::core::MaxEEFStep(0.001, 0.005),
+        moveit::core::CartesianPrecision{}, refinement));
+  }
+}
+
+BENCHMARK(computeCartesianPathSequential)->Unit(benchmark::kMillisecond);
+BENCHMARK(computeCartesianPathAdaptive)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond);
@@ -40,6 +40,8 @@
 #include <moveit/utils/robot_model_test_utils.hpp>
 #include <moveit/utils/eigen_test_utils.hpp>
 
+#include "planar_arm_kinematics.hpp"
+
 #include <rclcpp/node.hpp>
 
 using namespace moveit::core;
@@ -198,6 +200,153 @@ TEST_F(SimpleRobot, checkRelativeJointSpaceJump)
   EXPECT_ANY_THROW(CartesianInterpolator::checkJointSpaceJump(joint_model_group, traj, JumpThreshold::relative(0.0)));
 }
 
+class PlanarArm : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    robot_model_ = planar_arm_kinematics::createPlanarArmModel();
+    ASSERT_TRUE(robot_model_);
+    jmg_ = robot_model_->getJointModelGroup("arm");
+    link_ = robot_model_->getLinkModel("d");
+    solver_ = planar_arm_kinematics::PlanarArmKinematics::attach(jmg_);
+
+    start_state_ = std::make_shared<RobotState>(robot_model_);
+    start_state_->setToDefaultValues();
+    start_state_->setJointGroupPositions(jmg_, std::vector<double>{ 0.3, 1.2, -0.5 });
+    start_state_->update();
+
+    // move the tip across the workspace while turning it
+    target_ = Eigen::Translation3d(-0.6, 0.4, 0.0) * start_state_->getGlobalLinkTransform(link_) *
+              Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitZ());
+  }
+
+  double computeSequential(std::vector<RobotStatePtr>& traj,
+                           const GroupStateValidityCallbackFn& valid_callback = GroupStateValidityCallbackFn())
+  {
+    return CartesianInterpolator::computeCartesianPath(start_state_.get(), jmg_, traj, link_, target_, true, MAX_STEP,
+                                                       CartesianPrecision{}, valid_callback,
+                                                       kinematics::KinematicsQueryOptions());
+  }
+
+  double computeAdaptive(std::vector<RobotStatePtr>& traj, std::size_t threads,
+                         const GroupStateValidityCallbackFn& valid_callback = GroupStateValidityCallbackFn())
+  {
+    CartesianRefinement refinement;
+    refinement.threads = threads;
+    return CartesianInterpolator::computeCartesianPathAdaptive(start_state_.get(), jmg_, traj, link_, target_, true,
+                                                               MAX_STEP, CartesianPrecision{}, refinement,
+                                                               valid_callback);
+  }
+
+  // every waypoint must be close to the Cartesian line, and so must the joint-space midpoints of all segments
+  void expectFollowsLine(const std::vector<RobotStatePtr>& traj)
+  {
+    const CartesianPrecision precision;
+    for (std::size_t i = 1; i < traj.size(); ++i)
+    {
+      RobotState mid_state(robot_model_);
+      traj[i - 1]->interpolate(*traj[i], 0.5, mid_state);
+      mid_state.update();
+      const Eigen::Isometry3d& start_pose = traj[i - 1]->getGlobalLinkTransform(link_);
+      const Eigen::Isometry3d& end_pose = traj[i]->getGlobalLinkTransform(link_);
+      const Eigen::Vector3d mid_translation = 0.5 * (start_pose.translation() + end_pose.translation());
+      EXPECT_LE((mid_state.getGlobalLinkTransform(link_).translation() - mid_translation).norm(),
+                2.0 * precision.translational)
+          << "segment " << i;
+    }
+  }
+
+  static inline const MaxEEFStep MAX_STEP{ 0.01, 0.05 };
+
+  RobotModelPtr robot_model_;
+  JointModelGroup* jmg_;
+  const LinkModel* link_;
+  std::shared_ptr<planar_arm_kinematics::PlanarArmKinematics> solver_;
+  RobotStatePtr start_state_;
+  Eigen::Isometry3d target_;
+};
+
+TEST_F(PlanarArm, adaptiveMatchesSequential)
+{
+  std::vector<RobotStatePtr> sequential;
+  ASSERT_DOUBLE_EQ(computeSequential(sequential), 1.0);
+  const std::size_t sequential_queries = solver_->getQueryCount();
+
+  for (std::size_t threads : { 1, 4 })
+  {
+    SCOPED_TRACE(threads);
+    solver_->resetQueryCount();
+    std::vector<RobotStatePtr> adaptive;
+    ASSERT_DOUBLE_EQ(computeAdaptive(adaptive, threads), 1.0);
+    // interpolated waypoints save IK queries
+    EXPECT_LT(solver_->getQueryCount(), sequential_queries);
+
+    // same end points and precision guarantees as the sequential computation
+    ASSERT_GE(adaptive.size(), 2u);
+    EXPECT_EIGEN_NEAR(adaptive.front()->getGlobalLinkTransform(link_),
+                      sequential.front()->getGlobalLinkTransform(link_), 1e-9);
+    EXPECT_EIGEN_NEAR(adaptive.back()->getGlobalLinkTransform(link_), target_, 1e-9);
+    EXPECT_LE(adaptive.size(), sequential.size() + sequential.size() / 10);
+    expectFollowsLine(adaptive);
+  }
+}
+
+TEST_F(PlanarArm, adaptiveIsDeterministic)
+{
+  std::vector<RobotStatePtr> single_threaded, multi_threaded;
+  ASSERT_DOUBLE_EQ(computeAdaptive(single_threaded, 1), 1.0);
+  ASSERT_DOUBLE_EQ(computeAdaptive(multi_threaded, 4), 1.0);
+
+  ASSERT_EQ(single_threaded.size(), multi_threaded.size());
+  for (std::size_t i = 0; i < single_threaded.size(); ++i)
+  {
+    EXPECT_EQ(single_threaded[i]->distance(*multi_threaded[i], jmg_), 0.0) << "waypoint " << i;
+  }
+}
+
+TEST_F(PlanarArm, adaptiveStopsAtInvalidState)
+{
+  // the tip moves from x = 1.03 to x = 0.43, so the second half of the path is invalid
+  const GroupStateValidityCallbackFn valid_callback = [this](RobotState* state, const JointModelGroup* group,
+                                                             const double* values) {
+    state->setJointGroupPositions(group, values);
+    state->update();
+    return state->getGlobalLinkTransform(link_).translation().x() > 0.75;
+  };
+
+  std::vector<RobotStatePtr> sequential;
+  const double sequential_fraction = computeSequential(sequential, valid_callback);
+  ASSERT_GT(sequential_fraction, 0.0);
+  ASSERT_LT(sequential_fraction, 1.0);
+
+  for (std::size_t threads : { 1, 4 })
+  {
+    SCOPED_TRACE(threads);
+    std::vector<RobotStatePtr> adaptive;
+    EXPECT_DOUBLE_EQ(computeAdaptive(adaptive, threads, valid_callback), sequential_fraction);
+    for (const RobotStatePtr& waypoint : adaptive)
+    {
+      EXPECT_GT(waypoint->getGlobalLinkTransform(link_).translation().x(), 0.75);
+    }
+    EXPECT_EIGEN_NEAR(adaptive.back()->getGlobalLinkTransform(link_),
+                      sequential.back()->getGlobalLinkTransform(link_), 1e-9);
+  }
+}
+
+TEST_F(PlanarArm, adaptiveWaypoints)
+{
+  const Eigen::Isometry3d start_pose = start_state_->getGlobalLinkTransform(link_);
+  const EigenSTL::vector_Isometry3d waypoints = { target_, start_pose };
+
+  std::vector<RobotStatePtr> traj;
+  const double fraction = CartesianInterpolator::computeCartesianPathAdaptive(
+      start_state_.get(), jmg_, traj, link_, waypoints, true, MAX_STEP, CartesianPrecision{}, CartesianRefinement{});
+  EXPECT_DOUBLE_EQ(fraction, 1.0);
+  EXPECT_EIGEN_NEAR(traj.back()->getGlobalLinkTransform(link_), start_pose, 1e-9);
+  expectFollowsLine(traj);
+}
+
 // TODO - The tests below fail since no kinematic plugins are found. Move the tests to IK plugin package.
 // class PandaRobot : public testing::Test
 // {
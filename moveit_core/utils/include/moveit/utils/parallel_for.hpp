@@ -0,0 +1,108 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+/** \file parallel_for.hpp
+ *  \brief Run independent work items on a bounded number of threads
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace moveit
+{
+/** \brief The number of threads parallelFor() uses for \e count items when asked for \e num_threads.
+
+    0 asks for one thread per core. The result is never more than the number of cores or the number of items, and at
+    least 1. */
+inline std::size_t parallelThreadCount(std::size_t count, std::size_t num_threads)
+{
+  const std::size_t cores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  num_threads = num_threads == 0 ? cores : std::min(num_threads, cores);
+  return std::max<std::size_t>(std::min(num_threads, count), 1);
+}
+
+/** \brief Call task(index, worker) for every index in [0, count) on parallelThreadCount(count, num_threads) threads.
+
+    The calling thread is one of the workers. Indices are handed out one at a time, so items of uneven cost are
+    balanced between the threads. \e worker is in [0, parallelThreadCount(count, num_threads)) and is the same for all
+    calls made on one thread, so it can index per-thread scratch data such as a RobotState. Once a task throws, no
+    further indices are handed out and the first exception is rethrown after all threads have finished. */
+template <typename Task>
+void parallelFor(std::size_t count, std::size_t num_threads, const Task& task)
+{
+  const std::size_t threads = parallelThreadCount(count, num_threads);
+  if (threads == 1)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      task(i, std::size_t{ 0 });
+    return;
+  }
+
+  std::atomic<std::size_t> next_index{ 0 };
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  const auto work = [&](std::size_t worker) {
+    try
+    {
+      for (std::size_t i = next_index++; i < count; i = next_index++)
+        task(i, worker);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error)
+        error = std::current_exception();
+      next_index = count;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (std::size_t worker = 1; worker < threads; ++worker)
+    pool.emplace_back(work, worker);
+  work(0);
+  for (std::thread& thread : pool)
+    thread.join();
+  if (error)
+    std::rethrow_exception(error);
+}
+}  // namespace moveit
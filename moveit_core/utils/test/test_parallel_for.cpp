@@ -0,0 +1,89 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <moveit/utils/parallel_for.hpp>
+#include <set>
+#include <stdexcept>
+
+TEST(ParallelFor, ThreadCountIsBounded)
+{
+  const std::size_t cores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  EXPECT_EQ(moveit::parallelThreadCount(1000, 0), std::min<std::size_t>(cores, 1000));
+  EXPECT_EQ(moveit::parallelThreadCount(1000, 100000), std::min<std::size_t>(cores, 1000));
+  EXPECT_EQ(moveit::parallelThreadCount(2, 0), std::min<std::size_t>(cores, 2));
+  EXPECT_EQ(moveit::parallelThreadCount(0, 4), 1u);
+  EXPECT_EQ(moveit::parallelThreadCount(10, 1), 1u);
+}
+
+TEST(ParallelFor, EveryIndexOnce)
+{
+  const std::size_t count = 10000;
+  const std::size_t threads = moveit::parallelThreadCount(count, 0);
+  std::vector<int> calls(count, 0);
+  std::vector<std::set<std::thread::id>> worker_threads(threads);
+  std::mutex mutex;
+  moveit::parallelFor(count, 0, [&](std::size_t i, std::size_t worker) {
+    ++calls[i];
+    ASSERT_LT(worker, threads);
+    std::lock_guard<std::mutex> lock(mutex);
+    worker_threads[worker].insert(std::this_thread::get_id());
+  });
+  for (std::size_t i = 0; i < count; ++i)
+    EXPECT_EQ(calls[i], 1) << "index " << i;
+  // a worker index always refers to the same thread
+  for (const auto& ids : worker_threads)
+    EXPECT_LE(ids.size(), 1u);
+}
+
+TEST(ParallelFor, NoItems)
+{
+  bool called = false;
+  moveit::parallelFor(0, 4, [&](std::size_t /* index */, std::size_t /* worker */) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(ParallelFor, ExceptionIsRethrown)
+{
+  std::atomic<std::size_t> calls{ 0 };
+  EXPECT_THROW(moveit::parallelFor(1000, 0,
+                                   [&](std::size_t i, std::size_t /* worker */) {
+                                     ++calls;
+                                     if (i == 10)
+                                       throw std::runtime_error("item failed");
+                                   }),
+               std::runtime_error);
+  EXPECT_LE(calls.load(), 1000u);
+}
@@ -39,6 +39,7 @@
 #include <ompl/base/goals/GoalLazySamples.h>
 #include <moveit/kinematic_constraints/kinematic_constraint.hpp>
 #include <moveit/constraint_samplers/constraint_sampler.hpp>
+#include <moveit/ompl_interface/detail/goal_sample_cache.hpp>
 
 #include <moveit/robot_state/robot_state.hpp>
 #include <moveit/robot_model/joint_model_group.hpp>
@@ -48,14 +49,21 @@ namespace ompl_interface
 class ModelBasedPlanningContext;
 
 /** @class ConstrainedGoalSampler
- *  An interface to the OMPL goal lazy sampler*/
+ *  An interface to the OMPL goal lazy sampler
+ *
+ *  If a goal sample cache is given, the configurations cached for @e goal_key are offered (after revalidation)
+ *  before new samples are computed, and newly found goal configurations are added to the cache. */
 class ConstrainedGoalSampler : public ompl::base::GoalLazySamples
 {
 public:
   ConstrainedGoalSampler(const ModelBasedPlanningContext* pc, kinematic_constraints::KinematicConstraintSetPtr ks,
-                         constraint_samplers::ConstraintSamplerPtr cs = constraint_samplers::ConstraintSamplerPtr());
+                         constraint_samplers::ConstraintSamplerPtr cs = constraint_samplers::ConstraintSamplerPtr(),
+                         GoalSampleCachePtr goal_sample_cache = GoalSampleCachePtr(), std::size_t goal_key = 0);
 
 private:
+  bool sampleFromCache(const ompl::base::GoalLazySamples* gls, ompl::base::State* new_goal);
+  void addToCache();
+
   bool sampleUsingConstraintSampler(const ompl::base::GoalLazySamples* gls, ompl::base::State* new_goal);
   bool stateValidityCallback(ompl::base::State* new_goal, const moveit::core::RobotState* state,
                              const moveit::core::JointModelGroup* /*jmg*/, const double* /*jpos*/,
@@ -68,6 +76,9 @@ private:
   constraint_samplers::ConstraintSamplerPtr constraint_sampler_;
   ompl::base::StateSamplerPtr default_sampler_;
   moveit::core::RobotState work_state_;
+  GoalSampleCachePtr goal_sample_cache_;
+  std::size_t goal_key_;
+  std::vector<std::vector<double>> cached_samples_;
   unsigned int invalid_sampled_constraints_;
   bool warned_invalid_samples_;
   unsigned int verbose_display_;
@@ -0,0 +1,161 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+#include <moveit/macros/class_forward.hpp>
+#include <moveit/planning_scene/planning_scene.hpp>
+#include <ompl/tools/experience/ExperienceSetup.h>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ompl_interface
+{
+MOVEIT_CLASS_FORWARD(ExperienceRegistry);  // Defines ExperienceRegistryPtr, ConstPtr, WeakPtr... etc
+
+/** @class ExperienceStatsProvider
+ *  @brief Access to the statistics an OMPL experience planner keeps about how it solved its queries */
+class ExperienceStatsProvider
+{
+public:
+  virtual ~ExperienceStatsProvider() = default;
+
+  /** @brief The planner's own counts of solutions recalled, planned from scratch or failed, updated by solve() */
+  virtual const ompl::tools::ExperienceSetup::ExperienceStats& getExperienceStats() const = 0;
+};
+
+/** @brief An experience planner (ompl::tools::Lightning or Thunder) that gives access to its statistics */
+template <class ExperiencePlanner>
+class ExperiencePlannerWithStats : public ExperiencePlanner, public ExperienceStatsProvider
+{
+public:
+  using ExperiencePlanner::ExperiencePlanner;
+
+  const ompl::tools::ExperienceSetup::ExperienceStats& getExperienceStats() const override
+  {
+    return this->stats_;
+  }
+};
+
+/** @class ExperienceRegistry
+ *  @brief Bookkeeping for experience-based planning (OMPL Lightning / Thunder), shared between planning contexts.
+ *
+ *  Experience databases are stored on disk, one file per planning group and scene fingerprint, so experiences
+ *  recorded in one environment are not recalled in another. The registry names these files, serializes writes to
+ *  them, and keeps recall statistics per database. Only the most recently used databases are kept: older ones are
+ *  evicted from memory, and the oldest files are removed from the storage directory. */
+class ExperienceRegistry
+{
+public:
+  static constexpr std::size_t DEFAULT_MAX_DATABASES = 16;
+
+  /** @brief Keep at most @e max_databases databases in use and in each storage directory */
+  explicit ExperienceRegistry(std::size_t max_databases = DEFAULT_MAX_DATABASES);
+
+  struct Statistics
+  {
+    /// number of planning problems solved with this database
+    std::size_t problems = 0;
+    /// number of solutions obtained by recalling and repairing a stored path
+    std::size_t solved_from_recall = 0;
+    /// number of solutions obtained by planning from scratch
+    std::size_t solved_from_scratch = 0;
+    /// number of problems for which no solution was found
+    std::size_t failures = 0;
+    /// accumulated planning time [s] of solutions recalled from the database
+    double recall_planning_time = 0.0;
+    /// accumulated planning time [s] of solutions planned from scratch
+    double scratch_planning_time = 0.0;
+
+    /** @brief Fraction of the solved problems that were solved from recall */
+    double getRecallRate() const;
+
+    /** @brief Estimated planning time [s] saved by recall, relative to the average time for planning from scratch */
+    double getTimeSaved() const;
+  };
+
+  /** @brief Get the default directory for experience databases: $ROS_HOME/ompl_experience (~/.ros by default) */
+  static std::string getDefaultStoragePath();
+
+  /** @brief Compute a fingerprint of the collision geometry in the world of @e scene
+   *
+   *  Only the ids and shapes of the objects are part of the fingerprint, so moving objects around reuses the same
+   *  experiences. The octomap and attached objects are not part of the fingerprint either. */
+  static std::size_t computeSceneFingerprint(const planning_scene::PlanningScene& scene);
+
+  /** @brief Get the database file for @e group and @e scene_fingerprint in @e storage_path
+   *
+   *  The default storage path is used if @e storage_path is empty. The directory is created if it does not exist.
+   *  If the file does not exist yet, the least recently written databases in the directory are removed to make room
+   *  for it. An empty string is returned if the directory cannot be created. */
+  std::string getDatabasePath(const std::string& storage_path, const std::string& group,
+                              std::size_t scene_fingerprint) const;
+
+  /** @brief Mark @e database as the most recently used one
+   *  @return The databases that are no longer kept in use, least recently used first. Their statistics are dropped,
+   *          and their planning contexts should be released, which saves their experiences. */
+  std::vector<std::string> useDatabase(const std::string& database);
+
+  /** @brief Record the outcome of a planning problem solved with @e database
+   *  @param solved Whether a solution was found
+   *  @param from_recall Whether the solution was obtained from recall (only meaningful if solved)
+   *  @param planning_time The time spent planning [s] */
+  void recordSolution(const std::string& database, bool solved, bool from_recall, double planning_time);
+
+  /** @brief Store new experiences of @e experience_setup in its database file, if there are any
+   *
+   *  Writing the database takes a while, so this is called when a planning context is released rather than after
+   *  every solve. */
+  bool save(ompl::tools::ExperienceSetup& experience_setup) const;
+
+  /** @brief Get the statistics of @e database (zero if it was not used) */
+  Statistics getStatistics(const std::string& database) const;
+
+private:
+  std::size_t max_databases_;
+  /// databases in use, most recently used first
+  std::list<std::string> used_databases_;
+  std::map<std::string, Statistics> statistics_;
+  /// protects used_databases_ and statistics_
+  mutable std::mutex statistics_lock_;
+  /// serializes database writes, as several contexts may use the same file
+  mutable std::mutex file_lock_;
+};
+}  // namespace ompl_interface
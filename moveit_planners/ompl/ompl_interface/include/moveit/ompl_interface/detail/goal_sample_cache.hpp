@@ -0,0 +1,114 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/macros/class_forward.hpp>
+#include <moveit_msgs/msg/constraints.hpp>
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ompl_interface
+{
+MOVEIT_CLASS_FORWARD(GoalSampleCache);  // Defines GoalSampleCachePtr, ConstPtr, WeakPtr... etc
+
+/** @class GoalSampleCache
+ *  @brief Thread-safe store of valid goal configurations, shared between planning attempts and planning contexts.
+ *
+ *  Goal configurations (joint group positions) are stored per goal key, which identifies a planning group and the
+ *  goal constraints it was sampled for. ConstrainedGoalSampler hands out the cached configurations before running
+ *  new (IK) sampling. Cached configurations are revalidated against the current planning scene before use, and
+ *  configurations that became invalid are removed. The least recently used goals are evicted first. */
+class GoalSampleCache
+{
+public:
+  struct Statistics
+  {
+    /// number of goal samples that were served from the cache
+    std::size_t hits = 0;
+    /// number of goal samples that had to be computed because the cache had no (more) valid samples
+    std::size_t misses = 0;
+    /// number of cached samples that were rejected by revalidation against the current scene
+    std::size_t rejected = 0;
+  };
+
+  /** @brief Constructor
+   *  @param max_samples_per_goal The maximum number of configurations stored per goal key
+   *  @param max_goals The maximum number of goal keys to store before evicting the least recently used one */
+  GoalSampleCache(std::size_t max_samples_per_goal = 10, std::size_t max_goals = 100);
+
+  /** @brief Compute the key that identifies the goal @e constraints for @e group */
+  static std::size_t computeKey(const std::string& group, const moveit_msgs::msg::Constraints& constraints);
+
+  /** @brief Get a copy of the configurations cached for @e key (empty if none are stored) */
+  std::vector<std::vector<double>> getSamples(std::size_t key);
+
+  /** @brief Store a valid goal configuration for @e key. Duplicates of already stored configurations are ignored. */
+  void addSample(std::size_t key, const std::vector<double>& sample);
+
+  /** @brief Remove a cached configuration that is no longer valid */
+  void removeSample(std::size_t key, const std::vector<double>& sample);
+
+  void recordHit();
+  void recordMiss();
+
+  Statistics getStatistics() const;
+
+  /** @brief Remove all cached configurations and reset the statistics */
+  void clear();
+
+private:
+  struct Entry
+  {
+    std::vector<std::vector<double>> samples;
+    std::list<std::size_t>::iterator lru_position;
+  };
+
+  /** @brief Mark @e entry as most recently used. The lock must be held. */
+  void touch(Entry& entry);
+
+  std::size_t max_samples_per_goal_;
+  std::size_t max_goals_;
+
+  std::unordered_map<std::size_t, Entry> entries_;
+  std::list<std::size_t> lru_;
+  Statistics statistics_;
+  mutable std::mutex lock_;
+};
+}  // namespace ompl_interface
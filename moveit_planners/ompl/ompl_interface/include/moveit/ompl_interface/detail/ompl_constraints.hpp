@@ -36,7 +36,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ostream>
+#include <vector>
 
 #include <ompl/base/Constraint.h>
 
@@ -130,6 +132,7 @@ public:
    *
    * This is necessary because we cannot call the pure virtual
    * parseConstraintsMsg method from the constructor of this class.
+   * It also resolves the constrained link model used by the kinematics cache.
    * */
   void init(const moveit_msgs::msg::Constraints& constraints);
 
@@ -148,19 +151,17 @@ public:
 
   /** \brief Wrapper for forward kinematics calculated by MoveIt's Robot State.
    *
-   * TODO(jeroendm) Are these actually const, as the robot state is modified? How come it works?
-   * Also, output arguments could be significantly more performant,
-   * but MoveIt's robot state does not support passing Eigen::Ref objects at the moment.
+   * The link transform is cached per thread, so repeated calls for the same joint values (e.g. `function` followed
+   * by `jacobian` inside OMPL's Newton projection) only compute forward kinematics once.
    * */
-  Eigen::Isometry3d forwardKinematics(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const;
+  const Eigen::Isometry3d& forwardKinematics(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const;
 
   /** \brief Calculate the robot's geometric Jacobian using MoveIt's Robot State.
    *
-   * Ideally I would pass the output argument from OMPL's jacobian function directly,
-   * but I cannot pass an object of type , Eigen::Ref<Eigen::MatrixXd> to MoveIt's
-   * Jacobian method.
+   * The Jacobian is computed from the same cached link transforms as `forwardKinematics` and written into a
+   * thread-local buffer. The returned reference stays valid until the next kinematics query from the same thread.
    * */
-  Eigen::MatrixXd robotGeometricJacobian(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const;
+  const Eigen::MatrixXd& robotGeometricJacobian(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const;
 
   /** \brief Parse bounds on position and orientation parameters from MoveIt's constraint message.
    *
@@ -211,6 +212,35 @@ public:
   }
 
 protected:
+  /** \brief Per-thread kinematics buffers for the last evaluated joint values of one constraint. */
+  struct KinematicsCache
+  {
+    /** \brief `kinematics_cache_id_` of the constraint the buffers belong to, 0 when unused. */
+    std::uint64_t owner_id{ 0 };
+    /** \brief Value of the thread's use counter at the last query, to find the least recently used slot. */
+    std::uint64_t last_used{ 0 };
+    moveit::core::RobotState* robot_state{ nullptr };
+    Eigen::VectorXd joint_values;
+    Eigen::Isometry3d link_transform{ Eigen::Isometry3d::Identity() };
+    Eigen::MatrixXd jacobian;
+    bool jacobian_valid{ false };
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /** \brief Update the calling thread's kinematics cache for the given joint values.
+   *
+   * The robot state is only written, and forward kinematics only recomputed, when the joint values differ from the
+   * last call on this thread. The Jacobian is computed lazily from the same link transforms when requested.
+   *
+   * Every thread has a fixed number of cache slots, shared by all constraints, so that e.g. the position and
+   * orientation constraints of an intersection keep their own buffers. When all slots are in use, the least recently
+   * used one is taken over. The slots are freed with their thread, so they do not accumulate over the threads and
+   * constraints a planner goes through.
+   * */
+  const KinematicsCache& updateKinematics(const Eigen::Ref<const Eigen::VectorXd>& joint_values,
+                                          bool compute_jacobian) const;
+
   /** \brief Thread-safe storage of the robot state.
    *
    * The robot state is modified for kinematic calculations. As an instance of this class is possibly used in multiple
@@ -219,6 +249,12 @@ protected:
   TSStateStorage state_storage_;
   const moveit::core::JointModelGroup* joint_model_group_;
 
+  /** \brief Link model for `link_name_`, resolved in `init`. */
+  const moveit::core::LinkModel* link_model_;
+
+  /** \brief Identifies the cache slots of this constraint, unique over all constraints and renewed by `init`. */
+  std::uint64_t kinematics_cache_id_;
+
   // all attributes below can be considered const as soon as the constraint message is parsed
   // but I (jeroendm) do not know how to elegantly express this in C++
   // parsing the constraints message and passing all this data members separately to the constructor
@@ -441,6 +477,17 @@ ompl::base::ConstraintPtr createOMPLConstraints(const moveit::core::RobotModelCo
                                                 const std::string& group,
                                                 const moveit_msgs::msg::Constraints& constraints);
 
+/** \brief Project a batch of joint configurations onto the constraint manifold.
+ *
+ * Every column of `states` is projected in place using `constraint.project`. Projections are independent and run in
+ * parallel (OpenMP), relying on the per-thread kinematics buffers of the constraints. `success[i]` reports whether
+ * column `i` was projected within the constraint tolerance.
+ *
+ * \return the number of successfully projected states.
+ * */
+std::size_t projectStates(const ompl::base::Constraint& constraint, Eigen::Ref<Eigen::MatrixXd> states,
+                          std::vector<bool>& success);
+
 /** \brief  Return a matrix to convert angular velocity to angle-axis velocity
  *  Based on:
  * https://ethz.ch/content/dam/ethz/special-interest/mavt/robotics-n-intelligent-systems/rsl-dam/documents/RobotDynamics2016/RD2016script.pdf
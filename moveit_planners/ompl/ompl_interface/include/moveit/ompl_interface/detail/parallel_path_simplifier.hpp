@@ -0,0 +1,92 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/OptimizationObjective.h>
+#include <ompl/base/PlannerTerminationCondition.h>
+#include <ompl/geometric/PathGeometric.h>
+
+#include <utility>
+#include <vector>
+
+namespace ompl_interface
+{
+/** @class ParallelPathSimplifier
+ *  @brief Simplify a geometric path by running OMPL's PathSimplifier concurrently on disjoint windows of the path.
+ *
+ *  The path is split into consecutive windows that share their boundary states. Each window is shortcut
+ *  independently in its own thread, which keeps all window end points (and therefore the overall path end points)
+ *  fixed. The simplified windows are then joined and reconciled: the shared boundary states are bridged where
+ *  possible, using a batch of motion validity checks that is evaluated in parallel, before a final serial
+ *  reduction pass runs over the joined path. */
+class ParallelPathSimplifier
+{
+public:
+  /** @brief Constructor
+   *  @param si The space information used for motion validation
+   *  @param thread_count The maximum number of threads to use, capped at the number of cores; 0 or 1 runs OMPL's
+   *  serial simplification
+   *  @param objective Optional optimization objective used by the underlying path simplifiers */
+  ParallelPathSimplifier(const ompl::base::SpaceInformationPtr& si, unsigned int thread_count,
+                         const ompl::base::OptimizationObjectivePtr& objective = nullptr);
+
+  /** @brief Simplify @e path in place until it cannot be improved or @e ptc evaluates to true.
+   *  @return True if the simplified path is valid, like og::PathSimplifier::simplify(). This does not report whether
+   *  the path was changed. */
+  bool simplify(ompl::geometric::PathGeometric& path, const ompl::base::PlannerTerminationCondition& ptc) const;
+
+  /** @brief Check all motions (edges) of @e path, distributing the checks over the available threads.
+   *  @return True if all motions are valid */
+  bool checkMotions(const ompl::geometric::PathGeometric& path) const;
+
+  unsigned int getThreadCount() const
+  {
+    return thread_count_;
+  }
+
+  /** @brief Minimum number of segments a window must contain for the path to be split into windows */
+  static constexpr std::size_t MIN_WINDOW_SEGMENTS = 4;
+
+private:
+  /** @brief Evaluate the motions between the given pairs of states in parallel, storing the result per pair */
+  void checkMotionBatch(const std::vector<std::pair<const ompl::base::State*, const ompl::base::State*>>& motions,
+                        std::vector<char>& valid) const;
+
+  ompl::base::SpaceInformationPtr si_;
+  unsigned int thread_count_;
+  ompl::base::OptimizationObjectivePtr objective_;
+};
+}  // namespace ompl_interface
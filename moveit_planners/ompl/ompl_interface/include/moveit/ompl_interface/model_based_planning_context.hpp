@@ -37,6 +37,8 @@
 #pragma once
 
 #include <moveit/ompl_interface/parameterization/model_based_state_space.hpp>
+#include <moveit/ompl_interface/detail/goal_sample_cache.hpp>
+#include <moveit/ompl_interface/detail/experience_registry.hpp>
 #include <moveit/constraint_samplers/constraint_sampler_manager.hpp>
 #include <moveit/planning_interface/planning_interface.hpp>
 
@@ -82,6 +84,20 @@ struct ModelBasedPlanningContextSpecification
    * ConstrainedSpaceInformation object from it).
    * */
   ob::ConstrainedStateSpacePtr constrained_state_space_;
+
+  /** \brief Cache of valid goal configurations, shared between planning contexts.
+   *
+   * It is only used when the parameter "cache_goal_samples" is set to true for the planner configuration. */
+  GoalSampleCachePtr goal_sample_cache_;
+
+  /** \brief Bookkeeping of experience databases, shared between planning contexts.
+   *
+   * It is only used when `ompl_simple_setup_` is an experience planner, selected with the parameter
+   * "experience_planner" of the planner configuration. */
+  ExperienceRegistryPtr experience_registry_;
+
+  /** \brief Database file the experience planner loads and stores its experiences in. */
+  std::string experience_database_;
 };
 
 class ModelBasedPlanningContext : public planning_interface::PlanningContext
@@ -89,9 +105,8 @@ class ModelBasedPlanningContext : public planning_interface::PlanningContext
 public:
   ModelBasedPlanningContext(const std::string& name, const ModelBasedPlanningContextSpecification& spec);
 
-  ~ModelBasedPlanningContext() override
-  {
-  }
+  /** \brief Stores the new experiences of an experience planner in its database */
+  ~ModelBasedPlanningContext() override;
 
   void solve(planning_interface::MotionPlanResponse& res) override;
   void solve(planning_interface::MotionPlanDetailedResponse& res) override;
@@ -240,6 +255,18 @@ public:
     spec_.constraint_sampler_manager_ = csm;
   }
 
+  /** \brief Get the goal sample cache, if the planner configuration enables caching of goal samples */
+  GoalSampleCachePtr getGoalSampleCache() const;
+
+  /** \brief Whether this context plans with an experience planner (OMPL Lightning or Thunder) */
+  bool usesExperience() const
+  {
+    return static_cast<bool>(experience_setup_);
+  }
+
+  /** \brief Get the recall statistics of the experience database used by this context */
+  ExperienceRegistry::Statistics getExperienceStatistics() const;
+
   void setVerboseStateValidityChecks(bool flag);
 
   void setProjectionEvaluator(const std::string& peval);
@@ -289,6 +316,30 @@ public:
     hybridize_ = flag;
   }
 
+  /* \brief Get the number of threads used to simplify solution paths */
+  unsigned int getSimplificationThreads() const
+  {
+    return simplification_threads_;
+  }
+
+  /* \brief Set the number of threads used to simplify solution paths; 1 keeps OMPL's serial simplification */
+  void setSimplificationThreads(unsigned int simplification_threads)
+  {
+    simplification_threads_ = simplification_threads;
+  }
+
+  /* \brief Get the maximum time (in seconds) spent on simplifying a solution path; 0 means no extra limit */
+  double getSimplificationTimeout() const
+  {
+    return simplification_timeout_;
+  }
+
+  /* \brief Set the maximum time (in seconds) spent on simplifying a solution path; 0 means no extra limit */
+  void setSimplificationTimeout(double simplification_timeout)
+  {
+    simplification_timeout_ = simplification_timeout;
+  }
+
   /* @brief Solve the planning problem. Return true if the problem is solved
      @param timeout The time to spend on solving
      @param count The number of runs to combine the paths of, in an attempt to generate better quality paths
@@ -316,7 +367,9 @@ public:
   }
 
   /* @brief Apply smoothing and try to simplify the plan
-     @param timeout The amount of time allowed to be spent on simplifying the plan*/
+     @param timeout The amount of time allowed to be spent on simplifying the plan; this is further limited by the
+     simplification timeout, if one is set. With more than one simplification thread, the path is shortcut in
+     parallel windows (see ParallelPathSimplifier).*/
   void simplifySolution(double timeout);
 
   /* @brief Interpolate the solution*/
@@ -348,6 +401,10 @@ protected:
   void preSolve();
   void postSolve();
 
+  /** \brief Record the outcome of the last solve in the experience statistics and add its solution to the experiences
+   * in memory. The experience planner had recalled @e recalled_before solutions before that solve. */
+  void recordExperience(double recalled_before);
+
   void startSampling();
   void stopSampling();
 
@@ -397,6 +454,12 @@ protected:
   /// the OMPL planning context; this contains the problem definition and the planner used
   og::SimpleSetupPtr ompl_simple_setup_;
 
+  /// ompl_simple_setup_ as experience planner, or null if it does not plan from experience
+  std::shared_ptr<ot::ExperienceSetup> experience_setup_;
+
+  /// the statistics experience_setup_ keeps of its own queries
+  std::shared_ptr<ExperienceStatsProvider> experience_stats_;
+
   /// the OMPL tool for benchmarking planners
   ot::Benchmark ompl_benchmark_;
 
@@ -408,6 +471,8 @@ protected:
   kinematic_constraints::KinematicConstraintSetPtr path_constraints_;
   moveit_msgs::msg::Constraints path_constraints_msg_;
   std::vector<kinematic_constraints::KinematicConstraintSetPtr> goal_constraints_;
+  /// keys of the goal constraints in the goal sample cache, in the same order as goal_constraints_
+  std::vector<std::size_t> goal_sample_cache_keys_;
 
   const ob::PlannerTerminationCondition* ptc_;
   std::mutex ptc_lock_;
@@ -452,5 +517,11 @@ protected:
 
   // if false parallel plan returns the first solution found
   bool hybridize_;
+
+  /// number of threads used to simplify solution paths; with 1 thread OMPL's serial simplifier is used
+  unsigned int simplification_threads_;
+
+  /// the maximum time spent simplifying a solution path, in addition to the remaining planning time; 0 to disable
+  double simplification_timeout_;
 };
 }  // namespace ompl_interface
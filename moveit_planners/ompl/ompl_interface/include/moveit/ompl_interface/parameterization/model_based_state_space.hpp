@@ -257,6 +257,15 @@ public:
   double getTagSnapToSegment() const;
   void setTagSnapToSegment(double snap);
 
+  /** \brief True if all variables of the group belong to bounded revolute or prismatic joints.
+   *
+   * In that case distance() and interpolate() operate directly on the contiguous values array, instead of
+   * dispatching to every joint model. */
+  bool hasOnlyLinearJoints() const
+  {
+    return linear_joints_only_;
+  }
+
 protected:
   ModelBasedStateSpaceSpecification spec_;
   std::vector<moveit::core::JointModel::Bounds> joint_bounds_storage_;
@@ -269,5 +278,9 @@ protected:
 
   double tag_snap_to_segment_;
   double tag_snap_to_segment_complement_;
+
+  bool linear_joints_only_;
+  /// distance factor of every variable, only used if linear_joints_only_ is true
+  Eigen::VectorXd variable_distance_factors_;
 };
 }  // namespace ompl_interface
@@ -206,6 +206,22 @@ public:
 
   ConfiguredPlannerSelector getPlannerSelector() const;
 
+  /** \brief Get the cache of goal configurations shared by all planning contexts of this manager.
+   *
+   * Caching is enabled per planner configuration with the parameter "cache_goal_samples". */
+  const GoalSampleCachePtr& getGoalSampleCache() const
+  {
+    return goal_sample_cache_;
+  }
+
+  /** \brief Get the bookkeeping of experience databases shared by all planning contexts of this manager.
+   *
+   * Experience-based planning is enabled per planner configuration with the parameter "experience_planner". */
+  const ExperienceRegistryPtr& getExperienceRegistry() const
+  {
+    return experience_registry_;
+  }
+
 protected:
   ConfiguredPlannerAllocator plannerSelector(const std::string& planner) const;
 
@@ -215,10 +231,18 @@ protected:
   template <typename T>
   void registerPlannerAllocatorHelper(const std::string& planner_id);
 
-  /** \brief This is the function that constructs new planning contexts if no previous ones exist that are suitable */
+  /** \brief This is the function that constructs new planning contexts if no previous ones exist that are suitable
+   *
+   * If @e experience_database is not empty, the context plans with the configured experience planner and stores its
+   * experiences in that file. */
   ModelBasedPlanningContextPtr getPlanningContext(const planning_interface::PlannerConfigurationSettings& config,
                                                   const ModelBasedStateSpaceFactoryPtr& factory,
-                                                  const moveit_msgs::msg::MotionPlanRequest& req) const;
+                                                  const moveit_msgs::msg::MotionPlanRequest& req,
+                                                  const std::string& experience_database = std::string()) const;
+
+  /** \brief Drop the cached planning contexts that use @e experience_database. Each context saves its experiences
+   * when it is released, i.e. right away unless it is still planning. */
+  void releaseExperienceContexts(const std::string& experience_database) const;
 
   const ModelBasedStateSpaceFactoryPtr& getStateSpaceFactory(const std::string& factory_type) const;
   const ModelBasedStateSpaceFactoryPtr& getStateSpaceFactory(const std::string& group_name,
@@ -263,6 +287,12 @@ protected:
   /// Multi-query planner allocator
   MultiQueryPlannerAllocator planner_allocator_;
 
+  /// Valid goal configurations, shared between planning contexts and planning attempts
+  GoalSampleCachePtr goal_sample_cache_;
+
+  /// Experience database files and their recall statistics, shared between planning contexts
+  ExperienceRegistryPtr experience_registry_;
+
 private:
   MOVEIT_STRUCT_FORWARD(CachedContexts);
   CachedContextsPtr cached_contexts_;
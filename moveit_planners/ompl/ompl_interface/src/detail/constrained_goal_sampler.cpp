@@ -53,7 +53,8 @@ rclcpp::Logger getLogger()
 
 ConstrainedGoalSampler::ConstrainedGoalSampler(const ModelBasedPlanningContext* pc,
                                                kinematic_constraints::KinematicConstraintSetPtr ks,
-                                               constraint_samplers::ConstraintSamplerPtr cs)
+                                               constraint_samplers::ConstraintSamplerPtr cs,
+                                               GoalSampleCachePtr goal_sample_cache, std::size_t goal_key)
   : ob::GoalLazySamples(
         pc->getOMPLSimpleSetup()->getSpaceInformation(),
         [this](const GoalLazySamples* gls, ompl::base::State* state) {
@@ -64,12 +65,19 @@ ConstrainedGoalSampler::ConstrainedGoalSampler(const ModelBasedPlanningContext*
   , kinematic_constraint_set_(std::move(ks))
   , constraint_sampler_(std::move(cs))
   , work_state_(pc->getCompleteInitialRobotState())
+  , goal_sample_cache_(std::move(goal_sample_cache))
+  , goal_key_(goal_key)
   , invalid_sampled_constraints_(0)
   , warned_invalid_samples_(false)
   , verbose_display_(0)
 {
   if (!constraint_sampler_)
     default_sampler_ = si_->allocStateSampler();
+  if (goal_sample_cache_)
+  {
+    cached_samples_ = goal_sample_cache_->getSamples(goal_key_);
+    RCLCPP_DEBUG(getLogger(), "Found %zu cached goal samples", cached_samples_.size());
+  }
   RCLCPP_DEBUG(getLogger(), "Constructed a ConstrainedGoalSampler instance at address %p", this);
   startSampling();
 }
@@ -92,6 +100,35 @@ bool ConstrainedGoalSampler::stateValidityCallback(ob::State* new_goal, const mo
   return checkStateValidity(new_goal, solution_state, verbose);
 }
 
+bool ConstrainedGoalSampler::sampleFromCache(const ob::GoalLazySamples* gls, ob::State* new_goal)
+{
+  // the scene or the start state may have changed since the samples were cached, so they are checked again
+  while (!cached_samples_.empty() && gls->isSampling())
+  {
+    const std::vector<double> sample = std::move(cached_samples_.back());
+    cached_samples_.pop_back();
+    work_state_.setJointGroupPositions(planning_context_->getJointModelGroup(), sample);
+    work_state_.update();
+    if (kinematic_constraint_set_->decide(work_state_).satisfied && checkStateValidity(new_goal, work_state_))
+    {
+      goal_sample_cache_->recordHit();
+      return true;
+    }
+    goal_sample_cache_->removeSample(goal_key_, sample);
+  }
+  return false;
+}
+
+void ConstrainedGoalSampler::addToCache()
+{
+  if (!goal_sample_cache_)
+    return;
+  std::vector<double> sample;
+  work_state_.copyJointGroupPositions(planning_context_->getJointModelGroup(), sample);
+  goal_sample_cache_->addSample(goal_key_, sample);
+  goal_sample_cache_->recordMiss();
+}
+
 bool ConstrainedGoalSampler::sampleUsingConstraintSampler(const ob::GoalLazySamples* gls, ob::State* new_goal)
 {
   unsigned int max_attempts = planning_context_->getMaximumGoalSamplingAttempts();
@@ -109,6 +146,9 @@ bool ConstrainedGoalSampler::sampleUsingConstraintSampler(const ob::GoalLazySamp
   if (planning_context_->getOMPLSimpleSetup()->getProblemDefinition()->hasSolution())
     return false;
 
+  if (goal_sample_cache_ && sampleFromCache(gls, new_goal))
+    return true;
+
   unsigned int max_attempts_div2 = max_attempts / 2;
   for (unsigned int a = gls->samplingAttemptsCount(); a < max_attempts && gls->isSampling(); ++a)
   {
@@ -139,7 +179,10 @@ bool ConstrainedGoalSampler::sampleUsingConstraintSampler(const ob::GoalLazySamp
         if (kinematic_constraint_set_->decide(work_state_, verbose).satisfied)
         {
           if (checkStateValidity(new_goal, work_state_, verbose))
+          {
+            addToCache();
             return true;
+          }
         }
         else
         {
@@ -161,7 +204,10 @@ bool ConstrainedGoalSampler::sampleUsingConstraintSampler(const ob::GoalLazySamp
       {
         planning_context_->getOMPLStateSpace()->copyToRobotState(work_state_, new_goal);
         if (kinematic_constraint_set_->decide(work_state_, verbose).satisfied)
+        {
+          addToCache();
           return true;
+        }
       }
     }
   }
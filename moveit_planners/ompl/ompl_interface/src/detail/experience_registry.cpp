@@ -0,0 +1,223 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <moveit/ompl_interface/detail/experience_registry.hpp>
+#include <moveit/utils/logger.hpp>
+#include <moveit_msgs/msg/planning_scene_components.hpp>
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace ompl_interface
+{
+namespace
+{
+rclcpp::Logger getLogger()
+{
+  return moveit::getLogger("moveit.planners.ompl.experience_registry");
+}
+
+// Remove the least recently written databases in directory until at most max_count are left
+void pruneStorage(const std::filesystem::path& directory, std::size_t max_count)
+{
+  std::error_code error;
+  std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> databases;
+  for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+  {
+    if (entry.is_regular_file(error) && entry.path().extension() == ".db")
+    {
+      databases.emplace_back(entry.last_write_time(error), entry.path());
+    }
+  }
+  if (databases.size() <= max_count)
+    return;
+
+  std::sort(databases.begin(), databases.end());
+  for (std::size_t i = 0; i + max_count < databases.size(); ++i)
+  {
+    RCLCPP_INFO(getLogger(), "Removing the least recently used experience database '%s'",
+                databases[i].second.c_str());
+    std::filesystem::remove(databases[i].second, error);
+  }
+}
+}  // namespace
+
+ExperienceRegistry::ExperienceRegistry(std::size_t max_databases)
+  : max_databases_(std::max<std::size_t>(max_databases, 1))
+{
+}
+
+double ExperienceRegistry::Statistics::getRecallRate() const
+{
+  const std::size_t solved = solved_from_recall + solved_from_scratch;
+  return solved == 0 ? 0.0 : static_cast<double>(solved_from_recall) / static_cast<double>(solved);
+}
+
+double ExperienceRegistry::Statistics::getTimeSaved() const
+{
+  if (solved_from_scratch == 0 || solved_from_recall == 0)
+    return 0.0;
+  const double average_scratch_time = scratch_planning_time / static_cast<double>(solved_from_scratch);
+  return std::max(0.0, average_scratch_time * static_cast<double>(solved_from_recall) - recall_planning_time);
+}
+
+std::string ExperienceRegistry::getDefaultStoragePath()
+{
+  std::filesystem::path path;
+  if (const char* ros_home = std::getenv("ROS_HOME"))
+  {
+    path = ros_home;
+  }
+  else if (const char* home = std::getenv("HOME"))
+  {
+    path = std::filesystem::path(home) / ".ros";
+  }
+  else
+  {
+    path = std::filesystem::temp_directory_path();
+  }
+  return (path / "ompl_experience").string();
+}
+
+std::size_t ExperienceRegistry::computeSceneFingerprint(const planning_scene::PlanningScene& scene)
+{
+  moveit_msgs::msg::PlanningSceneComponents components;
+  components.components = moveit_msgs::msg::PlanningSceneComponents::WORLD_OBJECT_GEOMETRY;
+  moveit_msgs::msg::PlanningScene scene_msg;
+  scene.getPlanningSceneMsg(scene_msg, components);
+
+  // hash the serialized shapes without their poses, so only adding, removing or reshaping objects changes it
+  for (moveit_msgs::msg::CollisionObject& object : scene_msg.world.collision_objects)
+  {
+    object.header = std_msgs::msg::Header();
+    object.pose = geometry_msgs::msg::Pose();
+    object.primitive_poses.clear();
+    object.mesh_poses.clear();
+    object.plane_poses.clear();
+    object.subframe_poses.clear();
+  }
+  static const rclcpp::Serialization<moveit_msgs::msg::PlanningSceneWorld> SERIALIZER;
+  rclcpp::SerializedMessage serialized_msg;
+  SERIALIZER.serialize_message(&scene_msg.world, &serialized_msg);
+
+  const rcl_serialized_message_t& buffer = serialized_msg.get_rcl_serialized_message();
+  return std::hash<std::string_view>{}(
+      std::string_view(reinterpret_cast<const char*>(buffer.buffer), buffer.buffer_length));
+}
+
+std::string ExperienceRegistry::getDatabasePath(const std::string& storage_path, const std::string& group,
+                                                std::size_t scene_fingerprint) const
+{
+  const std::filesystem::path directory = storage_path.empty() ? getDefaultStoragePath() : storage_path;
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error)
+  {
+    RCLCPP_ERROR(getLogger(), "Unable to create experience database directory '%s': %s", directory.c_str(),
+                 error.message().c_str());
+    return std::string();
+  }
+
+  std::stringstream file_name;
+  file_name << group << '_' << std::hex << scene_fingerprint << ".db";
+  const std::filesystem::path database = directory / file_name.str();
+  if (!std::filesystem::exists(database, error))
+  {
+    pruneStorage(directory, max_databases_ - 1);
+  }
+  return database.string();
+}
+
+std::vector<std::string> ExperienceRegistry::useDatabase(const std::string& database)
+{
+  std::lock_guard<std::mutex> slock(statistics_lock_);
+  used_databases_.remove(database);
+  used_databases_.push_front(database);
+
+  std::vector<std::string> evicted;
+  while (used_databases_.size() > max_databases_)
+  {
+    evicted.push_back(used_databases_.back());
+    statistics_.erase(used_databases_.back());
+    used_databases_.pop_back();
+  }
+  return evicted;
+}
+
+void ExperienceRegistry::recordSolution(const std::string& database, bool solved, bool from_recall,
+                                        double planning_time)
+{
+  std::lock_guard<std::mutex> slock(statistics_lock_);
+  Statistics& stats = statistics_[database];
+  ++stats.problems;
+  if (!solved)
+  {
+    ++stats.failures;
+  }
+  else if (from_recall)
+  {
+    ++stats.solved_from_recall;
+    stats.recall_planning_time += planning_time;
+  }
+  else
+  {
+    ++stats.solved_from_scratch;
+    stats.scratch_planning_time += planning_time;
+  }
+}
+
+bool ExperienceRegistry::save(ompl::tools::ExperienceSetup& experience_setup) const
+{
+  std::lock_guard<std::mutex> slock(file_lock_);
+  return experience_setup.saveIfChanged();
+}
+
+ExperienceRegistry::Statistics ExperienceRegistry::getStatistics(const std::string& database) const
+{
+  std::lock_guard<std::mutex> slock(statistics_lock_);
+  auto it = statistics_.find(database);
+  return it == statistics_.end() ? Statistics() : it->second;
+}
+}  // namespace ompl_interface
@@ -0,0 +1,166 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/ompl_interface/detail/goal_sample_cache.hpp>
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string_view>
+
+namespace ompl_interface
+{
+namespace
+{
+bool sameSample(const std::vector<double>& a, const std::vector<double>& b)
+{
+  constexpr double EPSILON = 1e-6;
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](double x, double y) { return std::fabs(x - y) < EPSILON; });
+}
+}  // namespace
+
+GoalSampleCache::GoalSampleCache(std::size_t max_samples_per_goal, std::size_t max_goals)
+  : max_samples_per_goal_(std::max<std::size_t>(max_samples_per_goal, 1))
+  , max_goals_(std::max<std::size_t>(max_goals, 1))
+{
+}
+
+std::size_t GoalSampleCache::computeKey(const std::string& group, const moveit_msgs::msg::Constraints& constraints)
+{
+  // hash the serialized message, so any change to the goal (including the reference frames) changes the key
+  static const rclcpp::Serialization<moveit_msgs::msg::Constraints> SERIALIZER;
+  rclcpp::SerializedMessage serialized_msg;
+  SERIALIZER.serialize_message(&constraints, &serialized_msg);
+
+  const rcl_serialized_message_t& buffer = serialized_msg.get_rcl_serialized_message();
+  const std::size_t constraints_hash = std::hash<std::string_view>{}(
+      std::string_view(reinterpret_cast<const char*>(buffer.buffer), buffer.buffer_length));
+  // combine as in boost::hash_combine
+  std::size_t key = std::hash<std::string>{}(group);
+  key ^= constraints_hash + 0x9e3779b9 + (key << 6) + (key >> 2);
+  return key;
+}
+
+std::vector<std::vector<double>> GoalSampleCache::getSamples(std::size_t key)
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return {};
+  touch(it->second);
+  return it->second.samples;
+}
+
+void GoalSampleCache::addSample(std::size_t key, const std::vector<double>& sample)
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+  {
+    // evict the least recently used goal
+    if (entries_.size() >= max_goals_)
+    {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(key);
+    it = entries_.emplace(key, Entry{ {}, lru_.begin() }).first;
+  }
+  else
+  {
+    touch(it->second);
+  }
+
+  std::vector<std::vector<double>>& samples = it->second.samples;
+  if (std::any_of(samples.begin(), samples.end(),
+                  [&sample](const std::vector<double>& cached) { return sameSample(cached, sample); }))
+    return;
+  if (samples.size() >= max_samples_per_goal_)
+    samples.erase(samples.begin());
+  samples.push_back(sample);
+}
+
+void GoalSampleCache::removeSample(std::size_t key, const std::vector<double>& sample)
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  ++statistics_.rejected;
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return;
+  std::vector<std::vector<double>>& samples = it->second.samples;
+  samples.erase(std::remove_if(samples.begin(), samples.end(),
+                               [&sample](const std::vector<double>& cached) { return sameSample(cached, sample); }),
+                samples.end());
+  if (samples.empty())
+  {
+    lru_.erase(it->second.lru_position);
+    entries_.erase(it);
+  }
+}
+
+void GoalSampleCache::recordHit()
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  ++statistics_.hits;
+}
+
+void GoalSampleCache::recordMiss()
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  ++statistics_.misses;
+}
+
+GoalSampleCache::Statistics GoalSampleCache::getStatistics() const
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  return statistics_;
+}
+
+void GoalSampleCache::clear()
+{
+  std::lock_guard<std::mutex> slock(lock_);
+  entries_.clear();
+  lru_.clear();
+  statistics_ = Statistics();
+}
+
+void GoalSampleCache::touch(Entry& entry)
+{
+  lru_.splice(lru_.begin(), lru_, entry.lru_position);
+}
+}  // namespace ompl_interface
@@ -35,6 +35,9 @@
 /* Author: Jeroen De Maeyer, Boston Cleek */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <iterator>
 
 #include <moveit/ompl_interface/detail/ompl_constraints.hpp>
@@ -50,6 +53,15 @@ rclcpp::Logger getLogger()
 {
   return moveit::getLogger("moveit.planners.ompl.constraints");
 }
+
+/** \brief Number of constraints per thread whose kinematics are cached at the same time. */
+constexpr std::size_t KINEMATICS_CACHE_SLOTS = 4;
+
+std::uint64_t newKinematicsCacheId()
+{
+  static std::atomic<std::uint64_t> next_id{ 1 };
+  return next_id++;
+}
 }  // namespace
 
 Bounds::Bounds() : size_(0)
@@ -132,13 +144,18 @@ BaseConstraint::BaseConstraint(const moveit::core::RobotModelConstPtr& robot_mod
   : ompl::base::Constraint(num_dofs, num_cons_)
   , state_storage_(robot_model)
   , joint_model_group_(robot_model->getJointModelGroup(group))
-
+  , link_model_(nullptr)
+  , kinematics_cache_id_(newKinematicsCacheId())
 {
 }
 
 void BaseConstraint::init(const moveit_msgs::msg::Constraints& constraints)
 {
   parseConstraintMsg(constraints);
+  link_model_ = joint_model_group_->getLinkModel(link_name_);
+
+  // the cached kinematics refer to the previously constrained link
+  kinematics_cache_id_ = newKinematicsCacheId();
 }
 
 void BaseConstraint::function(const Eigen::Ref<const Eigen::VectorXd>& joint_values,
@@ -160,22 +177,63 @@ void BaseConstraint::jacobian(const Eigen::Ref<const Eigen::VectorXd>& joint_val
   }
 }
 
-Eigen::Isometry3d BaseConstraint::forwardKinematics(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const
+const BaseConstraint::KinematicsCache&
+BaseConstraint::updateKinematics(const Eigen::Ref<const Eigen::VectorXd>& joint_values, bool compute_jacobian) const
 {
-  moveit::core::RobotState* robot_state = state_storage_.getStateStorage();
-  robot_state->setJointGroupPositions(joint_model_group_, joint_values);
-  return robot_state->getGlobalLinkTransform(link_name_);
+  thread_local std::array<KinematicsCache, KINEMATICS_CACHE_SLOTS> caches;
+  thread_local std::uint64_t use_count = 0;
+
+  KinematicsCache* cache = &caches.front();
+  for (KinematicsCache& slot : caches)
+  {
+    if (slot.owner_id == kinematics_cache_id_)
+    {
+      cache = &slot;
+      break;
+    }
+    if (slot.last_used < cache->last_used)
+    {
+      cache = &slot;
+    }
+  }
+  if (cache->owner_id != kinematics_cache_id_)
+  {
+    // take over the least recently used slot
+    cache->owner_id = kinematics_cache_id_;
+    cache->robot_state = state_storage_.getStateStorage();
+    cache->joint_values.resize(0);
+    cache->jacobian_valid = false;
+  }
+  cache->last_used = ++use_count;
+
+  if (cache->joint_values.size() != joint_values.size() || cache->joint_values != joint_values)
+  {
+    cache->joint_values = joint_values;
+    cache->robot_state->setJointGroupPositions(joint_model_group_, cache->joint_values);
+    cache->link_transform = cache->robot_state->getGlobalLinkTransform(link_model_);
+    cache->jacobian_valid = false;
+  }
+
+  if (compute_jacobian && !cache->jacobian_valid)
+  {
+    // return value (success) not used, could return a garbage jacobian.
+    // the link transforms are up to date, so the const overload does not run forward kinematics again
+    static_cast<const moveit::core::RobotState*>(cache->robot_state)
+        ->getJacobian(joint_model_group_, link_model_, Eigen::Vector3d::Zero(), cache->jacobian);
+    cache->jacobian_valid = true;
+  }
+  return *cache;
 }
 
-Eigen::MatrixXd BaseConstraint::robotGeometricJacobian(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const
+const Eigen::Isometry3d& BaseConstraint::forwardKinematics(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const
 {
-  moveit::core::RobotState* robot_state = state_storage_.getStateStorage();
-  robot_state->setJointGroupPositions(joint_model_group_, joint_values);
-  Eigen::MatrixXd jacobian;
-  // return value (success) not used, could return a garbage jacobian.
-  robot_state->getJacobian(joint_model_group_, joint_model_group_->getLinkModel(link_name_),
-                           Eigen::Vector3d(0.0, 0.0, 0.0), jacobian);
-  return jacobian;
+  return updateKinematics(joint_values, false).link_transform;
+}
+
+const Eigen::MatrixXd&
+BaseConstraint::robotGeometricJacobian(const Eigen::Ref<const Eigen::VectorXd>& joint_values) const
+{
+  return updateKinematics(joint_values, true).jacobian;
 }
 
 Eigen::VectorXd BaseConstraint::calcError(const Eigen::Ref<const Eigen::VectorXd>& /*x*/) const
@@ -294,12 +352,13 @@ void EqualityPositionConstraint::jacobian(const Eigen::Ref<const Eigen::VectorXd
                                           Eigen::Ref<Eigen::MatrixXd> out) const
 {
   out.setZero();
-  Eigen::MatrixXd jac = target_orientation_.matrix().transpose() * robotGeometricJacobian(joint_values).topRows(3);
+  const Eigen::Matrix3d rotation = target_orientation_.matrix().transpose();
+  const Eigen::MatrixXd& robot_jacobian = robotGeometricJacobian(joint_values);
   for (std::size_t dim = 0; dim < 3; ++dim)
   {
     if (is_dim_constrained_.at(dim))
     {
-      out.row(dim) = jac.row(dim);  // equality constraint dimension
+      out.row(dim) = rotation.row(dim) * robot_jacobian.topRows(3);  // equality constraint dimension
     }
   }
 }
@@ -330,6 +389,26 @@ Eigen::MatrixXd OrientationConstraint::calcErrorJacobian(const Eigen::Ref<const
   return -angularVelocityToAngleAxis(aa.angle(), aa.axis()) * robotGeometricJacobian(x).bottomRows(3);
 }
 
+/************************************
+ * Batch projection
+ * **********************************/
+std::size_t projectStates(const ompl::base::Constraint& constraint, Eigen::Ref<Eigen::MatrixXd> states,
+                          std::vector<bool>& success)
+{
+  const long num_states = states.cols();
+  // std::vector<bool> packs bits, so it cannot be written concurrently
+  std::vector<char> projected(num_states, 0);
+
+#pragma omp parallel for schedule(dynamic)
+  for (long i = 0; i < num_states; ++i)
+  {
+    projected[i] = constraint.project(states.col(i)) ? 1 : 0;
+  }
+
+  success.assign(projected.begin(), projected.end());
+  return static_cast<std::size_t>(std::count(projected.begin(), projected.end(), 1));
+}
+
 /************************************
  * MoveIt constraint message parsing
  * **********************************/
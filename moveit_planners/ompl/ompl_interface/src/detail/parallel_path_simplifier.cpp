@@ -0,0 +1,148 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/ompl_interface/detail/parallel_path_simplifier.hpp>
+#include <moveit/utils/parallel_for.hpp>
+
+#include <ompl/geometric/PathSimplifier.h>
+
+#include <algorithm>
+
+namespace ompl_interface
+{
+namespace ob = ompl::base;
+namespace og = ompl::geometric;
+
+ParallelPathSimplifier::ParallelPathSimplifier(const ob::SpaceInformationPtr& si, unsigned int thread_count,
+                                               const ob::OptimizationObjectivePtr& objective)
+  : si_(si)
+  , thread_count_(static_cast<unsigned int>(moveit::parallelThreadCount(thread_count, std::max(thread_count, 1u))))
+  , objective_(objective)
+{
+}
+
+bool ParallelPathSimplifier::simplify(og::PathGeometric& path, const ob::PlannerTerminationCondition& ptc) const
+{
+  const std::size_t segment_count = path.getStateCount() < 2 ? 0 : path.getStateCount() - 1;
+  const std::size_t window_count = std::min<std::size_t>(thread_count_, segment_count / MIN_WINDOW_SEGMENTS);
+
+  // not enough work to split the path, fall back to the serial simplifier
+  if (window_count < 2)
+  {
+    og::PathSimplifier simplifier(si_, ob::GoalPtr(), objective_);
+    return simplifier.simplify(path, ptc);
+  }
+
+  // split the path into windows that share their boundary states
+  std::vector<og::PathGeometric> windows(window_count, og::PathGeometric(si_));
+  for (std::size_t k = 0; k < window_count; ++k)
+  {
+    const std::size_t begin = k * segment_count / window_count;
+    const std::size_t end = (k + 1) * segment_count / window_count;
+    for (std::size_t i = begin; i <= end; ++i)
+      windows[k].append(path.getState(i));
+  }
+
+  // shortcut all windows concurrently; each thread uses its own simplifier (and therefore its own RNG)
+  std::vector<char> window_valid(window_count, 1);
+  moveit::parallelFor(window_count, window_count, [this, &ptc, &windows, &window_valid](std::size_t k, std::size_t) {
+    og::PathSimplifier simplifier(si_, ob::GoalPtr(), objective_);
+    window_valid[k] = simplifier.simplify(windows[k], ptc) ? 1 : 0;
+  });
+
+  // join the windows again, remembering where the shared boundary states ended up
+  og::PathGeometric joined(windows[0]);
+  std::vector<std::size_t> seams;
+  for (std::size_t k = 1; k < window_count; ++k)
+  {
+    seams.push_back(joined.getStateCount() - 1);
+    for (std::size_t i = 1; i < windows[k].getStateCount(); ++i)
+      joined.append(windows[k].getState(i));
+  }
+
+  // try to bridge the boundary states. Adjacent seams are skipped so that every accepted bridge connects states that
+  // remain on the path.
+  std::vector<std::size_t> candidates;
+  std::vector<std::pair<const ob::State*, const ob::State*>> bridges;
+  for (std::size_t seam : seams)
+  {
+    if (seam == 0 || seam + 1 >= joined.getStateCount() || (!candidates.empty() && seam <= candidates.back() + 1))
+      continue;
+    candidates.push_back(seam);
+    bridges.emplace_back(joined.getState(seam - 1), joined.getState(seam + 1));
+  }
+  std::vector<char> bridge_valid;
+  checkMotionBatch(bridges, bridge_valid);
+
+  std::vector<ob::State*>& states = joined.getStates();
+  for (std::size_t i = candidates.size(); i-- > 0;)
+  {
+    if (bridge_valid[i])
+    {
+      si_->freeState(states[candidates[i]]);
+      states.erase(states.begin() + candidates[i]);
+    }
+  }
+
+  // final serial reconciliation over the joined path, as far as the time budget allows
+  og::PathSimplifier simplifier(si_, ob::GoalPtr(), objective_);
+  if (!ptc)
+    simplifier.reduceVertices(joined);
+  if (!ptc)
+    simplifier.shortcutPath(joined);
+
+  path = joined;
+  return std::all_of(window_valid.begin(), window_valid.end(), [](char valid) { return valid != 0; });
+}
+
+bool ParallelPathSimplifier::checkMotions(const og::PathGeometric& path) const
+{
+  std::vector<std::pair<const ob::State*, const ob::State*>> motions;
+  for (std::size_t i = 1; i < path.getStateCount(); ++i)
+    motions.emplace_back(path.getState(i - 1), path.getState(i));
+
+  std::vector<char> valid;
+  checkMotionBatch(motions, valid);
+  return std::all_of(valid.begin(), valid.end(), [](char v) { return v != 0; });
+}
+
+void ParallelPathSimplifier::checkMotionBatch(
+    const std::vector<std::pair<const ob::State*, const ob::State*>>& motions, std::vector<char>& valid) const
+{
+  valid.assign(motions.size(), 0);
+  moveit::parallelFor(motions.size(), thread_count_, [this, &motions, &valid](std::size_t i, std::size_t) {
+    valid[i] = si_->checkMotion(motions[i].first, motions[i].second) ? 1 : 0;
+  });
+}
+}  // namespace ompl_interface
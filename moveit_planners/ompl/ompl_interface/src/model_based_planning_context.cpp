@@ -46,6 +46,7 @@
 #include <moveit/ompl_interface/detail/goal_union.hpp>
 #include <moveit/ompl_interface/detail/projection_evaluators.hpp>
 #include <moveit/ompl_interface/detail/constraints_library.hpp>
+#include <moveit/ompl_interface/detail/parallel_path_simplifier.hpp>
 
 #include <moveit/kinematic_constraints/utils.hpp>
 
@@ -84,6 +85,8 @@ ModelBasedPlanningContext::ModelBasedPlanningContext(const std::string& name,
   , spec_(spec)
   , complete_initial_robot_state_(spec.state_space_->getRobotModel())
   , ompl_simple_setup_(spec.ompl_simple_setup_)
+  , experience_setup_(std::dynamic_pointer_cast<ot::ExperienceSetup>(spec.ompl_simple_setup_))
+  , experience_stats_(std::dynamic_pointer_cast<ExperienceStatsProvider>(spec.ompl_simple_setup_))
   , ompl_benchmark_(*ompl_simple_setup_)
   , ompl_parallel_plan_(ompl_simple_setup_->getProblemDefinition())
   , ptc_(nullptr)
@@ -99,6 +102,8 @@ ModelBasedPlanningContext::ModelBasedPlanningContext(const std::string& name,
   , simplify_solutions_(true)
   , interpolate_(true)
   , hybridize_(true)
+  , simplification_threads_(1)
+  , simplification_timeout_(0.0)
 {
   complete_initial_robot_state_.setToDefaultValues();  // avoid uninitialized memory
   complete_initial_robot_state_.update();
@@ -106,6 +111,16 @@ ModelBasedPlanningContext::ModelBasedPlanningContext(const std::string& name,
   constraints_library_ = std::make_shared<ConstraintsLibrary>(this);
 }
 
+ModelBasedPlanningContext::~ModelBasedPlanningContext()
+{
+  // the database is written once the context is released, as that takes too long to do after every solve
+  if (experience_setup_ && spec_.experience_registry_ && !spec_.experience_registry_->save(*experience_setup_))
+  {
+    RCLCPP_WARN(getLogger(), "%s: Unable to save experience database '%s'", name_.c_str(),
+                spec_.experience_database_.c_str());
+  }
+}
+
 void ModelBasedPlanningContext::configure(const rclcpp::Node::SharedPtr& node, bool use_constraints_approximations)
 {
   loadConstraintApproximations(node);
@@ -394,6 +409,41 @@ void ModelBasedPlanningContext::useConfig()
     cfg.erase(it);
   }
 
+  // number of threads used to simplify the solution path
+  it = cfg.find("simplification_threads");
+  if (it != cfg.end())
+  {
+    simplification_threads_ = std::max(1u, boost::lexical_cast<unsigned int>(it->second));
+    cfg.erase(it);
+  }
+
+  // time budget for simplifying the solution path
+  it = cfg.find("simplification_timeout");
+  if (it != cfg.end())
+  {
+    simplification_timeout_ = std::max(0.0, moveit::core::toDouble(it->second));
+    cfg.erase(it);
+  }
+
+  // goal sample caching is handled when the goal is constructed
+  it = cfg.find("cache_goal_samples");
+  if (it != cfg.end())
+  {
+    cfg.erase(it);
+  }
+
+  // the experience planner is selected when the context is created
+  it = cfg.find("experience_planner");
+  if (it != cfg.end())
+  {
+    cfg.erase(it);
+  }
+  it = cfg.find("experience_storage_path");
+  if (it != cfg.end())
+  {
+    cfg.erase(it);
+  }
+
   // check whether solution paths from parallel planning should be hybridized
   it = cfg.find("hybridize");
   if (it != cfg.end())
@@ -451,11 +501,33 @@ void ModelBasedPlanningContext::setPlanningVolume(const moveit_msgs::msg::Worksp
 
 void ModelBasedPlanningContext::simplifySolution(double timeout)
 {
+  if (simplification_timeout_ > 0.0)
+    timeout = std::min(timeout, simplification_timeout_);
+
   ompl::time::point start = ompl::time::now();
   ob::PlannerTerminationCondition ptc = constructPlannerTerminationCondition(timeout, start);
   registerTerminationCondition(ptc);
-  ompl_simple_setup_->simplifySolution(ptc);
-  last_simplify_time_ = ompl_simple_setup_->getLastSimplificationTime();
+  if (simplification_threads_ <= 1 || !ompl_simple_setup_->haveSolutionPath())
+  {
+    ompl_simple_setup_->simplifySolution(ptc);
+    last_simplify_time_ = ompl_simple_setup_->getLastSimplificationTime();
+  }
+  else
+  {
+    og::PathGeometric& path = ompl_simple_setup_->getSolutionPath();
+    const std::size_t state_count = path.getStateCount();
+    const ob::ProblemDefinitionPtr& pdef = ompl_simple_setup_->getProblemDefinition();
+    ParallelPathSimplifier simplifier(ompl_simple_setup_->getSpaceInformation(), simplification_threads_,
+                                      pdef->hasOptimizationObjective() ? pdef->getOptimizationObjective() :
+                                                                         ob::OptimizationObjectivePtr());
+    if (!simplifier.simplify(path, ptc))
+    {
+      RCLCPP_WARN(getLogger(), "%s: Parallel path simplification produced an invalid path segment", name_.c_str());
+    }
+    last_simplify_time_ = ompl::time::seconds(ompl::time::now() - start);
+    RCLCPP_DEBUG(getLogger(), "%s: Simplification with %u threads took %f seconds and changed from %zu to %zu states",
+                 name_.c_str(), simplification_threads_, last_simplify_time_, state_count, path.getStateCount());
+  }
   unregisterTerminationCondition();
 }
 
@@ -516,13 +588,24 @@ void ModelBasedPlanningContext::setVerboseStateValidityChecks(bool flag)
   }
 }
 
+GoalSampleCachePtr ModelBasedPlanningContext::getGoalSampleCache() const
+{
+  // the planner configuration is read here directly, as goals are constructed before useConfig() is called
+  auto it = spec_.config_.find("cache_goal_samples");
+  if (it != spec_.config_.end() && boost::lexical_cast<bool>(it->second))
+    return spec_.goal_sample_cache_;
+  return GoalSampleCachePtr();
+}
+
 ompl::base::GoalPtr ModelBasedPlanningContext::constructGoal()
 {
   // ******************* set up the goal representation, based on goal constraints
 
+  const GoalSampleCachePtr goal_sample_cache = getGoalSampleCache();
   std::vector<ob::GoalPtr> goals;
-  for (kinematic_constraints::KinematicConstraintSetPtr& goal_constraint : goal_constraints_)
+  for (std::size_t i = 0; i < goal_constraints_.size(); ++i)
   {
+    const kinematic_constraints::KinematicConstraintSetPtr& goal_constraint = goal_constraints_[i];
     constraint_samplers::ConstraintSamplerPtr constraint_sampler;
     if (spec_.constraint_sampler_manager_)
     {
@@ -532,7 +615,8 @@ ompl::base::GoalPtr ModelBasedPlanningContext::constructGoal()
 
     if (constraint_sampler)
     {
-      ob::GoalPtr goal = std::make_shared<ConstrainedGoalSampler>(this, goal_constraint, constraint_sampler);
+      ob::GoalPtr goal = std::make_shared<ConstrainedGoalSampler>(this, goal_constraint, constraint_sampler,
+                                                                  goal_sample_cache, goal_sample_cache_keys_[i]);
       goals.push_back(goal);
     }
   }
@@ -647,6 +731,7 @@ void ModelBasedPlanningContext::clear()
   ompl_simple_setup_->setStateValidityChecker(ob::StateValidityCheckerPtr());
   path_constraints_.reset();
   goal_constraints_.clear();
+  goal_sample_cache_keys_.clear();
   getOMPLStateSpace()->setInterpolationFunction(InterpolationFunction());
 }
 
@@ -667,6 +752,8 @@ bool ModelBasedPlanningContext::setGoalConstraints(const std::vector<moveit_msgs
 {
   // ******************* check if the input is correct
   goal_constraints_.clear();
+  goal_sample_cache_keys_.clear();
+  const bool use_goal_sample_cache = static_cast<bool>(getGoalSampleCache());
   for (const moveit_msgs::msg::Constraints& goal_constraint : goal_constraints)
   {
     moveit_msgs::msg::Constraints constr = kinematic_constraints::mergeConstraints(goal_constraint, path_constraints);
@@ -676,6 +763,8 @@ bool ModelBasedPlanningContext::setGoalConstraints(const std::vector<moveit_msgs
     if (!kset->empty())
     {
       goal_constraints_.push_back(kset);
+      goal_sample_cache_keys_.push_back(use_goal_sample_cache ? GoalSampleCache::computeKey(getGroupName(), constr) :
+                                                                0);
     }
   }
 
@@ -759,6 +848,13 @@ void ModelBasedPlanningContext::postSolve()
   int iv = ompl_simple_setup_->getSpaceInformation()->getMotionValidator()->getInvalidMotionCount();
   RCLCPP_DEBUG(getLogger(), "There were %d valid motions and %d invalid motions.", v, iv);
 
+  if (const GoalSampleCachePtr goal_sample_cache = getGoalSampleCache())
+  {
+    const GoalSampleCache::Statistics stats = goal_sample_cache->getStatistics();
+    RCLCPP_DEBUG(getLogger(), "Goal sample cache: %zu hits, %zu misses, %zu rejected samples.", stats.hits,
+                 stats.misses, stats.rejected);
+  }
+
   // Debug OMPL setup and solution
   RCLCPP_DEBUG(getLogger(), "%s",
                [&] {
@@ -769,6 +865,33 @@ void ModelBasedPlanningContext::postSolve()
                    .c_str());
 }
 
+void ModelBasedPlanningContext::recordExperience(double recalled_before)
+{
+  const bool solved = ompl_simple_setup_->getProblemDefinition()->hasExactSolution();
+  // the experience planner counts the solutions its retrieve-repair planner found
+  const bool from_recall =
+      solved && experience_stats_ && experience_stats_->getExperienceStats().numSolutionsFromRecall_ > recalled_before;
+  spec_.experience_registry_->recordSolution(spec_.experience_database_, solved, from_recall, last_plan_time_);
+
+  // make the solution available for recall in the next queries
+  experience_setup_->doPostProcessing();
+
+  const ExperienceRegistry::Statistics stats = getExperienceStatistics();
+  const char* outcome = !solved ? "not found" : (from_recall ? "recalled from experience" : "planned from scratch");
+  RCLCPP_INFO(getLogger(),
+              "%s: Solution %s. Experience database holds %zu paths, recall rate %.1f%% over %zu problems, "
+              "estimated %.3f seconds of planning time saved.",
+              name_.c_str(), outcome, experience_setup_->getExperiencesCount(), 100.0 * stats.getRecallRate(),
+              stats.problems, stats.getTimeSaved());
+}
+
+ExperienceRegistry::Statistics ModelBasedPlanningContext::getExperienceStatistics() const
+{
+  if (!experience_setup_ || !spec_.experience_registry_)
+    return ExperienceRegistry::Statistics();
+  return spec_.experience_registry_->getStatistics(spec_.experience_database_);
+}
+
 void ModelBasedPlanningContext::solve(planning_interface::MotionPlanResponse& res)
 {
   res.planner_id = request_.planner_id;
@@ -852,16 +975,23 @@ const moveit_msgs::msg::MoveItErrorCodes ModelBasedPlanningContext::solve(double
 
   moveit_msgs::msg::MoveItErrorCodes result;
   result.val = moveit_msgs::msg::MoveItErrorCodes::FAILURE;
-  if (count <= 1 || multi_query_planning_enabled_)  // multi-query planners should always run in single instances
+  // multi-query and experience planners should always run in single instances
+  if (count <= 1 || multi_query_planning_enabled_ || experience_setup_)
   {
     RCLCPP_DEBUG(getLogger(), "%s: Solving the planning problem once...", name_.c_str());
     ob::PlannerTerminationCondition ptc = constructPlannerTerminationCondition(timeout, start);
     registerTerminationCondition(ptc);
+    const double recalled_before =
+        experience_stats_ ? static_cast<double>(experience_stats_->getExperienceStats().numSolutionsFromRecall_) : 0.0;
     std::ignore = ompl_simple_setup_->solve(ptc);
     last_plan_time_ = ompl_simple_setup_->getLastPlanComputationTime();
     unregisterTerminationCondition();
     // fill the result status code
     result.val = logPlannerStatus(ompl_simple_setup_);
+    if (experience_setup_)
+    {
+      recordExperience(recalled_before);
+    }
   }
   else
   {
@@ -169,7 +169,12 @@ void OMPLInterface::loadPlannerConfigurations()
       { "projection_evaluator", rclcpp::ParameterType::PARAMETER_STRING },
       { "longest_valid_segment_fraction", rclcpp::ParameterType::PARAMETER_DOUBLE },
       { "enforce_joint_model_state_space", rclcpp::ParameterType::PARAMETER_BOOL },
-      { "enforce_constrained_state_space", rclcpp::ParameterType::PARAMETER_BOOL }
+      { "enforce_constrained_state_space", rclcpp::ParameterType::PARAMETER_BOOL },
+      { "simplification_threads", rclcpp::ParameterType::PARAMETER_INTEGER },
+      { "simplification_timeout", rclcpp::ParameterType::PARAMETER_DOUBLE },
+      { "cache_goal_samples", rclcpp::ParameterType::PARAMETER_BOOL },
+      { "experience_planner", rclcpp::ParameterType::PARAMETER_STRING },
+      { "experience_storage_path", rclcpp::ParameterType::PARAMETER_STRING }
     };
 
     const std::string group_name_param = parameter_namespace_ + "." + group_name;
@@ -35,6 +35,7 @@
 /* Author: Ioan Sucan */
 
 #include <moveit/ompl_interface/parameterization/model_based_state_space.hpp>
+#include <moveit/robot_model/revolute_joint_model.hpp>
 #include <utility>
 #include <moveit/utils/logger.hpp>
 
@@ -77,6 +78,25 @@ ModelBasedStateSpace::ModelBasedStateSpace(ModelBasedStateSpaceSpecification spe
     spec_.joint_bounds_[i] = &joint_bounds_storage_[i];
   }
 
+  // Distance and interpolation of bounded revolute and prismatic joints are linear in the joint values. If the group
+  // only consists of such joints (and therefore has no mimic joints that would need an update), both can be computed
+  // over the whole values array at once.
+  linear_joints_only_ = joint_model_vector_.size() == variable_count_;
+  for (const moveit::core::JointModel* joint_model : joint_model_vector_)
+  {
+    const bool linear =
+        joint_model->getType() == moveit::core::JointModel::PRISMATIC ||
+        (joint_model->getType() == moveit::core::JointModel::REVOLUTE &&
+         !static_cast<const moveit::core::RevoluteJointModel*>(joint_model)->isContinuous());
+    linear_joints_only_ = linear_joints_only_ && linear;
+  }
+  if (linear_joints_only_)
+  {
+    variable_distance_factors_.resize(variable_count_);
+    for (std::size_t i = 0; i < joint_model_vector_.size(); ++i)
+      variable_distance_factors_[i] = joint_model_vector_[i]->getDistanceFactor();
+  }
+
   // default settings
   setTagSnapToSegment(0.95);
 
@@ -179,6 +199,12 @@ double ModelBasedStateSpace::distance(const ompl::base::State* state1, const omp
   {
     return distance_function_(state1, state2);
   }
+  else if (linear_joints_only_)
+  {
+    const Eigen::Map<const Eigen::VectorXd> values1(state1->as<StateType>()->values, variable_count_);
+    const Eigen::Map<const Eigen::VectorXd> values2(state2->as<StateType>()->values, variable_count_);
+    return (values1 - values2).cwiseAbs().dot(variable_distance_factors_);
+  }
   else
   {
     return spec_.joint_model_group_->distance(state1->as<StateType>()->values, state2->as<StateType>()->values);
@@ -216,8 +242,18 @@ void ModelBasedStateSpace::interpolate(const ompl::base::State* from, const ompl
   if (!interpolation_function_ || !interpolation_function_(from, to, t, state))
   {
     // perform the actual interpolation
-    spec_.joint_model_group_->interpolate(from->as<StateType>()->values, to->as<StateType>()->values, t,
-                                          state->as<StateType>()->values);
+    if (linear_joints_only_)
+    {
+      const Eigen::Map<const Eigen::VectorXd> from_values(from->as<StateType>()->values, variable_count_);
+      const Eigen::Map<const Eigen::VectorXd> to_values(to->as<StateType>()->values, variable_count_);
+      Eigen::Map<Eigen::VectorXd>(state->as<StateType>()->values, variable_count_) =
+          from_values + t * (to_values - from_values);
+    }
+    else
+    {
+      spec_.joint_model_group_->interpolate(from->as<StateType>()->values, to->as<StateType>()->values, t,
+                                            state->as<StateType>()->values);
+    }
 
     // compute tag
     if (from->as<StateType>()->tag >= 0 && t < 1.0 - tag_snap_to_segment_)
@@ -70,6 +70,8 @@
 
 #include <ompl/base/ConstrainedSpaceInformation.h>
 #include <ompl/base/spaces/constraint/ProjectedStateSpace.h>
+#include <ompl/tools/lightning/Lightning.h>
+#include <ompl/tools/thunder/Thunder.h>
 
 #include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space_factory.hpp>
 #include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.hpp>
@@ -261,6 +263,8 @@ PlanningContextManager::PlanningContextManager(moveit::core::RobotModelConstPtr
   , max_planning_threads_(4)
   , max_solution_segment_length_(0.0)
   , minimum_waypoint_count_(2)
+  , goal_sample_cache_(std::make_shared<GoalSampleCache>())
+  , experience_registry_(std::make_shared<ExperienceRegistry>())
 {
   cached_contexts_ = std::make_shared<CachedContexts>();
   registerDefaultPlanners();
@@ -338,17 +342,40 @@ void PlanningContextManager::setPlannerConfigurations(const planning_interface::
   planner_configs_ = pconfig;
 }
 
+void PlanningContextManager::releaseExperienceContexts(const std::string& experience_database) const
+{
+  const std::string suffix = "@" + experience_database;
+  std::lock_guard<std::mutex> slock(cached_contexts_->lock_);
+  for (auto it = cached_contexts_->contexts_.begin(); it != cached_contexts_->contexts_.end();)
+  {
+    const std::string& cache_name = it->first.first;
+    if (cache_name.size() > suffix.size() &&
+        cache_name.compare(cache_name.size() - suffix.size(), suffix.size(), suffix) == 0)
+    {
+      it = cached_contexts_->contexts_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
 ModelBasedPlanningContextPtr
 PlanningContextManager::getPlanningContext(const planning_interface::PlannerConfigurationSettings& config,
                                            const ModelBasedStateSpaceFactoryPtr& factory,
-                                           const moveit_msgs::msg::MotionPlanRequest& req) const
+                                           const moveit_msgs::msg::MotionPlanRequest& req,
+                                           const std::string& experience_database) const
 {
   // Check for a cached planning context
   ModelBasedPlanningContextPtr context;
 
+  // an experience planner is bound to its database, so it is only reused for the same group and scene
+  const std::string cache_name = experience_database.empty() ? config.name : config.name + "@" + experience_database;
+
   {
     std::unique_lock<std::mutex> slock(cached_contexts_->lock_);
-    auto cached_contexts = cached_contexts_->contexts_.find(std::make_pair(config.name, factory->getType()));
+    auto cached_contexts = cached_contexts_->contexts_.find(std::make_pair(cache_name, factory->getType()));
     if (cached_contexts != cached_contexts_->contexts_.end())
     {
       for (const ModelBasedPlanningContextPtr& cached_context : cached_contexts->second)
@@ -371,6 +398,7 @@ PlanningContextManager::getPlanningContext(const planning_interface::PlannerConf
     context_spec.config_ = config.config;
     context_spec.planner_selector_ = getPlannerSelector();
     context_spec.constraint_sampler_manager_ = constraint_sampler_manager_;
+    context_spec.goal_sample_cache_ = goal_sample_cache_;
     context_spec.state_space_ = factory->getNewStateSpace(space_spec);
 
     if (factory->getType() == ConstrainedPlanningStateSpace::PARAMETERIZATION_TYPE)
@@ -398,6 +426,26 @@ PlanningContextManager::getPlanningContext(const planning_interface::PlannerConf
       context_spec.ompl_simple_setup_ = std::make_shared<ompl::geometric::SimpleSetup>(
           std::make_shared<ob::ConstrainedSpaceInformation>(context_spec.constrained_state_space_));
     }
+    else if (!experience_database.empty())
+    {
+      // Experience planners record solutions in a database and race a retrieve-repair planner against the
+      // configured planner on later queries
+      std::shared_ptr<ompl::tools::ExperienceSetup> experience_setup;
+      if (config.config.at("experience_planner") == "thunder")
+      {
+        experience_setup =
+            std::make_shared<ExperiencePlannerWithStats<ompl::tools::Thunder>>(context_spec.state_space_);
+      }
+      else
+      {
+        experience_setup =
+            std::make_shared<ExperiencePlannerWithStats<ompl::tools::Lightning>>(context_spec.state_space_);
+      }
+      experience_setup->setFilePath(experience_database);
+      context_spec.ompl_simple_setup_ = experience_setup;
+      context_spec.experience_registry_ = experience_registry_;
+      context_spec.experience_database_ = experience_database;
+    }
     else
     {
       // Choose the correct simple setup type to load
@@ -413,7 +461,7 @@ PlanningContextManager::getPlanningContext(const planning_interface::PlannerConf
     {
       {
         std::lock_guard<std::mutex> slock(cached_contexts_->lock_);
-        cached_contexts_->contexts_[std::make_pair(config.name, factory->getType())].push_back(context);
+        cached_contexts_->contexts_[std::make_pair(cache_name, factory->getType())].push_back(context);
       }
     }
   }
@@ -577,7 +625,45 @@ ModelBasedPlanningContextPtr PlanningContextManager::getPlanningContext(
     factory = getStateSpaceFactory(pc->second.group, req);
   }
 
-  ModelBasedPlanningContextPtr context = getPlanningContext(pc->second, factory, req);
+  // experience_planner
+  // ******************
+  // Plan with OMPL's experience planners ('lightning' or 'thunder'), which store solutions in a database per group and
+  // scene fingerprint and recall them for later queries. The databases are stored in 'experience_storage_path'
+  // ($ROS_HOME/ompl_experience by default). The constrained state space is not supported.
+  std::string experience_database;
+  auto experience_planner_iterator = pc->second.config.find("experience_planner");
+  if (experience_planner_iterator != pc->second.config.end() && !experience_planner_iterator->second.empty())
+  {
+    const std::string& experience_planner = experience_planner_iterator->second;
+    if (experience_planner != "lightning" && experience_planner != "thunder")
+    {
+      RCLCPP_WARN(getLogger(), "Unknown experience planner '%s', expected 'lightning' or 'thunder'. Planning without "
+                               "experience.",
+                  experience_planner.c_str());
+    }
+    else if (factory->getType() == ConstrainedPlanningStateSpace::PARAMETERIZATION_TYPE)
+    {
+      RCLCPP_WARN(getLogger(), "Experience planning is not supported in the constrained state space. Planning without "
+                               "experience.");
+    }
+    else
+    {
+      auto storage_path_iterator = pc->second.config.find("experience_storage_path");
+      experience_database = experience_registry_->getDatabasePath(
+          storage_path_iterator == pc->second.config.end() ? std::string() : storage_path_iterator->second,
+          pc->second.group, ExperienceRegistry::computeSceneFingerprint(*planning_scene));
+      if (!experience_database.empty())
+      {
+        // release the contexts of databases that fell out of use, which saves their experiences
+        for (const std::string& evicted_database : experience_registry_->useDatabase(experience_database))
+        {
+          releaseExperienceContexts(evicted_database);
+        }
+      }
+    }
+  }
+
+  ModelBasedPlanningContextPtr context = getPlanningContext(pc->second, factory, req, experience_database);
 
   if (context)
   {
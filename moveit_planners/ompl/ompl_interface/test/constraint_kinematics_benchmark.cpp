@@ -0,0 +1,155 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Benchmark the kinematics of the OMPL constraints. One Newton step of OMPL's projection evaluates the constraint
+// function and its Jacobian at the same configuration. The cached variant is what BaseConstraint does, the uncached
+// variant repeats the forward kinematics for every evaluation, as the constraints did before they cached them. To run
+// this benchmark, 'cd' to the build/moveit_planners_ompl directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+
+#include <moveit/ompl_interface/detail/ompl_constraints.hpp>
+#include <moveit/robot_state/robot_state.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+
+// Robot and planning group to use in the benchmarks.
+constexpr char TEST_ROBOT[] = "panda";
+constexpr char TEST_GROUP[] = "panda_arm";
+
+namespace
+{
+constexpr std::size_t STATE_COUNT = 1000;
+
+struct ConstraintSetup
+{
+  ConstraintSetup() : robot_model(moveit::core::loadTestingRobotModel(TEST_ROBOT)), robot_state(robot_model)
+  {
+    const moveit::core::JointModelGroup* jmg = robot_model->getJointModelGroup(TEST_GROUP);
+    link_model = robot_model->getLinkModel(jmg->getLinkModelNames().back());
+
+    shape_msgs::msg::SolidPrimitive box;
+    box.type = shape_msgs::msg::SolidPrimitive::BOX;
+    box.dimensions = { 0.05, 0.4, 0.05 };
+    geometry_msgs::msg::Pose box_pose;
+    box_pose.position.x = 0.5;
+    box_pose.position.z = 0.4;
+    box_pose.orientation.w = 1.0;
+    moveit_msgs::msg::PositionConstraint position_constraint;
+    position_constraint.header.frame_id = robot_model->getRootLinkName();
+    position_constraint.link_name = link_model->getName();
+    position_constraint.constraint_region.primitives.push_back(box);
+    position_constraint.constraint_region.primitive_poses.push_back(box_pose);
+    moveit_msgs::msg::Constraints constraint_msgs;
+    constraint_msgs.position_constraints.push_back(position_constraint);
+
+    const auto num_dofs = jmg->getVariableCount();
+    constraint = std::make_shared<ompl_interface::BoxConstraint>(robot_model, TEST_GROUP, num_dofs);
+    constraint->init(constraint_msgs);
+
+    states.resize(num_dofs, STATE_COUNT);
+    robot_state.setToDefaultValues();
+    for (std::size_t i = 0; i < STATE_COUNT; ++i)
+    {
+      robot_state.setToRandomPositions(jmg);
+      Eigen::VectorXd q;
+      robot_state.copyJointGroupPositions(jmg, q);
+      states.col(i) = q;
+    }
+  }
+
+  moveit::core::RobotModelPtr robot_model;
+  moveit::core::RobotState robot_state;
+  const moveit::core::LinkModel* link_model;
+  std::shared_ptr<ompl_interface::BaseConstraint> constraint;
+  Eigen::MatrixXd states;
+};
+}  // namespace
+
+static void newtonStepCached(benchmark::State& st)
+{
+  ConstraintSetup setup;
+  Eigen::VectorXd f(setup.constraint->getCoDimension());
+  Eigen::MatrixXd jacobian(setup.constraint->getCoDimension(), setup.constraint->getAmbientDimension());
+  for (auto _ : st)
+  {
+    for (Eigen::Index i = 0; i < setup.states.cols(); ++i)
+    {
+      setup.constraint->function(setup.states.col(i), f);
+      setup.constraint->jacobian(setup.states.col(i), jacobian);
+      benchmark::DoNotOptimize(jacobian.data());
+    }
+  }
+}
+
+static void newtonStepUncached(benchmark::State& st)
+{
+  // the kinematics that function() and jacobian() of a position constraint computed without the cache
+  ConstraintSetup setup;
+  const moveit::core::JointModelGroup* jmg = setup.robot_model->getJointModelGroup(TEST_GROUP);
+  for (auto _ : st)
+  {
+    for (Eigen::Index i = 0; i < setup.states.cols(); ++i)
+    {
+      const Eigen::VectorXd q = setup.states.col(i);
+      // function: calcError
+      setup.robot_state.setJointGroupPositions(jmg, q);
+      benchmark::DoNotOptimize(setup.robot_state.getGlobalLinkTransform(setup.link_model).translation().data());
+      // jacobian: calcError, then calcErrorJacobian
+      setup.robot_state.setJointGroupPositions(jmg, q);
+      benchmark::DoNotOptimize(setup.robot_state.getGlobalLinkTransform(setup.link_model).translation().data());
+      setup.robot_state.setJointGroupPositions(jmg, q);
+      Eigen::MatrixXd jacobian;
+      setup.robot_state.getJacobian(jmg, setup.link_model, Eigen::Vector3d::Zero(), jacobian);
+      benchmark::DoNotOptimize(jacobian.data());
+    }
+  }
+}
+
+static void projectStates(benchmark::State& st)
+{
+  ConstraintSetup setup;
+  for (auto _ : st)
+  {
+    Eigen::MatrixXd states = setup.states;
+    std::vector<bool> success;
+    benchmark::DoNotOptimize(ompl_interface::projectStates(*setup.constraint, states, success));
+  }
+}
+
+BENCHMARK(newtonStepCached)->Unit(benchmark::kMillisecond);
+BENCHMARK(newtonStepUncached)->Unit(benchmark::kMillisecond);
+BENCHMARK(projectStates)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Compare path length and simplification time of OMPL's serial path simplifier with the windowed
+// ParallelPathSimplifier. To run this benchmark, 'cd' to the build/moveit_planners_ompl directory and directly run
+// the binary.
+
+#include <benchmark/benchmark.h>
+
+#include <moveit/ompl_interface/detail/parallel_path_simplifier.hpp>
+#include <moveit/ompl_interface/detail/state_validity_checker.hpp>
+#include <moveit/ompl_interface/model_based_planning_context.hpp>
+#include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.hpp>
+#include <moveit/planning_scene/planning_scene.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+
+#include <ompl/geometric/SimpleSetup.h>
+
+// Robot and planning group to use in the benchmarks.
+constexpr char TEST_ROBOT[] = "panda";
+constexpr char TEST_GROUP[] = "panda_arm";
+
+namespace
+{
+struct SimplificationProblem
+{
+  SimplificationProblem()
+  {
+    robot_model = moveit::core::loadTestingRobotModel(TEST_ROBOT);
+    ompl_interface::ModelBasedStateSpaceSpecification space_spec(robot_model, TEST_GROUP);
+    state_space = std::make_shared<ompl_interface::JointModelStateSpace>(space_spec);
+    state_space->computeLocations();
+
+    context_spec.state_space_ = state_space;
+    context_spec.ompl_simple_setup_ = std::make_shared<ompl::geometric::SimpleSetup>(state_space);
+    context = std::make_shared<ompl_interface::ModelBasedPlanningContext>(TEST_GROUP, context_spec);
+    planning_scene = std::make_shared<planning_scene::PlanningScene>(robot_model);
+    context->setPlanningScene(planning_scene);
+    moveit::core::RobotState start_state(robot_model);
+    start_state.setToDefaultValues();
+    context->setCompleteInitialState(start_state);
+
+    si = context_spec.ompl_simple_setup_->getSpaceInformation();
+    si->setStateValidityChecker(std::make_shared<ompl_interface::StateValidityChecker>(context.get()));
+    si->setup();
+  }
+
+  // Create a jagged, collision-free random walk through the state space with the given number of states.
+  ompl::geometric::PathGeometric randomWalk(std::size_t state_count) const
+  {
+    ompl::geometric::PathGeometric path(si);
+    ompl::base::StateSamplerPtr sampler = si->allocStateSampler();
+    ompl::base::ScopedState<> current(state_space);
+    ompl::base::ScopedState<> next(state_space);
+    state_space->copyToOMPLState(current.get(), context->getCompleteInitialRobotState());
+    path.append(current.get());
+
+    const double step = 0.05 * state_space->getMaximumExtent();
+    while (path.getStateCount() < state_count)
+    {
+      sampler->sampleUniformNear(next.get(), current.get(), step);
+      if (si->isValid(next.get()) && si->checkMotion(current.get(), next.get()))
+      {
+        path.append(next.get());
+        current = next;
+      }
+    }
+    return path;
+  }
+
+  moveit::core::RobotModelPtr robot_model;
+  ompl_interface::ModelBasedStateSpacePtr state_space;
+  ompl_interface::ModelBasedPlanningContextSpecification context_spec;
+  ompl_interface::ModelBasedPlanningContextPtr context;
+  planning_scene::PlanningScenePtr planning_scene;
+  ompl::base::SpaceInformationPtr si;
+};
+}  // namespace
+
+// Simplify a random walk with a given number of states, using a given number of threads (1 = serial OMPL simplifier).
+static void simplifyPath(benchmark::State& st)
+{
+  const std::size_t state_count = st.range(0);
+  const unsigned int thread_count = st.range(1);
+  const double timeout = 5.0;
+
+  SimplificationProblem problem;
+  const ompl::geometric::PathGeometric initial_path = problem.randomWalk(state_count);
+  ompl_interface::ParallelPathSimplifier simplifier(problem.si, thread_count);
+
+  double path_length = 0.0;
+  double simplified_state_count = 0.0;
+  for (auto _ : st)
+  {
+    st.PauseTiming();
+    ompl::geometric::PathGeometric path(initial_path);
+    st.ResumeTiming();
+
+    simplifier.simplify(path, ompl::base::timedPlannerTerminationCondition(timeout));
+
+    st.PauseTiming();
+    path_length += path.length();
+    simplified_state_count += path.getStateCount();
+    if (!simplifier.checkMotions(path))
+      st.SkipWithError("The simplified path is invalid.");
+    st.ResumeTiming();
+  }
+
+  st.counters["initial_length"] = initial_path.length();
+  st.counters["path_length"] = path_length / st.iterations();
+  st.counters["state_count"] = simplified_state_count / st.iterations();
+}
+
+BENCHMARK(simplifyPath)
+    ->ArgsProduct({ { 100, 500, 1000 }, { 1, 2, 4, 8 } })
+    ->ArgNames({ "states", "threads" })
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
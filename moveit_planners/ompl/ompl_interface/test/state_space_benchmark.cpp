@@ -0,0 +1,121 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Benchmark nearest-neighbor queries in a ModelBasedStateSpace. The per-joint variant forces the distance to be
+// computed by the JointModelGroup, the default variant uses the contiguous values array of groups that only
+// contain bounded revolute and prismatic joints. To run this benchmark, 'cd' to the build/moveit_planners_ompl
+// directory and directly run the binary.
+
+#include <benchmark/benchmark.h>
+
+#include <moveit/ompl_interface/parameterization/joint_space/joint_model_state_space.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+
+#include <ompl/datastructures/NearestNeighborsGNAT.h>
+
+// Robot and planning group to use in the benchmarks.
+constexpr char TEST_ROBOT[] = "panda";
+constexpr char TEST_GROUP[] = "panda_arm";
+
+namespace
+{
+void nearestNeighbors(benchmark::State& st, bool per_joint)
+{
+  const std::size_t state_count = st.range(0);
+  const std::size_t query_count = 1000;
+
+  const moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel(TEST_ROBOT);
+  ompl_interface::ModelBasedStateSpaceSpecification spec(robot_model, TEST_GROUP);
+  auto space = std::make_shared<ompl_interface::JointModelStateSpace>(spec);
+  if (per_joint)
+  {
+    const moveit::core::JointModelGroup* jmg = space->getJointModelGroup();
+    space->setDistanceFunction([jmg](const ompl::base::State* state1, const ompl::base::State* state2) {
+      return jmg->distance(state1->as<ompl_interface::ModelBasedStateSpace::StateType>()->values,
+                           state2->as<ompl_interface::ModelBasedStateSpace::StateType>()->values);
+    });
+  }
+  space->setup();
+
+  ompl::base::StateSamplerPtr sampler = space->allocDefaultStateSampler();
+  std::vector<ompl::base::State*> states(state_count);
+  std::vector<ompl::base::State*> queries(query_count);
+  for (ompl::base::State*& state : states)
+  {
+    state = space->allocState();
+    sampler->sampleUniform(state);
+  }
+  for (ompl::base::State*& query : queries)
+  {
+    query = space->allocState();
+    sampler->sampleUniform(query);
+  }
+
+  ompl::NearestNeighborsGNAT<ompl::base::State*> nn;
+  nn.setDistanceFunction([&space](const ompl::base::State* a, const ompl::base::State* b) {
+    return space->distance(a, b);
+  });
+  nn.add(states);
+
+  std::vector<ompl::base::State*> neighbors;
+  for (auto _ : st)
+  {
+    for (ompl::base::State* query : queries)
+    {
+      nn.nearestK(query, 10, neighbors);
+      benchmark::DoNotOptimize(neighbors.data());
+    }
+  }
+
+  for (ompl::base::State* state : states)
+    space->freeState(state);
+  for (ompl::base::State* query : queries)
+    space->freeState(query);
+}
+}  // namespace
+
+static void nearestNeighborsPerJoint(benchmark::State& st)
+{
+  nearestNeighbors(st, true);
+}
+
+static void nearestNeighborsLinearJoints(benchmark::State& st)
+{
+  nearestNeighbors(st, false);
+}
+
+BENCHMARK(nearestNeighborsPerJoint)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(nearestNeighborsLinearJoints)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,256 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/** Test the per-thread kinematics cache of the constraints in /detail/ompl_constraints.hpp/cpp and the batch
+ * projection that relies on it.
+ *
+ *  NOTE q = joint positions
+ **/
+
+#include "load_test_robot.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <Eigen/Dense>
+
+#include <moveit/ompl_interface/detail/ompl_constraints.hpp>
+#include <moveit_msgs/msg/constraints.hpp>
+
+/** \brief Number of times to run a test that uses randomly generated input. **/
+constexpr int NUM_RANDOM_TESTS = 10;
+
+/** \brief Number of threads evaluating the same constraint at once. **/
+constexpr int NUM_THREADS = 4;
+
+namespace
+{
+/** \brief Constraint message with a box position constraint on the given link. **/
+moveit_msgs::msg::Constraints createPositionConstraints(const std::string& base_link, const std::string& link)
+{
+  shape_msgs::msg::SolidPrimitive box_constraint;
+  box_constraint.type = shape_msgs::msg::SolidPrimitive::BOX;
+  box_constraint.dimensions = { 0.05, 0.4, 0.05 };
+
+  geometry_msgs::msg::Pose box_pose;
+  box_pose.position.x = 0.9;
+  box_pose.position.y = 0.0;
+  box_pose.position.z = 0.2;
+  box_pose.orientation.w = 1.0;
+
+  moveit_msgs::msg::PositionConstraint position_constraint;
+  position_constraint.header.frame_id = base_link;
+  position_constraint.link_name = link;
+  position_constraint.constraint_region.primitives.push_back(box_constraint);
+  position_constraint.constraint_region.primitive_poses.push_back(box_pose);
+
+  moveit_msgs::msg::Constraints constraint_msgs;
+  constraint_msgs.position_constraints.push_back(position_constraint);
+  return constraint_msgs;
+}
+}  // namespace
+
+class ConstraintKinematicsCacheTest : public ompl_interface_testing::LoadTestRobot, public testing::Test
+{
+protected:
+  ConstraintKinematicsCacheTest() : LoadTestRobot("panda", "panda_arm")
+  {
+  }
+
+  std::shared_ptr<ompl_interface::BaseConstraint> createConstraint(const std::string& link) const
+  {
+    auto constraint = std::make_shared<ompl_interface::BoxConstraint>(robot_model_, group_name_, num_dofs_);
+    constraint->init(createPositionConstraints(base_link_name_, link));
+    return constraint;
+  }
+
+  /** \brief Check the cached kinematics of the constraint against a robot state that is not involved in caching. **/
+  void expectKinematics(ompl_interface::BaseConstraint& constraint, const Eigen::VectorXd& q)
+  {
+    const Eigen::Isometry3d pose = constraint.forwardKinematics(q);
+    const Eigen::MatrixXd jac = constraint.robotGeometricJacobian(q);
+
+    robot_state_->setJointGroupPositions(joint_model_group_, q);
+    const Eigen::Isometry3d pose_expected = robot_state_->getGlobalLinkTransform(constraint.getLinkName());
+    Eigen::MatrixXd jac_expected;
+    robot_state_->getJacobian(joint_model_group_, robot_model_->getLinkModel(constraint.getLinkName()),
+                              Eigen::Vector3d::Zero(), jac_expected);
+
+    EXPECT_TRUE(pose.isApprox(pose_expected)) << "link " << constraint.getLinkName();
+    EXPECT_TRUE(jac.isApprox(jac_expected)) << "link " << constraint.getLinkName();
+  }
+};
+
+TEST_F(ConstraintKinematicsCacheTest, MatchesRobotState)
+{
+  for (const std::string& link : { ee_link_name_, joint_model_group_->getLinkModelNames().at(num_dofs_ - 2) })
+  {
+    auto constraint = createConstraint(link);
+    for (int i = 0; i < NUM_RANDOM_TESTS; ++i)
+    {
+      const Eigen::VectorXd q = getRandomState();
+      const Eigen::VectorXd q_other = getRandomState();
+
+      // evaluate at another configuration first, so the cached kinematics must be invalidated
+      Eigen::MatrixXd jac_other(3, num_dofs_);
+      constraint->jacobian(q_other, jac_other);
+      expectKinematics(*constraint, q);
+      // the same configuration again is served from the cache
+      expectKinematics(*constraint, q);
+    }
+  }
+}
+
+TEST_F(ConstraintKinematicsCacheTest, InitInvalidatesCache)
+{
+  auto constraint = createConstraint(ee_link_name_);
+  const Eigen::VectorXd q = getRandomState();
+  expectKinematics(*constraint, q);
+
+  // the same configuration, but another constrained link
+  constraint->init(createPositionConstraints(base_link_name_, joint_model_group_->getLinkModelNames().at(2)));
+  expectKinematics(*constraint, q);
+}
+
+TEST_F(ConstraintKinematicsCacheTest, ConstraintsShareThread)
+{
+  // more constraints than cache slots per thread, evaluated in turns as in a constraint intersection
+  const std::vector<std::string>& links = joint_model_group_->getLinkModelNames();
+  std::vector<std::shared_ptr<ompl_interface::BaseConstraint>> constraints;
+  for (std::size_t i = 1; i < links.size(); ++i)
+  {
+    constraints.push_back(createConstraint(links[i]));
+  }
+  ASSERT_GT(constraints.size(), 4u);
+
+  for (int i = 0; i < NUM_RANDOM_TESTS; ++i)
+  {
+    const Eigen::VectorXd q = getRandomState();
+    for (const auto& constraint : constraints)
+    {
+      expectKinematics(*constraint, q);
+    }
+    // a pair of constraints alternating at the same configuration
+    for (int repeat = 0; repeat < 2; ++repeat)
+    {
+      expectKinematics(*constraints.front(), q);
+      expectKinematics(*constraints.back(), q);
+    }
+  }
+
+  // a new constraint must not find the buffers of a destroyed one
+  const Eigen::VectorXd q = getRandomState();
+  expectKinematics(*constraints.front(), q);
+  constraints.front() = createConstraint(links.back());
+  expectKinematics(*constraints.front(), q);
+}
+
+TEST_F(ConstraintKinematicsCacheTest, ThreadsHaveOwnCache)
+{
+  auto constraint = createConstraint(ee_link_name_);
+  std::vector<Eigen::VectorXd> states;
+  for (int i = 0; i < NUM_RANDOM_TESTS; ++i)
+  {
+    states.push_back(getRandomState());
+  }
+
+  // every thread evaluates all states, starting at a different one
+  std::vector<std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>>> poses(NUM_THREADS);
+  std::vector<std::vector<Eigen::MatrixXd>> jacobians(NUM_THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < NUM_THREADS; ++t)
+  {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < NUM_RANDOM_TESTS; ++i)
+      {
+        const Eigen::VectorXd& q = states[(i + t) % NUM_RANDOM_TESTS];
+        poses[t].push_back(constraint->forwardKinematics(q));
+        jacobians[t].push_back(constraint->robotGeometricJacobian(q));
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  const moveit::core::LinkModel* link_model = robot_model_->getLinkModel(ee_link_name_);
+  for (int t = 0; t < NUM_THREADS; ++t)
+  {
+    for (int i = 0; i < NUM_RANDOM_TESTS; ++i)
+    {
+      robot_state_->setJointGroupPositions(joint_model_group_, states[(i + t) % NUM_RANDOM_TESTS]);
+      Eigen::MatrixXd jac_expected;
+      robot_state_->getJacobian(joint_model_group_, link_model, Eigen::Vector3d::Zero(), jac_expected);
+      EXPECT_TRUE(poses[t][i].isApprox(robot_state_->getGlobalLinkTransform(link_model))) << "thread " << t;
+      EXPECT_TRUE(jacobians[t][i].isApprox(jac_expected)) << "thread " << t;
+    }
+  }
+}
+
+TEST_F(ConstraintKinematicsCacheTest, ProjectStates)
+{
+  auto constraint = createConstraint(ee_link_name_);
+
+  Eigen::MatrixXd states(num_dofs_, NUM_RANDOM_TESTS);
+  for (int i = 0; i < NUM_RANDOM_TESTS; ++i)
+  {
+    states.col(i) = getRandomState();
+  }
+
+  std::vector<bool> success;
+  const std::size_t num_projected = ompl_interface::projectStates(*constraint, states, success);
+
+  ASSERT_EQ(success.size(), static_cast<std::size_t>(NUM_RANDOM_TESTS));
+  EXPECT_EQ(num_projected, static_cast<std::size_t>(std::count(success.begin(), success.end(), true)));
+
+  for (int i = 0; i < NUM_RANDOM_TESTS; ++i)
+  {
+    if (success[i])
+    {
+      EXPECT_TRUE(constraint->isSatisfied(states.col(i)));
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,154 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/experience_registry.hpp>
+#include <moveit/planning_scene/planning_scene.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <geometric_shapes/shapes.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+TEST(ExperienceRegistry, Statistics)
+{
+  ompl_interface::ExperienceRegistry registry;
+  const std::string database = "arm_0.db";
+
+  auto stats = registry.getStatistics(database);
+  EXPECT_EQ(stats.problems, 0u);
+  EXPECT_DOUBLE_EQ(stats.getRecallRate(), 0.0);
+  EXPECT_DOUBLE_EQ(stats.getTimeSaved(), 0.0);
+
+  registry.recordSolution(database, true, false, 2.0);
+  registry.recordSolution(database, true, false, 4.0);
+  registry.recordSolution(database, true, true, 0.5);
+  registry.recordSolution(database, true, true, 0.5);
+  registry.recordSolution(database, false, false, 5.0);
+
+  stats = registry.getStatistics(database);
+  EXPECT_EQ(stats.problems, 5u);
+  EXPECT_EQ(stats.solved_from_scratch, 2u);
+  EXPECT_EQ(stats.solved_from_recall, 2u);
+  EXPECT_EQ(stats.failures, 1u);
+  EXPECT_DOUBLE_EQ(stats.getRecallRate(), 0.5);
+  // two recalled solutions, each 2.5 seconds faster than the average from scratch
+  EXPECT_DOUBLE_EQ(stats.getTimeSaved(), 5.0);
+
+  // statistics are kept per database
+  EXPECT_EQ(registry.getStatistics("other_0.db").problems, 0u);
+}
+
+TEST(ExperienceRegistry, LeastRecentlyUsedDatabases)
+{
+  ompl_interface::ExperienceRegistry registry(2);
+  EXPECT_TRUE(registry.useDatabase("a.db").empty());
+  EXPECT_TRUE(registry.useDatabase("b.db").empty());
+  registry.recordSolution("a.db", true, false, 1.0);
+  registry.recordSolution("b.db", true, false, 1.0);
+
+  // using a again makes b the least recently used database, which is evicted with its statistics
+  EXPECT_TRUE(registry.useDatabase("a.db").empty());
+  EXPECT_EQ(registry.useDatabase("c.db"), std::vector<std::string>{ "b.db" });
+  EXPECT_EQ(registry.getStatistics("a.db").problems, 1u);
+  EXPECT_EQ(registry.getStatistics("b.db").problems, 0u);
+}
+
+TEST(ExperienceRegistry, DatabasePath)
+{
+  ompl_interface::ExperienceRegistry registry;
+  const std::filesystem::path storage = std::filesystem::temp_directory_path() / "moveit_test_experience_registry";
+  std::filesystem::remove_all(storage);
+
+  const std::string database = registry.getDatabasePath(storage.string(), "panda_arm", 0xabc);
+  EXPECT_TRUE(std::filesystem::is_directory(storage));
+  EXPECT_EQ(std::filesystem::path(database).parent_path(), storage);
+  EXPECT_EQ(std::filesystem::path(database).filename(), "panda_arm_abc.db");
+  EXPECT_NE(database, registry.getDatabasePath(storage.string(), "panda_arm", 0xabd));
+  EXPECT_NE(database, registry.getDatabasePath(storage.string(), "hand", 0xabc));
+
+  // a new database replaces the least recently written ones beyond the limit
+  ompl_interface::ExperienceRegistry small_registry(2);
+  const auto now = std::filesystem::file_time_type::clock::now();
+  for (int i = 0; i < 3; ++i)
+  {
+    const std::string path = small_registry.getDatabasePath(storage.string(), "panda_arm", i);
+    std::ofstream(path) << "experiences";
+    std::filesystem::last_write_time(path, now - std::chrono::hours(3 - i));
+  }
+  EXPECT_FALSE(std::filesystem::exists(storage / "panda_arm_0.db"));
+  EXPECT_TRUE(std::filesystem::exists(storage / "panda_arm_1.db"));
+  EXPECT_TRUE(std::filesystem::exists(storage / "panda_arm_2.db"));
+  // an existing database does not remove others
+  small_registry.getDatabasePath(storage.string(), "panda_arm", 1);
+  EXPECT_TRUE(std::filesystem::exists(storage / "panda_arm_2.db"));
+
+  std::filesystem::remove_all(storage);
+}
+
+TEST(ExperienceRegistry, SceneFingerprint)
+{
+  const moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel("panda");
+  planning_scene::PlanningScene scene(robot_model);
+  const std::size_t empty_fingerprint = ompl_interface::ExperienceRegistry::computeSceneFingerprint(scene);
+
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation().x() = 0.5;
+  scene.getWorldNonConst()->addToObject("box", pose, std::make_shared<shapes::Box>(0.1, 0.1, 0.1),
+                                        Eigen::Isometry3d::Identity());
+  const std::size_t box_fingerprint = ompl_interface::ExperienceRegistry::computeSceneFingerprint(scene);
+  EXPECT_NE(empty_fingerprint, box_fingerprint);
+  EXPECT_EQ(box_fingerprint, ompl_interface::ExperienceRegistry::computeSceneFingerprint(scene));
+
+  // moving the object keeps the fingerprint, changing its shape changes it
+  pose.translation().x() = 0.6;
+  scene.getWorldNonConst()->setObjectPose("box", pose);
+  EXPECT_EQ(box_fingerprint, ompl_interface::ExperienceRegistry::computeSceneFingerprint(scene));
+  scene.getWorldNonConst()->removeObject("box");
+  scene.getWorldNonConst()->addToObject("box", pose, std::make_shared<shapes::Box>(0.2, 0.1, 0.1),
+                                        Eigen::Isometry3d::Identity());
+  EXPECT_NE(box_fingerprint, ompl_interface::ExperienceRegistry::computeSceneFingerprint(scene));
+
+  scene.getWorldNonConst()->removeObject("box");
+  EXPECT_EQ(empty_fingerprint, ompl_interface::ExperienceRegistry::computeSceneFingerprint(scene));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,123 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/** Test storage, eviction and statistics of the GoalSampleCache. **/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/goal_sample_cache.hpp>
+
+namespace
+{
+moveit_msgs::msg::Constraints createJointGoal(double position)
+{
+  moveit_msgs::msg::Constraints constraints;
+  moveit_msgs::msg::JointConstraint joint_constraint;
+  joint_constraint.joint_name = "joint_1";
+  joint_constraint.position = position;
+  joint_constraint.tolerance_above = 0.01;
+  joint_constraint.tolerance_below = 0.01;
+  joint_constraint.weight = 1.0;
+  constraints.joint_constraints.push_back(joint_constraint);
+  return constraints;
+}
+}  // namespace
+
+TEST(GoalSampleCache, ComputeKey)
+{
+  using ompl_interface::GoalSampleCache;
+  const std::size_t key = GoalSampleCache::computeKey("arm", createJointGoal(0.5));
+  EXPECT_EQ(key, GoalSampleCache::computeKey("arm", createJointGoal(0.5)));
+  EXPECT_NE(key, GoalSampleCache::computeKey("arm", createJointGoal(0.6)));
+  EXPECT_NE(key, GoalSampleCache::computeKey("other_arm", createJointGoal(0.5)));
+}
+
+TEST(GoalSampleCache, AddAndRemoveSamples)
+{
+  ompl_interface::GoalSampleCache cache(2, 10);
+  EXPECT_TRUE(cache.getSamples(1).empty());
+
+  cache.addSample(1, { 0.0, 1.0 });
+  cache.addSample(1, { 0.0, 1.0 });  // duplicate
+  ASSERT_EQ(cache.getSamples(1).size(), 1u);
+
+  cache.addSample(1, { 0.5, 1.0 });
+  cache.addSample(1, { 1.0, 1.0 });  // exceeds the samples per goal, drops the oldest one
+  const std::vector<std::vector<double>> samples = cache.getSamples(1);
+  ASSERT_EQ(samples.size(), 2u);
+  EXPECT_EQ(samples[0], std::vector<double>({ 0.5, 1.0 }));
+  EXPECT_EQ(samples[1], std::vector<double>({ 1.0, 1.0 }));
+
+  cache.removeSample(1, { 0.5, 1.0 });
+  ASSERT_EQ(cache.getSamples(1).size(), 1u);
+  cache.removeSample(1, { 1.0, 1.0 });
+  EXPECT_TRUE(cache.getSamples(1).empty());
+  EXPECT_EQ(cache.getStatistics().rejected, 2u);
+}
+
+TEST(GoalSampleCache, EvictLeastRecentlyUsed)
+{
+  ompl_interface::GoalSampleCache cache(5, 2);
+  cache.addSample(1, { 1.0 });
+  cache.addSample(2, { 2.0 });
+  EXPECT_EQ(cache.getSamples(1).size(), 1u);  // marks goal 1 as recently used
+
+  cache.addSample(3, { 3.0 });
+  EXPECT_EQ(cache.getSamples(1).size(), 1u);
+  EXPECT_TRUE(cache.getSamples(2).empty());
+  EXPECT_EQ(cache.getSamples(3).size(), 1u);
+}
+
+TEST(GoalSampleCache, Statistics)
+{
+  ompl_interface::GoalSampleCache cache;
+  cache.recordHit();
+  cache.recordHit();
+  cache.recordMiss();
+  ompl_interface::GoalSampleCache::Statistics stats = cache.getStatistics();
+  EXPECT_EQ(stats.hits, 2u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.rejected, 0u);
+
+  cache.clear();
+  stats = cache.getStatistics();
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(stats.misses, 0u);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/** Test the windowed ParallelPathSimplifier on a simple 2D state space with and without an obstacle. **/
+
+#include <gtest/gtest.h>
+
+#include <moveit/ompl_interface/detail/parallel_path_simplifier.hpp>
+
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+#include <ompl/base/ScopedState.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace ob = ompl::base;
+namespace og = ompl::geometric;
+
+class TestParallelPathSimplifier : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    auto space = std::make_shared<ob::RealVectorStateSpace>(2);
+    space->setBounds(-10.0, 10.0);
+    si_ = std::make_shared<ob::SpaceInformation>(space);
+  }
+
+  /** \brief Use a validity checker that rejects the square [-1, 1] x [-1, 1] */
+  void addObstacle()
+  {
+    si_->setStateValidityChecker([](const ob::State* state) {
+      const auto* values = state->as<ob::RealVectorStateSpace::StateType>()->values;
+      return std::abs(values[0]) > 1.0 || std::abs(values[1]) > 1.0;
+    });
+  }
+
+  /** \brief Create a zig-zag path from (-9, 0) to (9, 0) that stays above the obstacle */
+  og::PathGeometric createZigZagPath(std::size_t state_count) const
+  {
+    og::PathGeometric path(si_);
+    ob::ScopedState<ob::RealVectorStateSpace> state(si_);
+    for (std::size_t i = 0; i < state_count; ++i)
+    {
+      state[0] = -9.0 + 18.0 * i / (state_count - 1);
+      state[1] = (i == 0 || i + 1 == state_count) ? 0.0 : (i % 2 ? 4.0 : 2.0);
+      path.append(state.get());
+    }
+    return path;
+  }
+
+  void expectSameEndpoints(const og::PathGeometric& a, const og::PathGeometric& b) const
+  {
+    EXPECT_TRUE(si_->equalStates(a.getState(0), b.getState(0)));
+    EXPECT_TRUE(si_->equalStates(a.getState(a.getStateCount() - 1), b.getState(b.getStateCount() - 1)));
+  }
+
+  ob::SpaceInformationPtr si_;
+};
+
+TEST_F(TestParallelPathSimplifier, FreeSpace)
+{
+  si_->setStateValidityChecker([](const ob::State* /*state*/) { return true; });
+  si_->setup();
+
+  const og::PathGeometric initial_path = createZigZagPath(101);
+  og::PathGeometric path(initial_path);
+  ompl_interface::ParallelPathSimplifier simplifier(si_, 4);
+  EXPECT_TRUE(simplifier.simplify(path, ob::timedPlannerTerminationCondition(5.0)));
+
+  expectSameEndpoints(initial_path, path);
+  EXPECT_LT(path.length(), initial_path.length());
+  EXPECT_LT(path.getStateCount(), initial_path.getStateCount());
+  EXPECT_TRUE(simplifier.checkMotions(path));
+}
+
+TEST_F(TestParallelPathSimplifier, AroundObstacle)
+{
+  addObstacle();
+  si_->setup();
+
+  const og::PathGeometric initial_path = createZigZagPath(101);
+  ASSERT_TRUE(initial_path.check());
+
+  for (unsigned int thread_count : { 1u, 2u, 8u })
+  {
+    SCOPED_TRACE(thread_count);
+    og::PathGeometric path(initial_path);
+    ompl_interface::ParallelPathSimplifier simplifier(si_, thread_count);
+    EXPECT_TRUE(simplifier.simplify(path, ob::timedPlannerTerminationCondition(5.0)));
+
+    expectSameEndpoints(initial_path, path);
+    EXPECT_LT(path.length(), initial_path.length());
+    EXPECT_TRUE(simplifier.checkMotions(path));
+    EXPECT_TRUE(path.check());
+  }
+}
+
+TEST_F(TestParallelPathSimplifier, ShortPathFallsBackToSerial)
+{
+  si_->setStateValidityChecker([](const ob::State* /*state*/) { return true; });
+  si_->setup();
+
+  // too few segments to split the path into windows
+  const og::PathGeometric initial_path = createZigZagPath(5);
+  og::PathGeometric path(initial_path);
+  ompl_interface::ParallelPathSimplifier simplifier(si_, 8);
+  EXPECT_TRUE(simplifier.simplify(path, ob::timedPlannerTerminationCondition(1.0)));
+  expectSameEndpoints(initial_path, path);
+  EXPECT_TRUE(simplifier.checkMotions(path));
+}
+
+TEST_F(TestParallelPathSimplifier, ThreadCountIsCappedAtCores)
+{
+  si_->setup();
+  const unsigned int cores = std::max(std::thread::hardware_concurrency(), 1u);
+  EXPECT_EQ(ompl_interface::ParallelPathSimplifier(si_, 0).getThreadCount(), 1u);
+  EXPECT_EQ(ompl_interface::ParallelPathSimplifier(si_, 1).getThreadCount(), 1u);
+  EXPECT_EQ(ompl_interface::ParallelPathSimplifier(si_, cores + 16).getThreadCount(), cores);
+}
+
+TEST_F(TestParallelPathSimplifier, ReportsValidityNotModification)
+{
+  si_->setStateValidityChecker([](const ob::State* /*state*/) { return true; });
+  si_->setup();
+
+  // a straight path cannot be shortened, but it is valid
+  og::PathGeometric path = createZigZagPath(2);
+  ompl_interface::ParallelPathSimplifier simplifier(si_, 4);
+  EXPECT_TRUE(simplifier.simplify(path, ob::timedPlannerTerminationCondition(1.0)));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -188,6 +188,52 @@ TEST_F(LoadPlanningModelsPr2, StateSpaceCopy)
   joint_model_state_space.freeState(state);
 }
 
+// Compare distance and interpolation on the contiguous values array with the per-joint implementation
+TEST(TestLinearJoints, DistanceAndInterpolation)
+{
+  const moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel("panda");
+  ompl_interface::ModelBasedStateSpaceSpecification spec(robot_model, "panda_arm");
+  ompl_interface::JointModelStateSpace ss(spec);
+  ss.setup();
+  ASSERT_TRUE(ss.hasOnlyLinearJoints());
+
+  const moveit::core::JointModelGroup* jmg = robot_model->getJointModelGroup("panda_arm");
+  ompl::base::StateSamplerPtr sampler = ss.allocDefaultStateSampler();
+  ompl::base::State* from = ss.allocState();
+  ompl::base::State* to = ss.allocState();
+  ompl::base::State* state = ss.allocState();
+  std::vector<double> expected(jmg->getVariableCount());
+  for (int i = 0; i < 100; ++i)
+  {
+    sampler->sampleUniform(from);
+    sampler->sampleUniform(to);
+    const double* from_values = from->as<ompl_interface::ModelBasedStateSpace::StateType>()->values;
+    const double* to_values = to->as<ompl_interface::ModelBasedStateSpace::StateType>()->values;
+    EXPECT_NEAR(ss.distance(from, to), jmg->distance(from_values, to_values), 1e-12);
+
+    const double t = 0.01 * i;
+    ss.interpolate(from, to, t, state);
+    jmg->interpolate(from_values, to_values, t, expected.data());
+    for (std::size_t j = 0; j < expected.size(); ++j)
+      EXPECT_NEAR(state->as<ompl_interface::ModelBasedStateSpace::StateType>()->values[j], expected[j], 1e-12);
+  }
+  ss.freeState(from);
+  ss.freeState(to);
+  ss.freeState(state);
+}
+
+// Groups with continuous or multi-DOF joints use the per-joint implementation
+TEST_F(LoadPlanningModelsPr2, NoLinearJointsFastPath)
+{
+  ompl_interface::ModelBasedStateSpaceSpecification spec1(robot_model_, "right_arm");
+  ompl_interface::JointModelStateSpace ss1(spec1);
+  EXPECT_FALSE(ss1.hasOnlyLinearJoints());
+
+  ompl_interface::ModelBasedStateSpaceSpecification spec2(robot_model_, "whole_body");
+  ompl_interface::JointModelStateSpace ss2(spec2);
+  EXPECT_FALSE(ss2.hasOnlyLinearJoints());
+}
+
 // Run the OMPL sanity checks on the diff drive model
 TEST(TestDiffDrive, TestStateSpace)
 {
@@ -35,6 +35,9 @@
 /* Author: Peter David Fagan */
 
 #include "planning_scene.hpp"
+#include "../robot_state/robot_state.hpp"
+#include <moveit/utils/parallel_for.hpp>
+#include <optional>
 #include <moveit_py/moveit_py_utils/ros_msg_typecasters.hpp>
 #include <pybind11/operators.h>
 
@@ -63,6 +66,35 @@ bool loadGeometryFromFile(std::shared_ptr<planning_scene::PlanningScene>& planni
   file.close();
   return true;
 }
+/// Evaluate check for the current state of planning_scene with each row of positions as joint group positions
+template <typename Check>
+py::array_t<bool> checkStates(const planning_scene::PlanningScene& planning_scene,
+                              const std::string& joint_model_group_name,
+                              const Eigen::Ref<const moveit_py::bind_robot_state::RowMatrixXd>& positions,
+                              std::size_t num_threads, const Check& check)
+{
+  const moveit::core::JointModelGroup* joint_model_group = moveit_py::bind_robot_state::getBatchJointModelGroup(
+      *planning_scene.getRobotModel(), joint_model_group_name, positions);
+
+  const std::size_t count = positions.rows();
+  py::array_t<bool> results(count);
+  bool* data = results.mutable_data();
+  {
+    py::gil_scoped_release release;
+    std::vector<std::optional<moveit::core::RobotState>> states(moveit::parallelThreadCount(count, num_threads));
+    moveit::parallelFor(count, num_threads, [&](std::size_t i, std::size_t worker) {
+      if (!states[worker])
+      {
+        states[worker].emplace(planning_scene.getCurrentState());
+      }
+      moveit::core::RobotState& state = *states[worker];
+      state.setJointGroupPositions(joint_model_group, positions.row(i).data());
+      state.updateCollisionBodyTransforms();
+      data[i] = check(state);
+    });
+  }
+  return results;
+}
 }  // namespace
 
 namespace moveit_py
@@ -97,6 +129,28 @@ moveit_msgs::msg::PlanningScene getPlanningSceneMsg(std::shared_ptr<planning_sce
   return planning_scene_msg;
 }
 
+py::array_t<bool> areStatesColliding(std::shared_ptr<planning_scene::PlanningScene>& planning_scene,
+                                     const std::string& joint_model_group_name,
+                                     const Eigen::Ref<const bind_robot_state::RowMatrixXd>& positions,
+                                     std::size_t num_threads)
+{
+  return checkStates(*planning_scene, joint_model_group_name, positions, num_threads,
+                     [&](const moveit::core::RobotState& state) {
+                       return planning_scene->isStateColliding(state, joint_model_group_name);
+                     });
+}
+
+py::array_t<bool> areStatesValid(std::shared_ptr<planning_scene::PlanningScene>& planning_scene,
+                                 const std::string& joint_model_group_name,
+                                 const Eigen::Ref<const bind_robot_state::RowMatrixXd>& positions,
+                                 std::size_t num_threads)
+{
+  return checkStates(*planning_scene, joint_model_group_name, positions, num_threads,
+                     [&](const moveit::core::RobotState& state) {
+                       return planning_scene->isStateValid(state, joint_model_group_name);
+                     });
+}
+
 void initPlanningScene(py::module& m)
 {
   py::module planning_scene = m.def_submodule("planning_scene");
@@ -280,6 +334,36 @@ void initPlanningScene(py::module& m)
                bool: True if the robot state is in collision, false otherwise.
            )")
 
+      .def("are_states_colliding", &moveit_py::bind_planning_scene::areStatesColliding,
+           py::arg("joint_model_group_name"), py::arg("positions"), py::arg("num_threads") = 0,
+           R"(
+           Check a batch of joint model group positions for collisions.
+
+           The checks run in C++ without holding the GIL, split over num_threads threads. Variables outside the joint model group keep the values of the current state.
+
+	   Args:
+               joint_model_group_name (str): The name of the group to check collision for.
+               positions (:py:class:`numpy.ndarray`): An (N, dof) array with one set of joint model group positions per row.
+               num_threads (int): The number of threads to use, 0 uses all hardware threads.
+           Returns:
+               :py:class:`numpy.ndarray`: An array of N booleans, True where the state is in collision.
+           )")
+
+      .def("are_states_valid", &moveit_py::bind_planning_scene::areStatesValid, py::arg("joint_model_group_name"),
+           py::arg("positions"), py::arg("num_threads") = 0,
+           R"(
+           Check a batch of joint model group positions for validity (collision avoidance and feasibility).
+
+           The checks run in C++ without holding the GIL, split over num_threads threads. Variables outside the joint model group keep the values of the current state.
+
+	   Args:
+               joint_model_group_name (str): The name of the group to check validity for.
+               positions (:py:class:`numpy.ndarray`): An (N, dof) array with one set of joint model group positions per row.
+               num_threads (int): The number of threads to use, 0 uses all hardware threads.
+           Returns:
+               :py:class:`numpy.ndarray`: An array of N booleans, True where the state is valid.
+           )")
+
       .def("is_state_constrained",
            py::overload_cast<const moveit::core::RobotState&, const moveit_msgs::msg::Constraints&, bool>(
                &planning_scene::PlanningScene::isStateConstrained, py::const_),
@@ -39,6 +39,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/eigen.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include <moveit_py/moveit_py_utils/copy_ros_msg.hpp>
 #include <moveit_py/moveit_py_utils/ros_msg_typecasters.hpp>
 #include <moveit/planning_scene/planning_scene.hpp>
@@ -57,6 +58,18 @@ Eigen::MatrixXd getFrameTransform(std::shared_ptr<planning_scene::PlanningScene>
 
 moveit_msgs::msg::PlanningScene getPlanningSceneMsg(std::shared_ptr<planning_scene::PlanningScene>& planning_scene);
 
+py::array_t<bool> areStatesColliding(std::shared_ptr<planning_scene::PlanningScene>& planning_scene,
+                                     const std::string& joint_model_group_name,
+                                     const Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                                                                         Eigen::RowMajor>>& positions,
+                                     std::size_t num_threads);
+
+py::array_t<bool> areStatesValid(std::shared_ptr<planning_scene::PlanningScene>& planning_scene,
+                                 const std::string& joint_model_group_name,
+                                 const Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                                                                     Eigen::RowMajor>>& positions,
+                                 std::size_t num_threads);
+
 void initPlanningScene(py::module& m);
 }  // namespace bind_planning_scene
 }  // namespace moveit_py
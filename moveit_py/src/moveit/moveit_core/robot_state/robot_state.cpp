@@ -39,6 +39,8 @@
 #include <moveit_py/moveit_py_utils/ros_msg_typecasters.hpp>
 #include <moveit_msgs/msg/robot_state.hpp>
 #include <moveit/robot_state/conversions.hpp>
+#include <moveit/utils/parallel_for.hpp>
+#include <optional>
 
 namespace moveit_py
 {
@@ -206,6 +208,97 @@ bool setToDefaultValues(moveit::core::RobotState* self, const std::string& joint
   return self->setToDefaultValues(joint_model_group, state_name);
 }
 
+const moveit::core::JointModelGroup* getBatchJointModelGroup(const moveit::core::RobotModel& robot_model,
+                                                             const std::string& joint_model_group_name,
+                                                             const Eigen::Ref<const RowMatrixXd>& positions)
+{
+  const moveit::core::JointModelGroup* joint_model_group = robot_model.getJointModelGroup(joint_model_group_name);
+  if (!joint_model_group)
+  {
+    throw std::invalid_argument("Invalid joint model group: " + joint_model_group_name);
+  }
+  if (positions.cols() != static_cast<Eigen::Index>(joint_model_group->getVariableCount()))
+  {
+    throw std::invalid_argument("Expected an array of shape (N, " +
+                                std::to_string(joint_model_group->getVariableCount()) + ") for joint model group " +
+                                joint_model_group_name);
+  }
+  return joint_model_group;
+}
+
+py::array_t<double> getGlobalLinkTransforms(const moveit::core::RobotState* self,
+                                            const std::string& joint_model_group_name, const std::string& link_name,
+                                            const Eigen::Ref<const RowMatrixXd>& positions, std::size_t num_threads)
+{
+  const moveit::core::JointModelGroup* joint_model_group =
+      getBatchJointModelGroup(*self->getRobotModel(), joint_model_group_name, positions);
+  const moveit::core::LinkModel* link_model = self->getLinkModel(link_name);
+  if (!link_model)
+  {
+    throw std::invalid_argument("Invalid link: " + link_name);
+  }
+
+  const std::size_t count = positions.rows();
+  py::array_t<double> transforms({ count, std::size_t{ 4 }, std::size_t{ 4 } });
+  double* data = transforms.mutable_data();
+  {
+    py::gil_scoped_release release;
+    // variables outside the group keep the values of this state
+    std::vector<std::optional<moveit::core::RobotState>> states(moveit::parallelThreadCount(count, num_threads));
+    moveit::parallelFor(count, num_threads, [&](std::size_t i, std::size_t worker) {
+      if (!states[worker])
+      {
+        states[worker].emplace(*self);
+      }
+      moveit::core::RobotState& state = *states[worker];
+      state.setJointGroupPositions(joint_model_group, positions.row(i).data());
+      Eigen::Map<Eigen::Matrix<double, 4, 4, Eigen::RowMajor>>(data + 16 * i) =
+          state.getGlobalLinkTransform(link_model).matrix();
+    });
+  }
+  return transforms;
+}
+
+py::array_t<double> getJacobians(const moveit::core::RobotState* self, const std::string& joint_model_group_name,
+                                 const std::string& link_name, const Eigen::Ref<const RowMatrixXd>& positions,
+                                 const Eigen::Vector3d& reference_point_position, std::size_t num_threads)
+{
+  const moveit::core::JointModelGroup* joint_model_group =
+      getBatchJointModelGroup(*self->getRobotModel(), joint_model_group_name, positions);
+  const moveit::core::LinkModel* link_model = self->getLinkModel(link_name);
+  if (!link_model)
+  {
+    throw std::invalid_argument("Invalid link: " + link_name);
+  }
+
+  const std::size_t count = positions.rows();
+  const std::size_t cols = joint_model_group->getVariableCount();
+  py::array_t<double> jacobians({ count, std::size_t{ 6 }, cols });
+  double* data = jacobians.mutable_data();
+  {
+    py::gil_scoped_release release;
+    const std::size_t threads = moveit::parallelThreadCount(count, num_threads);
+    std::vector<std::optional<moveit::core::RobotState>> states(threads);
+    std::vector<Eigen::MatrixXd> jacobian_buffers(threads);
+    moveit::parallelFor(count, num_threads, [&](std::size_t i, std::size_t worker) {
+      if (!states[worker])
+      {
+        states[worker].emplace(*self);
+      }
+      moveit::core::RobotState& state = *states[worker];
+      Eigen::MatrixXd& jacobian = jacobian_buffers[worker];
+      state.setJointGroupPositions(joint_model_group, positions.row(i).data());
+      if (!state.getJacobian(joint_model_group, link_model, reference_point_position, jacobian))
+      {
+        throw std::invalid_argument("Unable to compute the Jacobian of joint model group " + joint_model_group_name +
+                                    " (is it a chain?)");
+      }
+      Eigen::Map<RowMatrixXd>(data + 6 * cols * i, 6, cols) = jacobian;
+    });
+  }
+  return jacobians;
+}
+
 void initRobotState(py::module& m)
 {
   py::module robot_state = m.def_submodule("robot_state");
@@ -435,6 +528,43 @@ void initRobotState(py::module& m)
            :py:class:`numpy.ndarray`: The transform of the specified link in the global frame.
        )")
 
+      // Batch forward kinematics
+      .def("get_global_link_transforms", &moveit_py::bind_robot_state::getGlobalLinkTransforms,
+           py::arg("joint_model_group_name"), py::arg("link_name"), py::arg("positions"), py::arg("num_threads") = 0,
+           R"(
+           Compute the transform of a link in the global frame for a batch of joint model group positions.
+
+           The computation runs in C++ without holding the GIL, split over num_threads threads. Variables outside the joint model group keep the values of this robot state, which itself is not modified.
+
+           Args:
+               joint_model_group_name (str): The name of the joint model group the positions are given for.
+               link_name (str): The name of the link to get the transforms for.
+               positions (:py:class:`numpy.ndarray`): An (N, dof) array with one set of joint model group positions per row.
+               num_threads (int): The number of threads to use, 0 uses all hardware threads.
+
+           Returns:
+               :py:class:`numpy.ndarray`: An (N, 4, 4) array of transforms of the link in the global frame.
+           )")
+
+      .def("get_jacobians", &moveit_py::bind_robot_state::getJacobians, py::arg("joint_model_group_name"),
+           py::arg("link_name"), py::arg("positions"),
+           py::arg("reference_point_position") = Eigen::Vector3d::Zero().eval(), py::arg("num_threads") = 0,
+           R"(
+           Compute the Jacobian of a joint model group with reference to a point on a link, for a batch of joint model group positions.
+
+           The computation runs in C++ without holding the GIL, split over num_threads threads. Variables outside the joint model group keep the values of this robot state, which itself is not modified.
+
+           Args:
+               joint_model_group_name (str): The name of the joint model group to compute the Jacobians for.
+               link_name (str): The name of the link model to compute the Jacobians for.
+               positions (:py:class:`numpy.ndarray`): An (N, dof) array with one set of joint model group positions per row.
+               reference_point_position (:py:class:`numpy.ndarray`): The position of the reference point in the link frame.
+               num_threads (int): The number of threads to use, 0 uses all hardware threads.
+
+           Returns:
+               :py:class:`numpy.ndarray`: An (N, 6, dof) array of Jacobians.
+           )")
+
       // Setting state from inverse kinematics
       .def(
           "set_from_ik",
@@ -44,6 +44,7 @@
 #endif
 #include <pybind11/eigen.h>
 #pragma GCC diagnostic pop
+#include <pybind11/numpy.h>
 #include <moveit_py/moveit_py_utils/copy_ros_msg.hpp>
 #include <tf2_eigen/tf2_eigen.hpp>
 #include <moveit/robot_state/robot_state.hpp>
@@ -54,6 +55,14 @@ namespace moveit_py
 {
 namespace bind_robot_state
 {
+/// Batch of joint group positions, one state per row; binds to C-contiguous NumPy arrays without a copy
+using RowMatrixXd = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/// Look up the joint model group of a batch query and check that positions has one column per group variable
+const moveit::core::JointModelGroup* getBatchJointModelGroup(const moveit::core::RobotModel& robot_model,
+                                                             const std::string& joint_model_group_name,
+                                                             const Eigen::Ref<const RowMatrixXd>& positions);
+
 void update(moveit::core::RobotState* self, bool force, std::string& category);
 
 Eigen::MatrixXd getFrameTransform(const moveit::core::RobotState* self, std::string& frame_id);
@@ -78,6 +87,14 @@ Eigen::MatrixXd getJacobian(const moveit::core::RobotState* self, const std::str
 bool setToDefaultValues(moveit::core::RobotState* self, const std::string& joint_model_group_name,
                         const std::string& state_name);
 
+py::array_t<double> getGlobalLinkTransforms(const moveit::core::RobotState* self,
+                                            const std::string& joint_model_group_name, const std::string& link_name,
+                                            const Eigen::Ref<const RowMatrixXd>& positions, std::size_t num_threads);
+
+py::array_t<double> getJacobians(const moveit::core::RobotState* self, const std::string& joint_model_group_name,
+                                 const std::string& link_name, const Eigen::Ref<const RowMatrixXd>& positions,
+                                 const Eigen::Vector3d& reference_point_position, std::size_t num_threads);
+
 void initRobotState(py::module& m);
 }  // namespace bind_robot_state
 }  // namespace moveit_py
@@ -37,11 +37,117 @@
 #include "robot_trajectory.hpp"
 #include <moveit_py/moveit_py_utils/ros_msg_typecasters.hpp>
 #include <moveit/trajectory_processing/trajectory_tools.hpp>
+#include <moveit/utils/parallel_for.hpp>
+#include <algorithm>
 
 namespace moveit_py
 {
 namespace bind_robot_trajectory
 {
+namespace
+{
+enum class WayPointValues
+{
+  POSITIONS,
+  VELOCITIES,
+  ACCELERATIONS
+};
+
+// Group whose variables form the array columns; nullptr stands for all variables of the robot model
+const moveit::core::JointModelGroup* getArrayJointModelGroup(const robot_trajectory::RobotTrajectory& self,
+                                                             const std::string& joint_model_group_name)
+{
+  if (joint_model_group_name.empty())
+  {
+    return self.getGroup();
+  }
+  const moveit::core::JointModelGroup* joint_model_group =
+      self.getRobotModel()->getJointModelGroup(joint_model_group_name);
+  if (!joint_model_group)
+  {
+    throw std::invalid_argument("Invalid joint model group: " + joint_model_group_name);
+  }
+  return joint_model_group;
+}
+
+std::size_t getArrayColumnCount(const robot_trajectory::RobotTrajectory& self,
+                                const moveit::core::JointModelGroup* joint_model_group)
+{
+  return joint_model_group ? joint_model_group->getVariableCount() : self.getRobotModel()->getVariableCount();
+}
+
+void checkArrayShape(const DoubleArray& array, const std::string& name, std::size_t rows, std::size_t cols)
+{
+  if (array.ndim() != 2 || static_cast<std::size_t>(array.shape(0)) != rows ||
+      static_cast<std::size_t>(array.shape(1)) != cols)
+  {
+    throw std::invalid_argument("Expected " + name + " of shape (" + std::to_string(rows) + ", " +
+                                std::to_string(cols) + ")");
+  }
+}
+
+py::array_t<double> copyWayPointValues(const robot_trajectory::RobotTrajectory& self,
+                                       const std::string& joint_model_group_name, WayPointValues values)
+{
+  const moveit::core::JointModelGroup* joint_model_group = getArrayJointModelGroup(self, joint_model_group_name);
+  const std::size_t count = self.getWayPointCount();
+  const std::size_t cols = getArrayColumnCount(self, joint_model_group);
+
+  py::array_t<double> array({ count, cols });
+  double* data = array.mutable_data();
+  {
+    py::gil_scoped_release release;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const moveit::core::RobotState& state = self.getWayPoint(i);
+      double* row = data + i * cols;
+      switch (values)
+      {
+        case WayPointValues::POSITIONS:
+          if (joint_model_group)
+          {
+            state.copyJointGroupPositions(joint_model_group, row);
+          }
+          else
+          {
+            std::copy_n(state.getVariablePositions(), cols, row);
+          }
+          break;
+        case WayPointValues::VELOCITIES:
+          if (!state.hasVelocities())
+          {
+            std::fill_n(row, cols, 0.0);
+          }
+          else if (joint_model_group)
+          {
+            state.copyJointGroupVelocities(joint_model_group, row);
+          }
+          else
+          {
+            std::copy_n(state.getVariableVelocities(), cols, row);
+          }
+          break;
+        case WayPointValues::ACCELERATIONS:
+          if (!state.hasAccelerations())
+          {
+            std::fill_n(row, cols, 0.0);
+          }
+          else if (joint_model_group)
+          {
+            state.copyJointGroupAccelerations(joint_model_group, row);
+          }
+          else
+          {
+            std::copy_n(state.getVariableAccelerations(), cols, row);
+          }
+          break;
+      }
+    }
+  }
+  return array;
+}
+}  // namespace
+
 moveit_msgs::msg::RobotTrajectory
 getRobotTrajectoryMsg(const robot_trajectory::RobotTrajectoryConstPtr& robot_trajectory,
                       const std::vector<std::string>& joint_filter)
@@ -58,6 +164,129 @@ setRobotTrajectoryMsg(const std::shared_ptr<robot_trajectory::RobotTrajectory>&
   return robot_trajectory->setRobotTrajectoryMsg(robot_state, msg);
 }
 
+py::array_t<double> getPositions(const robot_trajectory::RobotTrajectory& self,
+                                 const std::string& joint_model_group_name)
+{
+  return copyWayPointValues(self, joint_model_group_name, WayPointValues::POSITIONS);
+}
+
+py::array_t<double> getVelocities(const robot_trajectory::RobotTrajectory& self,
+                                  const std::string& joint_model_group_name)
+{
+  return copyWayPointValues(self, joint_model_group_name, WayPointValues::VELOCITIES);
+}
+
+py::array_t<double> getAccelerations(const robot_trajectory::RobotTrajectory& self,
+                                     const std::string& joint_model_group_name)
+{
+  return copyWayPointValues(self, joint_model_group_name, WayPointValues::ACCELERATIONS);
+}
+
+py::array_t<double> getTimeFromStart(const robot_trajectory::RobotTrajectory& self)
+{
+  const std::size_t count = self.getWayPointCount();
+  py::array_t<double> time_from_start(count);
+  double* data = time_from_start.mutable_data();
+  // accumulate once instead of calling getWayPointDurationFromStart(), which is linear in the index
+  double time = 0.0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    time += self.getWayPointDurationFromPrevious(i);
+    data[i] = time;
+  }
+  return time_from_start;
+}
+
+void setFromArrays(robot_trajectory::RobotTrajectory& self, const moveit::core::RobotState& reference_state,
+                   const std::string& joint_model_group_name, const DoubleArray& positions,
+                   const DoubleArray& time_from_start, const std::optional<DoubleArray>& velocities,
+                   const std::optional<DoubleArray>& accelerations, std::size_t num_threads)
+{
+  if (reference_state.getRobotModel() != self.getRobotModel())
+  {
+    throw std::invalid_argument("The reference state must belong to the robot model of the trajectory");
+  }
+  const moveit::core::JointModelGroup* joint_model_group = getArrayJointModelGroup(self, joint_model_group_name);
+  const std::size_t cols = getArrayColumnCount(self, joint_model_group);
+  if (positions.ndim() != 2)
+  {
+    throw std::invalid_argument("Expected positions of shape (N, " + std::to_string(cols) + ")");
+  }
+  const std::size_t count = positions.shape(0);
+  checkArrayShape(positions, "positions", count, cols);
+  if (velocities)
+  {
+    checkArrayShape(*velocities, "velocities", count, cols);
+  }
+  if (accelerations)
+  {
+    checkArrayShape(*accelerations, "accelerations", count, cols);
+  }
+  if (time_from_start.ndim() != 1 || static_cast<std::size_t>(time_from_start.shape(0)) != count)
+  {
+    throw std::invalid_argument("Expected time_from_start of shape (" + std::to_string(count) + ",)");
+  }
+
+  const double* position_data = positions.data();
+  const double* velocity_data = velocities ? velocities->data() : nullptr;
+  const double* acceleration_data = accelerations ? accelerations->data() : nullptr;
+  const double* time_data = time_from_start.data();
+  for (std::size_t i = 1; i < count; ++i)
+  {
+    if (time_data[i] < time_data[i - 1])
+    {
+      throw std::invalid_argument("time_from_start must be non-decreasing");
+    }
+  }
+
+  std::vector<moveit::core::RobotStatePtr> waypoints(count);
+  {
+    py::gil_scoped_release release;
+    moveit::parallelFor(count, num_threads, [&](std::size_t i, std::size_t /* worker */) {
+      // variables outside the group keep the values of the reference state
+      auto state = std::make_shared<moveit::core::RobotState>(reference_state);
+      const std::size_t offset = i * cols;
+      if (joint_model_group)
+      {
+        state->setJointGroupPositions(joint_model_group, position_data + offset);
+        if (velocity_data)
+        {
+          state->setJointGroupVelocities(joint_model_group, velocity_data + offset);
+        }
+        if (acceleration_data)
+        {
+          state->setJointGroupAccelerations(joint_model_group, acceleration_data + offset);
+        }
+      }
+      else
+      {
+        state->setVariablePositions(position_data + offset);
+        if (velocity_data)
+        {
+          state->setVariableVelocities(velocity_data + offset);
+        }
+        if (acceleration_data)
+        {
+          state->setVariableAccelerations(acceleration_data + offset);
+        }
+      }
+      state->update();
+      waypoints[i] = std::move(state);
+    });
+  }
+
+  self.clear();
+  if (joint_model_group)
+  {
+    self.setGroupName(joint_model_group->getName());
+  }
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // like setRobotTrajectoryMsg(), the first waypoint keeps its offset from the start of the trajectory
+    self.addSuffixWayPoint(waypoints[i], i == 0 ? time_data[0] : time_data[i] - time_data[i - 1]);
+  }
+}
+
 void initRobotTrajectory(py::module& m)
 {
   py::module robot_trajectory = m.def_submodule("robot_trajectory");
@@ -182,6 +411,60 @@ void initRobotTrajectory(py::module& m)
            Args:
                robot_state (:py:class:`moveit_py.core.RobotState`): The reference robot starting state.
                msg (moveit_msgs.msg.RobotTrajectory): A ROS robot trajectory message.
+           )")
+      .def("get_positions", &moveit_py::bind_robot_trajectory::getPositions,
+           py::arg("joint_model_group_name") = std::string(),
+           R"(
+           Get the joint positions of all waypoints as a single array.
+
+           Args:
+               joint_model_group_name (str): The joint model group whose variables form the columns. Defaults to the group of the trajectory, or all robot variables if the trajectory has no group.
+           Returns:
+               np.ndarray: An array of shape (N, dof) holding one waypoint per row.
+           )")
+      .def("get_velocities", &moveit_py::bind_robot_trajectory::getVelocities,
+           py::arg("joint_model_group_name") = std::string(),
+           R"(
+           Get the joint velocities of all waypoints as a single array.
+
+           Args:
+               joint_model_group_name (str): The joint model group whose variables form the columns. Defaults to the group of the trajectory, or all robot variables if the trajectory has no group.
+           Returns:
+               np.ndarray: An array of shape (N, dof) holding one waypoint per row. Waypoints without velocities contribute zeros.
+           )")
+      .def("get_accelerations", &moveit_py::bind_robot_trajectory::getAccelerations,
+           py::arg("joint_model_group_name") = std::string(),
+           R"(
+           Get the joint accelerations of all waypoints as a single array.
+
+           Args:
+               joint_model_group_name (str): The joint model group whose variables form the columns. Defaults to the group of the trajectory, or all robot variables if the trajectory has no group.
+           Returns:
+               np.ndarray: An array of shape (N, dof) holding one waypoint per row. Waypoints without accelerations contribute zeros.
+           )")
+      .def("get_time_from_start", &moveit_py::bind_robot_trajectory::getTimeFromStart,
+           R"(
+           Get the time of each waypoint relative to the start of the trajectory.
+
+           Returns:
+               np.ndarray: An array of shape (N,) with the cumulative waypoint durations.
+           )")
+      .def("set_from_arrays", &moveit_py::bind_robot_trajectory::setFromArrays, py::arg("reference_state"),
+           py::arg("joint_model_group_name"), py::arg("positions"), py::arg("time_from_start"),
+           py::arg("velocities") = py::none(), py::arg("accelerations") = py::none(), py::arg("num_threads") = 0,
+           R"(
+           Replace the waypoints of the trajectory with the rows of the given arrays.
+
+           The waypoints are built in C++ without holding the GIL. C-contiguous float64 arrays are read without a copy.
+
+           Args:
+               reference_state (:py:class:`moveit_py.core.RobotState`): Provides the values of all variables that are not set from the arrays.
+               joint_model_group_name (str): The joint model group whose variables form the columns. If empty, the group of the trajectory, or all robot variables if the trajectory has no group.
+               positions (np.ndarray): An array of shape (N, dof) holding one waypoint per row.
+               time_from_start (np.ndarray): An array of shape (N,) with non-decreasing waypoint times.
+               velocities (np.ndarray): An optional array of shape (N, dof) of joint velocities.
+               accelerations (np.ndarray): An optional array of shape (N, dof) of joint accelerations.
+               num_threads (int): The number of threads used to build the waypoints, 0 uses all hardware threads.
            )");
   // TODO (peterdavidfagan): support other methods such as appending trajectories
 }
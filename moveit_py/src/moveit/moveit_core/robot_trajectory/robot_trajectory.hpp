@@ -39,9 +39,11 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <moveit/robot_trajectory/robot_trajectory.hpp>
 #include <moveit_msgs/msg/robot_trajectory.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <optional>
 
 namespace py = pybind11;
 
@@ -49,6 +51,9 @@ namespace moveit_py
 {
 namespace bind_robot_trajectory
 {
+/// Row-major float64 array; C-contiguous input binds without a copy, anything else is converted once
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
 moveit_msgs::msg::RobotTrajectory
 getRobotTrajectoryMsg(const robot_trajectory::RobotTrajectoryConstPtr& robot_trajectory,
                       const std::vector<std::string>& joint_filter);
@@ -56,6 +61,19 @@ robot_trajectory::RobotTrajectory
 setRobotTrajectoryMsg(const std::shared_ptr<robot_trajectory::RobotTrajectory>& robot_trajectory,
                       const moveit::core::RobotState& robot_state, const moveit_msgs::msg::RobotTrajectory& msg);
 
+py::array_t<double> getPositions(const robot_trajectory::RobotTrajectory& self,
+                                 const std::string& joint_model_group_name);
+py::array_t<double> getVelocities(const robot_trajectory::RobotTrajectory& self,
+                                  const std::string& joint_model_group_name);
+py::array_t<double> getAccelerations(const robot_trajectory::RobotTrajectory& self,
+                                     const std::string& joint_model_group_name);
+py::array_t<double> getTimeFromStart(const robot_trajectory::RobotTrajectory& self);
+
+void setFromArrays(robot_trajectory::RobotTrajectory& self, const moveit::core::RobotState& reference_state,
+                   const std::string& joint_model_group_name, const DoubleArray& positions,
+                   const DoubleArray& time_from_start, const std::optional<DoubleArray>& velocities,
+                   const std::optional<DoubleArray>& accelerations, std::size_t num_threads);
+
 void initRobotTrajectory(py::module& m);
 }  // namespace bind_robot_trajectory
 }  // namespace moveit_py
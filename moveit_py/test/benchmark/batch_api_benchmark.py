@@ -0,0 +1,106 @@
+"""
+Compare per-state RobotState / PlanningScene queries with their batch counterparts.
+
+Run from a build space, e.g.:
+    PYTHONPATH=build/moveit_py python3 test/benchmark/batch_api_benchmark.py --states 10000
+"""
+
+import argparse
+import os
+import time
+
+import numpy as np
+
+from test_moveit.core.planning_scene import PlanningScene
+from test_moveit.core.robot_model import RobotModel
+from test_moveit.core.robot_state import RobotState
+
+dir_path = os.path.dirname(os.path.realpath(__file__))
+URDF_FILE = "{}/../unit/fixtures/panda.urdf".format(dir_path)
+SRDF_FILE = "{}/../unit/fixtures/panda.srdf".format(dir_path)
+
+GROUP = "panda_arm"
+LINK = "panda_link8"
+
+
+def timed(function):
+    """Return the wall time in seconds of calling function once."""
+    start = time.perf_counter()
+    function()
+    return time.perf_counter() - start
+
+
+def per_state_transforms(robot_state, positions):
+    for state_positions in positions:
+        robot_state.set_joint_group_positions(GROUP, state_positions)
+        robot_state.update()
+        robot_state.get_global_link_transform(LINK)
+
+
+def per_state_jacobians(robot_state, positions):
+    reference_point = np.zeros(3)
+    for state_positions in positions:
+        robot_state.set_joint_group_positions(GROUP, state_positions)
+        robot_state.update()
+        robot_state.get_jacobian(GROUP, LINK, reference_point)
+
+
+def per_state_collisions(planning_scene, robot_state, positions):
+    for state_positions in positions:
+        robot_state.set_joint_group_positions(GROUP, state_positions)
+        robot_state.update()
+        planning_scene.is_state_colliding(robot_state, GROUP)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--states", type=int, default=10000)
+    parser.add_argument("--threads", type=int, nargs="+", default=[1, 2, 4, 8])
+    args = parser.parse_args()
+
+    robot_model = RobotModel(urdf_xml_path=URDF_FILE, srdf_xml_path=SRDF_FILE)
+    robot_state = RobotState(robot_model)
+    robot_state.set_to_default_values()
+    robot_state.update()
+    planning_scene = PlanningScene(robot_model)
+
+    rng = np.random.default_rng(0)
+    positions = rng.uniform(-1.0, 1.0, size=(args.states, 7))
+
+    queries = {
+        "link transforms": (
+            lambda: per_state_transforms(robot_state, positions),
+            lambda threads: robot_state.get_global_link_transforms(
+                GROUP, LINK, positions, num_threads=threads
+            ),
+        ),
+        "jacobians": (
+            lambda: per_state_jacobians(robot_state, positions),
+            lambda threads: robot_state.get_jacobians(
+                GROUP, LINK, positions, num_threads=threads
+            ),
+        ),
+        "collision checks": (
+            lambda: per_state_collisions(planning_scene, robot_state, positions),
+            lambda threads: planning_scene.are_states_colliding(
+                GROUP, positions, num_threads=threads
+            ),
+        ),
+    }
+
+    rows = []
+    for query, (per_state, batch) in queries.items():
+        rows.append((query, "per-state", timed(per_state)))
+        for threads in args.threads:
+            mode = "batch x{}".format(threads)
+            rows.append((query, mode, timed(lambda: batch(threads))))
+
+    print("{} states".format(args.states))
+    print("{:<18}{:<12}{:>12}{:>16}".format("query", "mode", "time [s]", "states / s"))
+    for query, mode, seconds in rows:
+        rate = args.states / seconds
+        print("{:<18}{:<12}{:>12.4f}{:>16.0f}".format(query, mode, seconds, rate))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,143 @@
+"""
+Compare per-waypoint RobotTrajectory access with the array export and construction APIs.
+
+Run from a build space, e.g.:
+    PYTHONPATH=build/moveit_py \
+        python3 test/benchmark/robot_trajectory_array_benchmark.py --waypoints 10000
+"""
+
+import argparse
+import os
+import time
+
+import numpy as np
+
+from builtin_interfaces.msg import Duration
+from moveit_msgs.msg import RobotTrajectory as RobotTrajectoryMsg
+from trajectory_msgs.msg import JointTrajectoryPoint
+
+from test_moveit.core.robot_model import RobotModel
+from test_moveit.core.robot_state import RobotState
+from test_moveit.core.robot_trajectory import RobotTrajectory
+
+dir_path = os.path.dirname(os.path.realpath(__file__))
+URDF_FILE = "{}/../unit/fixtures/panda.urdf".format(dir_path)
+SRDF_FILE = "{}/../unit/fixtures/panda.srdf".format(dir_path)
+
+GROUP = "panda_arm"
+
+
+def timed(function):
+    """Return the wall time in seconds of calling function once."""
+    start = time.perf_counter()
+    function()
+    return time.perf_counter() - start
+
+
+def to_duration_msg(seconds):
+    sec = int(seconds)
+    return Duration(sec=sec, nanosec=int((seconds - sec) * 1e9))
+
+
+def per_waypoint_export(trajectory):
+    positions = np.array([w.get_joint_group_positions(GROUP) for w in trajectory])
+    velocities = np.array([w.get_joint_group_velocities(GROUP) for w in trajectory])
+    return positions, velocities
+
+
+def message_export(trajectory):
+    points = trajectory.get_robot_trajectory_msg().joint_trajectory.points
+    positions = np.array([point.positions for point in points])
+    velocities = np.array([point.velocities for point in points])
+    return positions, velocities
+
+
+def array_export(trajectory):
+    return trajectory.get_positions(GROUP), trajectory.get_velocities(GROUP)
+
+
+def message_construction(trajectory, reference_state, arrays):
+    positions, velocities, time_from_start = arrays
+    group = reference_state.robot_model.get_joint_model_group(GROUP)
+    msg = RobotTrajectoryMsg()
+    msg.joint_trajectory.joint_names = group.active_joint_model_names
+    for point_positions, point_velocities, point_time in zip(
+        positions, velocities, time_from_start
+    ):
+        msg.joint_trajectory.points.append(
+            JointTrajectoryPoint(
+                positions=point_positions.tolist(),
+                velocities=point_velocities.tolist(),
+                time_from_start=to_duration_msg(point_time),
+            )
+        )
+    trajectory.set_robot_trajectory_msg(reference_state, msg)
+
+
+def array_construction(trajectory, reference_state, arrays, threads):
+    positions, velocities, time_from_start = arrays
+    trajectory.set_from_arrays(
+        reference_state,
+        GROUP,
+        positions,
+        time_from_start,
+        velocities=velocities,
+        num_threads=threads,
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--waypoints", type=int, default=10000)
+    parser.add_argument("--threads", type=int, nargs="+", default=[1, 4])
+    args = parser.parse_args()
+
+    robot_model = RobotModel(urdf_xml_path=URDF_FILE, srdf_xml_path=SRDF_FILE)
+    reference_state = RobotState(robot_model)
+    reference_state.set_to_default_values()
+    reference_state.update()
+
+    rng = np.random.default_rng(0)
+    arrays = (
+        rng.uniform(-1.0, 1.0, size=(args.waypoints, 7)),
+        rng.uniform(-0.5, 0.5, size=(args.waypoints, 7)),
+        np.arange(args.waypoints) * 0.01,
+    )
+    trajectory = RobotTrajectory(robot_model)
+
+    rows = [
+        (
+            "construct",
+            "message",
+            timed(lambda: message_construction(trajectory, reference_state, arrays)),
+        )
+    ]
+    for threads in args.threads:
+        rows.append(
+            (
+                "construct",
+                "arrays x{}".format(threads),
+                timed(
+                    lambda: array_construction(
+                        trajectory, reference_state, arrays, threads
+                    )
+                ),
+            )
+        )
+    for mode, export in (
+        ("per-waypoint", per_waypoint_export),
+        ("message", message_export),
+        ("arrays", array_export),
+    ):
+        rows.append(("export", mode, timed(lambda: export(trajectory))))
+
+    print("{} waypoints".format(args.waypoints))
+    header = ("operation", "mode", "time [s]", "waypoints / s")
+    print("{:<12}{:<16}{:>12}{:>18}".format(*header))
+    for operation, mode, seconds in rows:
+        rate = args.waypoints / seconds
+        print("{:<12}{:<16}{:>12.4f}{:>18.0f}".format(operation, mode, seconds, rate))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,182 @@
+import unittest
+import numpy as np
+
+from geometry_msgs.msg import Pose
+from moveit_msgs.msg import CollisionObject
+from shape_msgs.msg import SolidPrimitive
+
+from test_moveit.core.planning_scene import PlanningScene
+from test_moveit.core.robot_state import RobotState
+from test_moveit.core.robot_model import RobotModel
+
+import os
+
+dir_path = os.path.dirname(os.path.realpath(__file__))
+URDF_FILE = "{}/fixtures/panda.urdf".format(dir_path)
+SRDF_FILE = "{}/fixtures/panda.srdf".format(dir_path)
+
+READY_POSITIONS = [0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785]
+
+
+def get_robot_model():
+    """Helper function that returns a RobotModel instance."""
+    return RobotModel(urdf_xml_path=URDF_FILE, srdf_xml_path=SRDF_FILE)
+
+
+def get_planning_scene_with_box():
+    """
+    Helper function that returns a PlanningScene and a RobotState at its current state.
+    A box surrounds the end of the arm in the ready pose.
+    """
+    robot_model = get_robot_model()
+    robot_state = RobotState(robot_model)
+    robot_state.set_to_default_values()
+    robot_state.set_joint_group_positions("panda_arm", READY_POSITIONS)
+    robot_state.update()
+    flange = robot_state.get_global_link_transform("panda_link8")
+
+    box = SolidPrimitive()
+    box.type = SolidPrimitive.BOX
+    box.dimensions = [0.2, 0.2, 0.2]
+    box_pose = Pose()
+    box_pose.position.x, box_pose.position.y, box_pose.position.z = flange[:3, 3]
+    box_pose.orientation.w = 1.0
+    collision_object = CollisionObject()
+    collision_object.header.frame_id = robot_model.model_frame
+    collision_object.id = "box"
+    collision_object.primitives = [box]
+    collision_object.primitive_poses = [box_pose]
+    collision_object.operation = CollisionObject.ADD
+
+    planning_scene = PlanningScene(robot_model)
+    planning_scene.current_state = robot_state
+    planning_scene.apply_collision_object(collision_object)
+    return planning_scene, robot_state
+
+
+def get_batch_positions():
+    """
+    Helper function that returns arm positions in the box, away from it and random ones.
+    """
+    away_from_box = list(READY_POSITIONS)
+    away_from_box[0] += 1.5
+    random_positions = np.random.default_rng(0).uniform(-1.0, 1.0, size=(20, 7))
+    return np.vstack([READY_POSITIONS, away_from_box, random_positions])
+
+
+class TestPlanningScene(unittest.TestCase):
+    def test_are_states_colliding(self):
+        """
+        Test that batch collision checks match per-state collision checks
+        """
+        planning_scene, robot_state = get_planning_scene_with_box()
+        positions = get_batch_positions()
+        colliding = planning_scene.are_states_colliding(
+            joint_model_group_name="panda_arm",
+            positions=positions,
+            num_threads=4,
+        )
+
+        self.assertEqual(colliding.shape, (len(positions),))
+        self.assertEqual(colliding.dtype, np.bool_)
+        self.assertTrue(colliding[0])
+        self.assertFalse(colliding[1])
+        for state_positions, state_colliding in zip(positions, colliding):
+            robot_state.set_joint_group_positions("panda_arm", state_positions)
+            robot_state.update()
+            self.assertEqual(
+                state_colliding,
+                planning_scene.is_state_colliding(robot_state, "panda_arm"),
+            )
+
+    def test_are_states_valid(self):
+        """
+        Test that batch validity checks match per-state validity checks
+        """
+        planning_scene, robot_state = get_planning_scene_with_box()
+        positions = get_batch_positions()
+        valid = planning_scene.are_states_valid(
+            joint_model_group_name="panda_arm",
+            positions=positions,
+            num_threads=4,
+        )
+
+        self.assertEqual(valid.shape, (len(positions),))
+        self.assertFalse(valid[0])
+        self.assertTrue(valid[1])
+        for state_positions, state_valid in zip(positions, valid):
+            robot_state.set_joint_group_positions("panda_arm", state_positions)
+            robot_state.update()
+            self.assertEqual(
+                state_valid, planning_scene.is_state_valid(robot_state, "panda_arm")
+            )
+
+    def test_batch_checks_single_thread(self):
+        """
+        Test that batch checks give the same results on one thread as on several
+        """
+        planning_scene, _ = get_planning_scene_with_box()
+        positions = get_batch_positions()
+
+        np.testing.assert_array_equal(
+            planning_scene.are_states_colliding("panda_arm", positions, num_threads=1),
+            planning_scene.are_states_colliding("panda_arm", positions, num_threads=4),
+        )
+        np.testing.assert_array_equal(
+            planning_scene.are_states_valid("panda_arm", positions, num_threads=1),
+            planning_scene.are_states_valid("panda_arm", positions, num_threads=4),
+        )
+
+    def test_batch_checks_empty(self):
+        """
+        Test that batch checks of no states return empty arrays
+        """
+        planning_scene, _ = get_planning_scene_with_box()
+        positions = np.empty((0, 7))
+
+        colliding = planning_scene.are_states_colliding("panda_arm", positions)
+        valid = planning_scene.are_states_valid("panda_arm", positions)
+
+        self.assertEqual(colliding.shape, (0,))
+        self.assertEqual(valid.shape, (0,))
+
+    def test_batch_checks_other_group(self):
+        """
+        Test that batch checks use the variables of the given group
+        """
+        planning_scene, robot_state = get_planning_scene_with_box()
+        arm_positions = get_batch_positions()
+        finger_positions = np.full((len(arm_positions), 2), 0.02)
+        positions = np.hstack([arm_positions, finger_positions])
+        colliding = planning_scene.are_states_colliding(
+            joint_model_group_name="panda_arm_hand", positions=positions
+        )
+
+        self.assertEqual(colliding.shape, (len(positions),))
+        for state_positions, state_colliding in zip(positions, colliding):
+            robot_state.set_joint_group_positions("panda_arm_hand", state_positions)
+            robot_state.update()
+            self.assertEqual(
+                state_colliding,
+                planning_scene.is_state_colliding(robot_state, "panda_arm_hand"),
+            )
+
+    def test_batch_checks_mismatched_group(self):
+        """
+        Test that batch checks reject positions that do not match the group
+        """
+        planning_scene, _ = get_planning_scene_with_box()
+        arm_positions = get_batch_positions()
+
+        with self.assertRaises(ValueError):
+            planning_scene.are_states_colliding("hand", arm_positions)
+        with self.assertRaises(ValueError):
+            planning_scene.are_states_valid("hand", arm_positions)
+        with self.assertRaises(ValueError):
+            planning_scene.are_states_colliding("panda_arm", arm_positions[:, :6])
+        with self.assertRaises(ValueError):
+            planning_scene.are_states_valid("not_a_group", arm_positions)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -148,6 +148,70 @@ class TestRobotState(unittest.TestCase):
             robot_state.get_joint_group_accelerations("panda_arm").tolist(),
         )
 
+    def test_get_global_link_transforms(self):
+        """
+        Test that batch forward kinematics matches per-state forward kinematics
+        """
+        robot_model = get_robot_model()
+        robot_state = RobotState(robot_model)
+        robot_state.update()
+        positions = np.random.uniform(-1.0, 1.0, size=(20, 7))
+        transforms = robot_state.get_global_link_transforms(
+            joint_model_group_name="panda_arm",
+            link_name="panda_link8",
+            positions=positions,
+            num_threads=4,
+        )
+
+        self.assertEqual(transforms.shape, (20, 4, 4))
+        for state_positions, transform in zip(positions, transforms):
+            robot_state.set_joint_group_positions("panda_arm", state_positions)
+            robot_state.update()
+            np.testing.assert_allclose(
+                transform, robot_state.get_global_link_transform("panda_link8")
+            )
+
+    def test_get_jacobians(self):
+        """
+        Test that batch Jacobians match per-state Jacobians
+        """
+        robot_model = get_robot_model()
+        robot_state = RobotState(robot_model)
+        robot_state.update()
+        positions = np.random.uniform(-1.0, 1.0, size=(20, 7))
+        jacobians = robot_state.get_jacobians(
+            joint_model_group_name="panda_arm",
+            link_name="panda_link8",
+            positions=positions,
+            num_threads=4,
+        )
+
+        self.assertEqual(jacobians.shape, (20, 6, 7))
+        for state_positions, jacobian in zip(positions, jacobians):
+            robot_state.set_joint_group_positions("panda_arm", state_positions)
+            robot_state.update()
+            np.testing.assert_allclose(
+                jacobian,
+                robot_state.get_jacobian(
+                    joint_model_group_name="panda_arm",
+                    link_name="panda_link8",
+                    reference_point_position=np.array([0.0, 0.0, 0.0]),
+                ),
+            )
+
+    def test_batch_positions_shape(self):
+        """
+        Test that batch queries reject positions with the wrong number of columns
+        """
+        robot_model = get_robot_model()
+        robot_state = RobotState(robot_model)
+        with self.assertRaises(ValueError):
+            robot_state.get_global_link_transforms(
+                joint_model_group_name="panda_arm",
+                link_name="panda_link8",
+                positions=np.zeros((5, 6)),
+            )
+
     # TODO (peterdavidfagan): requires kinematics solver to be loaded
     # def test_set_from_ik(self):
     #    """
@@ -0,0 +1,118 @@
+import unittest
+import numpy as np
+
+from test_moveit.core.robot_model import RobotModel
+from test_moveit.core.robot_state import RobotState
+from test_moveit.core.robot_trajectory import RobotTrajectory
+
+import os
+
+dir_path = os.path.dirname(os.path.realpath(__file__))
+URDF_FILE = "{}/fixtures/panda.urdf".format(dir_path)
+SRDF_FILE = "{}/fixtures/panda.srdf".format(dir_path)
+
+
+def get_robot_model():
+    """Helper function that returns a RobotModel instance."""
+    return RobotModel(urdf_xml_path=URDF_FILE, srdf_xml_path=SRDF_FILE)
+
+
+def get_trajectory_arrays(count):
+    """Helper function that returns random panda_arm trajectory arrays."""
+    positions = np.random.uniform(-1.0, 1.0, size=(count, 7))
+    velocities = np.random.uniform(-0.5, 0.5, size=(count, 7))
+    time_from_start = np.linspace(0.0, 0.1 * (count - 1), count)
+    return positions, velocities, time_from_start
+
+
+class TestRobotTrajectory(unittest.TestCase):
+    def test_set_from_arrays(self):
+        """
+        Test that a trajectory built from arrays matches the arrays waypoint by waypoint
+        """
+        robot_model = get_robot_model()
+        reference_state = RobotState(robot_model)
+        reference_state.set_to_default_values()
+        positions, velocities, time_from_start = get_trajectory_arrays(50)
+
+        trajectory = RobotTrajectory(robot_model)
+        trajectory.set_from_arrays(
+            reference_state,
+            "panda_arm",
+            positions,
+            time_from_start,
+            velocities=velocities,
+            num_threads=4,
+        )
+
+        self.assertEqual(len(trajectory), 50)
+        self.assertEqual(trajectory.joint_model_group_name, "panda_arm")
+        self.assertAlmostEqual(trajectory.duration, time_from_start[-1])
+        for i, waypoint in enumerate(trajectory):
+            np.testing.assert_allclose(
+                waypoint.get_joint_group_positions("panda_arm"), positions[i]
+            )
+            np.testing.assert_allclose(
+                waypoint.get_joint_group_velocities("panda_arm"), velocities[i]
+            )
+
+    def test_get_arrays(self):
+        """
+        Test that array exports round-trip the arrays a trajectory was built from
+        """
+        robot_model = get_robot_model()
+        reference_state = RobotState(robot_model)
+        reference_state.set_to_default_values()
+        positions, velocities, time_from_start = get_trajectory_arrays(50)
+
+        trajectory = RobotTrajectory(robot_model)
+        trajectory.set_from_arrays(
+            reference_state, "panda_arm", positions, time_from_start, velocities
+        )
+
+        np.testing.assert_allclose(trajectory.get_positions(), positions)
+        np.testing.assert_allclose(trajectory.get_velocities(), velocities)
+        np.testing.assert_allclose(trajectory.get_accelerations(), np.zeros((50, 7)))
+        np.testing.assert_allclose(trajectory.get_time_from_start(), time_from_start)
+        np.testing.assert_allclose(
+            np.diff(trajectory.get_time_from_start()),
+            trajectory.get_waypoint_durations()[1:],
+        )
+        np.testing.assert_allclose(
+            trajectory.get_positions("panda_arm_hand")[:, :7], positions
+        )
+
+    def test_set_from_arrays_shape(self):
+        """
+        Test that mismatched array shapes and decreasing times are rejected
+        """
+        robot_model = get_robot_model()
+        reference_state = RobotState(robot_model)
+        reference_state.set_to_default_values()
+        positions, velocities, time_from_start = get_trajectory_arrays(10)
+        trajectory = RobotTrajectory(robot_model)
+
+        with self.assertRaises(ValueError):
+            trajectory.set_from_arrays(
+                reference_state, "panda_arm", positions[:, :6], time_from_start
+            )
+        with self.assertRaises(ValueError):
+            trajectory.set_from_arrays(
+                reference_state, "panda_arm", positions, time_from_start[:-1]
+            )
+        with self.assertRaises(ValueError):
+            trajectory.set_from_arrays(
+                reference_state, "panda_arm", positions, time_from_start[::-1]
+            )
+        with self.assertRaises(ValueError):
+            trajectory.set_from_arrays(
+                reference_state,
+                "panda_arm",
+                positions,
+                time_from_start,
+                velocities=velocities[:-1],
+            )
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -52,12 +52,22 @@ static const std::string SET_PLANNER_PARAMS_SERVICE_NAME =
 static const std::string MOVE_ACTION = "move_action";     // name of 'move' action
 static const std::string IK_SERVICE_NAME = "compute_ik";  // name of ik service
 static const std::string FK_SERVICE_NAME = "compute_fk";  // name of fk service
+static const std::string IK_BATCH_SERVICE_NAME =
+    "compute_ik_batch";  // name of the ik service that solves many requests in one call
+static const std::string FK_BATCH_SERVICE_NAME =
+    "compute_fk_batch";  // name of the fk service that computes poses for many states in one call
 static const std::string STATE_VALIDITY_SERVICE_NAME =
     "check_state_validity";  // name of the service that validates states
+static const std::string STATE_VALIDITY_BATCH_SERVICE_NAME =
+    "check_state_validity_batch";  // name of the service that validates many states in one request
+static const std::string TRAJECTORY_VALIDITY_SERVICE_NAME =
+    "check_trajectory_validity";  // name of the service that validates all waypoints of a trajectory
 static const std::string CARTESIAN_PATH_SERVICE_NAME =
     "compute_cartesian_path";  // name of the service that computes cartesian paths
 static const std::string GET_PLANNING_SCENE_SERVICE_NAME =
     "get_planning_scene";  // name of the service that can be used to query the planning scene
+static const std::string GET_PLANNING_SCENE_DELTA_SERVICE_NAME =
+    "get_planning_scene_delta";  // name of the service that returns the planning scene as diffs to previous replies
 static const std::string APPLY_PLANNING_SCENE_SERVICE_NAME =
     "apply_planning_scene";  // name of the service that applies a given planning scene
 static const std::string CLEAR_OCTOMAP_SERVICE_NAME =
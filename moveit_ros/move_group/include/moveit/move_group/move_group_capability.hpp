@@ -41,6 +41,9 @@
 #include <moveit/planning_interface/planning_interface.hpp>
 #include <moveit/plan_execution/plan_representation.hpp>
 #include <moveit/move_group/move_group_context.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
 
 namespace move_group
 {
@@ -57,7 +60,8 @@ MOVEIT_CLASS_FORWARD(MoveGroupCapability);  // Defines MoveGroupCapabilityPtr, C
 class MoveGroupCapability
 {
 public:
-  explicit MoveGroupCapability(const std::string& capability_name) : capability_name_(capability_name)
+  explicit MoveGroupCapability(const std::string& capability_name)
+    : capability_name_(capability_name), max_concurrent_requests_(0), active_requests_(0), use_scene_snapshot_(false)
   {
   }
 
@@ -75,6 +79,35 @@ public:
   }
 
 protected:
+  /** \brief Holds one of the capability_options.<name>.max_concurrent_requests request slots of the capability while
+      it exists, waiting for a slot to become free on construction. A limit of 0 means no limit. */
+  class RequestSlot
+  {
+  public:
+    explicit RequestSlot(MoveGroupCapability& capability);
+    ~RequestSlot();
+
+    RequestSlot(const RequestSlot&) = delete;
+    RequestSlot& operator=(const RequestSlot&) = delete;
+
+  private:
+    MoveGroupCapability& capability_;
+  };
+
+  /** \brief Get the callback group to serve the services and actions of this capability with.
+
+      Configured by capability_options.<name>.callback_group: "default" uses the default callback group of the node,
+      which serializes the capability with every other capability on that group (nullptr is returned), while
+      "mutually_exclusive" and "reentrant" create a group of the respective type for this capability only. */
+  rclcpp::CallbackGroup::SharedPtr getCallbackGroup(const std::string& default_type = "default");
+
+  /** \brief Get the planning scene to serve a request from.
+
+      If capability_options.<name>.use_scene_snapshot is set, this is a snapshot of the monitored scene that is shared
+      between requests and holds no lock. Otherwise the monitored scene is read-locked for as long as the returned
+      pointer is held. */
+  planning_scene::PlanningSceneConstPtr getPlanningSceneForRequest() const;
+
   std::string getActionResultString(const moveit_msgs::msg::MoveItErrorCodes& error_code, bool planned_trajectory_empty,
                                     bool plan_only);
   std::string stateToStr(MoveGroupState state) const;
@@ -98,5 +131,13 @@ protected:
 
   std::string capability_name_;
   MoveGroupContextPtr context_;
+
+private:
+  std::optional<rclcpp::CallbackGroup::SharedPtr> capability_callback_group_;
+  std::size_t max_concurrent_requests_;
+  std::size_t active_requests_;
+  std::mutex request_mutex_;
+  std::condition_variable request_condition_;
+  bool use_scene_snapshot_;
 };
 }  // namespace move_group
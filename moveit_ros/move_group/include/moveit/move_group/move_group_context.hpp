@@ -37,6 +37,7 @@
 #pragma once
 
 #include <rclcpp/rclcpp.hpp>
+#include <memory>
 #include <string>
 #include <moveit/macros/class_forward.hpp>
 
@@ -45,9 +46,15 @@ namespace moveit_cpp
 MOVEIT_CLASS_FORWARD(MoveItCpp);
 }
 
+namespace planning_scene
+{
+MOVEIT_CLASS_FORWARD(PlanningScene);  // Defines PlanningScenePtr, ConstPtr, WeakPtr... etc
+}
+
 namespace planning_scene_monitor
 {
 MOVEIT_CLASS_FORWARD(PlanningSceneMonitor);  // Defines PlanningSceneMonitorPtr, ConstPtr, WeakPtr... etc
+class PlanningSceneSnapshotProvider;
 }
 
 namespace planning_pipeline
@@ -77,6 +84,11 @@ struct MoveGroupContext
 
   bool status() const;
 
+  /** \brief Get a snapshot of the monitored planning scene. The snapshot is shared by all callers until the monitored
+      scene changes, and the monitored scene is only locked while a new snapshot is taken. Updates of the robot state
+      alone do not copy the world again (see planning_scene_monitor::PlanningSceneSnapshotProvider). */
+  planning_scene::PlanningSceneConstPtr getPlanningSceneSnapshot();
+
   moveit_cpp::MoveItCppPtr moveit_cpp_;
   planning_scene_monitor::PlanningSceneMonitorPtr planning_scene_monitor_;
   trajectory_execution_manager::TrajectoryExecutionManagerPtr trajectory_execution_manager_;
@@ -84,5 +96,8 @@ struct MoveGroupContext
   plan_execution::PlanExecutionPtr plan_execution_;
   bool allow_trajectory_execution_;
   bool debug_;
+
+private:
+  std::unique_ptr<planning_scene_monitor::PlanningSceneSnapshotProvider> snapshot_provider_;
 };
 }  // namespace move_group
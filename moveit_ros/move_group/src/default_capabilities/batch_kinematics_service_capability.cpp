@@ -0,0 +1,298 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include "batch_kinematics_service_capability.hpp"
+#include <moveit/moveit_cpp/moveit_cpp.hpp>
+#include <moveit/robot_state/conversions.hpp>
+#include <moveit/utils/message_checks.hpp>
+#include <moveit/utils/parallel_for.hpp>
+#include <tf2_eigen/tf2_eigen.hpp>
+#include <moveit/move_group/capability_names.hpp>
+#include <moveit/utils/logger.hpp>
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+namespace move_group
+{
+namespace
+{
+rclcpp::Logger getLogger()
+{
+  return moveit::getLogger("moveit.ros.move_group.batch_kinematics_service");
+}
+
+bool isIKSolutionValid(const planning_scene::PlanningScene* planning_scene,
+                       const kinematic_constraints::KinematicConstraintSet* constraint_set,
+                       moveit::core::RobotState* state, const moveit::core::JointModelGroup* jmg,
+                       const double* ik_solution)
+{
+  state->setJointGroupPositions(jmg, ik_solution);
+  state->update();
+  return (!planning_scene || !planning_scene->isStateColliding(*state, jmg->getName())) &&
+         (!constraint_set || constraint_set->decide(*state).satisfied);
+}
+
+// An IK request with its poses transformed to the model frame and its constraints resolved against the scene
+struct PreparedIKRequest
+{
+  const moveit::core::JointModelGroup* jmg = nullptr;
+  EigenSTL::vector_Isometry3d poses;
+  std::vector<std::string> tips;  // empty if the single pose is for the default tip of the solver
+  std::unique_ptr<kinematic_constraints::KinematicConstraintSet> constraints;
+};
+}  // namespace
+
+MoveGroupBatchKinematicsService::MoveGroupBatchKinematicsService()
+  : MoveGroupCapability("batch_kinematics_service"), threads_(1), fk_threads_(0)
+{
+}
+
+void MoveGroupBatchKinematicsService::initialize()
+{
+  const rclcpp::Node::SharedPtr& node = context_->moveit_cpp_->getNode();
+
+  // the IK solver of a joint model group is shared by all threads, so IK is parallel only if asked for
+  int threads = 1;
+  node->get_parameter_or("batch_kinematics.threads", threads, 1);
+  threads_ = static_cast<std::size_t>(std::max(0, threads));
+  int fk_threads = 0;
+  node->get_parameter_or("batch_kinematics.fk_threads", fk_threads, 0);
+  fk_threads_ = static_cast<std::size_t>(std::max(0, fk_threads));
+  RCLCPP_INFO(getLogger(), "Solving batched IK requests with up to %zu threads, FK requests with up to %zu threads",
+              moveit::parallelThreadCount(std::numeric_limits<std::size_t>::max(), threads_),
+              moveit::parallelThreadCount(std::numeric_limits<std::size_t>::max(), fk_threads_));
+  if (threads_ != 1)
+  {
+    RCLCPP_WARN(getLogger(), "batch_kinematics.threads is not 1, the IK solvers must be thread-safe");
+  }
+
+  ik_service_ = node->create_service<moveit_ros_move_group_msgs::srv::GetPositionIKBatch>(
+      IK_BATCH_SERVICE_NAME,
+      [this](const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionIKBatch::Request>& req,
+             const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionIKBatch::Response>& res) {
+        computeIK(req, res);
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
+  fk_service_ = node->create_service<moveit_ros_move_group_msgs::srv::GetPositionFKBatch>(
+      FK_BATCH_SERVICE_NAME,
+      [this](const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Request>& req,
+             const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Response>& res) {
+        computeFK(req, res);
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
+}
+
+void MoveGroupBatchKinematicsService::computeIK(
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionIKBatch::Request>& req,
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionIKBatch::Response>& res)
+{
+  const RequestSlot slot(*this);
+  context_->planning_scene_monitor_->updateFrameTransforms();
+  // one snapshot for the whole request; the monitored scene is not locked while the requests are solved
+  const planning_scene::PlanningSceneConstPtr scene = context_->getPlanningSceneSnapshot();
+  const moveit::core::RobotModelConstPtr& robot_model = scene->getRobotModel();
+  const std::string& default_frame = robot_model->getModelFrame();
+
+  const std::size_t count = req->ik_requests.size();
+  res->solutions.resize(count);
+  res->error_codes.resize(count);
+
+  // transform the requested poses sequentially, so requests that cannot be solved are answered right away
+  std::vector<PreparedIKRequest> prepared(count);
+  std::vector<std::size_t> solvable;
+  solvable.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const moveit_msgs::msg::PositionIKRequest& ik_request = req->ik_requests[i];
+    PreparedIKRequest& query = prepared[i];
+    moveit_msgs::msg::MoveItErrorCodes& error_code = res->error_codes[i];
+
+    query.jmg = robot_model->getJointModelGroup(ik_request.group_name);
+    if (!query.jmg)
+    {
+      error_code.val = moveit_msgs::msg::MoveItErrorCodes::INVALID_GROUP_NAME;
+      continue;
+    }
+    if (ik_request.pose_stamped_vector.size() > 1 &&
+        ik_request.pose_stamped_vector.size() != ik_request.ik_link_names.size())
+    {
+      error_code.val = moveit_msgs::msg::MoveItErrorCodes::INVALID_LINK_NAME;
+      continue;
+    }
+
+    std::vector<geometry_msgs::msg::PoseStamped> poses = ik_request.pose_stamped_vector;
+    if (poses.empty())
+    {
+      poses.push_back(ik_request.pose_stamped);
+      if (!ik_request.ik_link_name.empty())
+        query.tips.push_back(ik_request.ik_link_name);
+    }
+    else if (!ik_request.ik_link_names.empty())
+    {
+      query.tips.assign(ik_request.ik_link_names.begin(), ik_request.ik_link_names.begin() + poses.size());
+    }
+
+    bool transformed = true;
+    query.poses.resize(poses.size());
+    for (std::size_t k = 0; transformed && k < poses.size(); ++k)
+    {
+      transformed = performTransform(poses[k], default_frame);
+      if (transformed)
+        tf2::fromMsg(poses[k].pose, query.poses[k]);
+    }
+    if (!transformed)
+    {
+      error_code.val = moveit_msgs::msg::MoveItErrorCodes::FRAME_TRANSFORM_FAILURE;
+      continue;
+    }
+
+    if (!moveit::core::isEmpty(ik_request.constraints))
+    {
+      query.constraints = std::make_unique<kinematic_constraints::KinematicConstraintSet>(robot_model);
+      query.constraints->add(ik_request.constraints, scene->getTransforms());
+      if (query.constraints->empty())
+        query.constraints.reset();
+    }
+    solvable.push_back(i);
+  }
+
+  std::vector<std::optional<moveit::core::RobotState>> states(moveit::parallelThreadCount(solvable.size(), threads_));
+  moveit::parallelFor(solvable.size(), threads_, [&](std::size_t s, std::size_t worker) {
+    const std::size_t i = solvable[s];
+    const moveit_msgs::msg::PositionIKRequest& ik_request = req->ik_requests[i];
+    const PreparedIKRequest& query = prepared[i];
+
+    if (!states[worker])
+      states[worker].emplace(scene->getCurrentState());
+    moveit::core::RobotState& state = *states[worker];
+    state = scene->getCurrentState();
+    if (!moveit::core::isEmpty(ik_request.robot_state))
+      moveit::core::robotStateMsgToRobotState(ik_request.robot_state, state);
+
+    moveit::core::GroupStateValidityCallbackFn constraint;
+    if (ik_request.avoid_collisions || query.constraints)
+    {
+      constraint = [scene_ptr = ik_request.avoid_collisions ? scene.get() : nullptr,
+                    kset_ptr = query.constraints.get()](moveit::core::RobotState* robot_state,
+                                                        const moveit::core::JointModelGroup* joint_group,
+                                                        const double* joint_group_variable_values) {
+        return isIKSolutionValid(scene_ptr, kset_ptr, robot_state, joint_group, joint_group_variable_values);
+      };
+    }
+
+    const double timeout = rclcpp::Duration(ik_request.timeout).seconds();
+    const bool result_ik = query.tips.empty() ?
+                               state.setFromIK(query.jmg, query.poses[0], timeout, constraint) :
+                               state.setFromIK(query.jmg, query.poses, query.tips, timeout, constraint);
+    if (result_ik)
+    {
+      moveit::core::robotStateToRobotStateMsg(state, res->solutions[i], false);
+      res->error_codes[i].val = moveit_msgs::msg::MoveItErrorCodes::SUCCESS;
+    }
+    else
+      res->error_codes[i].val = moveit_msgs::msg::MoveItErrorCodes::NO_IK_SOLUTION;
+  });
+}
+
+void MoveGroupBatchKinematicsService::computeFK(
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Request>& req,
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Response>& res)
+{
+  const RequestSlot slot(*this);
+  if (req->fk_link_names.empty())
+  {
+    RCLCPP_ERROR(getLogger(), "No links specified for FK request");
+    res->error_code.val = moveit_msgs::msg::MoveItErrorCodes::INVALID_LINK_NAME;
+    return;
+  }
+
+  context_->planning_scene_monitor_->updateFrameTransforms();
+  const planning_scene::PlanningSceneConstPtr scene = context_->getPlanningSceneSnapshot();
+  const moveit::core::RobotState& current_state = scene->getCurrentState();
+  const std::string& default_frame = scene->getRobotModel()->getModelFrame();
+  for (const std::string& link_name : req->fk_link_names)
+  {
+    if (!current_state.knowsFrameTransform(link_name))
+    {
+      RCLCPP_ERROR(getLogger(), "Unknown link '%s' in FK request", link_name.c_str());
+      res->error_code.val = moveit_msgs::msg::MoveItErrorCodes::INVALID_LINK_NAME;
+      return;
+    }
+  }
+
+  const std::size_t link_count = req->fk_link_names.size();
+  const rclcpp::Time stamp = context_->moveit_cpp_->getNode()->get_clock()->now();
+  res->pose_stamped.resize(req->robot_states.size() * link_count);
+
+  std::vector<std::optional<moveit::core::RobotState>> states(
+      moveit::parallelThreadCount(req->robot_states.size(), fk_threads_));
+  moveit::parallelFor(req->robot_states.size(), fk_threads_, [&](std::size_t i, std::size_t worker) {
+    if (!states[worker])
+      states[worker].emplace(current_state);
+    moveit::core::RobotState& state = *states[worker];
+    state = current_state;
+    moveit::core::robotStateMsgToRobotState(req->robot_states[i], state);
+    for (std::size_t k = 0; k < link_count; ++k)
+    {
+      geometry_msgs::msg::PoseStamped& pose = res->pose_stamped[i * link_count + k];
+      pose.pose = tf2::toMsg(state.getFrameTransform(req->fk_link_names[k]));
+      pose.header.frame_id = default_frame;
+      pose.header.stamp = stamp;
+    }
+  });
+
+  // TF lookups are done on this thread, after all states are solved
+  const bool do_transform = !req->header.frame_id.empty() &&
+                            !moveit::core::Transforms::sameFrame(req->header.frame_id, default_frame) &&
+                            context_->planning_scene_monitor_->getTFClient() != nullptr;
+  if (do_transform)
+  {
+    for (geometry_msgs::msg::PoseStamped& pose : res->pose_stamped)
+    {
+      if (!performTransform(pose, req->header.frame_id))
+      {
+        res->pose_stamped.clear();
+        res->error_code.val = moveit_msgs::msg::MoveItErrorCodes::FRAME_TRANSFORM_FAILURE;
+        return;
+      }
+    }
+  }
+  res->error_code.val = moveit_msgs::msg::MoveItErrorCodes::SUCCESS;
+}
+}  // namespace move_group
+
+#include <pluginlib/class_list_macros.hpp>
+
+PLUGINLIB_EXPORT_CLASS(move_group::MoveGroupBatchKinematicsService, move_group::MoveGroupCapability)
@@ -0,0 +1,69 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/move_group/move_group_capability.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_position_ik_batch.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_position_fk_batch.hpp>
+
+namespace move_group
+{
+/** \brief Solve many IK requests, or FK for many states, in one call.
+
+    All items of a request are solved against one snapshot of the planning scene. IK requests use
+    batch_kinematics.threads threads, 1 by default. A RobotState per thread does not isolate the IK solver: all threads
+    call the one solver instance of the joint model group, and solvers such as KDL keep mutable state. Only set more
+    threads (0 for one per core) with a thread-safe solver. FK uses no solver and runs on batch_kinematics.fk_threads
+    threads, 0 (one per core) by default. */
+class MoveGroupBatchKinematicsService : public MoveGroupCapability
+{
+public:
+  MoveGroupBatchKinematicsService();
+
+  void initialize() override;
+
+private:
+  void computeIK(const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionIKBatch::Request>& req,
+                 const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionIKBatch::Response>& res);
+  void computeFK(const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Request>& req,
+                 const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Response>& res);
+
+  rclcpp::Service<moveit_ros_move_group_msgs::srv::GetPositionIKBatch>::SharedPtr ik_service_;
+  rclcpp::Service<moveit_ros_move_group_msgs::srv::GetPositionFKBatch>::SharedPtr fk_service_;
+
+  std::size_t threads_;
+  std::size_t fk_threads_;
+};
+}  // namespace move_group
@@ -0,0 +1,193 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include "batch_state_validation_service_capability.hpp"
+#include <moveit/moveit_cpp/moveit_cpp.hpp>
+#include <moveit/planning_scene/state_validity_batch.hpp>
+#include <moveit/robot_state/conversions.hpp>
+#include <moveit/robot_trajectory/robot_trajectory.hpp>
+#include <moveit/utils/message_checks.hpp>
+#include <moveit/utils/parallel_for.hpp>
+#include <moveit/collision_detection/collision_tools.hpp>
+#include <moveit/move_group/capability_names.hpp>
+#include <moveit/utils/logger.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace move_group
+{
+namespace
+{
+rclcpp::Logger getLogger()
+{
+  return moveit::getLogger("moveit.ros.move_group.batch_state_validation_service");
+}
+
+std::unique_ptr<kinematic_constraints::KinematicConstraintSet> makeConstraintSet(
+    const planning_scene::PlanningScene& scene, const moveit_msgs::msg::Constraints& constraints)
+{
+  if (moveit::core::isEmpty(constraints))
+    return nullptr;
+  auto kset = std::make_unique<kinematic_constraints::KinematicConstraintSet>(scene.getRobotModel());
+  kset->add(constraints, scene.getTransforms());
+  return kset;
+}
+
+planning_scene::StateValidityOptions makeOptions(const std::string& group_name, bool compute_contacts,
+                                                 bool compute_clearance, std::size_t threads)
+{
+  planning_scene::StateValidityOptions options;
+  options.group = group_name;
+  options.compute_contacts = compute_contacts;
+  options.compute_clearance = compute_clearance;
+  options.threads = threads;
+  return options;
+}
+
+void resultToMsg(const planning_scene::PlanningScene& scene, const rclcpp::Time& stamp,
+                 const planning_scene::StateValidityResult& result, moveit_ros_move_group_msgs::msg::StateValidity& msg)
+{
+  // same notion of validity as the state validation service: collision-free and satisfying the constraints
+  msg.valid = !result.collision.collision && result.constraints.satisfied;
+  for (const auto& [bodies, contacts] : result.collision.contacts)
+  {
+    for (const collision_detection::Contact& contact : contacts)
+    {
+      msg.contacts.resize(msg.contacts.size() + 1);
+      collision_detection::contactToMsg(contact, msg.contacts.back());
+      msg.contacts.back().header.frame_id = scene.getPlanningFrame();
+      msg.contacts.back().header.stamp = stamp;
+    }
+  }
+  msg.cost_sources.resize(result.collision.cost_sources.size());
+  std::size_t k = 0;
+  for (const collision_detection::CostSource& cost_source : result.collision.cost_sources)
+    collision_detection::costSourceToMsg(cost_source, msg.cost_sources[k++]);
+  msg.constraint_result.resize(result.constraint_results.size());
+  for (k = 0; k < result.constraint_results.size(); ++k)
+  {
+    msg.constraint_result[k].result = result.constraint_results[k].satisfied;
+    msg.constraint_result[k].distance = result.constraint_results[k].distance;
+  }
+  msg.clearance = result.clearance.value_or(std::numeric_limits<double>::quiet_NaN());
+}
+}  // namespace
+
+MoveGroupBatchStateValidationService::MoveGroupBatchStateValidationService()
+  : MoveGroupCapability("batch_state_validation_service"), threads_(0)
+{
+}
+
+void MoveGroupBatchStateValidationService::initialize()
+{
+  const rclcpp::Node::SharedPtr& node = context_->moveit_cpp_->getNode();
+
+  int threads = 0;
+  node->get_parameter_or("batch_state_validation.threads", threads, 0);
+  threads_ = static_cast<std::size_t>(std::max(0, threads));
+  RCLCPP_INFO(getLogger(), "Checking batched states with up to %zu threads",
+              moveit::parallelThreadCount(std::numeric_limits<std::size_t>::max(), threads_));
+
+  states_service_ = node->create_service<moveit_ros_move_group_msgs::srv::GetStateValidityBatch>(
+      STATE_VALIDITY_BATCH_SERVICE_NAME,
+      [this](const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetStateValidityBatch::Request>& req,
+             const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetStateValidityBatch::Response>& res) {
+        checkStates(req, res);
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
+  trajectory_service_ = node->create_service<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity>(
+      TRAJECTORY_VALIDITY_SERVICE_NAME,
+      [this](const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity::Request>& req,
+             const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity::Response>& res) {
+        checkTrajectory(req, res);
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
+}
+
+void MoveGroupBatchStateValidationService::checkStates(
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetStateValidityBatch::Request>& req,
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetStateValidityBatch::Response>& res)
+{
+  const RequestSlot slot(*this);
+  // one snapshot for the whole request; the monitored scene is not locked while the states are checked
+  const planning_scene::PlanningSceneConstPtr scene = context_->getPlanningSceneSnapshot();
+  const rclcpp::Time stamp = context_->moveit_cpp_->getNode()->get_clock()->now();
+
+  std::vector<moveit::core::RobotState> states(req->robot_states.size(), scene->getCurrentState());
+  for (std::size_t i = 0; i < states.size(); ++i)
+    moveit::core::robotStateMsgToRobotState(req->robot_states[i], states[i]);
+
+  const std::unique_ptr<kinematic_constraints::KinematicConstraintSet> kset =
+      makeConstraintSet(*scene, req->constraints);
+  const std::vector<planning_scene::StateValidityResult> results = planning_scene::checkStatesValidity(
+      *scene, states, kset.get(),
+      makeOptions(req->group_name, req->compute_contacts, req->compute_clearance, threads_));
+
+  res->results.resize(results.size());
+  for (std::size_t i = 0; i < results.size(); ++i)
+    resultToMsg(*scene, stamp, results[i], res->results[i]);
+}
+
+void MoveGroupBatchStateValidationService::checkTrajectory(
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity::Request>& req,
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity::Response>& res)
+{
+  const RequestSlot slot(*this);
+  const planning_scene::PlanningSceneConstPtr scene = context_->getPlanningSceneSnapshot();
+  const rclcpp::Time stamp = context_->moveit_cpp_->getNode()->get_clock()->now();
+
+  robot_trajectory::RobotTrajectory trajectory(scene->getRobotModel(), req->group_name);
+  trajectory.setRobotTrajectoryMsg(scene->getCurrentState(), req->start_state, req->trajectory);
+
+  const std::unique_ptr<kinematic_constraints::KinematicConstraintSet> kset =
+      makeConstraintSet(*scene, req->constraints);
+  const std::vector<planning_scene::StateValidityResult> results = planning_scene::checkTrajectoryValidity(
+      *scene, trajectory, kset.get(),
+      makeOptions(req->group_name, req->compute_contacts, req->compute_clearance, threads_));
+
+  res->first_invalid_index = -1;
+  res->results.resize(results.size());
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    resultToMsg(*scene, stamp, results[i], res->results[i]);
+    if (!res->results[i].valid && res->first_invalid_index < 0)
+      res->first_invalid_index = static_cast<int32_t>(i);
+  }
+  res->valid = res->first_invalid_index < 0;
+}
+}  // namespace move_group
+
+#include <pluginlib/class_list_macros.hpp>
+
+PLUGINLIB_EXPORT_CLASS(move_group::MoveGroupBatchStateValidationService, move_group::MoveGroupCapability)
@@ -0,0 +1,66 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/move_group/move_group_capability.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_state_validity_batch.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_trajectory_validity.hpp>
+
+namespace move_group
+{
+/** \brief Check many states, or all waypoints of a trajectory, in one request.
+
+    All states of a request are checked in parallel against one snapshot of the planning scene, so they all see the
+    same world. The number of threads is set by batch_state_validation.threads (0 for one per core). On request, the
+    result of a collision-free state carries its clearance, the distance between the robot and the nearest obstacle. */
+class MoveGroupBatchStateValidationService : public MoveGroupCapability
+{
+public:
+  MoveGroupBatchStateValidationService();
+
+  void initialize() override;
+
+private:
+  void checkStates(const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetStateValidityBatch::Request>& req,
+                   const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetStateValidityBatch::Response>& res);
+  void checkTrajectory(const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity::Request>& req,
+                       const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity::Response>& res);
+
+  rclcpp::Service<moveit_ros_move_group_msgs::srv::GetStateValidityBatch>::SharedPtr states_service_;
+  rclcpp::Service<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity>::SharedPtr trajectory_service_;
+
+  std::size_t threads_;
+};
+}  // namespace move_group
@@ -75,12 +75,21 @@ rclcpp::Logger getLogger()
 namespace move_group
 {
 MoveGroupCartesianPathService::MoveGroupCartesianPathService()
-  : MoveGroupCapability("CartesianPathService"), display_computed_paths_(true)
+  : MoveGroupCapability("CartesianPathService"), display_computed_paths_(true), adaptive_cartesian_path_(false)
 {
 }
 
 void MoveGroupCartesianPathService::initialize()
 {
+  const rclcpp::Node::SharedPtr& node = context_->moveit_cpp_->getNode();
+  node->get_parameter_or("cartesian_path.adaptive", adaptive_cartesian_path_, false);
+  int coarse_stride, threads;
+  node->get_parameter_or("cartesian_path.coarse_stride", coarse_stride,
+                         static_cast<int>(cartesian_refinement_.coarse_stride));
+  node->get_parameter_or("cartesian_path.threads", threads, static_cast<int>(cartesian_refinement_.threads));
+  cartesian_refinement_.coarse_stride = std::max(coarse_stride, 1);
+  cartesian_refinement_.threads = std::max(threads, 0);
+
   display_path_ =
       context_->moveit_cpp_->getNode()->create_publisher<moveit_msgs::msg::DisplayTrajectory>(DISPLAY_PATH_TOPIC, 10);
 
@@ -183,9 +192,19 @@ bool MoveGroupCartesianPathService::computeService(
             jump_threshold = moveit::core::JumpThreshold::relative(req->jump_threshold);
           }
           std::vector<moveit::core::RobotStatePtr> traj;
-          res->fraction = moveit::core::CartesianInterpolator::computeCartesianPath(
-              &start_state, jmg, traj, start_state.getLinkModel(link_name), waypoints, global_frame,
-              moveit::core::MaxEEFStep(req->max_step), moveit::core::CartesianPrecision{}, constraint_fn);
+          if (adaptive_cartesian_path_)
+          {
+            res->fraction = moveit::core::CartesianInterpolator::computeCartesianPathAdaptive(
+                &start_state, jmg, traj, start_state.getLinkModel(link_name), waypoints, global_frame,
+                moveit::core::MaxEEFStep(req->max_step), moveit::core::CartesianPrecision{}, cartesian_refinement_,
+                constraint_fn);
+          }
+          else
+          {
+            res->fraction = moveit::core::CartesianInterpolator::computeCartesianPath(
+                &start_state, jmg, traj, start_state.getLinkModel(link_name), waypoints, global_frame,
+                moveit::core::MaxEEFStep(req->max_step), moveit::core::CartesianPrecision{}, constraint_fn);
+          }
           moveit::core::robotStateToRobotStateMsg(start_state, res->start_state);
 
           robot_trajectory::RobotTrajectory rt(context_->planning_scene_monitor_->getRobotModel(), req->group_name);
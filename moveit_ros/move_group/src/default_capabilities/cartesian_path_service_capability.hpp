@@ -37,6 +37,7 @@
 #pragma once
 
 #include <moveit/move_group/move_group_capability.hpp>
+#include <moveit/robot_state/cartesian_interpolator.hpp>
 #include <moveit_msgs/srv/get_cartesian_path.hpp>
 #include <moveit_msgs/msg/display_trajectory.hpp>
 
@@ -58,5 +59,10 @@ private:
   rclcpp::Publisher<moveit_msgs::msg::DisplayTrajectory>::SharedPtr display_path_;
 
   bool display_computed_paths_;
+
+  // use CartesianInterpolator::computeCartesianPathAdaptive() with these settings, configured by the
+  // cartesian_path.adaptive, cartesian_path.coarse_stride and cartesian_path.threads parameters
+  bool adaptive_cartesian_path_;
+  moveit::core::CartesianRefinement cartesian_refinement_;
 };
 }  // namespace move_group
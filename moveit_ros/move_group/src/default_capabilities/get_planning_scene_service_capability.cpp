@@ -35,19 +35,102 @@
 /* Author: Ioan Sucan */
 
 #include "get_planning_scene_service_capability.hpp"
+#include <moveit/moveit_cpp/moveit_cpp.hpp>
 #include <moveit/move_group/capability_names.hpp>
+#include <climits>
 
 namespace move_group
 {
+namespace
+{
+// the encoders of clients that stopped polling are dropped, oldest first, once this many are kept
+constexpr std::size_t MAX_DELTA_ENCODERS = 64;
+}  // namespace
+
 MoveGroupGetPlanningSceneService::MoveGroupGetPlanningSceneService() : MoveGroupCapability("get_planning_scene_service")
 {
 }
 
 void MoveGroupGetPlanningSceneService::initialize()
 {
-  context_->planning_scene_monitor_->providePlanningSceneService(GET_PLANNING_SCENE_SERVICE_NAME);
+  // served here instead of by PlanningSceneMonitor::providePlanningSceneService(), which holds the scene write lock
+  // while building the response and shares the monitor's executor thread with its scene updates
+  get_scene_service_ = context_->moveit_cpp_->getNode()->create_service<moveit_msgs::srv::GetPlanningScene>(
+      GET_PLANNING_SCENE_SERVICE_NAME,
+      [this](const std::shared_ptr<moveit_msgs::srv::GetPlanningScene::Request>& req,
+             const std::shared_ptr<moveit_msgs::srv::GetPlanningScene::Response>& res) {
+        getPlanningSceneService(req, res);
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
+  get_scene_delta_service_ =
+      context_->moveit_cpp_->getNode()->create_service<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta>(
+          GET_PLANNING_SCENE_DELTA_SERVICE_NAME,
+          [this](const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta::Request>& req,
+                 const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta::Response>& res) {
+            getPlanningSceneDeltaService(req, res);
+          },
+          rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
+}
+
+void MoveGroupGetPlanningSceneService::getPlanningSceneService(
+    const std::shared_ptr<moveit_msgs::srv::GetPlanningScene::Request>& req,
+    const std::shared_ptr<moveit_msgs::srv::GetPlanningScene::Response>& res)
+{
+  const RequestSlot slot(*this);
+  if (req->components.components & moveit_msgs::msg::PlanningSceneComponents::TRANSFORMS)
+    context_->planning_scene_monitor_->updateFrameTransforms();
+
+  moveit_msgs::msg::PlanningSceneComponents all_components;
+  all_components.components = UINT_MAX;  // Return all scene components if nothing is specified.
+
+  getPlanningSceneForRequest()->getPlanningSceneMsg(res->scene,
+                                                    req->components.components ? req->components : all_components);
 }
 
+void MoveGroupGetPlanningSceneService::getPlanningSceneDeltaService(
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta::Request>& req,
+    const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta::Response>& res)
+{
+  const RequestSlot slot(*this);
+  if (req->components.components & moveit_msgs::msg::PlanningSceneComponents::TRANSFORMS)
+    context_->planning_scene_monitor_->updateFrameTransforms();
+
+  // the scene is taken before the encoder lock, so slow scene access does not hold up other clients
+  const planning_scene::PlanningSceneConstPtr scene = getPlanningSceneForRequest();
+
+  std::lock_guard<std::mutex> lock(delta_encoders_mutex_);
+  // continue from the client's last applied reply if it is known; a new encoder sends the complete scene
+  planning_scene::PlanningSceneDeltaEncoder encoder;
+  const auto known = req->base_version == 0 ? delta_encoders_.end() : delta_encoders_.find(req->base_version);
+  if (known != delta_encoders_.end())
+  {
+    encoder = std::move(known->second);
+    delta_encoders_.erase(known);
+  }
+
+  moveit_msgs::msg::PlanningSceneComponents comp = req->components;
+  if (comp.components == 0)
+    comp.components = UINT_MAX;  // Return all scene components if nothing is specified.
+  planning_scene::PlanningSceneDeltaEncoder::MeshTable mesh_table;
+  encoder.getPlanningSceneMsg(*scene, comp, res->scene, mesh_table);
+  for (auto& [hash, mesh] : mesh_table.meshes)
+  {
+    res->mesh_hashes.push_back(hash);
+    res->meshes.push_back(std::move(mesh));
+  }
+  for (const auto& [id, mesh_hashes] : mesh_table.object_meshes)
+  {
+    moveit_ros_move_group_msgs::msg::CollisionObjectMeshes& object_meshes = res->object_meshes.emplace_back();
+    object_meshes.id = id;
+    object_meshes.mesh_hashes.assign(mesh_hashes.begin(), mesh_hashes.end());
+  }
+
+  // versions grow with every reply, so the encoder that was used least recently has the smallest key
+  res->version = ++last_delta_version_;
+  if (delta_encoders_.size() >= MAX_DELTA_ENCODERS)
+    delta_encoders_.erase(delta_encoders_.begin());
+  delta_encoders_.emplace(res->version, std::move(encoder));
+}
 }  // namespace move_group
 
 #include <pluginlib/class_list_macros.hpp>
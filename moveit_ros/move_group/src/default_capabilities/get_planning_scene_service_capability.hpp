@@ -37,7 +37,11 @@
 #pragma once
 
 #include <moveit/move_group/move_group_capability.hpp>
+#include <moveit/planning_scene/planning_scene_delta_encoder.hpp>
 #include <moveit_msgs/srv/get_planning_scene.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_planning_scene_delta.hpp>
+#include <map>
+#include <mutex>
 
 namespace move_group
 {
@@ -47,5 +51,22 @@ public:
   MoveGroupGetPlanningSceneService();
 
   void initialize() override;
+
+private:
+  void getPlanningSceneService(const std::shared_ptr<moveit_msgs::srv::GetPlanningScene::Request>& req,
+                               const std::shared_ptr<moveit_msgs::srv::GetPlanningScene::Response>& res);
+
+  void getPlanningSceneDeltaService(
+      const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta::Request>& req,
+      const std::shared_ptr<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta::Response>& res);
+
+  rclcpp::Service<moveit_msgs::srv::GetPlanningScene>::SharedPtr get_scene_service_;
+  rclcpp::Service<moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta>::SharedPtr get_scene_delta_service_;
+
+  // the encoders of the delta service, keyed by the version of the reply they encoded last. Versions are unique, so
+  // a client that did not apply the last reply it was sent finds no encoder and gets the complete scene.
+  std::mutex delta_encoders_mutex_;
+  std::map<uint64_t, planning_scene::PlanningSceneDeltaEncoder> delta_encoders_;
+  uint64_t last_delta_version_ = 0;
 };
 }  // namespace move_group
@@ -52,17 +52,21 @@ MoveGroupKinematicsService::MoveGroupKinematicsService() : MoveGroupCapability("
 void MoveGroupKinematicsService::initialize()
 {
   fk_service_ = context_->moveit_cpp_->getNode()->create_service<moveit_msgs::srv::GetPositionFK>(
-      FK_SERVICE_NAME, [this](const std::shared_ptr<rmw_request_id_t>& req_header,
-                              const std::shared_ptr<moveit_msgs::srv::GetPositionFK::Request>& req,
-                              const std::shared_ptr<moveit_msgs::srv::GetPositionFK::Response>& res) {
+      FK_SERVICE_NAME,
+      [this](const std::shared_ptr<rmw_request_id_t>& req_header,
+             const std::shared_ptr<moveit_msgs::srv::GetPositionFK::Request>& req,
+             const std::shared_ptr<moveit_msgs::srv::GetPositionFK::Response>& res) {
         return computeFKService(req_header, req, res);
-      });
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
   ik_service_ = context_->moveit_cpp_->getNode()->create_service<moveit_msgs::srv::GetPositionIK>(
-      IK_SERVICE_NAME, [this](const std::shared_ptr<rmw_request_id_t>& req_header,
-                              const std::shared_ptr<moveit_msgs::srv::GetPositionIK::Request>& req,
-                              const std::shared_ptr<moveit_msgs::srv::GetPositionIK::Response>& res) {
+      IK_SERVICE_NAME,
+      [this](const std::shared_ptr<rmw_request_id_t>& req_header,
+             const std::shared_ptr<moveit_msgs::srv::GetPositionIK::Request>& req,
+             const std::shared_ptr<moveit_msgs::srv::GetPositionIK::Response>& res) {
         return computeIKService(req_header, req, res);
-      });
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
 }
 
 namespace
@@ -169,19 +173,18 @@ bool MoveGroupKinematicsService::computeIKService(const std::shared_ptr<rmw_requ
                                                   const std::shared_ptr<moveit_msgs::srv::GetPositionIK::Request>& req,
                                                   const std::shared_ptr<moveit_msgs::srv::GetPositionIK::Response>& res)
 {
+  const RequestSlot slot(*this);
   context_->planning_scene_monitor_->updateFrameTransforms();
 
-  // check if the planning scene needs to be kept locked; if so, call computeIK() in the scope of the lock
+  // check if the planning scene needs to be kept; if so, call computeIK() while holding it
   if (req->ik_request.avoid_collisions || !moveit::core::isEmpty(req->ik_request.constraints))
   {
-    planning_scene_monitor::LockedPlanningSceneRO ls(context_->planning_scene_monitor_);
+    const planning_scene::PlanningSceneConstPtr ls = getPlanningSceneForRequest();
     kinematic_constraints::KinematicConstraintSet kset(ls->getRobotModel());
     moveit::core::RobotState rs = ls->getCurrentState();
     kset.add(req->ik_request.constraints, ls->getTransforms());
     computeIK(req->ik_request, res->solution, res->error_code, rs,
-              [scene = req->ik_request.avoid_collisions ?
-                           static_cast<const planning_scene::PlanningSceneConstPtr&>(ls).get() :
-                           nullptr,
+              [scene = req->ik_request.avoid_collisions ? ls.get() : nullptr,
                kset_ptr = kset.empty() ? nullptr : &kset](moveit::core::RobotState* robot_state,
                                                           const moveit::core::JointModelGroup* joint_group,
                                                           const double* joint_group_variable_values) {
@@ -191,8 +194,7 @@ bool MoveGroupKinematicsService::computeIKService(const std::shared_ptr<rmw_requ
   else
   {
     // compute unconstrained IK, no lock to planning scene maintained
-    moveit::core::RobotState rs =
-        planning_scene_monitor::LockedPlanningSceneRO(context_->planning_scene_monitor_)->getCurrentState();
+    moveit::core::RobotState rs = getPlanningSceneForRequest()->getCurrentState();
     computeIK(req->ik_request, res->solution, res->error_code, rs);
   }
 
@@ -210,6 +212,7 @@ bool MoveGroupKinematicsService::computeFKService(const std::shared_ptr<rmw_requ
     return true;
   }
 
+  const RequestSlot slot(*this);
   context_->planning_scene_monitor_->updateFrameTransforms();
 
   const std::string& default_frame = context_->planning_scene_monitor_->getRobotModel()->getModelFrame();
@@ -218,8 +221,7 @@ bool MoveGroupKinematicsService::computeFKService(const std::shared_ptr<rmw_requ
                       context_->planning_scene_monitor_->getTFClient();
   bool tf_problem = false;
 
-  moveit::core::RobotState rs =
-      planning_scene_monitor::LockedPlanningSceneRO(context_->planning_scene_monitor_)->getCurrentState();
+  moveit::core::RobotState rs = getPlanningSceneForRequest()->getCurrentState();
   moveit::core::robotStateMsgToRobotState(req->robot_state, rs);
   for (std::size_t i = 0; i < req->fk_link_names.size(); ++i)
   {
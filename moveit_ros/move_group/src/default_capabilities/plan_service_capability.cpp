@@ -59,11 +59,13 @@ MoveGroupPlanService::MoveGroupPlanService() : MoveGroupCapability("motion_plan_
 void MoveGroupPlanService::initialize()
 {
   plan_service_ = context_->moveit_cpp_->getNode()->create_service<moveit_msgs::srv::GetMotionPlan>(
-      PLANNER_SERVICE_NAME, [this](const std::shared_ptr<rmw_request_id_t>& request_header,
-                                   const std::shared_ptr<moveit_msgs::srv::GetMotionPlan::Request>& req,
-                                   const std::shared_ptr<moveit_msgs::srv::GetMotionPlan::Response>& res) {
+      PLANNER_SERVICE_NAME,
+      [this](const std::shared_ptr<rmw_request_id_t>& request_header,
+             const std::shared_ptr<moveit_msgs::srv::GetMotionPlan::Request>& req,
+             const std::shared_ptr<moveit_msgs::srv::GetMotionPlan::Response>& res) {
         return computePlanService(request_header, req, res);
-      });
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
 }
 
 bool MoveGroupPlanService::computePlanService(const std::shared_ptr<rmw_request_id_t>& /* unused */,
@@ -71,6 +73,7 @@ bool MoveGroupPlanService::computePlanService(const std::shared_ptr<rmw_request_
                                               const std::shared_ptr<moveit_msgs::srv::GetMotionPlan::Response>& res)
 {
   RCLCPP_INFO(getLogger(), "Received new planning service request...");
+  const RequestSlot slot(*this);
   // before we start planning, ensure that we have the latest robot state received...
   if (static_cast<bool>(req->motion_plan_request.start_state.is_diff))
     context_->planning_scene_monitor_->waitForCurrentRobotState(context_->moveit_cpp_->getNode()->get_clock()->now());
@@ -85,7 +88,7 @@ bool MoveGroupPlanService::computePlanService(const std::shared_ptr<rmw_request_
     return true;
   }
 
-  planning_scene_monitor::LockedPlanningSceneRO ps(context_->planning_scene_monitor_);
+  const planning_scene::PlanningSceneConstPtr ps = getPlanningSceneForRequest();
   try
   {
     planning_interface::MotionPlanResponse mp_res;
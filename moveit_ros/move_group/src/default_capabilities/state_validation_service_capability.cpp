@@ -50,11 +50,13 @@ MoveGroupStateValidationService::MoveGroupStateValidationService() : MoveGroupCa
 void MoveGroupStateValidationService::initialize()
 {
   validity_service_ = context_->moveit_cpp_->getNode()->create_service<moveit_msgs::srv::GetStateValidity>(
-      STATE_VALIDITY_SERVICE_NAME, [this](const std::shared_ptr<rmw_request_id_t>& request_header,
-                                          const std::shared_ptr<moveit_msgs::srv::GetStateValidity::Request>& req,
-                                          const std::shared_ptr<moveit_msgs::srv::GetStateValidity::Response>& res) {
+      STATE_VALIDITY_SERVICE_NAME,
+      [this](const std::shared_ptr<rmw_request_id_t>& request_header,
+             const std::shared_ptr<moveit_msgs::srv::GetStateValidity::Request>& req,
+             const std::shared_ptr<moveit_msgs::srv::GetStateValidity::Response>& res) {
         return computeService(request_header, req, res);
-      });
+      },
+      rclcpp::ServicesQoS(), getCallbackGroup("mutually_exclusive"));
 }
 
 bool MoveGroupStateValidationService::computeService(
@@ -62,7 +64,8 @@ bool MoveGroupStateValidationService::computeService(
     const std::shared_ptr<moveit_msgs::srv::GetStateValidity::Request>& req,
     const std::shared_ptr<moveit_msgs::srv::GetStateValidity::Response>& res)
 {
-  planning_scene_monitor::LockedPlanningSceneRO ls(context_->planning_scene_monitor_);
+  const RequestSlot slot(*this);
+  const planning_scene::PlanningSceneConstPtr ls = getPlanningSceneForRequest();
   moveit::core::RobotState rs = ls->getCurrentState();
   moveit::core::robotStateMsgToRobotState(req->robot_state, rs);
 
@@ -311,7 +311,12 @@ int main(int argc, char** argv)
       RCLCPP_INFO(nh->get_logger(), "MoveGroup debug mode is OFF");
     }
 
-    rclcpp::executors::MultiThreadedExecutor executor;
+    // capabilities configured with their own callback groups (see capability_options) are served concurrently by the
+    // executor threads; 0 uses one thread per core
+    int executor_threads = 0;
+    nh->get_parameter_or("executor_threads", executor_threads, 0);
+    rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(),
+                                                      static_cast<std::size_t>(std::max(0, executor_threads)));
 
     move_group::MoveGroupExe mge(moveit_cpp, default_planning_pipeline, debug);
 
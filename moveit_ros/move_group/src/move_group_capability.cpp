@@ -41,6 +41,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #include <moveit/utils/logger.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -57,6 +58,71 @@ rclcpp::Logger getLogger()
 void MoveGroupCapability::setContext(const MoveGroupContextPtr& context)
 {
   context_ = context;
+
+  const rclcpp::Node::SharedPtr& node = context_->moveit_cpp_->getNode();
+  const std::string prefix = "capability_options." + capability_name_ + ".";
+  int max_concurrent_requests = 0;
+  node->get_parameter_or(prefix + "max_concurrent_requests", max_concurrent_requests, 0);
+  max_concurrent_requests_ = static_cast<std::size_t>(std::max(0, max_concurrent_requests));
+  node->get_parameter_or(prefix + "use_scene_snapshot", use_scene_snapshot_, false);
+}
+
+MoveGroupCapability::RequestSlot::RequestSlot(MoveGroupCapability& capability) : capability_(capability)
+{
+  std::unique_lock<std::mutex> lock(capability_.request_mutex_);
+  capability_.request_condition_.wait(lock, [this] {
+    return capability_.max_concurrent_requests_ == 0 ||
+           capability_.active_requests_ < capability_.max_concurrent_requests_;
+  });
+  ++capability_.active_requests_;
+}
+
+MoveGroupCapability::RequestSlot::~RequestSlot()
+{
+  {
+    std::lock_guard<std::mutex> lock(capability_.request_mutex_);
+    --capability_.active_requests_;
+  }
+  capability_.request_condition_.notify_one();
+}
+
+rclcpp::CallbackGroup::SharedPtr MoveGroupCapability::getCallbackGroup(const std::string& default_type)
+{
+  if (capability_callback_group_)
+    return *capability_callback_group_;
+
+  const rclcpp::Node::SharedPtr& node = context_->moveit_cpp_->getNode();
+  std::string type;
+  node->get_parameter_or("capability_options." + capability_name_ + ".callback_group", type, default_type);
+  if (type == "mutually_exclusive")
+  {
+    capability_callback_group_ = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  }
+  else if (type == "reentrant")
+  {
+    capability_callback_group_ = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  }
+  else
+  {
+    if (type != "default")
+    {
+      RCLCPP_WARN(getLogger(), "Unknown callback group type '%s' for capability '%s', using the default group",
+                  type.c_str(), capability_name_.c_str());
+    }
+    capability_callback_group_ = rclcpp::CallbackGroup::SharedPtr();
+  }
+  return *capability_callback_group_;
+}
+
+planning_scene::PlanningSceneConstPtr MoveGroupCapability::getPlanningSceneForRequest() const
+{
+  if (use_scene_snapshot_)
+    return context_->getPlanningSceneSnapshot();
+
+  // keep the scene read-locked for as long as the returned pointer (which shares ownership of the lock) is alive
+  auto lock = std::make_shared<planning_scene_monitor::LockedPlanningSceneRO>(context_->planning_scene_monitor_);
+  const planning_scene::PlanningSceneConstPtr& scene = *lock;
+  return planning_scene::PlanningSceneConstPtr(lock, scene.get());
 }
 
 void MoveGroupCapability::convertToMsg(const std::vector<plan_execution::ExecutableTrajectory>& trajectory,
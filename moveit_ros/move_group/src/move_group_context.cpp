@@ -39,6 +39,8 @@
 #include <moveit/moveit_cpp/moveit_cpp.hpp>
 #include <moveit/planning_pipeline/planning_pipeline.hpp>
 #include <moveit/plan_execution/plan_execution.hpp>
+#include <moveit/planning_scene_monitor/planning_scene_monitor.hpp>
+#include <moveit/planning_scene_monitor/planning_scene_snapshot_provider.hpp>
 #include <moveit/utils/logger.hpp>
 
 namespace move_group
@@ -58,6 +60,7 @@ MoveGroupContext::MoveGroupContext(const moveit_cpp::MoveItCppPtr& moveit_cpp,
   , planning_scene_monitor_(moveit_cpp->getPlanningSceneMonitorNonConst())
   , allow_trajectory_execution_(allow_trajectory_execution)
   , debug_(debug)
+  , snapshot_provider_(std::make_unique<planning_scene_monitor::PlanningSceneSnapshotProvider>(planning_scene_monitor_))
 {
   // Check if default planning pipeline has been initialized successfully
   const auto& pipelines = moveit_cpp->getPlanningPipelines();
@@ -87,9 +90,15 @@ MoveGroupContext::~MoveGroupContext()
   plan_execution_.reset();
   trajectory_execution_manager_.reset();
   planning_pipeline_.reset();
+  snapshot_provider_.reset();
   planning_scene_monitor_.reset();
 }
 
+planning_scene::PlanningSceneConstPtr MoveGroupContext::getPlanningSceneSnapshot()
+{
+  return snapshot_provider_->getSnapshot();
+}
+
 bool MoveGroupContext::status() const
 {
   if (planning_pipeline_)
@@ -44,6 +44,10 @@
 #include <moveit/planning_scene_monitor/planning_scene_monitor.hpp>
 #include <moveit/planning_scene/planning_scene.hpp>
 #include <moveit_servo/moveit_servo_lib_parameters.hpp>
+#include <moveit_servo/utils/triple_buffer.hpp>
+#include <chrono>
+#include <mutex>
+#include <optional>
 
 namespace moveit_servo
 {
@@ -54,16 +58,72 @@ public:
   CollisionMonitor(const planning_scene_monitor::PlanningSceneMonitorPtr& planning_scene_monitor,
                    const servo::Params& servo_params, std::atomic<double>& collision_velocity_scale);
 
+  ~CollisionMonitor();
+
   void start();
 
   void stop();
 
+  /**
+   * \brief Hand the state servo currently commands to the collision monitor, without blocking.
+   * The monitor checks this state instead of the current state of the planning scene while it is recent, and predicts
+   * the upcoming states from the velocities. Only call this from one thread at a time.
+   * @param positions The positions of the active joints of the move group, in the order of its active joints.
+   * @param velocities The commanded velocities of the same joints.
+   * @param stamp The time the state is commanded at.
+   */
+  void setCommandedState(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
+                         std::chrono::steady_clock::time_point stamp);
+
+  /**
+   * \brief Run a single collision check on the calling thread and update the collision velocity scale.
+   * This is what the monitor thread does at collision_check_rate. Calling it directly, while the monitor thread is
+   * stopped, makes the checks happen in step with the commands, e.g. when replaying recorded commands.
+   * @param now The time of the check. The commanded state is checked if it is at most incoming_command_timeout older.
+   */
+  void checkOnce(std::chrono::steady_clock::time_point now);
+
 private:
+  struct CommandedState
+  {
+    Eigen::VectorXd positions;
+    Eigen::VectorXd velocities;
+    std::chrono::steady_clock::time_point stamp;
+  };
+
+  // The planning scene as checked by the monitor: a copy of the monitored scene and its latest robot state.
+  struct SceneSnapshot
+  {
+    planning_scene::PlanningSceneConstPtr scene;
+    moveit::core::RobotState state;
+  };
+
+  /**
+   * \brief Hand a snapshot of the monitored planning scene to the collision checks, called on update of the scene.
+   * This runs on the threads of the planning scene monitor, so the collision checks never wait for its lock. Updates
+   * of the robot state only copy the joint positions. Other updates copy the scene, at most once per collision check
+   * period: a change that follows a copy sooner is taken with the next update, e.g. of the robot state.
+   * @param update_type The type of the update of the monitored scene.
+   */
+  void publishSceneSnapshot(planning_scene_monitor::PlanningSceneMonitor::SceneUpdateType update_type);
+
   /**
    * \brief The collision checking function, this will run in a separate thread.
    */
   void checkCollisions();
 
+  /**
+   * \brief Check the states predicted along the commanded joint velocities for collision.
+   * At most collision_lookahead_steps states, evenly spaced over collision_lookahead_time, are checked.
+   * @param scene The planning scene to check the predicted states in.
+   * @param positions The commanded positions of the active joints of the move group to start the prediction from.
+   * @param velocities The commanded velocities of the same joints.
+   * @return The time until the last state before the first predicted collision, or std::nullopt if no collision is
+   * predicted.
+   */
+  std::optional<double> predictTimeToCollision(const planning_scene::PlanningScene& scene,
+                                               const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities);
+
   // Variables
 
   const servo::Params& servo_params_;
@@ -85,6 +145,26 @@ private:
   // The data structures used to get information about robot collision with other objects in the collision scene.
   collision_detection::CollisionRequest scene_collision_request_;
   collision_detection::CollisionResult scene_collision_result_;
+
+  // The states commanded by servo, handed over without locks.
+  TripleBuffer<CommandedState> commanded_states_;
+
+  // Written by publishSceneSnapshot() only. The mutex serializes the update callbacks of the planning scene monitor,
+  // which may run on several threads; the collision checks never take it.
+  std::mutex scene_snapshot_writer_mutex_;
+  planning_scene::PlanningSceneConstPtr scene_copy_;
+  bool scene_copy_outdated_;
+  std::chrono::steady_clock::time_point last_scene_copy_time_;
+  const std::chrono::duration<double> min_scene_copy_period_;
+  std::size_t scene_update_callback_id_;
+
+  // The snapshots of the planning scene, handed over without locks.
+  TripleBuffer<SceneSnapshot> scene_snapshots_;
+
+  // The data structures used to check the predicted states.
+  moveit::core::RobotState predicted_state_;
+  collision_detection::CollisionRequest lookahead_collision_request_;
+  collision_detection::CollisionResult lookahead_collision_result_;
 };
 
 }  // namespace moveit_servo
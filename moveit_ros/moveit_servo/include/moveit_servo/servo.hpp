@@ -52,6 +52,7 @@
 #include <sensor_msgs/msg/joint_state.hpp>
 #include <tf2_eigen/tf2_eigen.hpp>
 #include <tf2_ros/transform_listener.h>
+#include <chrono>
 #include <variant>
 #include <rclcpp/logger.hpp>
 #include <queue>
@@ -77,9 +78,24 @@ public:
    * \brief Computes the joint state required to follow the given command.
    * @param robot_state RobotStatePtr instance used for calculating the next joint state.
    * @param command The command to follow, std::variant type, can handle JointJog, Twist and Pose.
+   * @param stamp The time of the command. The collision checks use the commanded state while it is recent.
    * @return The required joint state.
    */
-  KinematicState getNextJointState(const moveit::core::RobotStatePtr& robot_state, const ServoInput& command);
+  KinematicState getNextJointState(const moveit::core::RobotStatePtr& robot_state, const ServoInput& command,
+                                   std::chrono::steady_clock::time_point stamp = std::chrono::steady_clock::now());
+
+  /**
+   * \brief Computes the joint state required to follow commands for several subgroups of the move group at once,
+   * e.g. for both arms of a bimanual robot. The joint deltas of all subgroups are combined, and velocity limits,
+   * collision scaling, joint bounds and smoothing are applied once for the whole move group.
+   * @param robot_state RobotStatePtr instance used for calculating the next joint state.
+   * @param commands The command for each subgroup. The subgroups must not share joints, and all commands must be of
+   * the expected command type.
+   * @param stamp The time of the commands. The collision checks use the commanded state while it is recent.
+   * @return The required joint state.
+   */
+  KinematicState getNextJointState(const moveit::core::RobotStatePtr& robot_state, const MultiGroupInput& commands,
+                                   std::chrono::steady_clock::time_point stamp = std::chrono::steady_clock::now());
 
   /**
    * \brief Set the type of incoming servo command.
@@ -111,8 +127,27 @@ public:
    */
   void setCollisionChecking(const bool check_collision);
 
+  /**
+   * \brief Run a single collision check on the calling thread, updating the velocity scaling for collisions.
+   * Use this instead of the collision checking thread (stop it with setCollisionChecking(false)) where the checks must
+   * be in step with the commands, e.g. to replay recorded commands deterministically.
+   * @param stamp The time of the check, which the age of the commanded state is measured against. Replays pass the
+   * same recording time as to getNextJointState(), so that the result does not depend on the wall clock.
+   */
+  void checkCollisionsOnce(std::chrono::steady_clock::time_point stamp = std::chrono::steady_clock::now());
+
+  /**
+   * \brief Hand the given state to the collision checks as if it was commanded, and run a single check on it.
+   * @param state The state to check, with the velocities to predict the upcoming states from.
+   * @param stamp The time the state is commanded and checked at.
+   */
+  void checkCollisionsOnce(const KinematicState& state,
+                           std::chrono::steady_clock::time_point stamp = std::chrono::steady_clock::now());
+
   /**
    * \brief Returns the most recent servo parameters.
+   * Changes made through the returned reference apply to the next cycle. Calling this also makes the next multi-group
+   * command rebuild the parameters of its subgroups, so avoid it in a loop that servos several subgroups.
    * @return The servo parameters.
    */
   servo::Params& getParams();
@@ -139,6 +174,12 @@ public:
    */
   void doSmoothing(KinematicState& state);
 
+  /**
+   * \brief Get the times at which the last call to doSmoothing started and finished.
+   * @return The start and end time of the last smoothing.
+   */
+  std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point> getLastSmoothingTimes() const;
+
   /**
    * \brief Resets the smoothing plugin, if set, to a specified state.
    * @param state The desired state to reset the smoothing plugin to.
@@ -182,9 +223,23 @@ private:
    * \brief Compute the change in joint position required to follow the received command.
    * @param command The incoming servo command.
    * @param robot_state RobotStatePtr instance used for calculating the command.
+   * @param params The servo parameters to use, their active_subgroup selects the subgroup that follows the command.
    * @return The joint position change required (delta).
    */
-  Eigen::VectorXd jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state);
+  Eigen::VectorXd jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state,
+                                        const servo::Params& params);
+
+  /**
+   * \brief Compute the next joint state from the change in joint position required by the commands.
+   * Applies velocity limits, collision scaling, joint bounds and smoothing.
+   * @param robot_state RobotStatePtr instance used for calculating the next joint state.
+   * @param joint_position_delta The joint position change required by the commands.
+   * @param stamp The time of the commands.
+   * @return The required joint state.
+   */
+  KinematicState nextJointStateFromDelta(const moveit::core::RobotStatePtr& robot_state,
+                                         const Eigen::VectorXd& joint_position_delta,
+                                         std::chrono::steady_clock::time_point stamp);
 
   /**
    * \brief Validate the servo parameters
@@ -235,8 +290,18 @@ private:
   // Map between joint subgroup names and corresponding joint name - move group indices map
   std::unordered_map<std::string, JointNameToMoveGroupIndexMap> joint_name_to_index_maps_;
 
+  // The parameters of each subgroup of the last multi-group command, with their active_subgroup set. They are only
+  // rebuilt when the parameters or the commanded subgroups change, so that servoing does not copy them every cycle.
+  std::vector<servo::Params> subgroup_params_;
+  // Set when the parameters may have been changed through getParams()
+  bool subgroup_params_stale_ = true;
+
   // The current joint limit safety margins for each active joint position variable.
   std::vector<double> joint_limit_margins_;
+
+  // The times at which the last smoothing started and finished, for latency tracing.
+  std::chrono::steady_clock::time_point last_smoothing_start_;
+  std::chrono::steady_clock::time_point last_smoothing_end_;
 };
 
 }  // namespace moveit_servo
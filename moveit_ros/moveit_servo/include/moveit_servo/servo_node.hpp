@@ -42,14 +42,17 @@
 #pragma once
 
 #include <control_msgs/msg/joint_jog.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
 #include <moveit_msgs/srv/servo_command_type.hpp>
 #include <moveit_msgs/msg/servo_status.hpp>
 #include <moveit_servo/servo.hpp>
+#include <moveit_servo/utils/latency_tracer.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <std_msgs/msg/float64_multi_array.hpp>
 #include <std_srvs/srv/set_bool.hpp>
+#include <std_srvs/srv/trigger.hpp>
 #include <trajectory_msgs/msg/joint_trajectory.hpp>
 #include <std_msgs/msg/float64_multi_array.hpp>
 
@@ -95,6 +98,17 @@ private:
   void switchCommandType(const std::shared_ptr<moveit_msgs::srv::ServoCommandType::Request>& request,
                          const std::shared_ptr<moveit_msgs::srv::ServoCommandType::Response>& response);
 
+  /**
+   * \brief Publish the latency statistics of the cycles recorded by the latency tracer.
+   */
+  void publishLatencyDiagnostics();
+
+  /**
+   * \brief The service to write the cycles recorded by the latency tracer to the latency_trace_file.
+   */
+  void dumpLatencyTrace(const std::shared_ptr<std_srvs::srv::Trigger::Request>& request,
+                        const std::shared_ptr<std_srvs::srv::Trigger::Response>& response);
+
   void jointJogCallback(const control_msgs::msg::JointJog::ConstSharedPtr& msg);
   void twistCallback(const geometry_msgs::msg::TwistStamped::ConstSharedPtr& msg);
   void poseCallback(const geometry_msgs::msg::PoseStamped::ConstSharedPtr& msg);
@@ -121,6 +135,9 @@ private:
   rclcpp::Publisher<std_msgs::msg::Float64MultiArray>::SharedPtr multi_array_publisher_;
   rclcpp::Publisher<trajectory_msgs::msg::JointTrajectory>::SharedPtr trajectory_publisher_;
   rclcpp::Publisher<moveit_msgs::msg::ServoStatus>::SharedPtr status_publisher_;
+  // Outgoing messages, reused every cycle so that publishing does not allocate
+  trajectory_msgs::msg::JointTrajectory trajectory_msg_;
+  std_msgs::msg::Float64MultiArray multi_array_msg_;
 
   rclcpp::Service<moveit_msgs::srv::ServoCommandType>::SharedPtr switch_command_type_;
   rclcpp::Service<std_srvs::srv::SetBool>::SharedPtr pause_servo_;
@@ -138,6 +155,15 @@ private:
 
   // rolling window of joint commands
   std::deque<KinematicState> joint_cmd_rolling_window_;
+
+  // Latency tracing, only created if latency_trace_size is greater than 0
+  std::unique_ptr<LatencyTracer> latency_tracer_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr latency_diagnostics_publisher_;
+  rclcpp::TimerBase::SharedPtr latency_diagnostics_timer_;
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr dump_latency_trace_;
+  // The time at which the latest command arrived, and the arrival time of the last command that was traced
+  std::atomic<std::chrono::steady_clock::time_point> latest_command_received_;
+  std::chrono::steady_clock::time_point last_traced_command_received_;
 };
 
 }  // namespace moveit_servo
@@ -0,0 +1,157 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : servo_replay.hpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : Replays recorded command and joint state streams through Servo as fast as possible, and collects
+ *                    the cycle times, the smoothness of the output and the collision scaling, so that changes to the
+ *                    servoing logic and the smoothing plugins can be compared in repeatable runs.
+ */
+
+#pragma once
+
+#include <moveit_servo/servo.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace moveit_servo
+{
+
+// A command, stamped with the time in seconds since the start of the recording.
+struct RecordedCommand
+{
+  double time;
+  ServoInput command;
+};
+
+// The state of the joints of the move group, stamped with the time in seconds since the start of the recording.
+struct RecordedJointState
+{
+  double time;
+  Eigen::VectorXd positions;
+  Eigen::VectorXd velocities;
+};
+
+// The streams of a recording, each ordered by time.
+struct ServoRecording
+{
+  CommandType command_type = CommandType::TWIST;
+  std::vector<RecordedCommand> commands;
+  // If there are no joint states, the robot is assumed to follow the commanded states exactly.
+  std::vector<RecordedJointState> joint_states;
+};
+
+struct ReplayResult
+{
+  // The commanded state and the status of servo for each cycle.
+  std::vector<KinematicState> commanded_states;
+  std::vector<StatusCode> statuses;
+
+  // Cycles in which there was no command yet, or the last command was older than incoming_command_timeout.
+  std::size_t stale_cycles = 0;
+  // Cycles in which servo slowed down or stopped for a collision.
+  std::size_t collision_deceleration_cycles = 0;
+  std::size_t collision_halt_cycles = 0;
+  std::size_t invalid_cycles = 0;
+
+  // The wall time spent computing the commanded state in the cycles that had a command, in seconds.
+  double mean_cycle_time = 0.0;
+  double p99_cycle_time = 0.0;
+  double max_cycle_time = 0.0;
+
+  // The largest absolute acceleration and jerk of any joint, and the RMS jerk over all joints, from finite
+  // differences of the commanded positions.
+  double max_acceleration = 0.0;
+  double max_jerk = 0.0;
+  double rms_jerk = 0.0;
+};
+
+/**
+ * \brief Drives Servo from recorded streams instead of topics, one cycle per publish_period of recording time, without
+ * waiting between the cycles. The collision checks run on the replaying thread once per cycle, so that the commanded
+ * states and statuses are the same in every replay of a recording.
+ */
+class ServoReplay
+{
+public:
+  /**
+   * \brief Creates the Servo instance to replay with. Like Servo itself, this requires the state monitor of
+   * planning_scene_monitor to have a complete state of the move group.
+   */
+  ServoReplay(const rclcpp::Node::SharedPtr& node, std::shared_ptr<const servo::ParamListener> servo_param_listener,
+              const planning_scene_monitor::PlanningSceneMonitorPtr& planning_scene_monitor);
+
+  /**
+   * \brief Replay a recording, from its first until its last sample.
+   * Without recorded joint states, each cycle starts from the state commanded in the previous cycle. Otherwise it
+   * starts from the latest recorded joint state, or the current state of the planning scene before the first one.
+   * @param recording The recording to replay.
+   * @return The commanded states and the metrics of the replay.
+   */
+  ReplayResult replay(const ServoRecording& recording);
+
+  /**
+   * \brief Get the Servo instance commands are replayed through, e.g. to change its parameters between replays.
+   */
+  Servo& getServo();
+
+private:
+  planning_scene_monitor::PlanningSceneMonitorPtr planning_scene_monitor_;
+  Servo servo_;
+};
+
+/**
+ * \brief Load a recording from a CSV file. The first line is "command_type,<value of CommandType>". Each following
+ * line is one of
+ *   command,<time>,<frame_id>,<6 twist values or pose x,y,z,qx,qy,qz,qw>
+ *   command,<time>,,<joint name>,<velocity>,...
+ *   joint_state,<time>,<positions of the move group joints>,<velocities of the same joints>
+ * @param file_path The file to load.
+ * @return The recording, or std::nullopt if the file could not be read or parsed.
+ */
+std::optional<ServoRecording> loadRecording(const std::string& file_path);
+
+/**
+ * \brief Save a recording to a CSV file, in the format read by loadRecording().
+ * @param recording The recording to save.
+ * @param file_path The file to write.
+ * @return True if the file was written.
+ */
+bool saveRecording(const ServoRecording& recording, const std::string& file_path);
+
+}  // namespace moveit_servo
@@ -90,6 +90,26 @@ JointDeltaResult jointDeltaFromPose(const PoseCommand& command, const moveit::co
                                     const std::string& ee_frame,
                                     const JointNameToMoveGroupIndexMap& joint_name_group_index_map);
 
+/**
+ * \brief Computes the change in joint angles toward the IK solution for the given pose that is closest to the current
+ * state. All solutions are requested from the kinematics plugin at once, which is cheap for analytic (e.g. IKFast)
+ * solvers. Like the result of jointDeltaFromIK(), the change is not scaled yet: jointDeltaFromPose() applies the
+ * singularity scaling and Servo the joint velocity limit scaling, so a distant solution is approached gradually.
+ * @param target_pose The next pose of the end effector frame, in the planning frame.
+ * @param robot_state_ The current robot state as obtained from PlanningSceneMonitor.
+ * @param servo_params The servo parameters.
+ * @param planning_frame The planning frame name.
+ * @param ee_frame The end effector frame name.
+ * @param joint_name_group_index_map Mapping between joint subgroup name and move group joint vector position.
+ * @return The status and joint position change required (delta). The status is INVALID if the group has no IK
+ * solver or no solution was found.
+ */
+JointDeltaResult jointDeltaFromAnalyticIK(const Eigen::Isometry3d& target_pose,
+                                          const moveit::core::RobotStatePtr& robot_state,
+                                          const servo::Params& servo_params, const std::string& planning_frame,
+                                          const std::string& ee_frame,
+                                          const JointNameToMoveGroupIndexMap& joint_name_group_index_map);
+
 /**
  * \brief Computes the required change in joint angles for given Cartesian change, using the robot's IK solver.
  * @param cartesian_position_delta The change in Cartesian position.
@@ -46,6 +46,7 @@
 #include <moveit/planning_scene_monitor/planning_scene_monitor.hpp>
 #include <moveit/robot_model/joint_model_group.hpp>
 #include <moveit/robot_state/robot_state.hpp>
+#include <rclcpp/publisher.hpp>
 #include <sensor_msgs/msg/joint_state.hpp>
 #include <std_msgs/msg/float64_multi_array.hpp>
 #include <tf2_eigen/tf2_eigen.hpp>
@@ -122,6 +123,18 @@ geometry_msgs::msg::Pose poseFromCartesianDelta(const Eigen::VectorXd& delta_x,
 std::optional<trajectory_msgs::msg::JointTrajectory>
 composeTrajectoryMessage(const servo::Params& servo_params, const std::deque<KinematicState>& joint_cmd_rolling_window);
 
+/**
+ * \brief Fill a trajectory message from a rolling window queue of joint state commands, reusing the memory of the
+ * given message. Once the message has been filled for a window of the same size, this does not allocate.
+ * @param servo_params The configuration used by servo, required for setting some field of the trajectory message.
+ * @param joint_cmd_rolling_window A rolling window queue of joint state commands.
+ * @param joint_trajectory The trajectory message to fill.
+ * @return True if the message was filled, false if the window has too few points for a trajectory.
+ */
+bool composeTrajectoryMessage(const servo::Params& servo_params,
+                              const std::deque<KinematicState>& joint_cmd_rolling_window,
+                              trajectory_msgs::msg::JointTrajectory& joint_trajectory);
+
 /**
  * \brief Adds a new joint state command to a queue containing commands over a time window. Also modifies the velocities
  * of the commands to help avoid overshooting.
@@ -143,11 +156,42 @@ void updateSlidingWindow(KinematicState& next_joint_state, std::deque<KinematicS
 std_msgs::msg::Float64MultiArray composeMultiArrayMessage(const servo::Params& servo_params,
                                                           const KinematicState& joint_state);
 
+/**
+ * \brief Fill a Float64MultiArray message from given joint state, reusing the memory of the given message.
+ * @param servo_params The configuration used by servo, required for selecting position vs velocity.
+ * @param joint_state The joint state to be added into the Float64MultiArray.
+ * @param multi_array The Float64MultiArray message to fill.
+ */
+void composeMultiArrayMessage(const servo::Params& servo_params, const KinematicState& joint_state,
+                              std_msgs::msg::Float64MultiArray& multi_array);
+
+/**
+ * \brief Publish a message through a message loaned from the middleware if it supports loans, else directly.
+ * @param publisher The publisher to publish with.
+ * @param message The message to publish.
+ */
+template <typename MessageT>
+void publishMessage(const typename rclcpp::Publisher<MessageT>::SharedPtr& publisher, const MessageT& message)
+{
+  if (publisher->can_loan_messages())
+  {
+    auto loaned_message = publisher->borrow_loaned_message();
+    loaned_message.get() = message;
+    publisher->publish(std::move(loaned_message));
+  }
+  else
+  {
+    publisher->publish(message);
+  }
+}
+
 /**
  * \brief Computes scaling factor for velocity when the robot is near a singularity.
+ * The Jacobian is that of the active subgroup if one is set, since the Cartesian delta is for its tip, and otherwise
+ * that of the move group. The robot state is restored after probing the Jacobian.
  * @param robot_state A pointer to the current robot state.
- * @param target_delta_x The vector containing the required change in Cartesian position.
- * @param servo_params The servo parameters, contains the singularity thresholds.
+ * @param target_delta_x The vector containing the required change in Cartesian position of the (sub)group tip.
+ * @param servo_params The servo parameters, contains the singularity thresholds and the groups.
  * @return The velocity scaling factor and the reason for scaling.
  */
 std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::core::RobotStatePtr& robot_state,
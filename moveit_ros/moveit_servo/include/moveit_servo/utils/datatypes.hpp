@@ -110,6 +110,9 @@ struct PoseCommand
 // The generic input type for servo that can be JointJog, Twist or Pose.
 typedef std::variant<JointJogCommand, TwistCommand, PoseCommand> ServoInput;
 
+// Commands for several subgroups of the move group, each given with the name of its subgroup.
+typedef std::vector<std::pair<std::string, ServoInput>> MultiGroupInput;
+
 // The output datatype of servo, this structure contains the names of the joints along with their positions, velocities and accelerations.
 struct KinematicState
 {
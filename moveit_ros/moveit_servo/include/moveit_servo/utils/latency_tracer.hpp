@@ -0,0 +1,156 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : latency_tracer.hpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : Records the time at which each stage of a servo cycle was reached, for latency statistics.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace moveit_servo
+{
+
+// The stages of a servo cycle, in the order in which a command passes them.
+enum class LatencyStage : std::size_t
+{
+  COMMAND_RECEIVED = 0,
+  CYCLE_START,
+  STATE_UPDATED,
+  SMOOTHING_START,
+  SMOOTHING_END,
+  PUBLISHED,
+  COUNT
+};
+
+constexpr std::size_t LATENCY_STAGE_COUNT = static_cast<std::size_t>(LatencyStage::COUNT);
+
+// The names of the stages, as used in the statistics and in dumped traces.
+const std::array<std::string, LATENCY_STAGE_COUNT> LATENCY_STAGE_NAMES = { "command_received", "cycle_start",
+                                                                          "state_updated",    "smoothing_start",
+                                                                          "smoothing_end",    "published" };
+
+// The steady clock time in nanoseconds at which each stage was reached during one cycle, 0 if it was not reached.
+struct CycleTrace
+{
+  std::array<int64_t, LATENCY_STAGE_COUNT> stamps{};
+
+  void mark(LatencyStage stage, std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now())
+  {
+    stamps[static_cast<std::size_t>(stage)] =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+  }
+
+  int64_t stamp(LatencyStage stage) const
+  {
+    return stamps[static_cast<std::size_t>(stage)];
+  }
+};
+
+// Latency statistics between two stages, in seconds.
+struct LatencyStatistics
+{
+  LatencyStage from;
+  LatencyStage to;
+  std::size_t samples = 0;
+  double p50 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+/**
+ * \brief Keeps the traces of the most recent servo cycles in a ring buffer.
+ *
+ * A single writer, the servo loop, records traces without locks or allocations. Any number of readers can take
+ * snapshots concurrently; traces that the writer overwrites while a snapshot is taken are left out of the snapshot.
+ */
+class LatencyTracer
+{
+public:
+  /**
+   * \brief Create a tracer.
+   * @param capacity The number of cycles kept, must be greater than 0.
+   */
+  explicit LatencyTracer(std::size_t capacity);
+
+  /**
+   * \brief Record the trace of a cycle, replacing the oldest trace once the buffer is full. Only call this from the
+   * writer thread.
+   * @param trace The trace of the cycle.
+   */
+  void record(const CycleTrace& trace);
+
+  /**
+   * \brief Copy the recorded traces.
+   * @return The traces, oldest first.
+   */
+  std::vector<CycleTrace> snapshot() const;
+
+  /**
+   * \brief Compute the latency between consecutive stages, and between receiving a command and publishing it.
+   * Only cycles in which both stages were reached contribute to a statistic.
+   * @param traces The cycle traces.
+   * @return The statistics of each pair of stages.
+   */
+  static std::vector<LatencyStatistics> computeStatistics(const std::vector<CycleTrace>& traces);
+
+  /**
+   * \brief Write the recorded traces to a CSV file, one row per cycle and one column per stage.
+   * @param file_path The file to write.
+   * @return True if the file was written.
+   */
+  bool dump(const std::string& file_path) const;
+
+private:
+  using Slot = std::array<std::atomic<int64_t>, LATENCY_STAGE_COUNT>;
+
+  const std::size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  // The number of traces whose recording has started and the number of completely recorded traces
+  std::atomic<uint64_t> started_count_;
+  std::atomic<uint64_t> recorded_count_;
+};
+
+}  // namespace moveit_servo
@@ -0,0 +1,130 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : triple_buffer.hpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : Wait-free hand-off of the latest value from one thread to another.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace moveit_servo
+{
+
+/**
+ * \brief A ring of three slots that hands the most recent value from a single writer to a single reader.
+ *
+ * The writer fills its own slot and swaps it with the shared slot, the reader swaps its own slot with the shared slot
+ * when that holds a newer value. Neither side ever waits for the other, and values are never copied between threads:
+ * each slot keeps its memory, so values like Eigen vectors of constant size are not reallocated either.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+  /**
+   * \brief Create the buffer with all slots holding \e initial, so that slots with dynamic size can be preallocated.
+   * @param initial The initial value of the slots.
+   */
+  explicit TripleBuffer(const T& initial = T()) : slots_{ initial, initial, initial }
+  {
+  }
+
+  /**
+   * \brief Get the slot the writer may fill. Only call this from the writer thread.
+   * @return The slot to write the next value into.
+   */
+  T& writeSlot()
+  {
+    return slots_[write_index_];
+  }
+
+  /**
+   * \brief Make the value in the write slot available to the reader. Only call this from the writer thread.
+   */
+  void publish()
+  {
+    write_index_ = shared_.exchange(write_index_ | NEW_VALUE, std::memory_order_acq_rel) & INDEX_MASK;
+  }
+
+  /**
+   * \brief Write a value and make it available to the reader. Only call this from the writer thread.
+   * @param value The value to hand to the reader.
+   */
+  void write(const T& value)
+  {
+    writeSlot() = value;
+    publish();
+  }
+
+  /**
+   * \brief Get the most recently published value. Only call this from the reader thread.
+   * The reference stays valid until the next call to read().
+   * @return The latest value, or the value returned by the previous call if nothing new was published.
+   */
+  const T& read()
+  {
+    if (shared_.load(std::memory_order_relaxed) & NEW_VALUE)
+      read_index_ = shared_.exchange(read_index_, std::memory_order_acq_rel) & INDEX_MASK;
+    return slots_[read_index_];
+  }
+
+  /**
+   * \brief Check whether a value was published since the last call to read(). Only call this from the reader thread.
+   * @return True if read() will return a new value.
+   */
+  bool hasNewValue() const
+  {
+    return shared_.load(std::memory_order_relaxed) & NEW_VALUE;
+  }
+
+private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t NEW_VALUE = 0x4;
+
+  std::array<T, 3> slots_;
+  // each slot is owned by exactly one of the writer, the reader and the shared index at any time
+  uint8_t write_index_ = 0;
+  std::atomic<uint8_t> shared_ = 1;
+  uint8_t read_index_ = 2;
+};
+
+}  // namespace moveit_servo
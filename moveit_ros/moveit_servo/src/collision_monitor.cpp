@@ -40,6 +40,7 @@
 #include <moveit_servo/collision_monitor.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <moveit/utils/logger.hpp>
+#include <algorithm>
 
 namespace moveit_servo
 {
@@ -57,12 +58,41 @@ CollisionMonitor::CollisionMonitor(const planning_scene_monitor::PlanningSceneMo
   , planning_scene_monitor_(planning_scene_monitor)
   , robot_state_(planning_scene_monitor->getPlanningScene()->getCurrentState())
   , collision_velocity_scale_(collision_velocity_scale)
+  , commanded_states_([&] {
+    // preallocate the slots, so that handing over a state does not allocate. Servo commands the active joints only.
+    const std::size_t joint_count =
+        robot_state_.getJointModelGroup(servo_params.move_group_name)->getActiveVariableCount();
+    return CommandedState{ Eigen::VectorXd::Zero(joint_count), Eigen::VectorXd::Zero(joint_count), {} };
+  }())
+  , scene_copy_outdated_(false)
+  , min_scene_copy_period_(1.0 / servo_params.collision_check_rate)
+  , scene_update_callback_id_(0)
+  , scene_snapshots_(SceneSnapshot{ nullptr, robot_state_ })
+  , predicted_state_(robot_state_)
 {
   scene_collision_request_.distance = true;
   scene_collision_request_.group_name = servo_params.move_group_name;
 
   self_collision_request_.distance = true;
   self_collision_request_.group_name = servo_params.move_group_name;
+
+  // The predicted states only need a yes/no answer, which is much cheaper than the distance.
+  lookahead_collision_request_.group_name = servo_params.move_group_name;
+
+  scene_update_callback_id_ = planning_scene_monitor_->addUpdateCallback(
+      [this](planning_scene_monitor::PlanningSceneMonitor::SceneUpdateType update_type) {
+        publishSceneSnapshot(update_type);
+      });
+  // The first snapshot is taken once the updates are handed over, so that none is missed. It does not hold back the
+  // copy of the scene for the next update.
+  publishSceneSnapshot(planning_scene_monitor::PlanningSceneMonitor::UPDATE_SCENE);
+  std::lock_guard<std::mutex> lock(scene_snapshot_writer_mutex_);
+  last_scene_copy_time_ = std::chrono::steady_clock::time_point();
+}
+
+CollisionMonitor::~CollisionMonitor()
+{
+  planning_scene_monitor_->removeUpdateCallback(scene_update_callback_id_);
 }
 
 void CollisionMonitor::start()
@@ -89,89 +119,195 @@ void CollisionMonitor::stop()
   RCLCPP_INFO_STREAM(getLogger(), "Collision monitor stopped");
 }
 
+void CollisionMonitor::setCommandedState(const Eigen::VectorXd& positions, const Eigen::VectorXd& velocities,
+                                         std::chrono::steady_clock::time_point stamp)
+{
+  CommandedState& state = commanded_states_.writeSlot();
+  state.positions = positions;
+  state.velocities = velocities;
+  state.stamp = stamp;
+  commanded_states_.publish();
+}
+
+void CollisionMonitor::publishSceneSnapshot(planning_scene_monitor::PlanningSceneMonitor::SceneUpdateType update_type)
+{
+  using planning_scene_monitor::PlanningSceneMonitor;
+  std::lock_guard<std::mutex> lock(scene_snapshot_writer_mutex_);
+
+  // the fixed transforms of the scene do not take part in collision checks
+  scene_copy_outdated_ = scene_copy_outdated_ || (update_type & PlanningSceneMonitor::UPDATE_GEOMETRY);
+  const auto now = std::chrono::steady_clock::now();
+  const bool copy_scene = scene_copy_outdated_ && now - last_scene_copy_time_ >= min_scene_copy_period_;
+  if (!copy_scene && !(update_type & PlanningSceneMonitor::UPDATE_STATE))
+  {
+    return;
+  }
+
+  SceneSnapshot& snapshot = scene_snapshots_.writeSlot();
+  {
+    planning_scene_monitor::LockedPlanningSceneRO locked_scene(planning_scene_monitor_);
+    if (copy_scene)
+    {
+      scene_copy_ = planning_scene::PlanningScene::clone(locked_scene);
+      scene_copy_outdated_ = false;
+      last_scene_copy_time_ = now;
+    }
+    // The attached objects come with the copy of the scene, so that they match its world. Only the joint positions
+    // are taken from the monitored scene otherwise, which does not allocate.
+    if (snapshot.scene != scene_copy_)
+    {
+      snapshot.scene = scene_copy_;
+      snapshot.state = scene_copy_->getCurrentState();
+    }
+    snapshot.state.setVariablePositions(locked_scene->getCurrentState().getVariablePositions());
+  }
+  scene_snapshots_.publish();
+}
+
 void CollisionMonitor::checkCollisions()
 {
   rclcpp::WallRate rate(servo_params_.collision_check_rate);
 
-  bool approaching_self_collision, approaching_scene_collision;
-  double self_collision_threshold_delta, scene_collision_threshold_delta;
-  double self_collision_scale, scene_collision_scale;
+  while (rclcpp::ok() && !stop_requested_)
+  {
+    checkOnce(std::chrono::steady_clock::now());
+    rate.sleep();
+  }
+}
+
+void CollisionMonitor::checkOnce(std::chrono::steady_clock::time_point now)
+{
   const double log_val = -log(0.001);
+  const double self_velocity_scale_coefficient{ log_val / servo_params_.self_collision_proximity_threshold };
+  const double scene_velocity_scale_coefficient{ log_val / servo_params_.scene_collision_proximity_threshold };
 
-  while (rclcpp::ok() && !stop_requested_)
+  if (servo_params_.check_collisions)
   {
-    const double self_velocity_scale_coefficient{ log_val / servo_params_.self_collision_proximity_threshold };
-    const double scene_velocity_scale_coefficient{ log_val / servo_params_.scene_collision_proximity_threshold };
+    // Get the latest snapshot of the planning scene, without waiting for the lock of the planning scene monitor.
+    const SceneSnapshot& snapshot = scene_snapshots_.read();
+    const planning_scene::PlanningSceneConstPtr& scene = snapshot.scene;
+
+    // Fetch latest robot state using planning scene instead of state monitor due to
+    // https://github.com/moveit/moveit2/issues/2748
+    robot_state_ = snapshot.state;
 
-    if (servo_params_.check_collisions)
+    // While servo is commanding the robot, check the state it commands.
+    const CommandedState& commanded_state = commanded_states_.read();
+    const std::chrono::duration<double> command_age = now - commanded_state.stamp;
+    const moveit::core::JointModelGroup* joint_model_group =
+        robot_state_.getJointModelGroup(servo_params_.move_group_name);
+    const auto joint_count = static_cast<Eigen::Index>(joint_model_group->getActiveVariableCount());
+    const bool is_commanding = command_age.count() <= servo_params_.incoming_command_timeout &&
+                               commanded_state.positions.size() == joint_count &&
+                               commanded_state.velocities.size() == joint_count;
+    if (is_commanding)
     {
-      // Get a read-only copy of the planning scene.
-      planning_scene_monitor::LockedPlanningSceneRO locked_scene(planning_scene_monitor_);
-
-      // Fetch latest robot state using planning scene instead of state monitor due to
-      // https://github.com/moveit/moveit2/issues/2748
-      robot_state_ = locked_scene->getCurrentState();
-      // This must be called before doing collision checking.
-      robot_state_.updateCollisionBodyTransforms();
-
-      // Check collision with environment.
-      scene_collision_result_.clear();
-      locked_scene->getCollisionEnv()->checkRobotCollision(scene_collision_request_, scene_collision_result_,
-                                                           robot_state_, locked_scene->getAllowedCollisionMatrix());
-
-      // Check robot self collision.
-      self_collision_result_.clear();
-      locked_scene->getCollisionEnvUnpadded()->checkSelfCollision(
-          self_collision_request_, self_collision_result_, robot_state_, locked_scene->getAllowedCollisionMatrix());
-
-      // If collision detected scale velocity to 0, else start decelerating exponentially.
-      // velocity_scale = e ^ k * (collision_distance - threshold)
-      // k = - ln(0.001) / collision_proximity_threshold
-      // velocity_scale should equal one when collision_distance is at collision_proximity_threshold.
-      // velocity_scale should equal 0.001 when collision_distance is at zero.
-      //
-      // NOTE:
-      // collision_velocity_scale_ is shared by the primary servo thread. Be sure to not set any
-      // intermediate values in this loop or they can be picked up and throw off scaling while processing
-      // joint updates.
-
-      if (self_collision_result_.collision || scene_collision_result_.collision)
+      robot_state_.setJointGroupActivePositions(joint_model_group, commanded_state.positions);
+    }
+    // This must be called before doing collision checking.
+    robot_state_.updateCollisionBodyTransforms();
+
+    // Check collision with environment.
+    scene_collision_result_.clear();
+    scene->getCollisionEnv()->checkRobotCollision(scene_collision_request_, scene_collision_result_, robot_state_,
+                                                  scene->getAllowedCollisionMatrix());
+
+    // Check robot self collision.
+    self_collision_result_.clear();
+    scene->getCollisionEnvUnpadded()->checkSelfCollision(self_collision_request_, self_collision_result_, robot_state_,
+                                                         scene->getAllowedCollisionMatrix());
+
+    // If collision detected scale velocity to 0, else start decelerating exponentially.
+    // velocity_scale = e ^ k * (collision_distance - threshold)
+    // k = - ln(0.001) / collision_proximity_threshold
+    // velocity_scale should equal one when collision_distance is at collision_proximity_threshold.
+    // velocity_scale should equal 0.001 when collision_distance is at zero.
+    //
+    // NOTE:
+    // collision_velocity_scale_ is shared by the primary servo thread. Be sure to not set any
+    // intermediate values in this function or they can be picked up and throw off scaling while processing
+    // joint updates.
+
+    if (self_collision_result_.collision || scene_collision_result_.collision)
+    {
+      collision_velocity_scale_ = 0.0;
+    }
+    else
+    {
+      double self_collision_scale = 1.0;
+      double scene_collision_scale = 1.0;
+
+      const bool approaching_scene_collision =
+          scene_collision_result_.distance < servo_params_.scene_collision_proximity_threshold;
+      const bool approaching_self_collision =
+          self_collision_result_.distance < servo_params_.self_collision_proximity_threshold;
+
+      if (approaching_scene_collision)
       {
-        collision_velocity_scale_ = 0.0;
+        const double scene_collision_threshold_delta =
+            scene_collision_result_.distance - servo_params_.scene_collision_proximity_threshold;
+        scene_collision_scale = std::exp(scene_velocity_scale_coefficient * scene_collision_threshold_delta);
       }
-      else
+
+      if (approaching_self_collision)
       {
-        self_collision_scale = scene_collision_scale = 1.0;
-
-        approaching_scene_collision =
-            scene_collision_result_.distance < servo_params_.scene_collision_proximity_threshold;
-        approaching_self_collision = self_collision_result_.distance < servo_params_.self_collision_proximity_threshold;
-
-        if (approaching_scene_collision)
-        {
-          scene_collision_threshold_delta =
-              scene_collision_result_.distance - servo_params_.scene_collision_proximity_threshold;
-          scene_collision_scale = std::exp(scene_velocity_scale_coefficient * scene_collision_threshold_delta);
-        }
-
-        if (approaching_self_collision)
-        {
-          self_collision_threshold_delta =
-              self_collision_result_.distance - servo_params_.self_collision_proximity_threshold;
-          self_collision_scale = std::exp(self_velocity_scale_coefficient * self_collision_threshold_delta);
-        }
-
-        // Use the scaling factor with lower value, i.e maximum scale down.
-        collision_velocity_scale_ = std::min(scene_collision_scale, self_collision_scale);
+        const double self_collision_threshold_delta =
+            self_collision_result_.distance - servo_params_.self_collision_proximity_threshold;
+        self_collision_scale = std::exp(self_velocity_scale_coefficient * self_collision_threshold_delta);
       }
+
+      // Slow down in proportion to the time left until a collision predicted along the commanded velocities.
+      // Unlike the distance based scaling, this does not slow down motions away from the obstacles.
+      double lookahead_scale = 1.0;
+      if (servo_params_.collision_lookahead_time > 0.0 && is_commanding)
+      {
+        const std::optional<double> time_to_collision =
+            predictTimeToCollision(*scene, commanded_state.positions, commanded_state.velocities);
+        if (time_to_collision.has_value())
+          lookahead_scale = *time_to_collision / servo_params_.collision_lookahead_time;
+      }
+
+      // Use the scaling factor with lower value, i.e maximum scale down.
+      collision_velocity_scale_ = std::min({ scene_collision_scale, self_collision_scale, lookahead_scale });
     }
-    else
+  }
+  else
+  {
+    // If collision checking is disabled we do not scale
+    collision_velocity_scale_ = 1.0;
+  }
+}
+
+std::optional<double> CollisionMonitor::predictTimeToCollision(const planning_scene::PlanningScene& scene,
+                                                               const Eigen::VectorXd& positions,
+                                                               const Eigen::VectorXd& velocities)
+{
+  const moveit::core::JointModelGroup* joint_model_group =
+      robot_state_.getJointModelGroup(servo_params_.move_group_name);
+  const auto joint_count = static_cast<Eigen::Index>(joint_model_group->getActiveVariableCount());
+  if (positions.size() != joint_count || velocities.size() != joint_count)
+  {
+    return std::nullopt;
+  }
+  predicted_state_ = robot_state_;
+
+  const double time_step = servo_params_.collision_lookahead_time / servo_params_.collision_lookahead_steps;
+  for (int step = 1; step <= servo_params_.collision_lookahead_steps; ++step)
+  {
+    predicted_state_.setJointGroupActivePositions(joint_model_group, positions + velocities * (step * time_step));
+    predicted_state_.updateCollisionBodyTransforms();
+
+    lookahead_collision_result_.clear();
+    scene.getCollisionEnv()->checkRobotCollision(lookahead_collision_request_, lookahead_collision_result_,
+                                                 predicted_state_, scene.getAllowedCollisionMatrix());
+    if (!lookahead_collision_result_.collision)
     {
-      // If collision checking is disabled we do not scale
-      collision_velocity_scale_ = 1.0;
+      scene.getCollisionEnvUnpadded()->checkSelfCollision(lookahead_collision_request_, lookahead_collision_result_,
+                                                          predicted_state_, scene.getAllowedCollisionMatrix());
     }
-
-    rate.sleep();
+    if (lookahead_collision_result_.collision)
+      return (step - 1) * time_step;
   }
+  return std::nullopt;
 }
 }  // namespace moveit_servo
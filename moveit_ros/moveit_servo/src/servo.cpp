@@ -43,6 +43,8 @@
 #include <rclcpp/rclcpp.hpp>
 #include <moveit/utils/logger.hpp>
 
+#include <algorithm>
+
 // Disable -Wold-style-cast because all _THROTTLE macros trigger this
 #pragma GCC diagnostic ignored "-Wold-style-cast"
 
@@ -163,10 +165,18 @@ void Servo::setSmoothingPlugin()
 
 void Servo::doSmoothing(KinematicState& state)
 {
+  last_smoothing_start_ = std::chrono::steady_clock::now();
   if (smoother_)
   {
     smoother_->doSmoothing(state.positions, state.velocities, state.accelerations);
   }
+  last_smoothing_end_ = std::chrono::steady_clock::now();
+}
+
+std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point>
+Servo::getLastSmoothingTimes() const
+{
+  return { last_smoothing_start_, last_smoothing_end_ };
 }
 
 void Servo::resetSmoothing(const KinematicState& state)
@@ -182,6 +192,17 @@ void Servo::setCollisionChecking(const bool check_collision)
   check_collision ? collision_monitor_->start() : collision_monitor_->stop();
 }
 
+void Servo::checkCollisionsOnce(std::chrono::steady_clock::time_point stamp)
+{
+  collision_monitor_->checkOnce(stamp);
+}
+
+void Servo::checkCollisionsOnce(const KinematicState& state, std::chrono::steady_clock::time_point stamp)
+{
+  collision_monitor_->setCommandedState(state.positions, state.velocities, stamp);
+  collision_monitor_->checkOnce(stamp);
+}
+
 bool Servo::validateParams(const servo::Params& servo_params)
 {
   bool params_valid = true;
@@ -311,6 +332,8 @@ bool Servo::updateParams()
 
 servo::Params& Servo::getParams()
 {
+  // the caller may change the parameters, which the subgroup parameters are copied from
+  subgroup_params_stale_ = true;
   return servo_params_;
 }
 
@@ -371,17 +394,16 @@ KinematicState Servo::haltJoints(const std::vector<size_t>& joint_variables_to_h
   return bounded_state;
 }
 
-Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state)
+Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const moveit::core::RobotStatePtr& robot_state,
+                                             const servo::Params& params)
 {
   // Determine joint_name_group_index_map, if no subgroup is active, the map is empty
-  const auto& active_subgroup_name =
-      servo_params_.active_subgroup.empty() ? servo_params_.move_group_name : servo_params_.active_subgroup;
-  const auto& joint_name_group_index_map = (active_subgroup_name != servo_params_.move_group_name) ?
-                                               joint_name_to_index_maps_.at(servo_params_.active_subgroup) :
+  const auto& active_subgroup_name = params.active_subgroup.empty() ? params.move_group_name : params.active_subgroup;
+  const auto& joint_name_group_index_map = (active_subgroup_name != params.move_group_name) ?
+                                               joint_name_to_index_maps_.at(params.active_subgroup) :
                                                JointNameToMoveGroupIndexMap();
 
-  const int num_joints =
-      robot_state->getJointModelGroup(servo_params_.move_group_name)->getActiveJointModelNames().size();
+  const int num_joints = robot_state->getJointModelGroup(params.move_group_name)->getActiveJointModelNames().size();
   Eigen::VectorXd joint_position_deltas(num_joints);
   joint_position_deltas.setZero();
 
@@ -392,7 +414,7 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
   {
     if (expected_type == CommandType::JOINT_JOG)
     {
-      delta_result = jointDeltaFromJointJog(std::get<JointJogCommand>(command), robot_state, servo_params_,
+      delta_result = jointDeltaFromJointJog(std::get<JointJogCommand>(command), robot_state, params,
                                             joint_name_group_index_map);
       servo_status_ = delta_result.first;
     }
@@ -407,8 +429,8 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
         const auto command_in_planning_frame_maybe = toPlanningFrame(std::get<TwistCommand>(command), planning_frame);
         if (command_in_planning_frame_maybe.has_value())
         {
-          delta_result = jointDeltaFromTwist(*command_in_planning_frame_maybe, robot_state, servo_params_,
-                                             planning_frame, joint_name_group_index_map);
+          delta_result = jointDeltaFromTwist(*command_in_planning_frame_maybe, robot_state, params, planning_frame,
+                                             joint_name_group_index_map);
           servo_status_ = delta_result.first;
         }
         else
@@ -436,7 +458,7 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
         const auto command_in_planning_frame_maybe = toPlanningFrame(std::get<PoseCommand>(command), planning_frame);
         if (command_in_planning_frame_maybe.has_value())
         {
-          delta_result = jointDeltaFromPose(*command_in_planning_frame_maybe, robot_state, servo_params_,
+          delta_result = jointDeltaFromPose(*command_in_planning_frame_maybe, robot_state, params,
                                             planning_frame, *ee_frame_maybe, joint_name_group_index_map);
           servo_status_ = delta_result.first;
         }
@@ -467,7 +489,8 @@ Eigen::VectorXd Servo::jointDeltaFromCommand(const ServoInput& command, const mo
   return joint_position_deltas;
 }
 
-KinematicState Servo::getNextJointState(const moveit::core::RobotStatePtr& robot_state, const ServoInput& command)
+KinematicState Servo::getNextJointState(const moveit::core::RobotStatePtr& robot_state, const ServoInput& command,
+                                        std::chrono::steady_clock::time_point stamp)
 {
   // Set status to clear
   servo_status_ = StatusCode::NO_WARNING;
@@ -475,6 +498,97 @@ KinematicState Servo::getNextJointState(const moveit::core::RobotStatePtr& robot
   // Update the parameters
   updateParams();
 
+  // Compute the change in joint position due to the incoming command
+  const Eigen::VectorXd joint_position_delta = jointDeltaFromCommand(command, robot_state, servo_params_);
+
+  return nextJointStateFromDelta(robot_state, joint_position_delta, stamp);
+}
+
+KinematicState Servo::getNextJointState(const moveit::core::RobotStatePtr& robot_state, const MultiGroupInput& commands,
+                                        std::chrono::steady_clock::time_point stamp)
+{
+  // Set status to clear
+  servo_status_ = StatusCode::NO_WARNING;
+
+  // Update the parameters, and the parameters of the subgroups if they or the commanded subgroups changed
+  const bool params_updated = updateParams();
+  const auto same_subgroup = [](const std::pair<std::string, ServoInput>& command, const servo::Params& params) {
+    return command.first == params.active_subgroup;
+  };
+  if (params_updated || subgroup_params_stale_ || subgroup_params_.size() != commands.size() ||
+      !std::equal(commands.begin(), commands.end(), subgroup_params_.begin(), same_subgroup))
+  {
+    subgroup_params_.assign(commands.size(), servo_params_);
+    for (std::size_t i = 0; i < commands.size(); ++i)
+    {
+      subgroup_params_[i].active_subgroup = commands[i].first;
+    }
+    subgroup_params_stale_ = false;
+  }
+
+  const std::size_t num_joints =
+      robot_state->getJointModelGroup(servo_params_.move_group_name)->getActiveJointModelNames().size();
+  Eigen::VectorXd joint_position_delta = Eigen::VectorXd::Zero(num_joints);
+  std::vector<bool> joint_commanded(num_joints, false);
+
+  // Each command is computed with its own subgroup active, the deltas only contain the joints of that subgroup.
+  StatusCode status = StatusCode::NO_WARNING;
+  for (std::size_t i = 0; i < commands.size(); ++i)
+  {
+    const auto& [subgroup_name, command] = commands[i];
+    const auto subgroup_map = joint_name_to_index_maps_.find(subgroup_name);
+    bool valid_subgroup = subgroup_map != joint_name_to_index_maps_.end();
+    bool overlapping = false;
+    if (valid_subgroup)
+    {
+      for (const auto& [joint_name, index] : subgroup_map->second)
+      {
+        // Joints outside of the move group are mapped past its last joint
+        if (index >= num_joints)
+        {
+          valid_subgroup = false;
+          break;
+        }
+        overlapping = overlapping || joint_commanded[index];
+        joint_commanded[index] = true;
+      }
+    }
+    if (!valid_subgroup)
+    {
+      status = StatusCode::INVALID;
+      RCLCPP_ERROR(logger_, "'%s' is not a subgroup of move group '%s'.", subgroup_name.c_str(),
+                   servo_params_.move_group_name.c_str());
+      break;
+    }
+    if (overlapping)
+    {
+      status = StatusCode::INVALID;
+      RCLCPP_ERROR(logger_, "Subgroup '%s' shares joints with another commanded subgroup.", subgroup_name.c_str());
+      break;
+    }
+
+    servo_status_ = StatusCode::NO_WARNING;
+    const Eigen::VectorXd group_delta = jointDeltaFromCommand(command, robot_state, subgroup_params_[i]);
+    if (servo_status_ == StatusCode::INVALID)
+    {
+      status = StatusCode::INVALID;
+      break;
+    }
+    if (servo_status_ != StatusCode::NO_WARNING)
+    {
+      status = servo_status_;
+    }
+    joint_position_delta += group_delta;
+  }
+  servo_status_ = status;
+
+  return nextJointStateFromDelta(robot_state, joint_position_delta, stamp);
+}
+
+KinematicState Servo::nextJointStateFromDelta(const moveit::core::RobotStatePtr& robot_state,
+                                              const Eigen::VectorXd& joint_position_delta,
+                                              std::chrono::steady_clock::time_point stamp)
+{
   // Get the joint model group info.
   const moveit::core::JointModelGroup* joint_model_group =
       robot_state->getJointModelGroup(servo_params_.move_group_name);
@@ -489,8 +603,13 @@ KinematicState Servo::getNextJointState(const moveit::core::RobotStatePtr& robot
   KinematicState target_state(num_joints);
   target_state.joint_names = joint_names;
 
-  // Compute the change in joint position due to the incoming command
-  Eigen::VectorXd joint_position_delta = jointDeltaFromCommand(command, robot_state);
+  // Hand the commanded state to the collision monitor. The velocities are not scaled for collisions, so that the
+  // monitor can predict where the command leads also while halted for a predicted collision.
+  if (servo_status_ != StatusCode::INVALID && servo_params_.check_collisions)
+  {
+    collision_monitor_->setCommandedState(current_state.positions, joint_position_delta / servo_params_.publish_period,
+                                          stamp);
+  }
 
   if (collision_velocity_scale_ > 0 && collision_velocity_scale_ < 1)
   {
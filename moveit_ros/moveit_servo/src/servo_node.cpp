@@ -69,6 +69,7 @@ ServoNode::ServoNode(const rclcpp::NodeOptions& options)
   , new_joint_jog_msg_{ false }
   , new_twist_msg_{ false }
   , new_pose_msg_{ false }
+  , latest_command_received_{ std::chrono::steady_clock::time_point() }
 {
   moveit::setNodeLoggerName(node_->get_name());
 
@@ -122,6 +123,17 @@ ServoNode::ServoNode(const rclcpp::NodeOptions& options)
     multi_array_publisher_ = node_->create_publisher<std_msgs::msg::Float64MultiArray>(servo_params_.command_out_topic,
                                                                                        rclcpp::SystemDefaultsQoS());
   }
+
+  // The outgoing messages are reused every cycle, reserve their memory up front.
+  const size_t num_joints = planning_scene_monitor_->getRobotModel()
+                                ->getJointModelGroup(servo_params_.move_group_name)
+                                ->getActiveJointModelNames()
+                                .size();
+  multi_array_msg_.data.reserve(num_joints);
+  trajectory_msg_.joint_names.reserve(num_joints);
+  trajectory_msg_.points.reserve(
+      static_cast<size_t>(std::ceil(servo_params_.max_expected_latency / servo_params_.publish_period)) + 2);
+
   // Create status publisher
   status_publisher_ =
       node_->create_publisher<moveit_msgs::msg::ServoStatus>(servo_params_.status_topic, rclcpp::SystemDefaultsQoS());
@@ -140,6 +152,22 @@ ServoNode::ServoNode(const rclcpp::NodeOptions& options)
         return pauseServo(request, response);
       });
 
+  // Set up latency tracing
+  if (servo_params_.latency_trace_size > 0)
+  {
+    latency_tracer_ = std::make_unique<LatencyTracer>(servo_params_.latency_trace_size);
+    latency_diagnostics_publisher_ = node_->create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+        servo_params_.latency_diagnostics_topic, rclcpp::SystemDefaultsQoS());
+    latency_diagnostics_timer_ =
+        node_->create_wall_timer(std::chrono::duration<double>(servo_params_.latency_diagnostics_period),
+                                 [this]() { publishLatencyDiagnostics(); });
+    dump_latency_trace_ = node_->create_service<std_srvs::srv::Trigger>(
+        "~/dump_latency_trace", [this](const std::shared_ptr<std_srvs::srv::Trigger::Request>& request,
+                                       const std::shared_ptr<std_srvs::srv::Trigger::Response>& response) {
+          return dumpLatencyTrace(request, response);
+        });
+  }
+
   // Start the servoing loop
   servo_loop_thread_ = std::thread(&ServoNode::servoLoop, this);
 }
@@ -194,20 +222,62 @@ void ServoNode::switchCommandType(const std::shared_ptr<moveit_msgs::srv::ServoC
   response->success = (request->command_type == static_cast<int8_t>(servo_->getCommandType()));
 }
 
+void ServoNode::publishLatencyDiagnostics()
+{
+  diagnostic_msgs::msg::DiagnosticArray diagnostics;
+  diagnostics.header.stamp = node_->now();
+  diagnostic_msgs::msg::DiagnosticStatus& status = diagnostics.status.emplace_back();
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = std::string(node_->get_name()) + ": latency";
+  status.hardware_id = servo_params_.move_group_name;
+
+  const std::vector<CycleTrace> traces = latency_tracer_->snapshot();
+  status.message = std::to_string(traces.size()) + " recorded cycles";
+  for (const auto& statistics : LatencyTracer::computeStatistics(traces))
+  {
+    if (statistics.samples == 0)
+    {
+      continue;
+    }
+    const std::string interval = LATENCY_STAGE_NAMES[static_cast<std::size_t>(statistics.from)] + " -> " +
+                                 LATENCY_STAGE_NAMES[static_cast<std::size_t>(statistics.to)];
+    for (const auto& [name, value] : { std::make_pair("p50", statistics.p50), std::make_pair("p99", statistics.p99),
+                                       std::make_pair("max", statistics.max) })
+    {
+      diagnostic_msgs::msg::KeyValue& key_value = status.values.emplace_back();
+      key_value.key = interval + " " + name + " [us]";
+      key_value.value = std::to_string(value * 1E6);
+    }
+  }
+  latency_diagnostics_publisher_->publish(diagnostics);
+}
+
+void ServoNode::dumpLatencyTrace(const std::shared_ptr<std_srvs::srv::Trigger::Request>& /* unused */,
+                                 const std::shared_ptr<std_srvs::srv::Trigger::Response>& response)
+{
+  const std::string file_path = servo_->getParams().latency_trace_file;
+  response->success = latency_tracer_->dump(file_path);
+  response->message = response->success ? "Latency trace written to " + file_path :
+                                          "Could not write latency trace to " + file_path;
+}
+
 void ServoNode::jointJogCallback(const control_msgs::msg::JointJog::ConstSharedPtr& msg)
 {
+  latest_command_received_ = std::chrono::steady_clock::now();
   latest_joint_jog_ = *msg;
   new_joint_jog_msg_ = true;
 }
 
 void ServoNode::twistCallback(const geometry_msgs::msg::TwistStamped::ConstSharedPtr& msg)
 {
+  latest_command_received_ = std::chrono::steady_clock::now();
   latest_twist_ = *msg;
   new_twist_msg_ = true;
 }
 
 void ServoNode::poseCallback(const geometry_msgs::msg::PoseStamped::ConstSharedPtr& msg)
 {
+  latest_command_received_ = std::chrono::steady_clock::now();
   latest_pose_ = *msg;
   new_pose_msg_ = true;
 }
@@ -353,6 +423,10 @@ void ServoNode::servoLoop()
       continue;
     }
 
+    CycleTrace cycle_trace;
+    const auto cycle_start = std::chrono::steady_clock::now();
+    cycle_trace.mark(LatencyStage::CYCLE_START, cycle_start);
+
     {  // scope for mutex-protected operations
       std::lock_guard<std::mutex> lock_guard(lock_);
       const bool use_trajectory = servo_params_.command_out_type == "trajectory_msgs/JointTrajectory";
@@ -373,6 +447,7 @@ void ServoNode::servoLoop()
       // update robot state values
       robot_state->setJointGroupPositions(joint_model_group, current_state.positions);
       robot_state->setJointGroupVelocities(joint_model_group, current_state.velocities);
+      cycle_trace.mark(LatencyStage::STATE_UPDATED);
 
       next_joint_state = std::nullopt;
       const CommandType expected_type = servo_->getCommandType();
@@ -395,6 +470,13 @@ void ServoNode::servoLoop()
         RCLCPP_WARN_STREAM(node_->get_logger(), "Command type has not been set, cannot accept input");
       }
 
+      const auto [smoothing_start, smoothing_end] = servo_->getLastSmoothingTimes();
+      if (next_joint_state && smoothing_start >= cycle_start)
+      {
+        cycle_trace.mark(LatencyStage::SMOOTHING_START, smoothing_start);
+        cycle_trace.mark(LatencyStage::SMOOTHING_END, smoothing_end);
+      }
+
       if (next_joint_state && (servo_->getStatus() != StatusCode::INVALID) &&
           (servo_->getStatus() != StatusCode::HALT_FOR_COLLISION))
       {
@@ -403,15 +485,17 @@ void ServoNode::servoLoop()
           auto& next_joint_state_value = next_joint_state.value();
           updateSlidingWindow(next_joint_state_value, joint_cmd_rolling_window_, servo_params_.max_expected_latency,
                               cur_time);
-          if (const auto msg = composeTrajectoryMessage(servo_params_, joint_cmd_rolling_window_))
+          if (composeTrajectoryMessage(servo_params_, joint_cmd_rolling_window_, trajectory_msg_))
           {
-            trajectory_publisher_->publish(msg.value());
+            publishMessage(trajectory_publisher_, trajectory_msg_);
           }
         }
         else
         {
-          multi_array_publisher_->publish(composeMultiArrayMessage(servo_->getParams(), next_joint_state.value()));
+          composeMultiArrayMessage(servo_->getParams(), next_joint_state.value(), multi_array_msg_);
+          publishMessage(multi_array_publisher_, multi_array_msg_);
         }
+        cycle_trace.mark(LatencyStage::PUBLISHED);
         last_commanded_state_ = next_joint_state.value();
       }
       else
@@ -427,6 +511,19 @@ void ServoNode::servoLoop()
       status_publisher_->publish(status_msg);
     }
 
+    // Trace the cycles that processed a command. The arrival of a command is only traced for the first cycle that
+    // processes it, later cycles keep following the same command.
+    if (latency_tracer_ && next_joint_state)
+    {
+      const auto command_received = latest_command_received_.load();
+      if (command_received != last_traced_command_received_ && command_received <= cycle_start)
+      {
+        cycle_trace.mark(LatencyStage::COMMAND_RECEIVED, command_received);
+        last_traced_command_received_ = command_received;
+      }
+      latency_tracer_->record(cycle_trace);
+    }
+
     servo_frequency.sleep();
   }
 }
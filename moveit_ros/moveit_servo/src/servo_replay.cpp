@@ -0,0 +1,431 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : servo_replay.cpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ */
+
+#include <moveit_servo/servo_replay.hpp>
+#include <moveit_servo/utils/common.hpp>
+#include <moveit/utils/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+namespace moveit_servo
+{
+namespace
+{
+rclcpp::Logger getLogger()
+{
+  return moveit::getLogger("moveit.ros.servo");
+}
+
+std::vector<std::string> splitLine(const std::string& line)
+{
+  std::vector<std::string> fields;
+  std::stringstream stream(line);
+  std::string field;
+  while (std::getline(stream, field, ','))
+  {
+    fields.push_back(field);
+  }
+  // A trailing empty field is not returned by getline.
+  if (!line.empty() && line.back() == ',')
+  {
+    fields.emplace_back();
+  }
+  return fields;
+}
+
+// The time of a sample, on the clock that the collision checks measure the age of the commanded state with.
+std::chrono::steady_clock::time_point toStamp(double time)
+{
+  return std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time)));
+}
+
+template <typename Derived>
+void writeValues(std::ofstream& file, const Eigen::MatrixBase<Derived>& values)
+{
+  for (Eigen::Index i = 0; i < values.size(); ++i)
+  {
+    file << ',' << values[i];
+  }
+}
+}  // namespace
+
+ServoReplay::ServoReplay(const rclcpp::Node::SharedPtr& node,
+                         std::shared_ptr<const servo::ParamListener> servo_param_listener,
+                         const planning_scene_monitor::PlanningSceneMonitorPtr& planning_scene_monitor)
+  : planning_scene_monitor_{ planning_scene_monitor }
+  , servo_{ node, std::move(servo_param_listener), planning_scene_monitor }
+{
+  // The collision checks run in step with the replayed commands instead.
+  servo_.setCollisionChecking(false);
+}
+
+Servo& ServoReplay::getServo()
+{
+  return servo_;
+}
+
+ReplayResult ServoReplay::replay(const ServoRecording& recording)
+{
+  ReplayResult result;
+  const servo::Params& servo_params = servo_.getParams();
+
+  // Start from the current state of the planning scene, which also provides the joints outside of the move group.
+  const auto robot_state = std::make_shared<moveit::core::RobotState>(
+      planning_scene_monitor::LockedPlanningSceneRO(planning_scene_monitor_)->getCurrentState());
+  const moveit::core::JointModelGroup* joint_model_group =
+      robot_state->getJointModelGroup(servo_params.move_group_name);
+  const auto num_joints = static_cast<long>(joint_model_group->getActiveJointModelNames().size());
+
+  if (recording.commands.empty())
+  {
+    RCLCPP_ERROR(getLogger(), "The recording has no commands to replay.");
+    return result;
+  }
+  for (const auto& joint_state : recording.joint_states)
+  {
+    if (joint_state.positions.size() != num_joints || joint_state.velocities.size() != num_joints)
+    {
+      RCLCPP_ERROR(getLogger(), "The recorded joint states do not match the %ld joints of move group '%s'.",
+                   num_joints, servo_params.move_group_name.c_str());
+      return result;
+    }
+  }
+
+  servo_.setCommandType(recording.command_type);
+  KinematicState state = extractRobotState(robot_state, servo_params.move_group_name);
+  state.velocities.setZero();
+  servo_.resetSmoothing(state);
+
+  double start_time = recording.commands.front().time;
+  double end_time = recording.commands.back().time;
+  if (!recording.joint_states.empty())
+  {
+    start_time = std::min(start_time, recording.joint_states.front().time);
+    end_time = std::max(end_time, recording.joint_states.back().time);
+  }
+  // Forget the states commanded in earlier replays.
+  servo_.checkCollisionsOnce(state, toStamp(start_time));
+  const auto num_cycles =
+      static_cast<std::size_t>(std::floor((end_time - start_time) / servo_params.publish_period)) + 1;
+  result.commanded_states.reserve(num_cycles);
+  result.statuses.reserve(num_cycles);
+  std::vector<double> cycle_times;
+  cycle_times.reserve(num_cycles);
+
+  auto next_command = recording.commands.cbegin();
+  auto next_joint_state = recording.joint_states.cbegin();
+  for (std::size_t cycle = 0; cycle < num_cycles; ++cycle)
+  {
+    const double time = start_time + static_cast<double>(cycle) * servo_params.publish_period;
+    // The commands and collision checks are stamped with the recording time instead of the wall clock.
+    const std::chrono::steady_clock::time_point stamp = toStamp(time);
+    while (next_command != recording.commands.cend() && next_command->time <= time)
+    {
+      ++next_command;
+    }
+    while (next_joint_state != recording.joint_states.cend() && next_joint_state->time <= time)
+    {
+      ++next_joint_state;
+    }
+
+    // Start from the latest recorded state, or else from the state commanded in the previous cycle.
+    if (next_joint_state != recording.joint_states.cbegin())
+    {
+      state.positions = std::prev(next_joint_state)->positions;
+      state.velocities = std::prev(next_joint_state)->velocities;
+    }
+    robot_state->setJointGroupPositions(joint_model_group, state.positions);
+    robot_state->setJointGroupVelocities(joint_model_group, state.velocities);
+    robot_state->update();
+
+    StatusCode status = StatusCode::NO_WARNING;
+    const bool is_stale = next_command == recording.commands.cbegin() ||
+                          time - std::prev(next_command)->time > servo_params.incoming_command_timeout;
+    if (is_stale)
+    {
+      ++result.stale_cycles;
+      state.velocities.setZero();
+      servo_.resetSmoothing(state);
+      servo_.checkCollisionsOnce(state, stamp);
+    }
+    else
+    {
+      const auto cycle_start = std::chrono::steady_clock::now();
+      KinematicState next_state = servo_.getNextJointState(robot_state, std::prev(next_command)->command, stamp);
+      cycle_times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - cycle_start).count());
+      servo_.checkCollisionsOnce(stamp);
+
+      status = servo_.getStatus();
+      if (status == StatusCode::DECELERATE_FOR_COLLISION)
+      {
+        ++result.collision_deceleration_cycles;
+      }
+      else if (status == StatusCode::HALT_FOR_COLLISION)
+      {
+        ++result.collision_halt_cycles;
+      }
+      else if (status == StatusCode::INVALID)
+      {
+        ++result.invalid_cycles;
+      }
+
+      // Like ServoNode, hold the current state if no command could be computed.
+      if (status != StatusCode::INVALID && status != StatusCode::HALT_FOR_COLLISION)
+      {
+        state = std::move(next_state);
+      }
+      else
+      {
+        state.velocities.setZero();
+        servo_.resetSmoothing(state);
+      }
+    }
+    result.commanded_states.push_back(state);
+    result.statuses.push_back(status);
+  }
+
+  if (!cycle_times.empty())
+  {
+    double total_cycle_time = 0.0;
+    for (const double cycle_time : cycle_times)
+    {
+      total_cycle_time += cycle_time;
+    }
+    result.mean_cycle_time = total_cycle_time / static_cast<double>(cycle_times.size());
+    result.max_cycle_time = *std::max_element(cycle_times.begin(), cycle_times.end());
+    const auto p99 = cycle_times.begin() + static_cast<long>(std::ceil(0.99 * cycle_times.size())) - 1;
+    std::nth_element(cycle_times.begin(), p99, cycle_times.end());
+    result.p99_cycle_time = *p99;
+  }
+
+  // Differentiate the commanded positions, as a controller following them would see them.
+  const double period = servo_params.publish_period;
+  Eigen::VectorXd last_velocity, last_acceleration;
+  double jerk_square_sum = 0.0;
+  std::size_t jerk_count = 0;
+  for (std::size_t i = 1; i < result.commanded_states.size(); ++i)
+  {
+    const Eigen::VectorXd velocity =
+        (result.commanded_states[i].positions - result.commanded_states[i - 1].positions) / period;
+    if (i >= 2)
+    {
+      const Eigen::VectorXd acceleration = (velocity - last_velocity) / period;
+      result.max_acceleration = std::max(result.max_acceleration, acceleration.cwiseAbs().maxCoeff());
+      if (i >= 3)
+      {
+        const Eigen::VectorXd jerk = (acceleration - last_acceleration) / period;
+        result.max_jerk = std::max(result.max_jerk, jerk.cwiseAbs().maxCoeff());
+        jerk_square_sum += jerk.squaredNorm();
+        jerk_count += jerk.size();
+      }
+      last_acceleration = acceleration;
+    }
+    last_velocity = velocity;
+  }
+  if (jerk_count > 0)
+  {
+    result.rms_jerk = std::sqrt(jerk_square_sum / static_cast<double>(jerk_count));
+  }
+
+  return result;
+}
+
+std::optional<ServoRecording> loadRecording(const std::string& file_path)
+{
+  std::ifstream file(file_path);
+  if (!file)
+  {
+    RCLCPP_ERROR(getLogger(), "Could not open recording '%s'.", file_path.c_str());
+    return std::nullopt;
+  }
+
+  ServoRecording recording;
+  bool has_command_type = false;
+  std::string line;
+  std::size_t line_number = 0;
+  try
+  {
+    while (std::getline(file, line))
+    {
+      ++line_number;
+      if (line.empty())
+      {
+        continue;
+      }
+      const std::vector<std::string> fields = splitLine(line);
+      if (!has_command_type)
+      {
+        const int command_type = fields.size() == 2 && fields[0] == "command_type" ? std::stoi(fields[1]) : -1;
+        if (command_type < static_cast<int>(CommandType::MIN) || command_type > static_cast<int>(CommandType::MAX))
+        {
+          throw std::invalid_argument("expected 'command_type,<type>'");
+        }
+        recording.command_type = static_cast<CommandType>(command_type);
+        has_command_type = true;
+      }
+      else if (fields.size() >= 3 && fields[0] == "command")
+      {
+        const double time = std::stod(fields[1]);
+        const std::size_t num_values = fields.size() - 3;
+        if (recording.command_type == CommandType::JOINT_JOG && num_values % 2 == 0)
+        {
+          JointJogCommand command;
+          for (std::size_t i = 3; i < fields.size(); i += 2)
+          {
+            command.names.push_back(fields[i]);
+            command.velocities.push_back(std::stod(fields[i + 1]));
+          }
+          recording.commands.push_back({ time, command });
+        }
+        else if (recording.command_type == CommandType::TWIST && num_values == 6)
+        {
+          TwistCommand command{ fields[2], Eigen::Vector<double, 6>::Zero() };
+          for (std::size_t i = 0; i < num_values; ++i)
+          {
+            command.velocities[i] = std::stod(fields[3 + i]);
+          }
+          recording.commands.push_back({ time, command });
+        }
+        else if (recording.command_type == CommandType::POSE && num_values == 7)
+        {
+          PoseCommand command{ fields[2], Eigen::Isometry3d::Identity() };
+          command.pose.translation() =
+              Eigen::Vector3d(std::stod(fields[3]), std::stod(fields[4]), std::stod(fields[5]));
+          command.pose.linear() = Eigen::Quaterniond(std::stod(fields[9]), std::stod(fields[6]), std::stod(fields[7]),
+                                                     std::stod(fields[8]))
+                                      .normalized()
+                                      .toRotationMatrix();
+          recording.commands.push_back({ time, command });
+        }
+        else
+        {
+          throw std::invalid_argument("wrong number of command values");
+        }
+      }
+      else if (fields.size() >= 2 && fields[0] == "joint_state" && fields.size() % 2 == 0)
+      {
+        const long num_joints = static_cast<long>(fields.size() - 2) / 2;
+        RecordedJointState joint_state{ std::stod(fields[1]), Eigen::VectorXd(num_joints),
+                                        Eigen::VectorXd(num_joints) };
+        for (long i = 0; i < num_joints; ++i)
+        {
+          joint_state.positions[i] = std::stod(fields[2 + i]);
+          joint_state.velocities[i] = std::stod(fields[2 + num_joints + i]);
+        }
+        recording.joint_states.push_back(std::move(joint_state));
+      }
+      else
+      {
+        throw std::invalid_argument("unknown line");
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    RCLCPP_ERROR(getLogger(), "Could not parse line %zu of recording '%s': %s", line_number, file_path.c_str(),
+                 e.what());
+    return std::nullopt;
+  }
+
+  const auto by_time = [](const auto& a, const auto& b) { return a.time < b.time; };
+  if (!std::is_sorted(recording.commands.begin(), recording.commands.end(), by_time) ||
+      !std::is_sorted(recording.joint_states.begin(), recording.joint_states.end(), by_time))
+  {
+    RCLCPP_ERROR(getLogger(), "The samples of recording '%s' are not ordered by time.", file_path.c_str());
+    return std::nullopt;
+  }
+  return recording;
+}
+
+bool saveRecording(const ServoRecording& recording, const std::string& file_path)
+{
+  std::ofstream file(file_path);
+  if (!file)
+  {
+    RCLCPP_ERROR(getLogger(), "Could not open '%s' to save the recording.", file_path.c_str());
+    return false;
+  }
+  // Write enough digits to read back the same values.
+  file.precision(std::numeric_limits<double>::max_digits10);
+
+  file << "command_type," << static_cast<int>(recording.command_type) << '\n';
+  for (const auto& [time, command] : recording.commands)
+  {
+    file << "command," << time;
+    if (const auto joint_jog = std::get_if<JointJogCommand>(&command))
+    {
+      file << ',';
+      for (std::size_t i = 0; i < joint_jog->names.size(); ++i)
+      {
+        file << ',' << joint_jog->names[i] << ',' << joint_jog->velocities[i];
+      }
+    }
+    else if (const auto twist = std::get_if<TwistCommand>(&command))
+    {
+      file << ',' << twist->frame_id;
+      writeValues(file, twist->velocities);
+    }
+    else if (const auto pose = std::get_if<PoseCommand>(&command))
+    {
+      const Eigen::Quaterniond orientation(pose->pose.rotation());
+      file << ',' << pose->frame_id;
+      writeValues(file, pose->pose.translation());
+      writeValues(file, orientation.coeffs());  // x, y, z, w
+    }
+    file << '\n';
+  }
+  for (const auto& joint_state : recording.joint_states)
+  {
+    file << "joint_state," << joint_state.time;
+    writeValues(file, joint_state.positions);
+    writeValues(file, joint_state.velocities);
+    file << '\n';
+  }
+  return static_cast<bool>(file);
+}
+
+}  // namespace moveit_servo
@@ -277,9 +277,20 @@ JointDeltaResult jointDeltaFromPose(const PoseCommand& command, const moveit::co
   cartesian_position_delta.head<3>() = translation_error;
   cartesian_position_delta.tail<3>() = angle_axis_error.axis() * angle_axis_error.angle();
 
-  // Compute the required change in joint angles.
-  const auto delta_result =
-      jointDeltaFromIK(cartesian_position_delta, robot_state, servo_params, joint_name_group_index_map);
+  // Compute the required change in joint angles, directly from the next pose if an analytic solution is wanted.
+  JointDeltaResult delta_result = std::make_pair(StatusCode::INVALID, joint_position_delta);
+  if (servo_params.pose_tracking.use_analytic_ik)
+  {
+    Eigen::Isometry3d next_pose = Eigen::Isometry3d::Identity();
+    next_pose.translation() = ee_pose.translation() + translation_error;
+    next_pose.linear() = q_target.toRotationMatrix();
+    delta_result = jointDeltaFromAnalyticIK(next_pose, robot_state, servo_params, planning_frame, ee_frame,
+                                            joint_name_group_index_map);
+  }
+  if (delta_result.first == StatusCode::INVALID)
+  {
+    delta_result = jointDeltaFromIK(cartesian_position_delta, robot_state, servo_params, joint_name_group_index_map);
+  }
   status = delta_result.first;
   if (status != StatusCode::INVALID)
   {
@@ -298,6 +309,102 @@ JointDeltaResult jointDeltaFromPose(const PoseCommand& command, const moveit::co
   return std::make_pair(status, joint_position_delta);
 }
 
+JointDeltaResult jointDeltaFromAnalyticIK(const Eigen::Isometry3d& target_pose,
+                                          const moveit::core::RobotStatePtr& robot_state,
+                                          const servo::Params& servo_params, const std::string& planning_frame,
+                                          const std::string& ee_frame,
+                                          const JointNameToMoveGroupIndexMap& joint_name_group_index_map)
+{
+  const auto& group_name =
+      servo_params.active_subgroup.empty() ? servo_params.move_group_name : servo_params.active_subgroup;
+  const moveit::core::JointModelGroup* joint_model_group = robot_state->getJointModelGroup(group_name);
+
+  std::vector<double> current_joint_positions;
+  robot_state->copyJointGroupPositions(joint_model_group, current_joint_positions);
+  Eigen::VectorXd delta_theta = Eigen::VectorXd::Zero(current_joint_positions.size());
+
+  const kinematics::KinematicsBaseConstPtr ik_solver = joint_model_group->getSolverInstance();
+  if (!ik_solver || !ik_solver->supportsGroup(joint_model_group))
+  {
+    return std::make_pair(StatusCode::INVALID, delta_theta);
+  }
+
+  // The solver expects the pose of its tip frame, which may be offset from the end effector frame, in its base frame.
+  const Eigen::Isometry3d& base_frame_transform = robot_state->getGlobalLinkTransform(ik_solver->getBaseFrame());
+  const Eigen::Isometry3d& ee_frame_transform = robot_state->getGlobalLinkTransform(ee_frame);
+  const Eigen::Isometry3d target_tip_transform = robot_state->getGlobalLinkTransform(planning_frame) * target_pose *
+                                                 ee_frame_transform.inverse() *
+                                                 robot_state->getGlobalLinkTransform(ik_solver->getTipFrame());
+  const geometry_msgs::msg::Pose ik_pose = tf2::toMsg(base_frame_transform.inverse() * target_tip_transform);
+
+  // The solver may order the joints differently than the group, so the seed and the solutions are mapped through the
+  // solver joint bijection: solver joint i is group variable ik_joint_bijection[i].
+  const std::vector<unsigned int>& ik_joint_bijection = joint_model_group->getKinematicsSolverJointBijection();
+  if (ik_joint_bijection.size() != current_joint_positions.size())
+  {
+    return std::make_pair(StatusCode::INVALID, delta_theta);
+  }
+  std::vector<double> ik_seed_state(ik_joint_bijection.size());
+  for (size_t i = 0; i < ik_joint_bijection.size(); ++i)
+  {
+    ik_seed_state[i] = current_joint_positions[ik_joint_bijection[i]];
+  }
+
+  std::vector<std::vector<double>> solutions;
+  kinematics::KinematicsResult result;
+  if (!ik_solver->getPositionIK({ ik_pose }, ik_seed_state, solutions, result, kinematics::KinematicsQueryOptions()) ||
+      solutions.empty())
+  {
+    RCLCPP_DEBUG_STREAM(getLogger(), "No analytic IK solution for the next pose, got error " << result.kinematic_error);
+    return std::make_pair(StatusCode::INVALID, delta_theta);
+  }
+
+  // Move toward the solution closest to the current state. Continuous joints take the shorter way around.
+  const moveit::core::RobotModel& robot_model = *joint_model_group->getParentModel();
+  const std::vector<std::string>& variable_names = joint_model_group->getVariableNames();
+  double min_distance = std::numeric_limits<double>::max();
+  for (const auto& solution : solutions)
+  {
+    if (solution.size() != current_joint_positions.size())
+    {
+      continue;
+    }
+    Eigen::VectorXd solution_delta(solution.size());
+    for (size_t i = 0; i < solution.size(); ++i)
+    {
+      const unsigned int variable_index = ik_joint_bijection[i];
+      solution_delta[variable_index] = solution[i] - current_joint_positions[variable_index];
+    }
+    for (size_t i = 0; i < variable_names.size(); ++i)
+    {
+      const moveit::core::JointModel* joint_model = robot_model.getJointOfVariable(variable_names[i]);
+      if (joint_model->getType() == moveit::core::JointModel::REVOLUTE &&
+          static_cast<const moveit::core::RevoluteJointModel*>(joint_model)->isContinuous())
+      {
+        solution_delta[i] = std::remainder(solution_delta[i], 2.0 * M_PI);
+      }
+    }
+    const double distance = solution_delta.squaredNorm();
+    if (distance < min_distance)
+    {
+      min_distance = distance;
+      delta_theta = solution_delta;
+    }
+  }
+  if (min_distance == std::numeric_limits<double>::max())
+  {
+    return std::make_pair(StatusCode::INVALID, delta_theta);
+  }
+
+  if (!servo_params.active_subgroup.empty() && servo_params.active_subgroup != servo_params.move_group_name)
+  {
+    return std::make_pair(StatusCode::NO_WARNING,
+                          createMoveGroupDelta(delta_theta, robot_state, servo_params, joint_name_group_index_map));
+  }
+
+  return std::make_pair(StatusCode::NO_WARNING, delta_theta);
+}
+
 JointDeltaResult jointDeltaFromIK(const Eigen::VectorXd& cartesian_position_delta,
                                   const moveit::core::RobotStatePtr& robot_state, const servo::Params& servo_params,
                                   const JointNameToMoveGroupIndexMap& joint_name_group_index_map)
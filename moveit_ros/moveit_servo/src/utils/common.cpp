@@ -150,54 +150,54 @@ geometry_msgs::msg::Pose poseFromCartesianDelta(const Eigen::VectorXd& delta_x,
 std::optional<trajectory_msgs::msg::JointTrajectory>
 composeTrajectoryMessage(const servo::Params& servo_params, const std::deque<KinematicState>& joint_cmd_rolling_window)
 {
-  if (joint_cmd_rolling_window.size() < MIN_POINTS_FOR_TRAJ_MSG)
+  trajectory_msgs::msg::JointTrajectory joint_trajectory;
+  if (!composeTrajectoryMessage(servo_params, joint_cmd_rolling_window, joint_trajectory))
   {
     return {};
   }
+  return joint_trajectory;
+}
 
-  trajectory_msgs::msg::JointTrajectory joint_trajectory;
+bool composeTrajectoryMessage(const servo::Params& servo_params,
+                              const std::deque<KinematicState>& joint_cmd_rolling_window,
+                              trajectory_msgs::msg::JointTrajectory& joint_trajectory)
+{
+  if (joint_cmd_rolling_window.size() < MIN_POINTS_FOR_TRAJ_MSG)
+  {
+    return false;
+  }
 
-  joint_trajectory.joint_names = joint_cmd_rolling_window.front().joint_names;
-  joint_trajectory.points.reserve(joint_cmd_rolling_window.size() + 1);
+  // The joint names rarely change, so only copy them when they do.
+  if (joint_trajectory.joint_names != joint_cmd_rolling_window.front().joint_names)
+  {
+    joint_trajectory.joint_names = joint_cmd_rolling_window.front().joint_names;
+  }
   joint_trajectory.header.stamp = joint_cmd_rolling_window.front().time_stamp;
 
-  auto add_point = [servo_params](trajectory_msgs::msg::JointTrajectory& joint_trajectory, const KinematicState& state) {
-    trajectory_msgs::msg::JointTrajectoryPoint point;
-    size_t num_joints = state.positions.size();
-    point.positions.reserve(num_joints);
-    point.velocities.reserve(num_joints);
-    point.accelerations.reserve(num_joints);
-    if (servo_params.publish_joint_positions)
+  // Overwrite the points in place, so that their vectors keep the capacity from the previous message.
+  auto assign = [](std::vector<double>& values, const Eigen::VectorXd& state_values, bool publish) {
+    if (publish)
     {
-      for (const auto& pos : state.positions)
-      {
-        point.positions.emplace_back(pos);
-      }
+      values.assign(state_values.data(), state_values.data() + state_values.size());
     }
-    if (servo_params.publish_joint_velocities)
+    else
     {
-      for (const auto& vel : state.velocities)
-      {
-        point.velocities.emplace_back(vel);
-      }
-    }
-    if (servo_params.publish_joint_accelerations)
-    {
-      for (const auto& acc : state.accelerations)
-      {
-        point.accelerations.emplace_back(acc);
-      }
+      values.clear();
     }
-    point.time_from_start = state.time_stamp - joint_trajectory.header.stamp;
-    joint_trajectory.points.emplace_back(point);
   };
 
-  for (size_t i = 0; i < joint_cmd_rolling_window.size() - 1; ++i)
+  joint_trajectory.points.resize(joint_cmd_rolling_window.size() - 1);
+  for (size_t i = 0; i < joint_trajectory.points.size(); ++i)
   {
-    add_point(joint_trajectory, joint_cmd_rolling_window[i]);
+    const KinematicState& state = joint_cmd_rolling_window[i];
+    trajectory_msgs::msg::JointTrajectoryPoint& point = joint_trajectory.points[i];
+    assign(point.positions, state.positions, servo_params.publish_joint_positions);
+    assign(point.velocities, state.velocities, servo_params.publish_joint_velocities);
+    assign(point.accelerations, state.accelerations, servo_params.publish_joint_accelerations);
+    point.time_from_start = state.time_stamp - joint_trajectory.header.stamp;
   }
 
-  return joint_trajectory;
+  return true;
 }
 
 void updateSlidingWindow(KinematicState& next_joint_state, std::deque<KinematicState>& joint_cmd_rolling_window,
@@ -259,6 +259,13 @@ std_msgs::msg::Float64MultiArray composeMultiArrayMessage(const servo::Params& s
                                                           const KinematicState& joint_state)
 {
   std_msgs::msg::Float64MultiArray multi_array;
+  composeMultiArrayMessage(servo_params, joint_state, multi_array);
+  return multi_array;
+}
+
+void composeMultiArrayMessage(const servo::Params& servo_params, const KinematicState& joint_state,
+                              std_msgs::msg::Float64MultiArray& multi_array)
+{
   const size_t num_joints = joint_state.joint_names.size();
   multi_array.data.resize(num_joints);
   if (servo_params.publish_joint_positions)
@@ -275,8 +282,10 @@ std_msgs::msg::Float64MultiArray composeMultiArrayMessage(const servo::Params& s
       multi_array.data[i] = joint_state.velocities[i];
     }
   }
-
-  return multi_array;
+  else
+  {
+    std::fill(multi_array.data.begin(), multi_array.data.end(), 0.0);
+  }
 }
 
 std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::core::RobotStatePtr& robot_state,
@@ -286,8 +295,10 @@ std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::
   // We need to send information back about if we are halting, moving away or towards the singularity.
   StatusCode servo_status = StatusCode::NO_WARNING;
 
-  const moveit::core::JointModelGroup* joint_model_group =
-      robot_state->getJointModelGroup(servo_params.move_group_name);
+  // The Cartesian delta is for the tip of the active subgroup, so its Jacobian is the relevant one.
+  const auto& group_name =
+      servo_params.active_subgroup.empty() ? servo_params.move_group_name : servo_params.active_subgroup;
+  const moveit::core::JointModelGroup* joint_model_group = robot_state->getJointModelGroup(group_name);
 
   // Get the thresholds.
   const double lower_singularity_threshold = servo_params.lower_singularity_threshold;
@@ -319,14 +330,15 @@ std::pair<double, StatusCode> velocityScalingFactorForSingularity(const moveit::
   const Eigen::VectorXd delta_x = vector_towards_singularity * servo_params.singularity_step_scale;
 
   // Compute the new joint angles if we take the small step delta_x
-  Eigen::VectorXd next_joint_angles;
-  robot_state->copyJointGroupPositions(joint_model_group, next_joint_angles);
-  next_joint_angles += pseudo_inverse * delta_x;
+  Eigen::VectorXd current_joint_angles;
+  robot_state->copyJointGroupPositions(joint_model_group, current_joint_angles);
+  const Eigen::VectorXd next_joint_angles = current_joint_angles + pseudo_inverse * delta_x;
 
-  // Compute the Jacobian SVD for the new robot state.
+  // Compute the Jacobian SVD for the new robot state, then restore the state for the commands of other subgroups.
   robot_state->setJointGroupPositions(joint_model_group, next_joint_angles);
   const Eigen::JacobiSVD<Eigen::MatrixXd> next_svd = Eigen::JacobiSVD<Eigen::MatrixXd>(
       robot_state->getJacobian(joint_model_group), Eigen::ComputeThinU | Eigen::ComputeThinV);
+  robot_state->setJointGroupPositions(joint_model_group, current_joint_angles);
 
   // Compute condition number for the new Jacobian.
   const double next_condition_number = next_svd.singularValues()(0) / next_svd.singularValues()(dims - 1);
@@ -489,7 +501,16 @@ planning_scene_monitor::PlanningSceneMonitorPtr createPlanningSceneMonitor(const
       node, robot_description_name, "planning_scene_monitor");
 
   planning_scene_monitor->startStateMonitor(servo_params.joint_topic);
-  planning_scene_monitor->startSceneMonitor(servo_params.monitored_planning_scene_topic);
+  const bool use_shared_scene =
+      !servo_params.is_primary_planning_scene_monitor && !servo_params.shared_planning_scene_segment.empty();
+  if (use_shared_scene)
+  {
+    planning_scene_monitor->startSharedSceneMonitor(servo_params.shared_planning_scene_segment);
+  }
+  else
+  {
+    planning_scene_monitor->startSceneMonitor(servo_params.monitored_planning_scene_topic);
+  }
   planning_scene_monitor->startWorldGeometryMonitor(
       planning_scene_monitor::PlanningSceneMonitor::DEFAULT_COLLISION_OBJECT_TOPIC,
       planning_scene_monitor::PlanningSceneMonitor::DEFAULT_PLANNING_SCENE_WORLD_TOPIC,
@@ -499,7 +520,7 @@ planning_scene_monitor::PlanningSceneMonitorPtr createPlanningSceneMonitor(const
   {
     planning_scene_monitor->providePlanningSceneService();
   }
-  else
+  else if (!use_shared_scene)
   {
     planning_scene_monitor->requestPlanningSceneState();
   }
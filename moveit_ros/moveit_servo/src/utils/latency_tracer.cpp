@@ -0,0 +1,166 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : latency_tracer.cpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ */
+
+#include <moveit_servo/utils/latency_tracer.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace moveit_servo
+{
+namespace
+{
+// Nearest-rank percentile of unsorted values, reorders the values.
+double percentile(std::vector<int64_t>& values, double fraction)
+{
+  const auto rank = static_cast<std::size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank] * 1E-9;
+}
+
+LatencyStatistics statisticsBetween(const std::vector<CycleTrace>& traces, LatencyStage from, LatencyStage to)
+{
+  LatencyStatistics statistics{ from, to };
+  std::vector<int64_t> latencies;
+  latencies.reserve(traces.size());
+  for (const auto& trace : traces)
+  {
+    if (trace.stamp(from) != 0 && trace.stamp(to) != 0)
+    {
+      latencies.push_back(trace.stamp(to) - trace.stamp(from));
+    }
+  }
+
+  statistics.samples = latencies.size();
+  if (!latencies.empty())
+  {
+    statistics.max = *std::max_element(latencies.begin(), latencies.end()) * 1E-9;
+    statistics.p99 = percentile(latencies, 0.99);
+    statistics.p50 = percentile(latencies, 0.5);
+  }
+  return statistics;
+}
+}  // namespace
+
+LatencyTracer::LatencyTracer(std::size_t capacity)
+  : capacity_(capacity), slots_(std::make_unique<Slot[]>(capacity)), started_count_(0), recorded_count_(0)
+{
+  if (capacity == 0)
+  {
+    throw std::invalid_argument("The capacity of a LatencyTracer must be greater than 0");
+  }
+}
+
+void LatencyTracer::record(const CycleTrace& trace)
+{
+  const uint64_t index = recorded_count_.load(std::memory_order_relaxed);
+  // Announce the write before touching the slot, readers drop the trace that was stored in it before.
+  started_count_.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Slot& slot = slots_[index % capacity_];
+  for (std::size_t stage = 0; stage < LATENCY_STAGE_COUNT; ++stage)
+  {
+    slot[stage].store(trace.stamps[stage], std::memory_order_relaxed);
+  }
+  recorded_count_.store(index + 1, std::memory_order_release);
+}
+
+std::vector<CycleTrace> LatencyTracer::snapshot() const
+{
+  const uint64_t end = recorded_count_.load(std::memory_order_acquire);
+  const uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+  std::vector<CycleTrace> traces(end - begin);
+  for (uint64_t index = begin; index < end; ++index)
+  {
+    const Slot& slot = slots_[index % capacity_];
+    for (std::size_t stage = 0; stage < LATENCY_STAGE_COUNT; ++stage)
+    {
+      traces[index - begin].stamps[stage] = slot[stage].load(std::memory_order_relaxed);
+    }
+  }
+
+  // Drop the traces whose slots the writer has started to overwrite in the meantime.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t started = started_count_.load(std::memory_order_relaxed);
+  const uint64_t first_valid = started > capacity_ ? started - capacity_ : 0;
+  if (first_valid > begin)
+  {
+    traces.erase(traces.begin(), traces.begin() + std::min(first_valid - begin, end - begin));
+  }
+  return traces;
+}
+
+std::vector<LatencyStatistics> LatencyTracer::computeStatistics(const std::vector<CycleTrace>& traces)
+{
+  std::vector<LatencyStatistics> statistics;
+  for (std::size_t stage = 1; stage < LATENCY_STAGE_COUNT; ++stage)
+  {
+    statistics.push_back(
+        statisticsBetween(traces, static_cast<LatencyStage>(stage - 1), static_cast<LatencyStage>(stage)));
+  }
+  statistics.push_back(statisticsBetween(traces, LatencyStage::COMMAND_RECEIVED, LatencyStage::PUBLISHED));
+  return statistics;
+}
+
+bool LatencyTracer::dump(const std::string& file_path) const
+{
+  std::ofstream file(file_path);
+  if (!file)
+  {
+    return false;
+  }
+
+  for (std::size_t stage = 0; stage < LATENCY_STAGE_COUNT; ++stage)
+  {
+    file << LATENCY_STAGE_NAMES[stage] << (stage + 1 < LATENCY_STAGE_COUNT ? "," : "\n");
+  }
+  for (const auto& trace : snapshot())
+  {
+    for (std::size_t stage = 0; stage < LATENCY_STAGE_COUNT; ++stage)
+    {
+      file << trace.stamps[stage] << (stage + 1 < LATENCY_STAGE_COUNT ? "," : "\n");
+    }
+  }
+  return static_cast<bool>(file);
+}
+
+}  // namespace moveit_servo
@@ -0,0 +1,163 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : collision_monitor_benchmark.cpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : Measures how long collision checks wait for the planning scene lock, and how much the duration of
+ *                    a check varies, while the planning scene monitor is busy with robot state updates. The collision
+ *                    monitor checks the snapshot its update callback hands over, without taking the scene lock. For
+ *                    comparison, the other benchmark first takes a snapshot under the scene lock, as it did before.
+ *                    To run this benchmark, 'cd' to the build/moveit_servo directory and directly run the binary.
+ */
+
+#include "pr2_servo.hpp"
+#include <moveit/planning_scene_monitor/planning_scene_snapshot_provider.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+// Updates the robot state of the monitored scene under the scene write lock, as the state monitor does, but more often
+class BusySceneMonitor
+{
+public:
+  BusySceneMonitor(const planning_scene_monitor::PlanningSceneMonitorPtr& planning_scene_monitor)
+    : thread_([this, planning_scene_monitor] {
+      double position = 0.0;
+      while (running_)
+      {
+        {
+          planning_scene_monitor::LockedPlanningSceneRW locked_scene(planning_scene_monitor);
+          position = position > 0.1 ? 0.0 : position + 1e-3;
+          locked_scene->getCurrentStateNonConst().setVariablePosition("r_shoulder_pan_joint", position);
+          locked_scene->getCurrentStateNonConst().update();
+        }
+        planning_scene_monitor->triggerSceneUpdateEvent(planning_scene_monitor::PlanningSceneMonitor::UPDATE_STATE);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+      }
+    })
+  {
+  }
+
+  ~BusySceneMonitor()
+  {
+    running_ = false;
+    thread_.join();
+  }
+
+private:
+  std::atomic<bool> running_{ true };
+  std::thread thread_;
+};
+
+double toMicroseconds(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+// Report the mean, the standard deviation, the 99th percentile and the maximum of the durations in microseconds
+void reportDurations(benchmark::State& st, const std::string& name, std::vector<double>& durations)
+{
+  if (durations.empty())
+    return;
+  std::sort(durations.begin(), durations.end());
+  const double mean = std::accumulate(durations.begin(), durations.end(), 0.0) / durations.size();
+  double variance = 0.0;
+  for (double duration : durations)
+    variance += (duration - mean) * (duration - mean) / durations.size();
+  st.counters[name + "_mean_us"] = mean;
+  st.counters[name + "_stddev_us"] = std::sqrt(variance);
+  st.counters[name + "_p99_us"] = durations[durations.size() * 99 / 100];
+  st.counters[name + "_max_us"] = durations.back();
+}
+}  // namespace
+
+// Before: a snapshot of the scene was taken under the scene lock for every check, as state updates changed the scene.
+// The lock wait includes the diff of the scene and the copy of the state made under the lock.
+static void checkWithSceneLock(benchmark::State& st)
+{
+  pr2_servo::Pr2Servo pr2("right_arm");
+  pr2.servo().setCollisionChecking(false);
+  planning_scene_monitor::PlanningSceneSnapshotProvider scene_snapshots(pr2.planningSceneMonitor());
+  BusySceneMonitor busy_scene_monitor(pr2.planningSceneMonitor());
+  std::vector<double> lock_waits;
+  std::vector<double> cycles;
+
+  for (auto _ : st)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    benchmark::DoNotOptimize(scene_snapshots.getSnapshot());
+    const auto snapshot_taken = std::chrono::steady_clock::now();
+    pr2.servo().checkCollisionsOnce();
+    const auto end = std::chrono::steady_clock::now();
+    lock_waits.push_back(toMicroseconds(snapshot_taken - start));
+    cycles.push_back(toMicroseconds(end - start));
+  }
+  reportDurations(st, "lock_wait", lock_waits);
+  reportDurations(st, "cycle", cycles);
+}
+
+// After: the check takes the snapshot handed over by the update callback, so it never waits for the scene lock.
+static void checkWithHandedOverSnapshot(benchmark::State& st)
+{
+  pr2_servo::Pr2Servo pr2("right_arm");
+  pr2.servo().setCollisionChecking(false);
+  BusySceneMonitor busy_scene_monitor(pr2.planningSceneMonitor());
+  std::vector<double> cycles;
+
+  for (auto _ : st)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    pr2.servo().checkCollisionsOnce();
+    cycles.push_back(toMicroseconds(std::chrono::steady_clock::now() - start));
+  }
+  reportDurations(st, "cycle", cycles);
+}
+
+BENCHMARK(checkWithSceneLock)->Unit(benchmark::kMicrosecond);
+BENCHMARK(checkWithHandedOverSnapshot)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  rclcpp::shutdown();
+  return 0;
+}
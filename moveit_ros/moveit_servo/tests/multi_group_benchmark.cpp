@@ -0,0 +1,110 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : multi_group_benchmark.cpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : Compares servoing both arms of the PR2 with a Servo instance per arm against a single Servo
+ *                    instance for the two-arm move group, which takes a command per arm and shares the state update
+ *                    and the collision query between the arms. The arms are jogged, since the PR2 model is loaded
+ *                    without kinematics solvers.
+ *                    To run this benchmark, 'cd' to the build/moveit_servo directory and directly run the binary.
+ */
+
+#include "pr2_servo.hpp"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const moveit_servo::JointJogCommand LEFT_ARM_JOG{ { "l_shoulder_pan_joint", "l_elbow_flex_joint" }, { 0.1, -0.1 } };
+const moveit_servo::JointJogCommand RIGHT_ARM_JOG{ { "r_shoulder_pan_joint", "r_elbow_flex_joint" }, { -0.1, -0.1 } };
+
+// Collisions are checked once per cycle by the benchmark instead of at the rate of the collision monitor.
+void prepare(pr2_servo::Pr2Servo& pr2)
+{
+  pr2.servo().setCollisionChecking(false);
+  pr2.servo().setCommandType(moveit_servo::CommandType::JOINT_JOG);
+}
+}  // namespace
+
+// One servo cycle per arm: each arm has its own Servo, which computes its next state and runs its own collision query.
+static void separateArmServos(benchmark::State& st)
+{
+  pr2_servo::Pr2Servo left_arm("left_arm");
+  pr2_servo::Pr2Servo right_arm("right_arm");
+  prepare(left_arm);
+  prepare(right_arm);
+  const auto robot_state = left_arm.getCurrentState();
+
+  for (auto _ : st)
+  {
+    const moveit_servo::KinematicState left_state = left_arm.servo().getNextJointState(robot_state, LEFT_ARM_JOG);
+    left_arm.servo().checkCollisionsOnce(left_state);
+    const moveit_servo::KinematicState right_state = right_arm.servo().getNextJointState(robot_state, RIGHT_ARM_JOG);
+    right_arm.servo().checkCollisionsOnce(right_state);
+    benchmark::DoNotOptimize(left_state.positions.data());
+    benchmark::DoNotOptimize(right_state.positions.data());
+  }
+}
+
+// A single servo cycle for the two-arm move group: a delta per arm, one next state and one collision query that
+// includes the checks between the arms.
+static void combinedArmServo(benchmark::State& st)
+{
+  pr2_servo::Pr2Servo arms("arms");
+  prepare(arms);
+  const auto robot_state = arms.getCurrentState();
+  const moveit_servo::MultiGroupInput commands{ { "left_arm", LEFT_ARM_JOG }, { "right_arm", RIGHT_ARM_JOG } };
+
+  for (auto _ : st)
+  {
+    const moveit_servo::KinematicState next_state = arms.servo().getNextJointState(robot_state, commands);
+    arms.servo().checkCollisionsOnce(next_state);
+    benchmark::DoNotOptimize(next_state.positions.data());
+  }
+}
+
+BENCHMARK(separateArmServos);
+BENCHMARK(combinedArmServo);
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,203 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : planar_arm_analytic_ik.hpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : A three joint planar arm with a closed-form IK solver that reports both elbow solutions, like
+ *                    an IKFast plugin does. Used by the pose tracking tests and benchmark.
+ */
+
+#pragma once
+
+#include <moveit/kinematics_base/kinematics_base.hpp>
+#include <moveit/robot_model/robot_model.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <cmath>
+
+namespace planar_arm_analytic_ik
+{
+const std::string GROUP_NAME = "arm";
+const std::string BASE_FRAME = "a";
+const std::string TIP_FRAME = "d";
+
+/** \brief Planar arm a->b->c->d of three continuous joints about z, with unit distances between the joints. */
+inline moveit::core::RobotModelPtr createPlanarArmModel()
+{
+  geometry_msgs::msg::Pose origin;
+  origin.orientation.w = 1.0;
+  geometry_msgs::msg::Pose unit_offset = origin;
+  unit_offset.position.x = 1.0;
+
+  moveit::core::RobotModelBuilder builder("planar_arm", BASE_FRAME);
+  builder.addChain("a->b->c->d", "continuous", { origin, unit_offset, unit_offset }, urdf::Vector3(0.0, 0.0, 1.0));
+  builder.addGroupChain(BASE_FRAME, TIP_FRAME, GROUP_NAME);
+  return builder.build();
+}
+
+/** \brief Closed-form IK for the arm of createPlanarArmModel().
+
+    The single solution queries keep the elbow configuration of the seed, the multiple solution query returns both
+    elbow configurations. Out of plane components of the requested pose are ignored. */
+class PlanarArmKinematics : public kinematics::KinematicsBase
+{
+public:
+  PlanarArmKinematics(const moveit::core::JointModelGroup& group)
+    : joint_names_(group.getActiveJointModelNames()), link_names_(group.getLinkModelNames())
+  {
+    storeValues(group.getParentModel(), group.getName(), BASE_FRAME, { TIP_FRAME }, 0.0);
+  }
+
+  /// Install a PlanarArmKinematics instance as the IK solver of group
+  static void attach(moveit::core::JointModelGroup* group)
+  {
+    auto solver = std::make_shared<PlanarArmKinematics>(*group);
+    group->setSolverAllocators([solver](const moveit::core::JointModelGroup*) { return solver; },
+                               moveit::core::SolverAllocatorMapFn());
+  }
+
+  bool getPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                     std::vector<double>& solution, moveit_msgs::msg::MoveItErrorCodes& error_code,
+                     const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool getPositionIK(const std::vector<geometry_msgs::msg::Pose>& ik_poses, const std::vector<double>& ik_seed_state,
+                     std::vector<std::vector<double>>& solutions, kinematics::KinematicsResult& result,
+                     const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    solutions.clear();
+    moveit_msgs::msg::MoveItErrorCodes error_code;
+    std::vector<double> solution;
+    for (const double elbow_sign : { 1.0, -1.0 })
+    {
+      if (ik_poses.size() == 1 && solve(ik_poses.front(), ik_seed_state, solution, error_code, elbow_sign))
+      {
+        solutions.push_back(solution);
+      }
+    }
+    result.kinematic_error =
+        solutions.empty() ? kinematics::KinematicErrors::NO_SOLUTION : kinematics::KinematicErrors::OK;
+    result.solution_percentage = solutions.empty() ? 0.0 : 1.0;
+    return !solutions.empty();
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, std::vector<double>& solution,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, const std::vector<double>& /*consistency_limits*/,
+                        std::vector<double>& solution, moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, std::vector<double>& solution, const IKCallbackFn& /*solution_callback*/,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, const std::vector<double>& /*consistency_limits*/,
+                        std::vector<double>& solution, const IKCallbackFn& /*solution_callback*/,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool getPositionFK(const std::vector<std::string>& /*link_names*/, const std::vector<double>& /*joint_angles*/,
+                     std::vector<geometry_msgs::msg::Pose>& /*poses*/) const override
+  {
+    return false;
+  }
+
+  const std::vector<std::string>& getJointNames() const override
+  {
+    return joint_names_;
+  }
+
+  const std::vector<std::string>& getLinkNames() const override
+  {
+    return link_names_;
+  }
+
+private:
+  // Solve for the given elbow configuration, or for the one of the seed if elbow_sign is zero.
+  bool solve(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& seed, std::vector<double>& solution,
+             moveit_msgs::msg::MoveItErrorCodes& error_code, double elbow_sign = 0.0) const
+  {
+    const double x = ik_pose.position.x;
+    const double y = ik_pose.position.y;
+    const double theta = 2.0 * std::atan2(ik_pose.orientation.z, ik_pose.orientation.w);
+    const double cos_elbow = (x * x + y * y - 2.0) / 2.0;
+    if (std::abs(cos_elbow) > 1.0)
+    {
+      error_code.val = moveit_msgs::msg::MoveItErrorCodes::NO_IK_SOLUTION;
+      return false;
+    }
+
+    if (elbow_sign == 0.0)
+    {
+      elbow_sign = std::sin(seed[1]) < 0.0 ? -1.0 : 1.0;
+    }
+    const double elbow = elbow_sign * std::acos(cos_elbow);
+    const double shoulder = std::atan2(y, x) - std::atan2(std::sin(elbow), 1.0 + std::cos(elbow));
+    solution = { shoulder, elbow, theta - shoulder - elbow };
+    // Use the representation of each continuous joint that is closest to the seed.
+    for (std::size_t i = 0; i < solution.size(); ++i)
+    {
+      solution[i] = seed[i] + std::remainder(solution[i] - seed[i], 2.0 * M_PI);
+    }
+
+    error_code.val = moveit_msgs::msg::MoveItErrorCodes::SUCCESS;
+    return true;
+  }
+
+  std::vector<std::string> joint_names_;
+  std::vector<std::string> link_names_;
+};
+}  // namespace planar_arm_analytic_ik
@@ -0,0 +1,166 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+
+/*      Title       : pose_tracking_benchmark.cpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : Compares tracking a moving pose target by moving toward the closest analytic IK solution against
+ *                    the Jacobian pseudo-inverse, on a planar arm with a closed-form solver and on the six joint Fanuc
+ *                    arm with a solver that orders the joints differently than the group. Reports the cycle time
+ *                    and the mean position error left after each cycle.
+ *                    To run this benchmark, 'cd' to the build/moveit_servo directory and directly run the binary.
+ */
+
+#include "planar_arm_analytic_ik.hpp"
+#include "reversed_order_kinematics.hpp"
+#include <benchmark/benchmark.h>
+#include <moveit_servo/utils/command.hpp>
+#include <functional>
+
+namespace
+{
+constexpr double PUBLISH_PERIOD = 0.01;  // s
+constexpr double ANGULAR_SPEED = 1.0;    // rad/s, both along the circle and of the end effector itself
+
+struct TrackedArm
+{
+  moveit::core::RobotModelPtr robot_model;
+  std::string group_name;
+  std::string base_frame;
+  std::string tip_frame;
+  std::vector<double> start_positions;
+  double radius;  // m, of the circle the tip is moved along
+  std::function<void(moveit::core::JointModelGroup*)> attach_analytic_ik;
+};
+
+TrackedArm planarArm()
+{
+  using namespace planar_arm_analytic_ik;
+  return { createPlanarArmModel(), GROUP_NAME, BASE_FRAME, TIP_FRAME, { 0.3, -1.2, 0.5 }, 0.3,
+           &PlanarArmKinematics::attach };
+}
+
+TrackedArm sixJointArm()
+{
+  using namespace reversed_order_kinematics;
+  return { moveit::core::loadTestingRobotModel(ROBOT_NAME), GROUP_NAME, BASE_FRAME, TIP_FRAME,
+           { 0.2, 0.3, -0.2, 0.4, -0.5, 0.6 }, 0.1, &ReversedOrderKinematics::attach };
+}
+
+// Servo the tip of the arm along a circle, one cycle per benchmark iteration.
+void trackCircle(benchmark::State& st, const TrackedArm& arm, bool use_analytic_ik)
+{
+  moveit::core::JointModelGroup* joint_model_group = arm.robot_model->getJointModelGroup(arm.group_name);
+  if (use_analytic_ik)
+  {
+    arm.attach_analytic_ik(joint_model_group);
+  }
+  const auto robot_state = std::make_shared<moveit::core::RobotState>(arm.robot_model);
+  robot_state->setJointGroupPositions(joint_model_group, arm.start_positions);
+  robot_state->update();
+
+  servo::Params servo_params;
+  servo_params.move_group_name = arm.group_name;
+
+  const Eigen::Isometry3d start_pose = robot_state->getGlobalLinkTransform(arm.tip_frame);
+  const Eigen::Vector3d center = start_pose.translation() - Eigen::Vector3d(arm.radius, 0.0, 0.0);
+  Eigen::VectorXd joint_positions;
+  double total_error = 0.0;
+  std::size_t step = 0;
+  for (auto _ : st)
+  {
+    const double phase = ANGULAR_SPEED * PUBLISH_PERIOD * ++step;
+    Eigen::Isometry3d target_pose = start_pose;
+    target_pose.translation() = center + arm.radius * Eigen::Vector3d(std::cos(phase), std::sin(phase), 0.0);
+    target_pose.rotate(Eigen::AngleAxisd(phase, Eigen::Vector3d::UnitZ()));
+
+    moveit_servo::JointDeltaResult delta;
+    if (use_analytic_ik)
+    {
+      delta = moveit_servo::jointDeltaFromAnalyticIK(target_pose, robot_state, servo_params, arm.base_frame,
+                                                     arm.tip_frame, {});
+    }
+    else
+    {
+      // Same Cartesian delta as jointDeltaFromPose() computes.
+      const Eigen::Isometry3d& ee_pose = robot_state->getGlobalLinkTransform(arm.tip_frame);
+      const Eigen::AngleAxisd rotation_error(target_pose.linear() * ee_pose.linear().transpose());
+      Eigen::Vector<double, 6> cartesian_delta;
+      cartesian_delta.head<3>() = target_pose.translation() - ee_pose.translation();
+      cartesian_delta.tail<3>() = rotation_error.axis() * rotation_error.angle();
+      delta = moveit_servo::jointDeltaFromIK(cartesian_delta, robot_state, servo_params, {});
+    }
+
+    robot_state->copyJointGroupPositions(joint_model_group, joint_positions);
+    robot_state->setJointGroupPositions(joint_model_group, joint_positions + delta.second);
+    robot_state->update();
+    total_error +=
+        (robot_state->getGlobalLinkTransform(arm.tip_frame).translation() - target_pose.translation()).norm();
+  }
+  st.counters["mean_position_error"] = total_error / step;
+}
+}  // namespace
+
+// Move toward the closest of the analytic IK solutions for the next pose.
+static void analyticIKPoseTracking(benchmark::State& st)
+{
+  trackCircle(st, planarArm(), true);
+}
+
+// First order step through the Jacobian pseudo-inverse, which Servo uses when the group has no IK solver.
+static void jacobianPoseTracking(benchmark::State& st)
+{
+  trackCircle(st, planarArm(), false);
+}
+
+// The same on a six joint arm, whose solver lists the joints from the tip to the base.
+static void analyticIKPoseTrackingSixJoints(benchmark::State& st)
+{
+  trackCircle(st, sixJointArm(), true);
+}
+
+static void jacobianPoseTrackingSixJoints(benchmark::State& st)
+{
+  trackCircle(st, sixJointArm(), false);
+}
+
+BENCHMARK(analyticIKPoseTracking);
+BENCHMARK(jacobianPoseTracking);
+BENCHMARK(analyticIKPoseTrackingSixJoints);
+BENCHMARK(jacobianPoseTrackingSixJoints);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,158 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : pr2_servo.hpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : A Servo instance for a move group of the two-arm PR2, with its own node, planning scene monitor
+ *                    and joint state publisher. Used by the multi-group tests and the benchmarks.
+ */
+
+#pragma once
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <moveit_servo/servo.hpp>
+#include <moveit_servo/utils/common.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace pr2_servo
+{
+const std::string PARAM_NAMESPACE = "moveit_servo";
+
+/** \brief Servo for a PR2 move group, e.g. "arms" with the subgroups "left_arm" and "right_arm".
+
+    The robot holds its default state, which is published on a joint state topic of its own, so that several
+    instances can run next to each other and next to another robot. Requires rclcpp to be initialized. */
+class Pr2Servo
+{
+public:
+  Pr2Servo(const std::string& move_group_name)
+  {
+    const std::string node_name = "pr2_servo_" + move_group_name;
+    const std::string description_path =
+        ament_index_cpp::get_package_share_directory("moveit_resources_pr2_description");
+    // the parameters are set here only, so that a parameter file for another robot does not apply
+    node_ = std::make_shared<rclcpp::Node>(
+        node_name, rclcpp::NodeOptions().use_global_arguments(false).parameter_overrides({
+                       { "robot_description", readFile(description_path + "/urdf/robot.xml") },
+                       { "robot_description_semantic", readFile(description_path + "/srdf/robot.xml") },
+                       { PARAM_NAMESPACE + ".move_group_name", move_group_name },
+                       { PARAM_NAMESPACE + ".joint_topic", "/" + node_name + "/joint_states" },
+                       { PARAM_NAMESPACE + ".command_in_type", "speed_units" },
+                       { PARAM_NAMESPACE + ".use_smoothing", false },
+                   }));
+    param_listener_ = std::make_shared<servo::ParamListener>(node_, PARAM_NAMESPACE);
+    params_ = param_listener_->get_params();
+    planning_scene_monitor_ = moveit_servo::createPlanningSceneMonitor(node_, params_);
+
+    moveit::core::RobotState default_state(planning_scene_monitor_->getRobotModel());
+    default_state.setToDefaultValues();
+    for (const moveit::core::JointModel* joint_model : default_state.getRobotModel()->getActiveJointModels())
+    {
+      if (joint_model->getVariableCount() == 1)
+      {
+        joint_state_.name.push_back(joint_model->getName());
+        joint_state_.position.push_back(default_state.getVariablePosition(joint_model->getFirstVariableIndex()));
+      }
+    }
+    joint_state_publisher_ = node_->create_publisher<sensor_msgs::msg::JointState>(params_.joint_topic, 10);
+    publisher_thread_ = std::thread([this] {
+      while (publishing_)
+      {
+        joint_state_.header.stamp = node_->now();
+        joint_state_publisher_->publish(joint_state_);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    });
+
+    // Servo waits for the complete state itself, the scene is updated once it arrived
+    servo_ = std::make_unique<moveit_servo::Servo>(node_, param_listener_, planning_scene_monitor_);
+    planning_scene_monitor_->updateSceneWithCurrentState();
+  }
+
+  ~Pr2Servo()
+  {
+    servo_.reset();
+    publishing_ = false;
+    publisher_thread_.join();
+  }
+
+  moveit_servo::Servo& servo()
+  {
+    return *servo_;
+  }
+
+  const servo::Params& params() const
+  {
+    return params_;
+  }
+
+  const planning_scene_monitor::PlanningSceneMonitorPtr& planningSceneMonitor() const
+  {
+    return planning_scene_monitor_;
+  }
+
+  /// A copy of the current state of the robot
+  moveit::core::RobotStatePtr getCurrentState() const
+  {
+    planning_scene_monitor::LockedPlanningSceneRO locked_scene(planning_scene_monitor_);
+    return std::make_shared<moveit::core::RobotState>(locked_scene->getCurrentState());
+  }
+
+private:
+  static std::string readFile(const std::string& path)
+  {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  std::shared_ptr<const servo::ParamListener> param_listener_;
+  servo::Params params_;
+  planning_scene_monitor::PlanningSceneMonitorPtr planning_scene_monitor_;
+  sensor_msgs::msg::JointState joint_state_;
+  rclcpp::Publisher<sensor_msgs::msg::JointState>::SharedPtr joint_state_publisher_;
+  std::atomic<bool> publishing_{ true };
+  std::thread publisher_thread_;
+  std::unique_ptr<moveit_servo::Servo> servo_;
+};
+}  // namespace pr2_servo
@@ -0,0 +1,204 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : reversed_order_kinematics.hpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : An IK solver for the six joint Fanuc arm that lists its joints in the opposite order of the
+ *                    planning group and reports several solutions, to test that Servo maps solver and group order.
+ *                    Used by the pose tracking tests and benchmark.
+ */
+
+#pragma once
+
+#include <moveit/kinematics_base/kinematics_base.hpp>
+#include <moveit/robot_model/robot_model.hpp>
+#include <moveit/robot_state/robot_state.hpp>
+#include <moveit/utils/robot_model_test_utils.hpp>
+#include <tf2_eigen/tf2_eigen.hpp>
+#include <Eigen/SVD>
+
+namespace reversed_order_kinematics
+{
+const std::string ROBOT_NAME = "fanuc";
+const std::string GROUP_NAME = "manipulator";
+const std::string BASE_FRAME = "base_link";
+const std::string TIP_FRAME = "tool0";
+
+/** \brief Numeric IK for a chain group that lists the joints from the tip to the base.
+
+    Every query converges from the seed and from a second seed with the wrist turned by half a turn, and reports both
+    results, as an analytic solver reports several solution branches. Not thread-safe. */
+class ReversedOrderKinematics : public kinematics::KinematicsBase
+{
+public:
+  ReversedOrderKinematics(const moveit::core::JointModelGroup& group)
+    : group_(group)
+      // the model owns its groups and their solvers, so do not keep it alive from here
+    , state_(moveit::core::RobotModelConstPtr(std::shared_ptr<void>(), &group.getParentModel()))
+    , joint_names_(group.getActiveJointModelNames().rbegin(), group.getActiveJointModelNames().rend())
+    , link_names_(group.getLinkModelNames())
+  {
+    state_.setToDefaultValues();
+    storeValues(group.getParentModel(), group.getName(), BASE_FRAME, { TIP_FRAME }, 0.0);
+  }
+
+  /// Install a ReversedOrderKinematics instance as the IK solver of group
+  static void attach(moveit::core::JointModelGroup* group)
+  {
+    auto solver = std::make_shared<ReversedOrderKinematics>(*group);
+    group->setSolverAllocators([solver](const moveit::core::JointModelGroup*) { return solver; },
+                               moveit::core::SolverAllocatorMapFn());
+  }
+
+  bool getPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                     std::vector<double>& solution, moveit_msgs::msg::MoveItErrorCodes& error_code,
+                     const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool getPositionIK(const std::vector<geometry_msgs::msg::Pose>& ik_poses, const std::vector<double>& ik_seed_state,
+                     std::vector<std::vector<double>>& solutions, kinematics::KinematicsResult& result,
+                     const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    solutions.clear();
+    moveit_msgs::msg::MoveItErrorCodes error_code;
+    std::vector<double> solution;
+    std::vector<double> flipped_seed = ik_seed_state;
+    flipped_seed.front() += M_PI;  // the last joint of the group
+    for (const auto& seed : { ik_seed_state, flipped_seed })
+    {
+      if (ik_poses.size() == 1 && solve(ik_poses.front(), seed, solution, error_code))
+      {
+        solutions.push_back(solution);
+      }
+    }
+    result.kinematic_error =
+        solutions.empty() ? kinematics::KinematicErrors::NO_SOLUTION : kinematics::KinematicErrors::OK;
+    result.solution_percentage = solutions.empty() ? 0.0 : 1.0;
+    return !solutions.empty();
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, std::vector<double>& solution,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, const std::vector<double>& /*consistency_limits*/,
+                        std::vector<double>& solution, moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, std::vector<double>& solution, const IKCallbackFn& /*solution_callback*/,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double /*timeout*/, const std::vector<double>& /*consistency_limits*/,
+                        std::vector<double>& solution, const IKCallbackFn& /*solution_callback*/,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& /*options*/) const override
+  {
+    return solve(ik_pose, ik_seed_state, solution, error_code);
+  }
+
+  bool getPositionFK(const std::vector<std::string>& /*link_names*/, const std::vector<double>& /*joint_angles*/,
+                     std::vector<geometry_msgs::msg::Pose>& /*poses*/) const override
+  {
+    return false;
+  }
+
+  const std::vector<std::string>& getJointNames() const override
+  {
+    return joint_names_;
+  }
+
+  const std::vector<std::string>& getLinkNames() const override
+  {
+    return link_names_;
+  }
+
+private:
+  // Newton iterations on the tip pose from the seed, which is in solver (reversed) order like the solution.
+  bool solve(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& seed, std::vector<double>& solution,
+             moveit_msgs::msg::MoveItErrorCodes& error_code) const
+  {
+    Eigen::Isometry3d target;
+    tf2::fromMsg(ik_pose, target);
+    const moveit::core::LinkModel* tip_link = state_.getLinkModel(TIP_FRAME);
+
+    Eigen::VectorXd positions = Eigen::Map<const Eigen::VectorXd>(seed.data(), seed.size()).reverse();
+    Eigen::MatrixXd jacobian;
+    for (int iteration = 0; iteration < 100; ++iteration)
+    {
+      state_.setJointGroupPositions(&group_, positions);
+      state_.updateLinkTransforms();
+      const Eigen::Isometry3d& tip = state_.getGlobalLinkTransform(tip_link);
+      const Eigen::AngleAxisd rotation_error(target.linear() * tip.linear().transpose());
+      Eigen::Vector<double, 6> error;
+      error.head<3>() = target.translation() - tip.translation();
+      error.tail<3>() = rotation_error.axis() * rotation_error.angle();
+      if (error.norm() < 1e-12)
+      {
+        solution.resize(positions.size());
+        Eigen::Map<Eigen::VectorXd>(solution.data(), solution.size()) = positions.reverse();
+        error_code.val = moveit_msgs::msg::MoveItErrorCodes::SUCCESS;
+        return true;
+      }
+      state_.getJacobian(&group_, tip_link, Eigen::Vector3d::Zero(), jacobian);
+      positions += jacobian.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(error);
+    }
+    error_code.val = moveit_msgs::msg::MoveItErrorCodes::NO_IK_SOLUTION;
+    return false;
+  }
+
+  const moveit::core::JointModelGroup& group_;
+  mutable moveit::core::RobotState state_;
+  std::vector<std::string> joint_names_;
+  std::vector<std::string> link_names_;
+};
+}  // namespace reversed_order_kinematics
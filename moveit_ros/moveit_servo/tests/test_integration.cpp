@@ -39,7 +39,13 @@
    Created   : 07/07/2023
 */
 
+#include "pr2_servo.hpp"
 #include "servo_cpp_fixture.hpp"
+#include <geometric_shapes/shapes.h>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <unistd.h>
 
 namespace
 {
@@ -72,6 +78,60 @@ TEST_F(ServoCppFixture, JointJogTest)
   ASSERT_NEAR(delta, 0.01, tol);
 }
 
+TEST_F(ServoCppFixture, MultiGroupTest)
+{
+  planning_scene_monitor::LockedPlanningSceneRO locked_scene(planning_scene_monitor_);
+  auto robot_state = std::make_shared<moveit::core::RobotState>(locked_scene->getCurrentState());
+  servo_test_instance_->setCommandType(moveit_servo::CommandType::JOINT_JOG);
+  const moveit_servo::JointJogCommand joint_jog{ { "panda_finger_joint1" }, { 1.0 } };
+
+  // Without any subgroup commands the arm holds its position.
+  const moveit_servo::MultiGroupInput no_commands;
+  const moveit_servo::KinematicState curr_state = servo_test_instance_->getNextJointState(robot_state, no_commands);
+  ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::NO_WARNING);
+  ASSERT_EQ(curr_state.positions.size(), 7);
+
+  // The hand has joints outside of the panda_arm move group, so it cannot be commanded as a subgroup.
+  const moveit_servo::MultiGroupInput hand_command{ { "hand", joint_jog } };
+  servo_test_instance_->getNextJointState(robot_state, hand_command);
+  ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::INVALID);
+
+  // Unknown groups are rejected as well.
+  const moveit_servo::MultiGroupInput unknown_command{ { "no_such_group", joint_jog } };
+  servo_test_instance_->getNextJointState(robot_state, unknown_command);
+  ASSERT_EQ(servo_test_instance_->getStatus(), moveit_servo::StatusCode::INVALID);
+}
+
+TEST(ServoMultiGroupTest, TwoSubgroupsInOneCycle)
+{
+  pr2_servo::Pr2Servo pr2("arms");
+  moveit_servo::Servo& servo = pr2.servo();
+  servo.setCollisionChecking(false);
+  servo.setCommandType(moveit_servo::CommandType::JOINT_JOG);
+  const auto robot_state = pr2.getCurrentState();
+
+  // Both arms are jogged in the same cycle, each through its own subgroup.
+  const std::map<std::string, double> joint_velocities{ { "l_shoulder_pan_joint", 0.1 },
+                                                        { "r_shoulder_pan_joint", -0.2 } };
+  const moveit_servo::MultiGroupInput commands{
+    { "left_arm", moveit_servo::JointJogCommand{ { "l_shoulder_pan_joint" }, { 0.1 } } },
+    { "right_arm", moveit_servo::JointJogCommand{ { "r_shoulder_pan_joint" }, { -0.2 } } }
+  };
+  const moveit_servo::KinematicState next_state = servo.getNextJointState(robot_state, commands);
+  ASSERT_EQ(servo.getStatus(), moveit_servo::StatusCode::NO_WARNING);
+  ASSERT_EQ(next_state.joint_names.size(), 14u);
+
+  constexpr double tol = 1.0e-9;
+  for (std::size_t i = 0; i < next_state.joint_names.size(); ++i)
+  {
+    const auto velocity = joint_velocities.find(next_state.joint_names[i]);
+    const double expected_delta =
+        velocity == joint_velocities.end() ? 0.0 : velocity->second * pr2.params().publish_period;
+    const double delta = next_state.positions[i] - robot_state->getVariablePosition(next_state.joint_names[i]);
+    EXPECT_NEAR(delta, expected_delta, tol) << next_state.joint_names[i];
+  }
+}
+
 TEST_F(ServoCppFixture, TwistTest)
 {
   planning_scene_monitor::LockedPlanningSceneRO locked_scene(planning_scene_monitor_);
@@ -159,6 +219,112 @@ TEST_F(ServoCppFixture, PoseTest)
   ASSERT_NEAR(delta, expected_delta, tol);
 }
 
+TEST_F(ServoCppFixture, CollisionLookaheadTest)
+{
+  // Integrate the servo output here and run the collision checks in step with the servo cycles, instead of on the
+  // monitor thread, so that the outcome does not depend on timing. The parameters are only written while the monitor
+  // thread is stopped.
+  servo_test_instance_->setCollisionChecking(false);
+  planning_scene_monitor_->stopStateMonitor();
+  moveit::core::RobotState start_state = [this] {
+    planning_scene_monitor::LockedPlanningSceneRW locked_scene(planning_scene_monitor_);
+    locked_scene->getWorldNonConst()->addToObject("wall", Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.45, 0.5)),
+                                                  std::make_shared<const shapes::Box>(0.05, 0.5, 1.0),
+                                                  Eigen::Isometry3d::Identity());
+    return locked_scene->getCurrentState();
+  }();
+  planning_scene_monitor_->triggerSceneUpdateEvent(planning_scene_monitor::PlanningSceneMonitor::UPDATE_GEOMETRY);
+  const moveit::core::JointModelGroup* joint_model_group = start_state.getJointModelGroup("panda_arm");
+
+  servo_test_instance_->setCommandType(moveit_servo::CommandType::JOINT_JOG);
+  servo_test_instance_->getParams().scale.joint = 2.0;
+  const moveit_servo::JointJogCommand jog_towards_wall{ { "panda_joint1" }, { 1.0 } };
+
+  // Jog into the wall for a fixed number of cycles, checking collisions every check_interval cycles, and return the
+  // closest distance to the wall.
+  const auto jog = [&](int check_interval) {
+    auto robot_state = std::make_shared<moveit::core::RobotState>(start_state);
+    servo_test_instance_->resetSmoothing(moveit_servo::extractRobotState(robot_state, "panda_arm"));
+    servo_test_instance_->checkCollisionsOnce();
+
+    double min_distance = std::numeric_limits<double>::max();
+    for (int cycle = 1; cycle <= 75; ++cycle)
+    {
+      const moveit_servo::KinematicState next_state =
+          servo_test_instance_->getNextJointState(robot_state, jog_towards_wall);
+      robot_state->setJointGroupActivePositions(joint_model_group, next_state.positions);
+      robot_state->setJointGroupVelocities(joint_model_group, next_state.velocities);
+      robot_state->update();
+      min_distance = std::min(min_distance, planning_scene_monitor::LockedPlanningSceneRO(planning_scene_monitor_)
+                                                ->distanceToCollision(*robot_state));
+      if (cycle % check_interval == 0)
+        servo_test_instance_->checkCollisionsOnce();
+    }
+    return min_distance;
+  };
+
+  // Without lookahead, every check asks for the scene and self collision distances. With one lookahead step, a check
+  // adds two yes/no queries, which cost less than the distance queries. Checking half as often keeps the collision
+  // checking budget of the lookahead run below that of the run without lookahead.
+  servo_test_instance_->getParams().collision_lookahead_time = 0.0;
+  const double distance_without_lookahead = jog(1);
+  servo_test_instance_->getParams().collision_lookahead_time = 0.3;
+  servo_test_instance_->getParams().collision_lookahead_steps = 1;
+  const double distance_with_lookahead = jog(2);
+
+  EXPECT_GT(distance_with_lookahead, 0.0);
+  EXPECT_GT(distance_with_lookahead, distance_without_lookahead);
+}
+
+TEST_F(ServoCppFixture, SharedPlanningSceneTest)
+{
+  // a primary monitor, e.g. that of move_group, writes its scene to shared memory
+  const std::string segment_name = "/moveit_servo_test_scene_" + std::to_string(getpid());
+  auto primary_monitor = std::make_shared<planning_scene_monitor::PlanningSceneMonitor>(
+      servo_test_node_, "robot_description", "primary_planning_scene_monitor");
+  primary_monitor->setPlanningScenePublishingFrequency(100.0);
+  primary_monitor->startSharedScenePublisher(segment_name, 16 * 1024 * 1024);
+
+  servo::Params params = servo_params_;
+  params.is_primary_planning_scene_monitor = false;
+  params.shared_planning_scene_segment = segment_name;
+  const planning_scene_monitor::PlanningSceneMonitorPtr follower =
+      moveit_servo::createPlanningSceneMonitor(servo_test_node_, params);
+
+  // the follower reads the segment instead of subscribing to the monitored planning scene
+  std::vector<std::string> topics;
+  follower->getMonitoredTopics(topics);
+  const auto monitored_scene_topic = std::find_if(topics.begin(), topics.end(), [&](const std::string& topic) {
+    return topic.find(params.monitored_planning_scene_topic) != std::string::npos;
+  });
+  EXPECT_EQ(monitored_scene_topic, topics.end());
+
+  moveit_msgs::msg::PlanningScene msg;
+  msg.is_diff = msg.robot_state.is_diff = true;
+  moveit_msgs::msg::CollisionObject& box = msg.world.collision_objects.emplace_back();
+  box.header.frame_id = follower->getRobotModel()->getModelFrame();
+  box.id = "shared_box";
+  box.operation = moveit_msgs::msg::CollisionObject::ADD;
+  box.pose.position.x = 1.0;
+  box.pose.orientation.w = 1.0;
+  box.primitives.emplace_back();
+  box.primitives.back().type = shape_msgs::msg::SolidPrimitive::BOX;
+  box.primitives.back().dimensions = { 0.1, 0.1, 0.1 };
+  primary_monitor->newPlanningSceneMessage(msg);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  bool has_box = false;
+  while (!has_box && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    has_box = planning_scene_monitor::LockedPlanningSceneRO(follower)->getWorld()->hasObject("shared_box");
+  }
+  EXPECT_TRUE(has_box);
+
+  follower->stopSharedSceneMonitor();
+  primary_monitor->stopSharedScenePublisher();
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
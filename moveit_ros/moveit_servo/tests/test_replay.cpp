@@ -0,0 +1,298 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/*      Title       : test_replay.cpp
+ *      Project     : moveit_servo
+ *      Created     : 10/18/2026
+ *
+ *      Description : Replays commands through Servo without any other nodes, and checks that the replays are
+ *                    repeatable and that the motion stays smooth.
+ */
+
+#include <gtest/gtest.h>
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <moveit/planning_scene_monitor/current_state_monitor.hpp>
+#include <moveit_servo/servo_replay.hpp>
+#include <moveit_servo/utils/common.hpp>
+#include <geometric_shapes/shapes.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+const std::string MOVE_GROUP = "panda_arm";
+const std::string PLANNING_FRAME = "panda_link0";
+const std::vector<double> READY_POSITIONS = { 0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785 };
+const std::string PARAM_NAMESPACE = "moveit_servo_test";
+const std::string JOINT_TOPIC = "/moveit_servo_replay_test/joint_states";
+
+std::string readFile(const std::string& path)
+{
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+/** \brief Middleware for the state monitor that does not subscribe to anything.
+
+    The test passes the joint states to the stored callback itself, so no other node or topic is involved. */
+class SeededStateMiddlewareHandle : public planning_scene_monitor::CurrentStateMonitor::MiddlewareHandle
+{
+public:
+  SeededStateMiddlewareHandle(const rclcpp::Node::SharedPtr& node,
+                              planning_scene_monitor::JointStateUpdateCallback* callback)
+    : node_(node), callback_(callback)
+  {
+  }
+
+  rclcpp::Time now() const override
+  {
+    return node_->now();
+  }
+
+  void createJointStateSubscription(const std::string& topic,
+                                    planning_scene_monitor::JointStateUpdateCallback callback) override
+  {
+    topic_ = topic;
+    *callback_ = std::move(callback);
+  }
+
+  void createStaticTfSubscription(TfCallback /* callback */) override
+  {
+  }
+
+  void createDynamicTfSubscription(TfCallback /* callback */) override
+  {
+  }
+
+  void resetJointStateSubscription() override
+  {
+  }
+
+  std::string getJointStateTopicName() const override
+  {
+    return topic_;
+  }
+
+  bool sleepFor(const std::chrono::nanoseconds& nanoseconds) const override
+  {
+    std::this_thread::sleep_for(nanoseconds);
+    return true;
+  }
+
+  bool ok() const override
+  {
+    return true;
+  }
+
+  std::string getStaticTfTopicName() const override
+  {
+    return "";
+  }
+
+  std::string getDynamicTfTopicName() const override
+  {
+    return "";
+  }
+
+  void resetTfSubscriptions() override
+  {
+  }
+
+private:
+  rclcpp::Node::SharedPtr node_;
+  planning_scene_monitor::JointStateUpdateCallback* callback_;
+  std::string topic_;
+};
+
+class ServoReplayFixture : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // the parameters are set here only, so that the test does not depend on a launch file
+    const std::string description_path =
+        ament_index_cpp::get_package_share_directory("moveit_resources_panda_description");
+    const std::string config_path =
+        ament_index_cpp::get_package_share_directory("moveit_resources_panda_moveit_config");
+    node_ = std::make_shared<rclcpp::Node>(
+        "moveit_servo_replay_test",
+        rclcpp::NodeOptions().use_global_arguments(false).parameter_overrides({
+            { "robot_description", readFile(description_path + "/urdf/panda.urdf") },
+            { "robot_description_semantic", readFile(config_path + "/config/panda.srdf") },
+            { PARAM_NAMESPACE + ".move_group_name", MOVE_GROUP },
+            { PARAM_NAMESPACE + ".joint_topic", JOINT_TOPIC },
+            { PARAM_NAMESPACE + ".publish_period", 0.02 },
+            { PARAM_NAMESPACE + ".incoming_command_timeout", 0.5 },
+            { PARAM_NAMESPACE + ".scale.linear", 0.2 },
+            { PARAM_NAMESPACE + ".scale.rotational", 0.2 },
+            { PARAM_NAMESPACE + ".scale.joint", 0.5 },
+            { PARAM_NAMESPACE + ".use_smoothing", true },
+        }));
+    const auto servo_param_listener = std::make_shared<servo::ParamListener>(node_, PARAM_NAMESPACE);
+    servo_params_ = servo_param_listener->get_params();
+
+    // Nothing else is running, so the state monitor gets the initial state of the robot from the test.
+    planning_scene_monitor_ = std::make_shared<planning_scene_monitor::PlanningSceneMonitor>(
+        node_, "robot_description", "planning_scene_monitor");
+    ASSERT_TRUE(planning_scene_monitor_->getPlanningScene());
+    planning_scene_monitor_->getStateMonitorNonConst() = std::make_shared<planning_scene_monitor::CurrentStateMonitor>(
+        std::make_unique<SeededStateMiddlewareHandle>(node_, &seed_joint_state_),
+        planning_scene_monitor_->getRobotModel(), planning_scene_monitor_->getTFClient(), false);
+    planning_scene_monitor_->startStateMonitor(servo_params_.joint_topic);
+    planning_scene_monitor_->startSceneMonitor(servo_params_.monitored_planning_scene_topic);
+    planning_scene_monitor_->getStateMonitor()->enableCopyDynamics(true);
+    ASSERT_TRUE(seed_joint_state_);
+
+    auto joint_state = std::make_shared<sensor_msgs::msg::JointState>();
+    joint_state->header.stamp = node_->now();
+    joint_state->name =
+        planning_scene_monitor_->getRobotModel()->getJointModelGroup(MOVE_GROUP)->getActiveJointModelNames();
+    joint_state->position = READY_POSITIONS;
+    seed_joint_state_(joint_state);
+    ASSERT_TRUE(planning_scene_monitor_->getStateMonitor()->waitForCompleteState(MOVE_GROUP, 0.0));
+    planning_scene_monitor_->updateSceneWithCurrentState();
+
+    replay_ = std::make_unique<moveit_servo::ServoReplay>(node_, servo_param_listener, planning_scene_monitor_);
+    // From here on, only the replayed commands move the robot.
+    planning_scene_monitor_->stopStateMonitor();
+  }
+
+  // A command every publish period for about 2 s, starting at 0.1 s
+  moveit_servo::ServoRecording makeRecording(moveit_servo::CommandType command_type,
+                                             const moveit_servo::ServoInput& command) const
+  {
+    moveit_servo::ServoRecording recording;
+    recording.command_type = command_type;
+    for (int i = 0; i < 96; ++i)
+    {
+      recording.commands.push_back({ 0.1 + i * servo_params_.publish_period, command });
+    }
+    return recording;
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  servo::Params servo_params_;
+  planning_scene_monitor::JointStateUpdateCallback seed_joint_state_;
+  planning_scene_monitor::PlanningSceneMonitorPtr planning_scene_monitor_;
+  std::unique_ptr<moveit_servo::ServoReplay> replay_;
+};
+
+void expectSameCommands(const moveit_servo::ReplayResult& result, const moveit_servo::ReplayResult& other_result)
+{
+  ASSERT_EQ(result.commanded_states.size(), other_result.commanded_states.size());
+  for (std::size_t i = 0; i < result.commanded_states.size(); ++i)
+  {
+    EXPECT_EQ(result.commanded_states[i].positions, other_result.commanded_states[i].positions) << "cycle " << i;
+    EXPECT_EQ(result.commanded_states[i].velocities, other_result.commanded_states[i].velocities) << "cycle " << i;
+  }
+  EXPECT_EQ(result.statuses, other_result.statuses);
+}
+
+TEST_F(ServoReplayFixture, TwistReplay)
+{
+  const moveit_servo::TwistCommand twist{ PLANNING_FRAME, { 0.5, 0.0, 0.0, 0.0, 0.0, 0.2 } };
+  moveit_servo::ServoRecording recording = makeRecording(moveit_servo::CommandType::TWIST, twist);
+
+  // Without joint states, the robot follows the commands exactly. The same commands give the same states.
+  const moveit_servo::ReplayResult result = replay_->replay(recording);
+  ASSERT_GE(result.commanded_states.size(), 95ul);
+  EXPECT_EQ(result.stale_cycles, 0ul);
+  EXPECT_EQ(result.invalid_cycles, 0ul);
+  EXPECT_EQ(result.collision_halt_cycles, 0ul);
+  EXPECT_GT((result.commanded_states.back().positions - result.commanded_states.front().positions).norm(), 0.01);
+  expectSameCommands(result, replay_->replay(recording));
+
+  // The cycle times depend on the machine, only their consistency is checked. The accelerations do not.
+  EXPECT_GT(result.mean_cycle_time, 0.0);
+  EXPECT_LE(result.p99_cycle_time, result.max_cycle_time);
+  EXPECT_GT(result.max_acceleration, 0.0);
+  EXPECT_LT(result.max_acceleration, 10.0);
+
+  // Record the commanded states as joint states, and replay them from a file.
+  for (std::size_t i = 0; i < result.commanded_states.size(); ++i)
+  {
+    recording.joint_states.push_back({ 0.1 + i * servo_params_.publish_period, result.commanded_states[i].positions,
+                                       result.commanded_states[i].velocities });
+  }
+  const std::string file_path = testing::TempDir() + "servo_replay_recording.csv";
+  ASSERT_TRUE(moveit_servo::saveRecording(recording, file_path));
+  const std::optional<moveit_servo::ServoRecording> loaded_recording = moveit_servo::loadRecording(file_path);
+  std::remove(file_path.c_str());
+  ASSERT_TRUE(loaded_recording.has_value());
+  ASSERT_EQ(loaded_recording->commands.size(), recording.commands.size());
+  ASSERT_EQ(loaded_recording->joint_states.size(), recording.joint_states.size());
+  EXPECT_EQ(loaded_recording->joint_states.back().positions, recording.joint_states.back().positions);
+
+  const moveit_servo::ReplayResult recorded_state_result = replay_->replay(*loaded_recording);
+  EXPECT_EQ(recorded_state_result.stale_cycles, 0ul);
+  expectSameCommands(recorded_state_result, replay_->replay(recording));
+}
+
+TEST_F(ServoReplayFixture, CollisionReplay)
+{
+  {
+    planning_scene_monitor::LockedPlanningSceneRW locked_scene(planning_scene_monitor_);
+    locked_scene->getWorldNonConst()->addToObject("wall", Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.45, 0.5)),
+                                                  std::make_shared<const shapes::Box>(0.05, 0.5, 1.0),
+                                                  Eigen::Isometry3d::Identity());
+  }
+  planning_scene_monitor_->triggerSceneUpdateEvent(planning_scene_monitor::PlanningSceneMonitor::UPDATE_GEOMETRY);
+
+  // Jog towards the wall until servo stops the robot, in the same cycle in every replay.
+  replay_->getServo().getParams().scale.joint = 2.0;
+  const moveit_servo::JointJogCommand jog_towards_wall{ { "panda_joint1" }, { 1.0 } };
+  const moveit_servo::ServoRecording recording =
+      makeRecording(moveit_servo::CommandType::JOINT_JOG, jog_towards_wall);
+
+  const moveit_servo::ReplayResult result = replay_->replay(recording);
+  EXPECT_GT(result.collision_deceleration_cycles + result.collision_halt_cycles, 0ul);
+  EXPECT_EQ(result.invalid_cycles, 0ul);
+  expectSameCommands(result, replay_->replay(recording));
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -39,12 +39,54 @@
    Created   : 06/20/2023
 */
 
+#include "planar_arm_analytic_ik.hpp"
+#include "reversed_order_kinematics.hpp"
 #include <gtest/gtest.h>
 #include <moveit_servo/servo.hpp>
+#include <moveit_servo/utils/command.hpp>
 #include <moveit_servo/utils/common.hpp>
 #include <moveit_servo/utils/datatypes.hpp>
+#include <moveit_servo/utils/latency_tracer.hpp>
+#include <moveit_servo/utils/triple_buffer.hpp>
 #include <moveit/utils/robot_model_test_utils.hpp>
 #include <tf2_eigen/tf2_eigen.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace
+{
+// Heap allocations of the current thread are counted while this is set, to check that publishing does not allocate.
+thread_local bool count_allocations = false;
+thread_local size_t allocation_count = 0;
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+  if (count_allocations)
+  {
+    ++allocation_count;
+  }
+  if (void* ptr = std::malloc(size > 0 ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
 
 namespace
 {
@@ -234,6 +276,48 @@ TEST(ServoUtilsUnitTests, LeavingSingularityScaling)
   ASSERT_EQ(scaling_result.second, moveit_servo::StatusCode::DECELERATE_FOR_LEAVING_SINGULARITY);
 }
 
+TEST(ServoUtilsUnitTests, SubgroupSingularityScaling)
+{
+  using moveit::core::loadTestingRobotModel;
+  moveit::core::RobotModelPtr robot_model = loadTestingRobotModel("pr2");
+  moveit::core::RobotStatePtr robot_state = std::make_shared<moveit::core::RobotState>(robot_model);
+  robot_state->setToDefaultValues();
+
+  // The stretched right arm is singular, the left arm is bent.
+  const auto left_arm = robot_state->getJointModelGroup("left_arm");
+  Eigen::Vector<double, 7> state_bent{ 0.3, 0.2, 0.5, -1.2, 0.4, -0.8, 0.0 };
+  robot_state->setJointGroupActivePositions(left_arm, state_bent);
+  robot_state->update();
+  const moveit::core::RobotState initial_state = *robot_state;
+
+  Eigen::Vector<double, 6> cartesian_delta{ 0.005, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  servo::Params arm_params;
+  servo::Params subgroup_params;
+  subgroup_params.move_group_name = "arms";
+
+  // A subgroup is scaled by its own Jacobian, as if it was the move group, regardless of the other arm.
+  for (const std::string arm : { "left_arm", "right_arm" })
+  {
+    arm_params.move_group_name = arm;
+    subgroup_params.active_subgroup = arm;
+    const auto arm_result = moveit_servo::velocityScalingFactorForSingularity(robot_state, cartesian_delta, arm_params);
+    const auto subgroup_result =
+        moveit_servo::velocityScalingFactorForSingularity(robot_state, cartesian_delta, subgroup_params);
+    EXPECT_EQ(subgroup_result.second, arm_result.second);
+    EXPECT_DOUBLE_EQ(subgroup_result.first, arm_result.first);
+    if (arm == "right_arm")
+    {
+      EXPECT_EQ(subgroup_result.second, moveit_servo::StatusCode::HALT_FOR_SINGULARITY);
+    }
+  }
+
+  // The state probed for the direction towards the singularity is restored.
+  for (const std::string& name : robot_model->getVariableNames())
+  {
+    EXPECT_EQ(robot_state->getVariablePosition(name), initial_state.getVariablePosition(name)) << name;
+  }
+}
+
 TEST(ServoUtilsUnitTests, ExtractRobotState)
 {
   using moveit::core::loadTestingRobotModel;
@@ -279,6 +363,272 @@ TEST(ServoUtilsUnitTests, SlidingWinodw)
   ASSERT_FALSE(msg.has_value());
 }
 
+TEST(ServoUtilsUnitTests, ReusedMessagesDoNotAllocate)
+{
+  moveit_servo::KinematicState state(7);
+  state.joint_names = { "j1", "j2", "j3", "j4", "j5", "j6", "j7" };
+  std::deque<moveit_servo::KinematicState> window;
+  for (size_t i = 0; i < 7; ++i)
+  {
+    moveit_servo::updateSlidingWindow(state, window, 1.0, rclcpp::Time(100, i * 1E8, RCL_ROS_TIME));
+  }
+  servo::Params params;
+  params.publish_joint_velocities = true;
+  params.publish_joint_accelerations = true;
+
+  // The first messages allocate their memory.
+  trajectory_msgs::msg::JointTrajectory trajectory;
+  std_msgs::msg::Float64MultiArray multi_array;
+  ASSERT_TRUE(moveit_servo::composeTrajectoryMessage(params, window, trajectory));
+  moveit_servo::composeMultiArrayMessage(params, window.back(), multi_array);
+
+  count_allocations = true;
+  for (size_t cycle = 0; cycle < 10000; ++cycle)
+  {
+    for (auto& window_state : window)
+    {
+      window_state.positions.array() += 1E-3;
+      window_state.time_stamp = window_state.time_stamp + rclcpp::Duration(0, 10000000);
+    }
+    moveit_servo::composeTrajectoryMessage(params, window, trajectory);
+    moveit_servo::composeMultiArrayMessage(params, window.back(), multi_array);
+  }
+  count_allocations = false;
+  ASSERT_EQ(allocation_count, 0ul);
+
+  // The reused messages have the same content as newly composed ones.
+  ASSERT_EQ(trajectory, moveit_servo::composeTrajectoryMessage(params, window).value());
+  ASSERT_EQ(multi_array, moveit_servo::composeMultiArrayMessage(params, window.back()));
+}
+
+TEST(ServoUtilsUnitTests, PublishingReusedMessagesAddsNoAllocations)
+{
+  moveit_servo::KinematicState state(7);
+  state.joint_names = { "j1", "j2", "j3", "j4", "j5", "j6", "j7" };
+  std::deque<moveit_servo::KinematicState> window;
+  for (size_t i = 0; i < 7; ++i)
+  {
+    moveit_servo::updateSlidingWindow(state, window, 1.0, rclcpp::Time(100, i * 1E8, RCL_ROS_TIME));
+  }
+  servo::Params params;
+  trajectory_msgs::msg::JointTrajectory trajectory;
+  std_msgs::msg::Float64MultiArray multi_array;
+  ASSERT_TRUE(moveit_servo::composeTrajectoryMessage(params, window, trajectory));
+  moveit_servo::composeMultiArrayMessage(params, window.back(), multi_array);
+
+  auto node = std::make_shared<rclcpp::Node>("servo_publish_allocation_test");
+  auto trajectory_publisher = node->create_publisher<trajectory_msgs::msg::JointTrajectory>("~/trajectory", 1);
+  auto multi_array_publisher = node->create_publisher<std_msgs::msg::Float64MultiArray>("~/multi_array", 1);
+
+  // The first publishes let the middleware allocate its buffers.
+  moveit_servo::publishMessage(trajectory_publisher, trajectory);
+  moveit_servo::publishMessage(multi_array_publisher, multi_array);
+  trajectory_publisher->publish(trajectory);
+  multi_array_publisher->publish(multi_array);
+
+  // Whatever the middleware allocates itself when publishing is counted by publishing the messages directly, so that
+  // only the allocations added by publishMessage, including its loaned message path, make the test fail.
+  constexpr size_t cycles = 1000;
+  allocation_count = 0;
+  count_allocations = true;
+  for (size_t cycle = 0; cycle < cycles; ++cycle)
+  {
+    trajectory_publisher->publish(trajectory);
+    multi_array_publisher->publish(multi_array);
+  }
+  count_allocations = false;
+  const size_t direct_publish_allocations = allocation_count;
+
+  allocation_count = 0;
+  count_allocations = true;
+  for (size_t cycle = 0; cycle < cycles; ++cycle)
+  {
+    moveit_servo::composeTrajectoryMessage(params, window, trajectory);
+    moveit_servo::publishMessage(trajectory_publisher, trajectory);
+    moveit_servo::composeMultiArrayMessage(params, window.back(), multi_array);
+    moveit_servo::publishMessage(multi_array_publisher, multi_array);
+  }
+  count_allocations = false;
+  const size_t servo_publish_allocations = allocation_count;
+
+  RecordProperty("uses_loaned_messages", trajectory_publisher->can_loan_messages() ? "true" : "false");
+  RecordProperty("direct_publish_allocations", std::to_string(direct_publish_allocations));
+  RecordProperty("servo_publish_allocations", std::to_string(servo_publish_allocations));
+  ASSERT_LE(servo_publish_allocations, direct_publish_allocations);
+}
+
+TEST(ServoUtilsUnitTests, TripleBuffer)
+{
+  moveit_servo::TripleBuffer<int> buffer(-1);
+  ASSERT_FALSE(buffer.hasNewValue());
+  ASSERT_EQ(buffer.read(), -1);
+
+  // Only the latest value is read, and it stays readable until a new one is written.
+  buffer.write(1);
+  buffer.write(2);
+  ASSERT_TRUE(buffer.hasNewValue());
+  ASSERT_EQ(buffer.read(), 2);
+  ASSERT_FALSE(buffer.hasNewValue());
+  ASSERT_EQ(buffer.read(), 2);
+
+  // A concurrent reader never sees values out of order.
+  std::thread writer([&buffer] {
+    for (int i = 3; i <= 100000; ++i)
+      buffer.write(i);
+  });
+  int last = 2;
+  int out_of_order = 0;
+  while (last < 100000)
+  {
+    const int value = buffer.read();
+    out_of_order += value < last;
+    last = std::max(last, value);
+  }
+  writer.join();
+  ASSERT_EQ(out_of_order, 0);
+}
+
+TEST(ServoUtilsUnitTests, LatencyTracer)
+{
+  constexpr size_t capacity = 100;
+  moveit_servo::LatencyTracer tracer(capacity);
+  const auto start = std::chrono::steady_clock::now();
+
+  // Record more cycles than the tracer keeps, cycle i takes i microseconds from its start to publishing.
+  constexpr size_t num_cycles = 250;
+  for (size_t i = 1; i <= num_cycles; ++i)
+  {
+    moveit_servo::CycleTrace trace;
+    const auto cycle_start = start + std::chrono::milliseconds(i);
+    trace.mark(moveit_servo::LatencyStage::CYCLE_START, cycle_start);
+    trace.mark(moveit_servo::LatencyStage::PUBLISHED, cycle_start + std::chrono::microseconds(i));
+    tracer.record(trace);
+  }
+
+  // Only the most recent cycles are kept, oldest first.
+  const auto traces = tracer.snapshot();
+  ASSERT_EQ(traces.size(), capacity);
+  for (size_t i = 1; i < traces.size(); ++i)
+  {
+    ASSERT_LT(traces[i - 1].stamp(moveit_servo::LatencyStage::CYCLE_START),
+              traces[i].stamp(moveit_servo::LatencyStage::CYCLE_START));
+  }
+
+  // Cycles 151 to 250 are kept. Only the cycle start and publication were traced, so the statistics between the
+  // stages in between, and between receiving a command and publishing it, are empty.
+  const auto statistics = moveit_servo::LatencyTracer::computeStatistics(traces);
+  ASSERT_EQ(statistics.size(), moveit_servo::LATENCY_STAGE_COUNT);
+  for (const auto& statistic : statistics)
+  {
+    EXPECT_EQ(statistic.samples, 0u);
+  }
+
+  // A trace that covers all stages in between contributes to the statistics.
+  moveit_servo::CycleTrace trace;
+  for (size_t stage = 0; stage < moveit_servo::LATENCY_STAGE_COUNT; ++stage)
+  {
+    trace.mark(static_cast<moveit_servo::LatencyStage>(stage), start + std::chrono::microseconds(10 * stage));
+  }
+  tracer.record(trace);
+  const auto full_statistics = moveit_servo::LatencyTracer::computeStatistics(tracer.snapshot());
+  ASSERT_EQ(full_statistics.back().samples, 1u);
+  EXPECT_EQ(full_statistics.back().from, moveit_servo::LatencyStage::COMMAND_RECEIVED);
+  EXPECT_EQ(full_statistics.back().to, moveit_servo::LatencyStage::PUBLISHED);
+  EXPECT_NEAR(full_statistics.back().p50, 50E-6, 1E-9);
+  EXPECT_NEAR(full_statistics.back().max, 50E-6, 1E-9);
+
+  // The recorded cycles can be dumped to a file with a header line.
+  const std::string file_path = testing::TempDir() + "servo_latency_trace.csv";
+  ASSERT_TRUE(tracer.dump(file_path));
+  std::ifstream file(file_path);
+  size_t num_lines = 0;
+  for (std::string line; std::getline(file, line);)
+  {
+    ++num_lines;
+  }
+  EXPECT_EQ(num_lines, capacity + 1);
+  std::remove(file_path.c_str());
+}
+
+TEST(ServoUtilsUnitTests, AnalyticIKClosestSolution)
+{
+  using namespace planar_arm_analytic_ik;
+  moveit::core::RobotModelPtr robot_model = createPlanarArmModel();
+  moveit::core::RobotStatePtr robot_state = std::make_shared<moveit::core::RobotState>(robot_model);
+  const auto joint_model_group = robot_model->getJointModelGroup(GROUP_NAME);
+
+  servo::Params servo_params;
+  servo_params.move_group_name = GROUP_NAME;
+  robot_state->setJointGroupPositions(joint_model_group, std::vector<double>{ 0.3, -1.2, 0.5 });
+  robot_state->update();
+
+  Eigen::Isometry3d target_pose = robot_state->getGlobalLinkTransform(TIP_FRAME);
+  target_pose.translation() += Eigen::Vector3d(0.002, -0.001, 0.0);
+  target_pose.rotate(Eigen::AngleAxisd(0.004, Eigen::Vector3d::UnitZ()));
+
+  // Without an IK solver there is no analytic solution.
+  auto delta_result =
+      moveit_servo::jointDeltaFromAnalyticIK(target_pose, robot_state, servo_params, BASE_FRAME, TIP_FRAME, {});
+  ASSERT_EQ(delta_result.first, moveit_servo::StatusCode::INVALID);
+
+  // The target is reached in one step, keeping the elbow down although the elbow up solution is also reported.
+  PlanarArmKinematics::attach(robot_model->getJointModelGroup(GROUP_NAME));
+  delta_result =
+      moveit_servo::jointDeltaFromAnalyticIK(target_pose, robot_state, servo_params, BASE_FRAME, TIP_FRAME, {});
+  ASSERT_EQ(delta_result.first, moveit_servo::StatusCode::NO_WARNING);
+  ASSERT_LT(delta_result.second.norm(), 0.01);
+
+  Eigen::VectorXd joint_positions;
+  robot_state->copyJointGroupPositions(joint_model_group, joint_positions);
+  robot_state->setJointGroupPositions(joint_model_group, joint_positions + delta_result.second);
+  robot_state->update();
+  const Eigen::Isometry3d reached_pose = robot_state->getGlobalLinkTransform(TIP_FRAME);
+  ASSERT_NEAR((reached_pose.translation() - target_pose.translation()).norm(), 0.0, 1E-9);
+  ASSERT_TRUE(reached_pose.linear().isApprox(target_pose.linear(), 1E-9));
+
+  // A target out of reach has no solution.
+  target_pose.translation() = Eigen::Vector3d(3.0, 0.0, 0.0);
+  delta_result =
+      moveit_servo::jointDeltaFromAnalyticIK(target_pose, robot_state, servo_params, BASE_FRAME, TIP_FRAME, {});
+  ASSERT_EQ(delta_result.first, moveit_servo::StatusCode::INVALID);
+}
+
+TEST(ServoUtilsUnitTests, AnalyticIKSolverJointOrder)
+{
+  using namespace reversed_order_kinematics;
+  moveit::core::RobotModelPtr robot_model = moveit::core::loadTestingRobotModel(ROBOT_NAME);
+  moveit::core::JointModelGroup* joint_model_group = robot_model->getJointModelGroup(GROUP_NAME);
+  ReversedOrderKinematics::attach(joint_model_group);
+
+  // The solver lists the joints of the six joint group in the opposite order.
+  const std::vector<unsigned int>& bijection = joint_model_group->getKinematicsSolverJointBijection();
+  ASSERT_EQ(bijection.size(), 6u);
+  ASSERT_EQ(bijection.front(), 5u);
+
+  servo::Params servo_params;
+  servo_params.move_group_name = GROUP_NAME;
+  moveit::core::RobotStatePtr robot_state = std::make_shared<moveit::core::RobotState>(robot_model);
+  const Eigen::VectorXd joint_positions = (Eigen::VectorXd(6) << 0.2, 0.3, -0.2, 0.4, -0.5, 0.6).finished();
+  robot_state->setJointGroupPositions(joint_model_group, joint_positions);
+  robot_state->update();
+
+  Eigen::Isometry3d target_pose = robot_state->getGlobalLinkTransform(TIP_FRAME);
+  target_pose.translation() += Eigen::Vector3d(0.002, -0.001, 0.001);
+  target_pose.rotate(Eigen::AngleAxisd(0.004, Eigen::Vector3d::UnitZ()));
+
+  // The closest solution is reached in one step, with each joint moving by its own share of the change.
+  const auto delta_result =
+      moveit_servo::jointDeltaFromAnalyticIK(target_pose, robot_state, servo_params, BASE_FRAME, TIP_FRAME, {});
+  ASSERT_EQ(delta_result.first, moveit_servo::StatusCode::NO_WARNING);
+  ASSERT_LT(delta_result.second.norm(), 0.05);
+
+  robot_state->setJointGroupPositions(joint_model_group, joint_positions + delta_result.second);
+  robot_state->update();
+  const Eigen::Isometry3d reached_pose = robot_state->getGlobalLinkTransform(TIP_FRAME);
+  ASSERT_NEAR((reached_pose.translation() - target_pose.translation()).norm(), 0.0, 1E-9);
+  ASSERT_TRUE(reached_pose.linear().isApprox(target_pose.linear(), 1E-9));
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
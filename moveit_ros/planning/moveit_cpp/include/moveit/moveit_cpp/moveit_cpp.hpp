@@ -72,6 +72,8 @@ public:
       node->get_parameter_or(ns + ".name", name, std::string("planning_scene_monitor"));
       node->get_parameter_or(ns + ".robot_description", robot_description, std::string("robot_description"));
       node->get_parameter_or(ns + ".wait_for_initial_state_timeout", wait_for_initial_state_timeout, 0.0);
+      node->get_parameter_or(ns + ".shared_memory_segment", shared_memory_segment, std::string());
+      node->get_parameter_or(ns + ".shared_memory_size_mb", shared_memory_size_mb, 256);
     }
     std::string name;
     std::string robot_description;
@@ -80,6 +82,9 @@ public:
     const std::string monitored_planning_scene_topic;
     const std::string publish_planning_scene_topic;
     double wait_for_initial_state_timeout;
+    /// If not empty, also write the planning scene into this shared memory segment for co-located processes
+    std::string shared_memory_segment;
+    int shared_memory_size_mb;
   };
 
   /// struct contains the the variables used for loading the planning pipeline
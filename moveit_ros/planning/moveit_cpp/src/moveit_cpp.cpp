@@ -34,6 +34,7 @@
 
 /* Author: Henning Kayser */
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <moveit/controller_manager/controller_manager.hpp>
@@ -102,6 +103,12 @@ bool MoveItCpp::loadPlanningSceneMonitor(const PlanningSceneMonitorOptions& opti
     // Publish planning scene updates to remote monitors like RViz
     planning_scene_monitor_->startPublishingPlanningScene(planning_scene_monitor::PlanningSceneMonitor::UPDATE_SCENE,
                                                           options.monitored_planning_scene_topic);
+    // Share the planning scene with co-located processes like servo without going through the middleware
+    if (!options.shared_memory_segment.empty())
+    {
+      planning_scene_monitor_->startSharedScenePublisher(
+          options.shared_memory_segment, static_cast<std::size_t>(std::max(1, options.shared_memory_size_mb)) << 20);
+    }
     // Monitor and apply planning scene updates from remote publishers like the PlanningSceneInterface
     planning_scene_monitor_->startSceneMonitor(options.publish_planning_scene_topic);
     // Monitor requests for changes in the collision environment
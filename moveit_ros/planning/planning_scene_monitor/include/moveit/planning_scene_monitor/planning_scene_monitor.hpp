@@ -44,6 +44,7 @@
 #include <moveit/robot_model_loader/robot_model_loader.hpp>
 #include <moveit/occupancy_map_monitor/occupancy_map_monitor.hpp>
 #include <moveit/planning_scene_monitor/current_state_monitor.hpp>
+#include <moveit/planning_scene_monitor/shared_scene_segment.hpp>
 #include <moveit/collision_plugin_loader/collision_plugin_loader.hpp>
 #include <moveit_msgs/srv/get_planning_scene.hpp>
 #include <memory>
@@ -116,6 +117,10 @@ public:
   /// name, so the topic is prefixed by the node name)
   static const std::string MONITORED_PLANNING_SCENE_TOPIC;  // "monitored_planning_scene"
 
+  /// The name of the shared memory segment used by default for sharing the planning scene between processes on the
+  /// same machine
+  static const std::string DEFAULT_SHARED_SCENE_SEGMENT;  // "/moveit_planning_scene"
+
   /** @brief Constructor
    *  @param robot_description The name of the ROS parameter that contains the URDF (in string format)
    *  @param name A name identifying this planning scene monitor
@@ -350,6 +355,34 @@ public:
   /** @brief Stop the scene monitor*/
   void stopSceneMonitor();
 
+  /** @brief Write the maintained planning scene into a shared memory segment whenever it changes, at most at the
+   *         planning scene publishing frequency. Monitors in other processes on the same machine can follow it with
+   *         startSharedSceneMonitor() instead of subscribing to the published scene. Updates that only move the robot
+   *         write its joint state to a small second segment (segment_name + "_state") instead of the complete scene.
+   *         Only one monitor should write a given segment.
+   *  @param segment_name The name of the POSIX shared memory segment
+   *  @param capacity The largest serialized planning scene (in bytes) the segment can hold
+   */
+  void startSharedScenePublisher(const std::string& segment_name = DEFAULT_SHARED_SCENE_SEGMENT,
+                                 std::size_t capacity = 256 * 1024 * 1024);
+
+  /** @brief Stop writing the maintained planning scene into shared memory and release the segment */
+  void stopSharedScenePublisher();
+
+  /** @brief Follow a planning scene that another process writes with startSharedScenePublisher(). Each new version
+   *         is applied as a diff against the previous one, so only changed objects are replaced, and robot state
+   *         updates only set the current state. Every follower still deserializes the scene into its own maintained
+   *         planning scene: the segment saves the topic transport, not the memory of the followers' scenes. Waits for
+   *         the segment to be created if it does not exist yet.
+   *  @param segment_name The name of the POSIX shared memory segment
+   *  @param poll_frequency How often to check for a new version (Hz)
+   */
+  void startSharedSceneMonitor(const std::string& segment_name = DEFAULT_SHARED_SCENE_SEGMENT,
+                               double poll_frequency = 100.0);
+
+  /** @brief Stop following the shared planning scene */
+  void stopSharedSceneMonitor();
+
   /** @brief Start the OccupancyMapMonitor and listening for:
    *     - Requests to add/remove/update collision objects to/from the world
    *     - The collision map
@@ -365,8 +398,13 @@ public:
   /** @brief Stop the world geometry monitor */
   void stopWorldGeometryMonitor();
 
-  /** @brief Add a function to be called when an update to the scene is received */
-  void addUpdateCallback(const std::function<void(SceneUpdateType)>& fn);
+  /** @brief Add a function to be called when an update to the scene is received
+   *  @return An id to pass to removeUpdateCallback() */
+  std::size_t addUpdateCallback(const std::function<void(SceneUpdateType)>& fn);
+
+  /** @brief Remove a function added by addUpdateCallback(). Once this returns, the function is not called anymore,
+   *  unless this is called from within the function itself. */
+  void removeUpdateCallback(std::size_t id);
 
   /** @brief Clear the functions to be called when an update to the scene is received */
   void clearUpdateCallbacks();
@@ -505,6 +543,17 @@ protected:
   std::atomic<SceneUpdateType> new_scene_update_;
   std::condition_variable_any new_scene_update_condition_;
 
+  // variables for sharing the planning scene through shared memory
+  SharedSceneSegmentPtr shared_scene_publisher_segment_;
+  SharedSceneSegmentPtr shared_scene_state_publisher_segment_;
+  std::thread shared_scene_publisher_thread_;
+  std::thread shared_scene_monitor_thread_;
+  std::mutex shared_scene_mutex_;
+  std::condition_variable shared_scene_condition_;
+  SceneUpdateType shared_scene_pending_update_;
+  bool shared_scene_publisher_running_;
+  bool shared_scene_monitor_running_;
+
   // subscribe to various sources of data
   rclcpp::Subscription<moveit_msgs::msg::PlanningScene>::SharedPtr planning_scene_subscriber_;
   rclcpp::Subscription<moveit_msgs::msg::PlanningSceneWorld>::SharedPtr planning_scene_world_subscriber_;
@@ -537,8 +586,9 @@ protected:
 
   /// lock access to update_callbacks_
   std::recursive_mutex update_lock_;
-  std::vector<std::function<void(SceneUpdateType)> > update_callbacks_;  /// List of callbacks to trigger when updates
-                                                                         /// are received
+  std::vector<std::pair<std::size_t, std::function<void(SceneUpdateType)> > >
+      update_callbacks_;                     /// List of callbacks to trigger when updates are received, with their ids
+  std::size_t last_update_callback_id_ = 0;  /// The id of the callback added last
 
 private:
   void getUpdatedFrameTransforms(std::vector<geometry_msgs::msg::TransformStamped>& transforms);
@@ -546,6 +596,12 @@ private:
   // publish planning scene update diffs (runs in its own thread)
   void scenePublishingThread();
 
+  // write the full planning scene into shared memory on updates (runs in its own thread)
+  void sharedScenePublishingThread();
+
+  // apply new versions of a planning scene shared through memory (runs in its own thread)
+  void sharedSceneMonitorThread(const std::string& segment_name, double poll_frequency);
+
   // called by current_state_monitor_ when robot state (as monitored on joint state topic) changes
   void onStateUpdate(const sensor_msgs::msg::JointState::ConstSharedPtr& joint_state);
 
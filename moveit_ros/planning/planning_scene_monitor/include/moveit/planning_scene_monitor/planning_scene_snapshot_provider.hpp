@@ -0,0 +1,79 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+#include <moveit/planning_scene_monitor/planning_scene_monitor.hpp>
+#include <atomic>
+#include <mutex>
+
+#include <moveit_planning_scene_monitor_export.h>
+
+namespace planning_scene_monitor
+{
+/** \brief Hands out read-only snapshots of a monitored planning scene.
+
+    A snapshot is shared by all callers until the monitored scene changes, and the monitored scene is only locked while
+    a new snapshot is taken. Only changes to the world, the transforms or the attached objects make a full copy of the
+    scene. After an update of the robot state alone, the new snapshot is a diff of the last full copy that only
+    carries the new state, so the world is shared instead of copied again. */
+class MOVEIT_PLANNING_SCENE_MONITOR_EXPORT PlanningSceneSnapshotProvider
+{
+public:
+  PlanningSceneSnapshotProvider(const PlanningSceneMonitorPtr& planning_scene_monitor);
+  ~PlanningSceneSnapshotProvider();
+
+  /** \brief Get a snapshot of the current monitored scene */
+  planning_scene::PlanningSceneConstPtr getSnapshot();
+
+  /** \brief Get the number of full copies of the monitored scene taken so far */
+  std::size_t getSceneCopyCount() const;
+
+private:
+  PlanningSceneMonitorPtr planning_scene_monitor_;
+  std::size_t update_callback_id_;
+
+  // counted by the update callback of the monitor
+  std::atomic<std::size_t> scene_updates_;
+  std::atomic<std::size_t> state_updates_;
+
+  mutable std::mutex snapshot_mutex_;
+  planning_scene::PlanningSceneConstPtr scene_copy_;
+  planning_scene::PlanningSceneConstPtr snapshot_;
+  std::size_t scene_generation_;
+  std::size_t state_generation_;
+  std::size_t scene_copy_count_;
+};
+}  // namespace planning_scene_monitor
@@ -0,0 +1,114 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#pragma once
+
+#include <moveit/macros/class_forward.hpp>
+#include <moveit_msgs/msg/planning_scene.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <moveit_planning_scene_monitor_export.h>
+
+namespace planning_scene_monitor
+{
+MOVEIT_CLASS_FORWARD(SharedSceneSegment);  // Defines SharedSceneSegmentPtr, ConstPtr, WeakPtr... etc
+
+/** \brief A POSIX shared memory segment holding versioned planning scene snapshots.
+
+    One process creates the segment and writes complete planning scene messages into it; any number of processes on the
+    same machine map it read-only and pick up the latest version when they poll. The segment holds two slots that the
+    writer alternates between, so readers never block the writer and only retry if the writer lapped them while they
+    were copying. Snapshots are stored serialized, which replaces the topic transport (and its per-subscriber copies)
+    but still leaves every reader with its own deserialized scene. */
+class MOVEIT_PLANNING_SCENE_MONITOR_EXPORT SharedSceneSegment
+{
+public:
+  /** \brief Create the segment \e name (e.g. "/moveit_planning_scene") for writing, with room for snapshots of up to
+      \e capacity serialized bytes. An existing segment of the same name is replaced. Throws std::runtime_error. */
+  static SharedSceneSegmentPtr create(const std::string& name, std::size_t capacity);
+
+  /** \brief Map the existing segment \e name read-only. Throws std::runtime_error if it does not exist. */
+  static SharedSceneSegmentPtr open(const std::string& name);
+
+  ~SharedSceneSegment();
+
+  SharedSceneSegment(const SharedSceneSegment&) = delete;
+  SharedSceneSegment& operator=(const SharedSceneSegment&) = delete;
+
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  /** \brief The largest serialized snapshot the segment can hold */
+  std::size_t getCapacity() const;
+
+  /** \brief The version of the latest snapshot; 0 if nothing was written yet */
+  std::uint64_t getVersion() const;
+
+  /** \brief True once the writer has released the segment; readers should reopen it */
+  bool isClosed() const;
+
+  /** \brief Write \e scene as the next version. Returns false if the segment was opened read-only or \e scene does not
+      fit. Only one thread may write. */
+  bool write(const moveit_msgs::msg::PlanningScene& scene);
+
+  /** \brief If a snapshot newer than \e version is available, read it into \e scene, set \e version to its version and
+      \e stamp (if given) to the steady clock time it was written at, and return true. */
+  bool read(moveit_msgs::msg::PlanningScene& scene, std::uint64_t& version,
+            std::chrono::steady_clock::time_point* stamp = nullptr);
+
+private:
+  struct Header;
+
+  SharedSceneSegment(std::string name, int fd, void* address, std::size_t size, bool writable);
+
+  Header* header() const;
+  std::uint8_t* slotData(std::uint32_t slot) const;
+
+  std::string name_;
+  int fd_;
+  void* address_;
+  std::size_t size_;
+  bool writable_;
+
+  rclcpp::SerializedMessage buffer_;
+};
+}  // namespace planning_scene_monitor
@@ -36,6 +36,7 @@
 
 #include <moveit/planning_scene_monitor/planning_scene_monitor.hpp>
 #include <moveit/robot_model_loader/robot_model_loader.hpp>
+#include <moveit/robot_state/conversions.hpp>
 #include <moveit/utils/message_checks.hpp>
 #include <moveit/exceptions/exceptions.hpp>
 #include <moveit_msgs/srv/get_planning_scene.hpp>
@@ -58,7 +59,10 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 
 #include <fmt/format.h>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <optional>
 
 #include <std_msgs/msg/string.hpp>
 
@@ -74,6 +78,69 @@ const std::string PlanningSceneMonitor::DEFAULT_PLANNING_SCENE_WORLD_TOPIC = "pl
 const std::string PlanningSceneMonitor::DEFAULT_PLANNING_SCENE_TOPIC = "planning_scene";
 const std::string PlanningSceneMonitor::DEFAULT_PLANNING_SCENE_SERVICE = "get_planning_scene";
 const std::string PlanningSceneMonitor::MONITORED_PLANNING_SCENE_TOPIC = "monitored_planning_scene";
+const std::string PlanningSceneMonitor::DEFAULT_SHARED_SCENE_SEGMENT = "/moveit_planning_scene";
+
+namespace
+{
+// robot state updates go to a second, small segment next to the complete scene
+const std::string SHARED_SCENE_STATE_SUFFIX = "_state";
+constexpr std::size_t SHARED_STATE_CAPACITY = 1024 * 1024;
+
+// Turn the complete scene next into a diff against the complete scene previous, so a reader following the shared
+// scene only replaces the objects that changed instead of rebuilding its whole world
+moveit_msgs::msg::PlanningScene diffSharedScene(const moveit_msgs::msg::PlanningScene& previous,
+                                                const moveit_msgs::msg::PlanningScene& next)
+{
+  if (previous.robot_model_name != next.robot_model_name)
+    return next;
+
+  moveit_msgs::msg::PlanningScene diff;
+  diff.is_diff = true;
+  diff.name = next.name;
+  diff.robot_model_name = next.robot_model_name;
+  diff.fixed_frame_transforms = next.fixed_frame_transforms;
+  diff.allowed_collision_matrix = next.allowed_collision_matrix;
+  diff.link_padding = next.link_padding;
+  diff.link_scale = next.link_scale;
+  diff.object_colors = next.object_colors;
+
+  // a complete robot state replaces all attached bodies, so only send them if they changed
+  diff.robot_state = next.robot_state;
+  if (next.robot_state.attached_collision_objects == previous.robot_state.attached_collision_objects)
+  {
+    diff.robot_state.attached_collision_objects.clear();
+    diff.robot_state.is_diff = true;
+  }
+
+  std::map<std::string, const moveit_msgs::msg::CollisionObject*> removed;
+  for (const moveit_msgs::msg::CollisionObject& object : previous.world.collision_objects)
+    removed[object.id] = &object;
+  for (const moveit_msgs::msg::CollisionObject& object : next.world.collision_objects)
+  {
+    const auto it = removed.find(object.id);
+    // an ADD of an existing object replaces it
+    if (it == removed.end() || !(*it->second == object))
+      diff.world.collision_objects.push_back(object);
+    if (it != removed.end())
+      removed.erase(it);
+  }
+  for (const auto& [id, object] : removed)
+  {
+    moveit_msgs::msg::CollisionObject& remove = diff.world.collision_objects.emplace_back();
+    remove.id = id;
+    remove.header = object->header;
+    remove.operation = moveit_msgs::msg::CollisionObject::REMOVE;
+  }
+
+  if (!(next.world.octomap == previous.world.octomap))
+  {
+    diff.world.octomap = next.world.octomap;
+    // an octomap without data removes the previous one
+    diff.world.octomap.octomap.id = "OcTree";
+  }
+  return diff;
+}
+}  // namespace
 
 PlanningSceneMonitor::PlanningSceneMonitor(const rclcpp::Node::SharedPtr& node, const std::string& robot_description,
                                            const std::string& name)
@@ -104,6 +171,9 @@ PlanningSceneMonitor::PlanningSceneMonitor(const rclcpp::Node::SharedPtr& node,
   , node_(node)
   , private_executor_(std::make_shared<rclcpp::executors::SingleThreadedExecutor>())
   , tf_buffer_(std::make_shared<tf2_ros::Buffer>(node->get_clock()))
+  , shared_scene_pending_update_(UPDATE_NONE)
+  , shared_scene_publisher_running_(false)
+  , shared_scene_monitor_running_(false)
   , dt_state_update_(0.0)
   , shape_transform_cache_lookup_wait_time_(0, 0)
   , rm_loader_(rm_loader)
@@ -136,6 +206,8 @@ PlanningSceneMonitor::~PlanningSceneMonitor()
     scene_->setCollisionObjectUpdateCallback(collision_detection::World::ObserverCallbackFn());
     scene_->setAttachedBodyUpdateCallback(moveit::core::AttachedBodyCallback());
   }
+  stopSharedSceneMonitor();
+  stopSharedScenePublisher();
   stopPublishingPlanningScene();
   stopStateMonitor();
   stopWorldGeometryMonitor();
@@ -551,6 +623,193 @@ void PlanningSceneMonitor::scenePublishingThread()
   } while (publish_planning_scene_);
 }
 
+void PlanningSceneMonitor::startSharedScenePublisher(const std::string& segment_name, std::size_t capacity)
+{
+  if (shared_scene_publisher_thread_.joinable())
+  {
+    RCLCPP_WARN(logger_, "The planning scene is already written to shared memory segment '%s'",
+                shared_scene_publisher_segment_->getName().c_str());
+    return;
+  }
+  if (!scene_)
+  {
+    RCLCPP_WARN(logger_, "Did not find a planning scene, so cannot share it.");
+    return;
+  }
+
+  try
+  {
+    shared_scene_publisher_segment_ = SharedSceneSegment::create(segment_name, capacity);
+    shared_scene_state_publisher_segment_ =
+        SharedSceneSegment::create(segment_name + SHARED_SCENE_STATE_SUFFIX, std::min(capacity, SHARED_STATE_CAPACITY));
+  }
+  catch (const std::runtime_error& e)
+  {
+    RCLCPP_ERROR(logger_, "Cannot share the planning scene: %s", e.what());
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(shared_scene_mutex_);
+    shared_scene_publisher_running_ = true;
+    shared_scene_pending_update_ = UPDATE_SCENE;  // write the current scene right away
+  }
+  shared_scene_publisher_thread_ = std::thread([this] { sharedScenePublishingThread(); });
+  RCLCPP_INFO(logger_, "Writing the maintained planning scene to shared memory segment '%s'", segment_name.c_str());
+}
+
+void PlanningSceneMonitor::stopSharedScenePublisher()
+{
+  if (!shared_scene_publisher_thread_.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(shared_scene_mutex_);
+    shared_scene_publisher_running_ = false;
+  }
+  shared_scene_condition_.notify_all();
+  shared_scene_publisher_thread_.join();
+  shared_scene_publisher_segment_.reset();
+  shared_scene_state_publisher_segment_.reset();
+  RCLCPP_INFO(logger_, "Stopped writing the maintained planning scene to shared memory.");
+}
+
+void PlanningSceneMonitor::sharedScenePublishingThread()
+{
+  while (true)
+  {
+    SceneUpdateType update;
+    {
+      std::unique_lock<std::mutex> lock(shared_scene_mutex_);
+      shared_scene_condition_.wait(
+          lock, [this] { return !shared_scene_publisher_running_ || shared_scene_pending_update_ != UPDATE_NONE; });
+      if (!shared_scene_publisher_running_)
+        return;
+      update = shared_scene_pending_update_;
+      shared_scene_pending_update_ = UPDATE_NONE;
+    }
+
+    rclcpp::Rate rate(publish_planning_scene_frequency_);
+    moveit_msgs::msg::PlanningScene msg;
+    SharedSceneSegment* segment = shared_scene_publisher_segment_.get();
+    if (update == UPDATE_STATE)
+    {
+      // only the robot moved: write just its joints, so readers neither copy nor re-apply the world
+      segment = shared_scene_state_publisher_segment_.get();
+      msg.is_diff = true;
+      {
+        std::shared_lock<std::shared_mutex> lock(scene_update_mutex_);
+        moveit::core::robotStateToRobotStateMsg(scene_->getCurrentState(), msg.robot_state, false);
+      }
+      msg.robot_state.is_diff = true;
+    }
+    else
+    {
+      std::shared_lock<std::shared_mutex> lock(scene_update_mutex_);
+      collision_detection::OccMapTree::ReadLock octomap_lock;
+      if (octomap_monitor_)
+        octomap_lock = octomap_monitor_->getOcTreePtr()->reading();
+      scene_->getPlanningSceneMsg(msg);
+    }
+    msg.robot_state.joint_state.header.stamp = last_robot_motion_time_;
+    if (!segment->write(msg))
+    {
+      rclcpp::Clock steady_clock = rclcpp::Clock();
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+      RCLCPP_ERROR_THROTTLE(logger_, steady_clock, 5000,
+                            "The planning scene does not fit into shared memory segment '%s' (%zu bytes)",
+                            segment->getName().c_str(), segment->getCapacity());
+#pragma GCC diagnostic pop
+    }
+    rate.sleep();
+  }
+}
+
+void PlanningSceneMonitor::startSharedSceneMonitor(const std::string& segment_name, double poll_frequency)
+{
+  stopSharedSceneMonitor();
+  {
+    std::lock_guard<std::mutex> lock(shared_scene_mutex_);
+    shared_scene_monitor_running_ = true;
+  }
+  shared_scene_monitor_thread_ = std::thread(
+      [this, segment_name, poll_frequency] { sharedSceneMonitorThread(segment_name, poll_frequency); });
+  RCLCPP_INFO(logger_, "Listening to shared memory segment '%s' for planning scenes", segment_name.c_str());
+}
+
+void PlanningSceneMonitor::stopSharedSceneMonitor()
+{
+  if (!shared_scene_monitor_thread_.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(shared_scene_mutex_);
+    shared_scene_monitor_running_ = false;
+  }
+  shared_scene_condition_.notify_all();
+  shared_scene_monitor_thread_.join();
+  RCLCPP_INFO(logger_, "Stopped listening to shared memory for planning scenes.");
+}
+
+void PlanningSceneMonitor::sharedSceneMonitorThread(const std::string& segment_name, double poll_frequency)
+{
+  const auto period = std::chrono::duration<double>(1.0 / std::max(poll_frequency, 1e-3));
+  SharedSceneSegmentPtr segment;
+  SharedSceneSegmentPtr state_segment;
+  std::uint64_t version = 0;
+  std::uint64_t state_version = 0;
+  // the last complete scene applied and when it was written, to diff the next one against
+  std::optional<moveit_msgs::msg::PlanningScene> applied_scene;
+  std::chrono::steady_clock::time_point applied_stamp;
+  moveit_msgs::msg::PlanningScene msg;
+  while (true)
+  {
+    // a segment released by its writer is reopened once the writer (or a new one) creates it again
+    if (segment && segment->isClosed())
+    {
+      segment.reset();
+      state_segment.reset();
+    }
+    if (!segment)
+    {
+      try
+      {
+        segment = SharedSceneSegment::open(segment_name);
+        state_segment = SharedSceneSegment::open(segment_name + SHARED_SCENE_STATE_SUFFIX);
+        version = 0;
+        state_version = 0;
+        applied_scene.reset();
+      }
+      catch (const std::runtime_error& e)
+      {
+        segment.reset();
+        RCLCPP_DEBUG(logger_, "Waiting for the shared planning scene: %s", e.what());
+      }
+    }
+
+    std::chrono::steady_clock::time_point stamp;
+    if (segment && segment->read(msg, version, &stamp))
+    {
+      if (applied_scene)
+      {
+        newPlanningSceneMessage(diffSharedScene(*applied_scene, msg));
+        std::swap(*applied_scene, msg);
+      }
+      else
+      {
+        newPlanningSceneMessage(msg);
+        applied_scene = std::move(msg);
+      }
+      applied_stamp = stamp;
+    }
+    // a state written before the last complete scene is already part of it
+    if (applied_scene && state_segment && state_segment->read(msg, state_version, &stamp) && stamp > applied_stamp)
+      newPlanningSceneMessage(msg);
+
+    std::unique_lock<std::mutex> lock(shared_scene_mutex_);
+    if (shared_scene_condition_.wait_for(lock, period, [this] { return !shared_scene_monitor_running_; }))
+      return;
+  }
+}
+
 void PlanningSceneMonitor::getMonitoredTopics(std::vector<std::string>& topics) const
 {
   // TODO(anasarrak): Do we need this for ROS2?
@@ -601,10 +860,17 @@ void PlanningSceneMonitor::triggerSceneUpdateEvent(SceneUpdateType update_type)
   // do not modify update functions while we are calling them
   std::scoped_lock lock(update_lock_);
 
-  for (std::function<void(SceneUpdateType)>& update_callback : update_callbacks_)
+  for (auto& [id, update_callback] : update_callbacks_)
     update_callback(update_type);
   new_scene_update_ = static_cast<SceneUpdateType>(static_cast<int>(new_scene_update_) | static_cast<int>(update_type));
   new_scene_update_condition_.notify_all();
+
+  {
+    std::lock_guard<std::mutex> shared_lock(shared_scene_mutex_);
+    shared_scene_pending_update_ =
+        static_cast<SceneUpdateType>(static_cast<int>(shared_scene_pending_update_) | static_cast<int>(update_type));
+  }
+  shared_scene_condition_.notify_all();
 }
 
 bool PlanningSceneMonitor::requestPlanningSceneState(const std::string& service_name)
@@ -1530,11 +1796,21 @@ void PlanningSceneMonitor::updateSceneWithCurrentState(bool skip_update_if_locke
   }
 }
 
-void PlanningSceneMonitor::addUpdateCallback(const std::function<void(SceneUpdateType)>& fn)
+std::size_t PlanningSceneMonitor::addUpdateCallback(const std::function<void(SceneUpdateType)>& fn)
+{
+  std::scoped_lock lock(update_lock_);
+  if (!fn)
+    return 0;
+  update_callbacks_.emplace_back(++last_update_callback_id_, fn);
+  return last_update_callback_id_;
+}
+
+void PlanningSceneMonitor::removeUpdateCallback(std::size_t id)
 {
   std::scoped_lock lock(update_lock_);
-  if (fn)
-    update_callbacks_.push_back(fn);
+  update_callbacks_.erase(std::remove_if(update_callbacks_.begin(), update_callbacks_.end(),
+                                         [id](const auto& callback) { return callback.first == id; }),
+                          update_callbacks_.end());
 }
 
 void PlanningSceneMonitor::clearUpdateCallbacks()
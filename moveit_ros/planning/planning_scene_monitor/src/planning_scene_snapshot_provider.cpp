@@ -0,0 +1,92 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <moveit/planning_scene_monitor/planning_scene_snapshot_provider.hpp>
+
+namespace planning_scene_monitor
+{
+PlanningSceneSnapshotProvider::PlanningSceneSnapshotProvider(const PlanningSceneMonitorPtr& planning_scene_monitor)
+  : planning_scene_monitor_(planning_scene_monitor)
+  , update_callback_id_(0)
+  , scene_updates_(0)
+  , state_updates_(0)
+  , scene_generation_(0)
+  , state_generation_(0)
+  , scene_copy_count_(0)
+{
+  update_callback_id_ = planning_scene_monitor_->addUpdateCallback([this](PlanningSceneMonitor::SceneUpdateType type) {
+    if (type == PlanningSceneMonitor::UPDATE_STATE)
+      ++state_updates_;
+    else if (type != PlanningSceneMonitor::UPDATE_NONE)
+      ++scene_updates_;
+  });
+}
+
+PlanningSceneSnapshotProvider::~PlanningSceneSnapshotProvider()
+{
+  planning_scene_monitor_->removeUpdateCallback(update_callback_id_);
+}
+
+planning_scene::PlanningSceneConstPtr PlanningSceneSnapshotProvider::getSnapshot()
+{
+  std::lock_guard<std::mutex> lock(snapshot_mutex_);
+  if (snapshot_ && scene_generation_ == scene_updates_.load() && state_generation_ == state_updates_.load())
+    return snapshot_;
+
+  // read the counters under the scene lock: an update that is not yet counted only causes a redundant snapshot
+  LockedPlanningSceneRO ls(planning_scene_monitor_);
+  state_generation_ = state_updates_.load();
+  if (!scene_copy_ || scene_generation_ != scene_updates_.load())
+  {
+    scene_generation_ = scene_updates_.load();
+    scene_copy_ = planning_scene::PlanningScene::clone(ls);
+    ++scene_copy_count_;
+    snapshot_ = scene_copy_;
+    return snapshot_;
+  }
+
+  // only the robot state changed
+  planning_scene::PlanningScenePtr snapshot = scene_copy_->diff();
+  snapshot->setCurrentState(ls->getCurrentState());
+  snapshot_ = snapshot;
+  return snapshot_;
+}
+
+std::size_t PlanningSceneSnapshotProvider::getSceneCopyCount() const
+{
+  std::lock_guard<std::mutex> lock(snapshot_mutex_);
+  return scene_copy_count_;
+}
+}  // namespace planning_scene_monitor
@@ -0,0 +1,280 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <moveit/planning_scene_monitor/shared_scene_segment.hpp>
+#include <rclcpp/serialization.hpp>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace planning_scene_monitor
+{
+namespace
+{
+constexpr std::uint64_t SEGMENT_MAGIC = 0x4d6f766549745053;  // "MoveItPS"
+constexpr std::uint32_t SLOT_COUNT = 2;
+
+std::runtime_error segmentError(const std::string& what, const std::string& name)
+{
+  return std::runtime_error(what + " '" + name + "': " + std::strerror(errno));
+}
+
+std::int64_t steadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+// Layout at the start of the segment; the slot data follows, each slot taking 'capacity' bytes.
+// Each slot is guarded by a sequence counter that is odd while the writer fills the slot.
+struct SharedSceneSegment::Header
+{
+  struct Slot
+  {
+    std::atomic<std::uint64_t> sequence;
+    std::uint64_t version;
+    std::int64_t stamp;  // steady clock nanoseconds, which are comparable across processes on Linux
+    std::uint64_t size;
+  };
+
+  std::uint64_t magic;
+  std::uint64_t capacity;
+  std::atomic<std::uint64_t> version;
+  std::atomic<std::uint32_t> active;
+  std::atomic<std::uint32_t> closed;
+  Slot slots[SLOT_COUNT];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+              "shared memory synchronization requires lock-free atomics");
+
+SharedSceneSegmentPtr SharedSceneSegment::create(const std::string& name, std::size_t capacity)
+{
+  // replace a segment left over by a previous writer; readers that still map it see it closed
+  shm_unlink(name.c_str());
+  const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0)
+    throw segmentError("Failed to create shared memory segment", name);
+
+  const std::size_t size = sizeof(Header) + SLOT_COUNT * capacity;
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    const std::runtime_error error = segmentError("Failed to size shared memory segment", name);
+    close(fd);
+    shm_unlink(name.c_str());
+    throw error;
+  }
+  void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED)
+  {
+    const std::runtime_error error = segmentError("Failed to map shared memory segment", name);
+    close(fd);
+    shm_unlink(name.c_str());
+    throw error;
+  }
+
+  Header* header = new (address) Header();
+  header->capacity = capacity;
+  header->version.store(0);
+  header->active.store(0);
+  header->closed.store(0);
+  for (Header::Slot& slot : header->slots)
+  {
+    slot.sequence.store(0);
+    slot.version = 0;
+    slot.stamp = 0;
+    slot.size = 0;
+  }
+  // readers check the magic number last, so they never see a partially initialized header
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = SEGMENT_MAGIC;
+
+  return SharedSceneSegmentPtr(new SharedSceneSegment(name, fd, address, size, true));
+}
+
+SharedSceneSegmentPtr SharedSceneSegment::open(const std::string& name)
+{
+  const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    throw segmentError("Failed to open shared memory segment", name);
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header))
+  {
+    close(fd);
+    throw std::runtime_error("Shared memory segment '" + name + "' is not initialized");
+  }
+  const std::size_t size = static_cast<std::size_t>(info.st_size);
+  void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED)
+  {
+    const std::runtime_error error = segmentError("Failed to map shared memory segment", name);
+    close(fd);
+    throw error;
+  }
+
+  const Header* header = static_cast<const Header*>(address);
+  if (header->magic != SEGMENT_MAGIC || sizeof(Header) + SLOT_COUNT * header->capacity > size)
+  {
+    munmap(address, size);
+    close(fd);
+    throw std::runtime_error("Shared memory segment '" + name + "' does not hold planning scenes");
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  return SharedSceneSegmentPtr(new SharedSceneSegment(name, fd, address, size, false));
+}
+
+SharedSceneSegment::SharedSceneSegment(std::string name, int fd, void* address, std::size_t size, bool writable)
+  : name_(std::move(name)), fd_(fd), address_(address), size_(size), writable_(writable)
+{
+}
+
+SharedSceneSegment::~SharedSceneSegment()
+{
+  if (writable_)
+  {
+    header()->closed.store(1, std::memory_order_release);
+    shm_unlink(name_.c_str());
+  }
+  munmap(address_, size_);
+  close(fd_);
+}
+
+SharedSceneSegment::Header* SharedSceneSegment::header() const
+{
+  return static_cast<Header*>(address_);
+}
+
+std::uint8_t* SharedSceneSegment::slotData(std::uint32_t slot) const
+{
+  return static_cast<std::uint8_t*>(address_) + sizeof(Header) + slot * header()->capacity;
+}
+
+std::size_t SharedSceneSegment::getCapacity() const
+{
+  return header()->capacity;
+}
+
+std::uint64_t SharedSceneSegment::getVersion() const
+{
+  return header()->version.load(std::memory_order_acquire);
+}
+
+bool SharedSceneSegment::isClosed() const
+{
+  return header()->closed.load(std::memory_order_acquire) != 0;
+}
+
+bool SharedSceneSegment::write(const moveit_msgs::msg::PlanningScene& scene)
+{
+  if (!writable_)
+    return false;
+
+  static const rclcpp::Serialization<moveit_msgs::msg::PlanningScene> SERIALIZATION;
+  SERIALIZATION.serialize_message(&scene, &buffer_);
+  const rcl_serialized_message_t& serialized = buffer_.get_rcl_serialized_message();
+  Header* h = header();
+  if (serialized.buffer_length > h->capacity)
+    return false;
+
+  // fill the slot readers are not directed to
+  const std::uint32_t slot_index = (h->active.load(std::memory_order_relaxed) + 1) % SLOT_COUNT;
+  Header::Slot& slot = h->slots[slot_index];
+  const std::uint64_t version = h->version.load(std::memory_order_relaxed) + 1;
+
+  const std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.version = version;
+  slot.stamp = steadyNow();
+  slot.size = serialized.buffer_length;
+  std::memcpy(slotData(slot_index), serialized.buffer, serialized.buffer_length);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+
+  h->active.store(slot_index, std::memory_order_release);
+  h->version.store(version, std::memory_order_release);
+  return true;
+}
+
+bool SharedSceneSegment::read(moveit_msgs::msg::PlanningScene& scene, std::uint64_t& version,
+                              std::chrono::steady_clock::time_point* stamp)
+{
+  const Header* h = header();
+  // the writer only laps a reader if it writes twice while the reader copies, so a few attempts are enough
+  for (int attempt = 0; attempt < 8; ++attempt)
+  {
+    if (h->version.load(std::memory_order_acquire) == version)
+      return false;
+
+    const std::uint32_t slot_index = h->active.load(std::memory_order_acquire);
+    const Header::Slot& slot = h->slots[slot_index];
+    const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence % 2 != 0)
+      continue;
+
+    const std::uint64_t slot_version = slot.version;
+    const std::int64_t slot_stamp = slot.stamp;
+    const std::size_t size = slot.size;
+    if (size > h->capacity)
+      continue;
+    buffer_.reserve(size);
+    std::memcpy(buffer_.get_rcl_serialized_message().buffer, slotData(slot_index), size);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+    if (slot_version == version)
+      return false;
+
+    buffer_.get_rcl_serialized_message().buffer_length = size;
+    static const rclcpp::Serialization<moveit_msgs::msg::PlanningScene> SERIALIZATION;
+    SERIALIZATION.deserialize_message(&buffer_, &scene);
+    version = slot_version;
+    if (stamp)
+      *stamp = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(slot_stamp));
+    return true;
+  }
+  return false;
+}
+}  // namespace planning_scene_monitor
@@ -44,8 +44,11 @@
 
 // Main class
 #include <moveit/planning_scene_monitor/planning_scene_monitor.hpp>
+#include <moveit/planning_scene_monitor/planning_scene_snapshot_provider.hpp>
 #include <moveit/robot_state/conversions.hpp>
 
+#include <unistd.h>
+
 class PlanningSceneMonitorTest : public ::testing::Test
 {
 public:
@@ -147,6 +150,146 @@ TEST_F(PlanningSceneMonitorTest, UpdateTypes)
   TRIGGERS_UPDATE(msg, UpdateType::UPDATE_SCENE);
 }
 
+TEST_F(PlanningSceneMonitorTest, RemoveUpdateCallback)
+{
+  int first_calls = 0;
+  int second_calls = 0;
+  const std::size_t first = planning_scene_monitor_->addUpdateCallback([&](auto /*type*/) { ++first_calls; });
+  planning_scene_monitor_->addUpdateCallback([&](auto /*type*/) { ++second_calls; });
+
+  moveit_msgs::msg::PlanningScene msg;
+  msg.is_diff = msg.robot_state.is_diff = false;
+  planning_scene_monitor_->newPlanningSceneMessage(msg);
+  EXPECT_EQ(first_calls, 1);
+  EXPECT_EQ(second_calls, 1);
+
+  planning_scene_monitor_->removeUpdateCallback(first);
+  planning_scene_monitor_->newPlanningSceneMessage(msg);
+  EXPECT_EQ(first_calls, 1);
+  EXPECT_EQ(second_calls, 2);
+  planning_scene_monitor_->clearUpdateCallbacks();
+}
+
+TEST_F(PlanningSceneMonitorTest, SnapshotsShareTheWorldAcrossStateUpdates)
+{
+  planning_scene_monitor::PlanningSceneSnapshotProvider provider(planning_scene_monitor_);
+  const planning_scene::PlanningSceneConstPtr first = provider.getSnapshot();
+  EXPECT_EQ(provider.getSnapshot(), first);
+  EXPECT_EQ(provider.getSceneCopyCount(), 1u);
+
+  // updates of the robot state alone give new snapshots that carry the state, but do not copy the scene again
+  moveit::core::RobotState state(scene_->getCurrentState());
+  planning_scene::PlanningSceneConstPtr previous = first;
+  for (int i = 0; i < 3; ++i)
+  {
+    state.setToRandomPositions();
+    moveit_msgs::msg::PlanningScene msg;
+    msg.is_diff = true;
+    moveit::core::robotStateToRobotStateMsg(state, msg.robot_state, false);
+    msg.robot_state.is_diff = true;
+    planning_scene_monitor_->newPlanningSceneMessage(msg);
+
+    const planning_scene::PlanningSceneConstPtr snapshot = provider.getSnapshot();
+    EXPECT_NE(snapshot, previous);
+    EXPECT_EQ(provider.getSceneCopyCount(), 1u);
+    EXPECT_LT(snapshot->getCurrentState().distance(state), 1e-9);
+    previous = snapshot;
+  }
+
+  // a geometry update makes a new copy
+  moveit_msgs::msg::PlanningScene msg;
+  msg.is_diff = msg.robot_state.is_diff = true;
+  moveit_msgs::msg::CollisionObject collision_object;
+  collision_object.header.frame_id = scene_->getPlanningFrame();
+  collision_object.id = "object";
+  collision_object.operation = moveit_msgs::msg::CollisionObject::ADD;
+  collision_object.pose.orientation.w = 1.0;
+  collision_object.primitives.emplace_back();
+  collision_object.primitives.back().type = shape_msgs::msg::SolidPrimitive::SPHERE;
+  collision_object.primitives.back().dimensions = { 0.1 };
+  msg.world.collision_objects.push_back(collision_object);
+  planning_scene_monitor_->newPlanningSceneMessage(msg);
+
+  const planning_scene::PlanningSceneConstPtr with_object = provider.getSnapshot();
+  EXPECT_EQ(provider.getSceneCopyCount(), 2u);
+  EXPECT_TRUE(with_object->getWorld()->hasObject("object"));
+  EXPECT_FALSE(previous->getWorld()->hasObject("object"));
+  EXPECT_LT(with_object->getCurrentState().distance(state), 1e-9);
+}
+
+TEST_F(PlanningSceneMonitorTest, SharedSceneFollowerAppliesDiffs)
+{
+  const std::string segment_name = "/moveit_psm_test_scene_" + std::to_string(getpid());
+  planning_scene_monitor_->setPlanningScenePublishingFrequency(100.0);
+  planning_scene_monitor_->startSharedScenePublisher(segment_name, 16 * 1024 * 1024);
+  auto follower = std::make_shared<planning_scene_monitor::PlanningSceneMonitor>(test_node_, "robot_description",
+                                                                                 "shared_scene_follower");
+  follower->startSharedSceneMonitor(segment_name, 200.0);
+
+  const auto wait_for = [](const auto& predicate) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate() && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return predicate();
+  };
+  const auto follower_object = [&follower](const std::string& id) {
+    planning_scene_monitor::LockedPlanningSceneRO scene(follower);
+    return scene->getWorld()->getObject(id);
+  };
+  const auto add_sphere = [this](const std::string& id) {
+    moveit_msgs::msg::PlanningScene msg;
+    msg.is_diff = msg.robot_state.is_diff = true;
+    moveit_msgs::msg::CollisionObject& collision_object = msg.world.collision_objects.emplace_back();
+    collision_object.header.frame_id = scene_->getPlanningFrame();
+    collision_object.id = id;
+    collision_object.operation = moveit_msgs::msg::CollisionObject::ADD;
+    collision_object.pose.orientation.w = 1.0;
+    collision_object.primitives.emplace_back();
+    collision_object.primitives.back().type = shape_msgs::msg::SolidPrimitive::SPHERE;
+    collision_object.primitives.back().dimensions = { 0.1 };
+    planning_scene_monitor_->newPlanningSceneMessage(msg);
+  };
+
+  add_sphere("first");
+  ASSERT_TRUE(wait_for([&] { return follower_object("first") != nullptr; }));
+  const collision_detection::World::ObjectConstPtr first = follower_object("first");
+
+  // a robot state update reaches the follower without touching its world
+  moveit::core::RobotState state(scene_->getCurrentState());
+  state.setToRandomPositions();
+  moveit_msgs::msg::PlanningScene msg;
+  msg.is_diff = true;
+  moveit::core::robotStateToRobotStateMsg(state, msg.robot_state, false);
+  msg.robot_state.is_diff = true;
+  planning_scene_monitor_->newPlanningSceneMessage(msg);
+  EXPECT_TRUE(wait_for([&] {
+    planning_scene_monitor::LockedPlanningSceneRO scene(follower);
+    return scene->getCurrentState().distance(state) < 1e-9;
+  }));
+  EXPECT_EQ(follower_object("first"), first);
+
+  // a new object is added next to the unchanged one instead of rebuilding the world
+  add_sphere("second");
+  EXPECT_TRUE(wait_for([&] { return follower_object("second") != nullptr; }));
+  EXPECT_EQ(follower_object("first"), first);
+
+  msg = moveit_msgs::msg::PlanningScene();
+  msg.is_diff = msg.robot_state.is_diff = true;
+  moveit_msgs::msg::CollisionObject& remove = msg.world.collision_objects.emplace_back();
+  remove.id = "first";
+  remove.operation = moveit_msgs::msg::CollisionObject::REMOVE;
+  planning_scene_monitor_->newPlanningSceneMessage(msg);
+  EXPECT_TRUE(wait_for([&] { return follower_object("first") == nullptr; }));
+  EXPECT_NE(follower_object("second"), nullptr);
+  {
+    planning_scene_monitor::LockedPlanningSceneRO scene(follower);
+    EXPECT_LT(scene->getCurrentState().distance(state), 1e-9);
+  }
+
+  follower->stopSharedSceneMonitor();
+  planning_scene_monitor_->stopSharedScenePublisher();
+}
+
 int main(int argc, char** argv)
 {
   rclcpp::init(argc, argv);
@@ -0,0 +1,237 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+// Shares a planning scene with 10 large meshes between two processes and reports the update latency seen by the
+// reading process and its resident memory.
+
+#include <gtest/gtest.h>
+#include <moveit/planning_scene_monitor/shared_scene_segment.hpp>
+#include <rclcpp/serialization.hpp>
+#include <fstream>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr std::size_t OBJECT_COUNT = 10;
+constexpr std::uint64_t VERSION_COUNT = 50;
+
+moveit_msgs::msg::PlanningScene makeScene(double offset)
+{
+  moveit_msgs::msg::PlanningScene scene;
+  scene.name = "shared";
+  scene.world.collision_objects.resize(OBJECT_COUNT);
+  for (std::size_t i = 0; i < OBJECT_COUNT; ++i)
+  {
+    moveit_msgs::msg::CollisionObject& object = scene.world.collision_objects[i];
+    object.id = "mesh" + std::to_string(i);
+    object.header.frame_id = "world";
+    object.operation = moveit_msgs::msg::CollisionObject::ADD;
+    object.pose.position.x = offset + i;
+    object.pose.orientation.w = 1.0;
+
+    // a triangle strip with enough vertices to make the scene a few MB large
+    shape_msgs::msg::Mesh& mesh = object.meshes.emplace_back();
+    const std::size_t vertex_count = 20000;
+    mesh.vertices.resize(vertex_count);
+    for (std::size_t v = 0; v < vertex_count; ++v)
+    {
+      mesh.vertices[v].x = 1e-4 * v;
+      mesh.vertices[v].y = v % 2;
+    }
+    mesh.triangles.resize(vertex_count - 2);
+    for (std::size_t t = 0; t + 2 < vertex_count; ++t)
+      mesh.triangles[t].vertex_indices = { static_cast<uint32_t>(t), static_cast<uint32_t>(t + 1),
+                                           static_cast<uint32_t>(t + 2) };
+    object.mesh_poses.emplace_back().orientation.w = 1.0;
+  }
+  return scene;
+}
+
+std::size_t residentSetKB()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.rfind("VmRSS:", 0) == 0)
+      return std::stoul(line.substr(6));
+  }
+  return 0;
+}
+
+// What the reading process reports back through a pipe
+struct ReaderReport
+{
+  std::uint64_t last_version = 0;
+  std::uint64_t versions_read = 0;
+  std::size_t objects = 0;
+  double last_x = 0.0;
+  double mean_latency_ms = 0.0;
+  double max_latency_ms = 0.0;
+  std::size_t rss_kb = 0;
+};
+
+ReaderReport runReader(const std::string& name)
+{
+  ReaderReport report;
+  planning_scene_monitor::SharedSceneSegmentPtr segment = planning_scene_monitor::SharedSceneSegment::open(name);
+  moveit_msgs::msg::PlanningScene scene;
+  std::uint64_t version = 0;
+  double total_latency_ms = 0.0;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+  while (version < VERSION_COUNT && std::chrono::steady_clock::now() < deadline)
+  {
+    std::chrono::steady_clock::time_point stamp;
+    if (!segment->read(scene, version, &stamp))
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      continue;
+    }
+    const double latency_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stamp).count();
+    total_latency_ms += latency_ms;
+    report.max_latency_ms = std::max(report.max_latency_ms, latency_ms);
+    ++report.versions_read;
+  }
+  report.last_version = version;
+  report.objects = scene.world.collision_objects.size();
+  if (!scene.world.collision_objects.empty())
+    report.last_x = scene.world.collision_objects[0].pose.position.x;
+  report.mean_latency_ms = report.versions_read ? total_latency_ms / report.versions_read : 0.0;
+  report.rss_kb = residentSetKB();
+  return report;
+}
+}  // namespace
+
+TEST(SharedSceneSegment, ReadOnlyAccess)
+{
+  const std::string name = "/moveit_test_scene_" + std::to_string(getpid());
+  planning_scene_monitor::SharedSceneSegmentPtr writer =
+      planning_scene_monitor::SharedSceneSegment::create(name, 1024 * 1024);
+  planning_scene_monitor::SharedSceneSegmentPtr reader = planning_scene_monitor::SharedSceneSegment::open(name);
+
+  moveit_msgs::msg::PlanningScene scene;
+  std::uint64_t version = 0;
+  EXPECT_EQ(reader->getVersion(), 0u);
+  EXPECT_FALSE(reader->read(scene, version));
+
+  moveit_msgs::msg::PlanningScene written;
+  written.name = "small";
+  EXPECT_TRUE(writer->write(written));
+  EXPECT_FALSE(reader->write(written));
+  EXPECT_TRUE(reader->read(scene, version));
+  EXPECT_EQ(version, 1u);
+  EXPECT_EQ(scene.name, "small");
+  EXPECT_FALSE(reader->read(scene, version));
+
+  // too large for the segment
+  EXPECT_FALSE(writer->write(makeScene(0.0)));
+  EXPECT_EQ(reader->getVersion(), 1u);
+
+  EXPECT_FALSE(reader->isClosed());
+  writer.reset();
+  EXPECT_TRUE(reader->isClosed());
+  EXPECT_THROW(planning_scene_monitor::SharedSceneSegment::open(name), std::runtime_error);
+}
+
+TEST(SharedSceneSegment, TwoProcesses)
+{
+  const std::string name = "/moveit_test_scene_" + std::to_string(getpid());
+  planning_scene_monitor::SharedSceneSegmentPtr writer =
+      planning_scene_monitor::SharedSceneSegment::create(name, 64 * 1024 * 1024);
+
+  // fork before building the scene, so the reader does not inherit a copy of it
+  int report_pipe[2];
+  ASSERT_EQ(pipe(report_pipe), 0);
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0)
+  {
+    close(report_pipe[0]);
+    ReaderReport report;
+    try
+    {
+      report = runReader(name);
+    }
+    catch (const std::exception&)
+    {
+    }
+    const bool written = ::write(report_pipe[1], &report, sizeof(report)) == sizeof(report);
+    _exit(written ? 0 : 1);
+  }
+  close(report_pipe[1]);
+
+  moveit_msgs::msg::PlanningScene scene = makeScene(0.0);
+  ASSERT_TRUE(writer->write(scene));
+
+  // move the objects with every version, as a perception pipeline updating the scene would
+  for (std::uint64_t version = 2; version <= VERSION_COUNT; ++version)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    for (moveit_msgs::msg::CollisionObject& object : scene.world.collision_objects)
+      object.pose.position.x += 1.0;
+    ASSERT_TRUE(writer->write(scene));
+  }
+
+  ReaderReport report;
+  ASSERT_EQ(read(report_pipe[0], &report, sizeof(report)), static_cast<ssize_t>(sizeof(report)));
+  close(report_pipe[0]);
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  EXPECT_EQ(report.last_version, VERSION_COUNT);
+  EXPECT_EQ(report.objects, OBJECT_COUNT);
+  EXPECT_DOUBLE_EQ(report.last_x, VERSION_COUNT - 1.0);
+  EXPECT_GT(report.versions_read, 0u);
+
+  rclcpp::Serialization<moveit_msgs::msg::PlanningScene> serialization;
+  rclcpp::SerializedMessage serialized;
+  serialization.serialize_message(&scene, &serialized);
+  RecordProperty("scene_size_kb", std::to_string(serialized.size() / 1024));
+  RecordProperty("versions_read", std::to_string(report.versions_read) + "/" + std::to_string(VERSION_COUNT));
+  RecordProperty("mean_latency_ms", std::to_string(report.mean_latency_ms));
+  RecordProperty("max_latency_ms", std::to_string(report.max_latency_ms));
+  RecordProperty("reader_rss_kb", std::to_string(report.rss_kb));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,73 @@
+import launch
+import unittest
+import launch_ros
+import launch_testing
+from moveit_configs_utils import MoveItConfigsBuilder
+
+
+def generate_test_description():
+    moveit_config = (
+        MoveItConfigsBuilder("moveit_resources_panda")
+        .robot_description(file_path="config/panda.urdf.xacro")
+        .robot_description_semantic(file_path="config/panda.srdf")
+        .planning_pipelines(pipelines=["ompl"])
+        .to_moveit_configs()
+    )
+
+    # The services under test are not loaded by default
+    capabilities = {
+        "capabilities": " ".join(
+            [
+                "move_group/BatchKinematicsService",
+                "move_group/BatchStateValidationService",
+            ]
+        )
+    }
+
+    # No joint states are published, so the scene keeps the default state of the robot
+    move_group_node = launch_ros.actions.Node(
+        package="moveit_ros_move_group",
+        executable="move_group",
+        output="screen",
+        parameters=[moveit_config.to_dict(), capabilities],
+        arguments=["--ros-args", "--log-level", "info"],
+    )
+
+    move_group_gtest = launch_ros.actions.Node(
+        executable=launch.substitutions.PathJoinSubstitution(
+            [
+                launch.substitutions.LaunchConfiguration("test_binary_dir"),
+                "move_group_services_test",
+            ]
+        ),
+        parameters=[moveit_config.to_dict()],
+        output="screen",
+    )
+
+    return launch.LaunchDescription(
+        [
+            launch.actions.DeclareLaunchArgument(
+                name="test_binary_dir",
+                description="Binary directory of package "
+                "containing test executables",
+            ),
+            move_group_node,
+            move_group_gtest,
+            launch_testing.actions.ReadyToTest(),
+        ]
+    ), {
+        "move_group_gtest": move_group_gtest,
+    }
+
+
+class TestGTestWaitForCompletion(unittest.TestCase):
+    # Waits for test to complete, then waits a bit to make sure result files are generated
+    def test_gtest_run_complete(self, move_group_gtest):
+        self.proc_info.assertWaitForShutdown(move_group_gtest, timeout=4000.0)
+
+
+@launch_testing.post_shutdown_test()
+class TestGTestProcessPostShutdown(unittest.TestCase):
+    # Checks if the test has been completed with acceptable exit codes (successful codes)
+    def test_gtest_pass(self, proc_info, move_group_gtest):
+        launch_testing.asserts.assertExitCodes(proc_info, process=move_group_gtest)
@@ -0,0 +1,405 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Fidelitas Defense
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+/* Description: Integration tests for the services of optional move_group capabilities
+ */
+
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+
+#include <moveit_msgs/srv/apply_planning_scene.hpp>
+#include <moveit_msgs/srv/get_position_fk.hpp>
+#include <moveit_msgs/srv/get_position_ik.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_planning_scene_delta.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_position_fk_batch.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_position_ik_batch.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_state_validity_batch.hpp>
+#include <moveit_ros_move_group_msgs/srv/get_trajectory_validity.hpp>
+#include <shape_msgs/msg/solid_primitive.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr std::chrono::seconds SERVICE_TIMEOUT{ 10 };
+const std::vector<std::string> ARM_JOINTS = { "panda_joint1", "panda_joint2", "panda_joint3", "panda_joint4",
+                                              "panda_joint5", "panda_joint6", "panda_joint7" };
+const std::vector<double> READY_POSITIONS = { 0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785 };
+
+double distance(const geometry_msgs::msg::Point& a, const geometry_msgs::msg::Point& b)
+{
+  return std::hypot(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+std::vector<std::string> getObjectIds(const moveit_msgs::msg::PlanningScene& scene)
+{
+  std::vector<std::string> ids;
+  for (const moveit_msgs::msg::CollisionObject& object : scene.world.collision_objects)
+    ids.push_back(object.id);
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// arm states spread around the ready position
+std::vector<std::vector<double>> makeArmPositions(std::size_t count)
+{
+  std::vector<std::vector<double>> positions(count, READY_POSITIONS);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    positions[i][0] = -1.0 + 2.0 * i / std::max<std::size_t>(count - 1, 1);
+    positions[i][3] += 0.3 * std::sin(static_cast<double>(i));
+  }
+  return positions;
+}
+}  // namespace
+
+class MoveGroupServicesFixture : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    node_ = std::make_shared<rclcpp::Node>("move_group_services_test_node");
+    executor_.add_node(node_);
+    removeAllObjects();
+  }
+
+  template <typename ServiceT>
+  typename ServiceT::Response::SharedPtr call(const std::string& name, const typename ServiceT::Request& request)
+  {
+    auto client = node_->create_client<ServiceT>(name);
+    if (!client->wait_for_service(SERVICE_TIMEOUT))
+    {
+      ADD_FAILURE() << "Service " << name << " is not available";
+      return nullptr;
+    }
+    auto future = client->async_send_request(std::make_shared<typename ServiceT::Request>(request));
+    if (executor_.spin_until_future_complete(future, SERVICE_TIMEOUT) != rclcpp::FutureReturnCode::SUCCESS)
+    {
+      ADD_FAILURE() << "Service " << name << " did not reply";
+      return nullptr;
+    }
+    return future.get();
+  }
+
+  void applyObjects(const std::vector<moveit_msgs::msg::CollisionObject>& objects)
+  {
+    moveit_msgs::srv::ApplyPlanningScene::Request request;
+    request.scene.is_diff = true;
+    request.scene.robot_state.is_diff = true;
+    request.scene.world.collision_objects = objects;
+    const auto response = call<moveit_msgs::srv::ApplyPlanningScene>("apply_planning_scene", request);
+    ASSERT_TRUE(response && response->success);
+  }
+
+  void removeAllObjects()
+  {
+    // a REMOVE operation without object id removes every world object
+    moveit_msgs::msg::CollisionObject remove_all;
+    remove_all.operation = moveit_msgs::msg::CollisionObject::REMOVE;
+    applyObjects({ remove_all });
+  }
+
+  static moveit_msgs::msg::CollisionObject makeBox(const std::string& id, double x, double y, double z, double size)
+  {
+    moveit_msgs::msg::CollisionObject object;
+    object.id = id;
+    object.header.frame_id = "panda_link0";
+    object.operation = moveit_msgs::msg::CollisionObject::ADD;
+    shape_msgs::msg::SolidPrimitive box;
+    box.type = shape_msgs::msg::SolidPrimitive::BOX;
+    box.dimensions = { size, size, size };
+    object.primitives.push_back(box);
+    object.pose.position.x = x;
+    object.pose.position.y = y;
+    object.pose.position.z = z;
+    object.pose.orientation.w = 1.0;
+    return object;
+  }
+
+  static moveit_msgs::msg::RobotState makeArmState(const std::vector<double>& positions)
+  {
+    moveit_msgs::msg::RobotState state;
+    state.is_diff = true;
+    state.joint_state.name = ARM_JOINTS;
+    state.joint_state.position = positions;
+    return state;
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  rclcpp::executors::SingleThreadedExecutor executor_;
+};
+
+TEST_F(MoveGroupServicesFixture, StateValidityBatch)
+{
+  moveit_ros_move_group_msgs::srv::GetStateValidityBatch::Request request;
+  request.group_name = "panda_arm";
+  request.compute_clearance = true;
+  request.robot_states = { makeArmState(READY_POSITIONS), makeArmState(READY_POSITIONS) };
+  request.robot_states[1].joint_state.position[0] = 1.0;
+
+  // nothing to collide with
+  auto response = call<moveit_ros_move_group_msgs::srv::GetStateValidityBatch>("check_state_validity_batch", request);
+  ASSERT_TRUE(response);
+  ASSERT_EQ(response->results.size(), 2u);
+  for (const auto& result : response->results)
+  {
+    EXPECT_TRUE(result.valid);
+    EXPECT_EQ(result.clearance, std::numeric_limits<double>::infinity());
+  }
+
+  // a box in front of the robot gives a finite clearance, and one around the base makes every state collide
+  applyObjects({ makeBox("front", 1.5, 0.0, 0.5, 0.2) });
+  response = call<moveit_ros_move_group_msgs::srv::GetStateValidityBatch>("check_state_validity_batch", request);
+  ASSERT_TRUE(response);
+  ASSERT_EQ(response->results.size(), 2u);
+  for (const auto& result : response->results)
+  {
+    EXPECT_TRUE(result.valid);
+    EXPECT_GT(result.clearance, 0.0);
+    EXPECT_LT(result.clearance, 2.0);
+  }
+
+  applyObjects({ makeBox("base", 0.0, 0.0, 0.3, 0.4) });
+  request.compute_contacts = true;
+  response = call<moveit_ros_move_group_msgs::srv::GetStateValidityBatch>("check_state_validity_batch", request);
+  ASSERT_TRUE(response);
+  ASSERT_EQ(response->results.size(), 2u);
+  for (const auto& result : response->results)
+  {
+    EXPECT_FALSE(result.valid);
+    EXPECT_FALSE(result.contacts.empty());
+    // the clearance is only computed for collision-free states
+    EXPECT_TRUE(std::isnan(result.clearance));
+  }
+
+  // an empty request gets an empty reply
+  request.robot_states.clear();
+  response = call<moveit_ros_move_group_msgs::srv::GetStateValidityBatch>("check_state_validity_batch", request);
+  ASSERT_TRUE(response);
+  EXPECT_TRUE(response->results.empty());
+}
+
+TEST_F(MoveGroupServicesFixture, TrajectoryValidity)
+{
+  moveit_ros_move_group_msgs::srv::GetTrajectoryValidity::Request request;
+  request.group_name = "panda_arm";
+  request.start_state = makeArmState(READY_POSITIONS);
+  request.trajectory.joint_trajectory.joint_names = ARM_JOINTS;
+  for (int i = 0; i < 5; ++i)
+  {
+    trajectory_msgs::msg::JointTrajectoryPoint point;
+    point.positions = READY_POSITIONS;
+    // the first joint turns the arm towards +y
+    point.positions[0] = 0.4 * i;
+    point.time_from_start = rclcpp::Duration::from_seconds(0.5 * i);
+    request.trajectory.joint_trajectory.points.push_back(point);
+  }
+
+  auto response = call<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity>("check_trajectory_validity", request);
+  ASSERT_TRUE(response);
+  EXPECT_TRUE(response->valid);
+  EXPECT_EQ(response->first_invalid_index, -1);
+  EXPECT_EQ(response->results.size(), 5u);
+
+  // a box where the hand ends up when the arm is turned by about 90 degrees
+  applyObjects({ makeBox("side", 0.0, 0.31, 0.55, 0.2) });
+  response = call<moveit_ros_move_group_msgs::srv::GetTrajectoryValidity>("check_trajectory_validity", request);
+  ASSERT_TRUE(response);
+  EXPECT_FALSE(response->valid);
+  ASSERT_EQ(response->results.size(), 5u);
+  ASSERT_GE(response->first_invalid_index, 1);
+  EXPECT_TRUE(response->results[0].valid);
+  for (int i = 0; i < response->first_invalid_index; ++i)
+    EXPECT_TRUE(response->results[i].valid) << i;
+  EXPECT_FALSE(response->results[response->first_invalid_index].valid);
+}
+
+TEST_F(MoveGroupServicesFixture, FKBatchMatchesSingleRequests)
+{
+  const std::vector<std::string> links = { "panda_link4", "panda_link8" };
+  moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Request request;
+  request.fk_link_names = links;
+  for (const std::vector<double>& positions : makeArmPositions(8))
+    request.robot_states.push_back(makeArmState(positions));
+
+  const auto response = call<moveit_ros_move_group_msgs::srv::GetPositionFKBatch>("compute_fk_batch", request);
+  ASSERT_TRUE(response);
+  ASSERT_EQ(response->error_code.val, moveit_msgs::msg::MoveItErrorCodes::SUCCESS);
+  ASSERT_EQ(response->pose_stamped.size(), request.robot_states.size() * links.size());
+
+  for (std::size_t i = 0; i < request.robot_states.size(); ++i)
+  {
+    moveit_msgs::srv::GetPositionFK::Request single;
+    single.fk_link_names = links;
+    single.robot_state = request.robot_states[i];
+    const auto single_response = call<moveit_msgs::srv::GetPositionFK>("compute_fk", single);
+    ASSERT_TRUE(single_response);
+    ASSERT_EQ(single_response->pose_stamped.size(), links.size());
+    for (std::size_t k = 0; k < links.size(); ++k)
+    {
+      const geometry_msgs::msg::PoseStamped& pose = response->pose_stamped[i * links.size() + k];
+      EXPECT_EQ(pose.header.frame_id, single_response->pose_stamped[k].header.frame_id);
+      EXPECT_NEAR(distance(pose.pose.position, single_response->pose_stamped[k].pose.position), 0.0, 1e-9)
+          << "state " << i << ", link " << links[k];
+    }
+  }
+
+  // an unknown link fails the whole request
+  request.fk_link_names.push_back("no_such_link");
+  const auto failed = call<moveit_ros_move_group_msgs::srv::GetPositionFKBatch>("compute_fk_batch", request);
+  ASSERT_TRUE(failed);
+  EXPECT_EQ(failed->error_code.val, moveit_msgs::msg::MoveItErrorCodes::INVALID_LINK_NAME);
+  EXPECT_TRUE(failed->pose_stamped.empty());
+}
+
+TEST_F(MoveGroupServicesFixture, IKBatchReachesRequestedPoses)
+{
+  constexpr std::size_t COUNT = 32;
+  const std::vector<std::vector<double>> positions = makeArmPositions(COUNT);
+
+  // reachable targets: the flange poses of known arm states
+  moveit_ros_move_group_msgs::srv::GetPositionFKBatch::Request fk_request;
+  fk_request.fk_link_names = { "panda_link8" };
+  for (const std::vector<double>& p : positions)
+    fk_request.robot_states.push_back(makeArmState(p));
+  const auto targets = call<moveit_ros_move_group_msgs::srv::GetPositionFKBatch>("compute_fk_batch", fk_request);
+  ASSERT_TRUE(targets);
+  ASSERT_EQ(targets->pose_stamped.size(), COUNT);
+
+  moveit_ros_move_group_msgs::srv::GetPositionIKBatch::Request request;
+  for (const geometry_msgs::msg::PoseStamped& target : targets->pose_stamped)
+  {
+    moveit_msgs::msg::PositionIKRequest ik_request;
+    ik_request.group_name = "panda_arm";
+    ik_request.ik_link_name = "panda_link8";
+    ik_request.pose_stamped = target;
+    ik_request.robot_state = makeArmState(READY_POSITIONS);
+    ik_request.timeout = rclcpp::Duration::from_seconds(0.5);
+    request.ik_requests.push_back(ik_request);
+  }
+  // requests that cannot be solved are answered in place
+  request.ik_requests.push_back(request.ik_requests.front());
+  request.ik_requests.back().group_name = "no_such_group";
+
+  auto start = std::chrono::steady_clock::now();
+  const auto response = call<moveit_ros_move_group_msgs::srv::GetPositionIKBatch>("compute_ik_batch", request);
+  const double batch_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  ASSERT_TRUE(response);
+  ASSERT_EQ(response->error_codes.size(), COUNT + 1);
+  ASSERT_EQ(response->solutions.size(), COUNT + 1);
+  EXPECT_EQ(response->error_codes.back().val, moveit_msgs::msg::MoveItErrorCodes::INVALID_GROUP_NAME);
+
+  // check every solution by computing its flange pose again
+  fk_request.robot_states.clear();
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    ASSERT_EQ(response->error_codes[i].val, moveit_msgs::msg::MoveItErrorCodes::SUCCESS) << i;
+    fk_request.robot_states.push_back(response->solutions[i]);
+  }
+  const auto reached = call<moveit_ros_move_group_msgs::srv::GetPositionFKBatch>("compute_fk_batch", fk_request);
+  ASSERT_TRUE(reached);
+  ASSERT_EQ(reached->pose_stamped.size(), COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i)
+    EXPECT_NEAR(distance(reached->pose_stamped[i].pose.position, targets->pose_stamped[i].pose.position), 0.0, 1e-3);
+
+  // the same requests one by one through compute_ik, for comparison in the test report
+  start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < COUNT; ++i)
+  {
+    moveit_msgs::srv::GetPositionIK::Request single;
+    single.ik_request = request.ik_requests[i];
+    const auto single_response = call<moveit_msgs::srv::GetPositionIK>("compute_ik", single);
+    ASSERT_TRUE(single_response);
+    EXPECT_EQ(single_response->error_code.val, moveit_msgs::msg::MoveItErrorCodes::SUCCESS);
+  }
+  const double sequential_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  RecordProperty("ik_batch_seconds", std::to_string(batch_time));
+  RecordProperty("ik_sequential_seconds", std::to_string(sequential_time));
+}
+
+TEST_F(MoveGroupServicesFixture, PlanningSceneDeltaRecoversFromLostReply)
+{
+  using moveit_ros_move_group_msgs::srv::GetPlanningSceneDelta;
+  using Ids = std::vector<std::string>;
+  GetPlanningSceneDelta::Request request;
+
+  applyObjects({ makeBox("first", 1.0, 0.0, 0.5, 0.1) });
+  auto reply = call<GetPlanningSceneDelta>("get_planning_scene_delta", request);
+  ASSERT_TRUE(reply);
+  EXPECT_FALSE(reply->scene.is_diff);
+  EXPECT_EQ(getObjectIds(reply->scene), Ids({ "first" }));
+  const uint64_t applied_version = reply->version;
+
+  // a diff against the applied reply only carries the new object
+  applyObjects({ makeBox("second", 1.0, 0.5, 0.5, 0.1) });
+  request.base_version = applied_version;
+  reply = call<GetPlanningSceneDelta>("get_planning_scene_delta", request);
+  ASSERT_TRUE(reply);
+  EXPECT_TRUE(reply->scene.is_diff);
+  EXPECT_EQ(getObjectIds(reply->scene), Ids({ "second" }));
+
+  // this reply is lost, so the client asks again against the version it applied last and gets the complete scene
+  applyObjects({ makeBox("third", 1.0, -0.5, 0.5, 0.1) });
+  reply = call<GetPlanningSceneDelta>("get_planning_scene_delta", request);
+  ASSERT_TRUE(reply);
+  EXPECT_FALSE(reply->scene.is_diff);
+  EXPECT_EQ(getObjectIds(reply->scene), Ids({ "first", "second", "third" }));
+
+  // once it applied that reply, the client gets diffs again
+  request.base_version = reply->version;
+  reply = call<GetPlanningSceneDelta>("get_planning_scene_delta", request);
+  ASSERT_TRUE(reply);
+  EXPECT_TRUE(reply->scene.is_diff);
+  EXPECT_TRUE(reply->scene.world.collision_objects.empty());
+
+  // a version the server never sent is not trusted either
+  request.base_version = reply->version + 1000;
+  reply = call<GetPlanningSceneDelta>("get_planning_scene_delta", request);
+  ASSERT_TRUE(reply);
+  EXPECT_FALSE(reply->scene.is_diff);
+  EXPECT_EQ(getObjectIds(reply->scene), Ids({ "first", "second", "third" }));
+}
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}